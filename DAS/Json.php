@@ -321,6 +321,13 @@ it comes in but by then the model is set
      */
     public function decode($jsonString, $root_type = null, $root_namespace = null )
     {
+        // when the sdo extension provides the native decoder the
+        // graph is built directly from the json string in one pass
+        if (class_exists('SDO_DAS_JsonImpl', false)) {
+            $sdo = $this->_createRootDataObject($root_type, $root_namespace);
+            return SDO_DAS_JsonImpl::decode($jsonString, $sdo);
+        }
+
         // decode json string into PHP variable representation
         $json = json_decode($jsonString);
 
@@ -336,55 +343,65 @@ it comes in but by then the model is set
         // top level object here to be an SDO object on the assumption
         // that we will not be passed fragments of JSON. I.e. $jason_string
         // will always start with '{' and end with '}'
-        $sdo = null;
-
-        // guess the namespace if one is not provided
-        if ($root_namespace == null ) {
-            $root_namespace = $this->default_namespace;
-        }
+        $sdo = $this->_createRootDataObject($root_type, $root_namespace);
 
         // currently do a different parse if types have specified
         // compared to the generic parse we started with
         // just want to keep the code separate while we move toward
         // the newer type driven parse.
-        if ($this->is_smd_model == true &&
-             $root_type          != null ) {
+        if (($this->is_smd_model == true || $this->is_xsd_model == true) &&
+             $root_type != null ) {
             // walk the jason tree creating the correct types based
             // on the model from the specified root type down
-            $sdo = $this->data_factory->create($root_namespace, $root_type);
-            $this->_decodeObjectToSDONew($json, $sdo);
-        } else if ($this->is_xsd_model == true &&
-                    $root_type         != null ) {
-            // walk the jason tree creating the correct types based
-            // on the model from the specified root type down
-            $sdo = $this->xml_das->createDataObject($root_namespace, $root_type);
             $this->_decodeObjectToSDONew($json, $sdo);
         } else {
-            // either there is no model or there is no root type
-            // so we need to create a generic model
-            $this->is_generic_model = true;
-
-            if ($this->data_factory == null ) {
-                // create an empty data factory
-                $this->data_factory = SDO_DAS_DataFactory::getDataFactory();
-
-                // first parse the incomming JSON message to construct
-                // a type hierarchy.
-                // TODO - I'm cheating here by just using a generic type
-                //        for now
-                $this->data_factory->addType('GenericNS',
-                                             'GenericType',
-                                             array('open'=>true));
-            }
-
-            // parse the JSON message using this type hierarchy
-            $sdo = $this->data_factory->create('GenericNS', 'GenericType');
+            // parse the JSON message using the generic type
             $this->_decodeObjectToSDO($json, $sdo);
         }
 
         return $sdo;
     }
 
+    /**
+     * Create the data object a JSON message is decoded into, using the
+     * SMD or XSD model when a root type is given and the generic type
+     * otherwise
+     */
+    private function _createRootDataObject($root_type, $root_namespace)
+    {
+        // guess the namespace if one is not provided
+        if ($root_namespace == null ) {
+            $root_namespace = $this->default_namespace;
+        }
+
+        if ($this->is_smd_model == true &&
+             $root_type          != null ) {
+            return $this->data_factory->create($root_namespace, $root_type);
+        } else if ($this->is_xsd_model == true &&
+                    $root_type         != null ) {
+            return $this->xml_das->createDataObject($root_namespace, $root_type);
+        }
+
+        // either there is no model or there is no root type
+        // so we need to create a generic model
+        $this->is_generic_model = true;
+
+        if ($this->data_factory == null ) {
+            // create an empty data factory
+            $this->data_factory = SDO_DAS_DataFactory::getDataFactory();
+
+            // first parse the incomming JSON message to construct
+            // a type hierarchy.
+            // TODO - I'm cheating here by just using a generic type
+            //        for now
+            $this->data_factory->addType('GenericNS',
+                                         'GenericType',
+                                         array('open'=>true));
+        }
+
+        return $this->data_factory->create('GenericNS', 'GenericType');
+    }
+
     private function _decodeObjectToSDONew($object, $sdo)
     {
         foreach ($object as $param_name => $param_value ) {
@@ -534,6 +551,11 @@ it comes in but by then the model is set
      */
     public function encode ($sdo )
     {
+        // use the native encoder when the sdo extension provides it
+        if (class_exists('SDO_DAS_JsonImpl', false)) {
+            return SDO_DAS_JsonImpl::encode($sdo);
+        }
+
         $json_string = null;
 
         $this->_encodeObjectFromSDO($sdo, $json_string);
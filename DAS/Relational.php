@@ -168,6 +168,10 @@ class SDO_DAS_Relational {
     {
         include_once "SDO/DAS/Relational/PDOConstants.colon.inc.php";
 
+        if (class_exists('SDO_DAS_GraphBuilder', false)) {
+            return $this->normaliseResultSetWithGraphBuilder($pdo_stmt, $column_specifier);
+        }
+
         if ($column_specifier == null) {
             $all_rows = $pdo_stmt->fetchAll(SDO_DAS_Relational_PDO_FETCH_ASSOC);
         } else {
@@ -245,6 +249,115 @@ class SDO_DAS_Relational {
         return $root;
     }
 
+    /**
+     * Normalise the result set using the native graph builder from the SDO extension.
+     *
+     * The column plan is worked out once, from the column specifier or from the column
+     * names of the first row, and the builder then fetches the rest of the rows from the
+     * PDO statement, finds or creates the object for each table on each row, and sets the
+     * non-containment references once all the rows have been read.
+     */
+    private function normaliseResultSetWithGraphBuilder($pdo_stmt, $column_specifier)
+    {
+        $root      = self::createRoot($this->data_factory);
+        $first_row = null;
+
+        if ($column_specifier == null) {
+            $first_row = $pdo_stmt->fetch(SDO_DAS_Relational_PDO_FETCH_ASSOC);
+            if ($first_row === false) {
+                $root->getChangeSummary()->beginLogging();
+                return $root;
+            }
+            $columns = array();
+            foreach ($first_row as $col => $value) {
+                $table_names_with_this_column = $this->object_model->getTypesByColumnNameIgnoreCase($col);
+                switch (count($table_names_with_this_column)) {
+                    case 0:
+                    throw new SDO_DAS_Relational_Exception('The result set from ExecuteQuery contained a column with name ' . $col . ' but there is no table with a column with this name.');
+                    case 1:
+                    foreach ($table_names_with_this_column as $table_name => $property_name) // only one entry
+                    $columns[] = array($table_name, $property_name);
+                    break;
+                    default:
+                    throw new SDO_DAS_Relational_Exception('The result set from ExecuteQuery contained a column with name ' . $col . ' but there is more than one table with a column with this name. You need to pass a column specifier to resolve the ambiguity.');
+                }
+            }
+        } else {
+            $columns = array();
+            foreach ($column_specifier as $cs) {
+                $columns[] = split('[.]', $cs);
+            }
+        }
+
+        $tables_in_result = array();
+        foreach ($columns as $column) {
+            $tables_in_result[$column[0]][] = $column[1];
+        }
+
+        $parent_tables = array();
+        foreach ($this->database_model->getAllTableNames() as $table_name) {
+            if (!array_key_exists($table_name, $tables_in_result)) {
+                continue;
+            }
+            $pk_name = $this->database_model->getPrimaryKeyFromTableName($table_name);
+            if (!in_array($pk_name, $tables_in_result[$table_name])) {
+                throw new SDO_DAS_Relational_Exception("Data retrieved from table " . $table_name . " did not include the primary key for this table. Primary keys must always be included.\n");
+            }
+            $parent_table_name = $this->database_model->getParentTable($table_name);
+            if ($parent_table_name !== null && !array_key_exists($parent_table_name, $tables_in_result)) {
+                throw new SDO_DAS_Relational_Exception("Data retrieved from table " . $table_name . " did not include data from its parent table " . $parent_table_name . ".\n");
+            }
+            $parent_tables[$table_name] = $parent_table_name;
+        }
+
+        // The metadata may list a child table before its parent, but the builder needs the parent first
+        $builder      = new SDO_DAS_GraphBuilder($root);
+        $added_tables = array();
+        while (count($parent_tables) > 0) {
+            $added_one = false;
+            foreach ($parent_tables as $table_name => $parent_table_name) {
+                if ($parent_table_name === null || array_key_exists($parent_table_name, $added_tables)) {
+                    $builder->addTable($table_name, $parent_table_name);
+                    $added_tables[$table_name] = true;
+                    unset($parent_tables[$table_name]);
+                    $added_one = true;
+                }
+            }
+            if (!$added_one) {
+                throw new SDO_DAS_Relational_Exception("The foreign keys of tables " . implode(', ', array_keys($parent_tables)) . " form a cycle, so none of them can be the parent of the others.\n");
+            }
+        }
+
+        $keyed_tables = array();
+        foreach ($columns as $column) {
+            list($table_name, $column_name) = $column;
+            if (!array_key_exists($table_name, $added_tables)) {
+                throw new SDO_DAS_Relational_Exception('The result set contained a column ' . $column_name . ' from table ' . $table_name . ' but there is no table with this name.');
+            }
+            if ($this->object_model->isNonContainmentReferenceProperty($table_name, $column_name)) {
+                $to_type = $this->object_model->getToTypeOfNonContainmentReferenceProperty($table_name, $column_name);
+                $builder->addColumn($table_name, $column_name, false, $to_type);
+            } else {
+                $is_key = !array_key_exists($table_name, $keyed_tables)
+                    && $column_name == $this->database_model->getPrimaryKeyFromTableName($table_name);
+                if ($is_key) {
+                    $keyed_tables[$table_name] = true;
+                }
+                $builder->addColumn($table_name, $column_name, $is_key);
+            }
+        }
+
+        if ($first_row !== null) {
+            $builder->addRows(array(array_values($first_row)));
+        }
+        $pdo_stmt->setFetchMode(SDO_DAS_Relational_PDO_FETCH_NUM);
+        $builder->addRows($pdo_stmt);
+        $builder->resolveReferences();
+
+        $root->getChangeSummary()->beginLogging();
+        return $root;
+    }
+
     public function breakRowIntoObjectsUsingPDOColumnNames($row)
     {
         $parsed_row = array();
@@ -302,6 +415,53 @@ class SDO_DAS_Relational {
         if (self::DEBUG_CHANGE_SUMMARY) {
             self::displayChangeSummary($change_summary);
         }
+        if (method_exists($change_summary, 'getChangePlan')) {
+            $plan = $this->buildPlanFromChangePlan($change_summary->getChangePlan());
+        } else {
+            $plan = $this->buildPlanFromChangedDataObjects($change_summary);
+        }
+        $dbh->beginTransaction();
+        $plan->execute($dbh);
+        $dbh->commit();
+        // turn logging off and on again to clear out the change summary. The user can now continue to work with the data graph.
+        $root->getChangeSummary()->endLogging();
+        $root->getChangeSummary()->beginLogging();
+
+    }
+
+    /**
+     * Build the plan from the change plan of the change summary, which gives every change
+     * with its old values in one call. The deletes come first, children before their
+     * parents, so that a row can be deleted and reinserted with the same primary key,
+     * then the inserts, a parent row always before its children, then the updates.
+     */
+    private function buildPlanFromChangePlan($change_plan)
+    {
+        $plan = new SDO_DAS_Relational_Plan();
+        foreach ($change_plan as $change) {
+            $do = $change['data_object'];
+            switch ($change['change_type']) {
+            case SDO_DAS_ChangeSummary::ADDITION:
+                $plan->addAction(new SDO_DAS_Relational_InsertAction($this->object_model, $do));
+                break;
+            case SDO_DAS_ChangeSummary::MODIFICATION:
+                if (self::isRoot($do)) {
+                    continue;
+                }
+                $plan->addAction(new SDO_DAS_Relational_UpdateAction($this->object_model, $do, $change['old_values']));
+                break;
+            case SDO_DAS_ChangeSummary::DELETION:
+                $plan->addAction(new SDO_DAS_Relational_DeleteAction($this->object_model, $do, $change['old_values']));
+                break;
+            default:
+                assert(false, 'SDO_DAS_Relational.php found a change in the change summary with an improper type');
+            }
+        }
+        return $plan;
+    }
+
+    private function buildPlanFromChangedDataObjects($change_summary)
+    {
         $changed_data_objects = $change_summary->getChangedDataObjects();
         $plan                 = new SDO_DAS_Relational_Plan();
         foreach ($changed_data_objects as $do) {
@@ -326,13 +486,7 @@ class SDO_DAS_Relational {
                 assert(false, 'SDO_DAS_Relational.php found a change in the change summary with an improper type');
             }
         }
-        $dbh->beginTransaction();
-        $plan->execute($dbh);
-        $dbh->commit();
-        // turn logging off and on again to clear out the change summary. The user can now continue to work with the data graph.
-        $root->getChangeSummary()->endLogging();
-        $root->getChangeSummary()->beginLogging();
-
+        return $plan;
     }
 
     private static function displaySettingsList($cs,$cdo)
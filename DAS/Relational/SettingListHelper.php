@@ -30,8 +30,13 @@ $Id: SettingListHelper.php 220738 2006-09-28 19:25:00Z cem $
 class SDO_DAS_Relational_SettingListHelper
 {
 
-    public static function getSettingsAsArray(SDO_DAS_SettingList $setting_list)
+    public static function getSettingsAsArray($setting_list)
     {
+        if (is_array($setting_list)) {
+            // already property name => old value, as from SDO_DAS_ChangeSummary::getChangePlan()
+            return $setting_list;
+        }
+
         $settings_as_array = array();
 
         foreach ($setting_list as $setting) {
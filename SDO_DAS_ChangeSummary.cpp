@@ -31,6 +31,8 @@ static char rcs_id[] = "$Id: SDO_DAS_ChangeSummary.cpp 234945 2007-05-04 15:05:5
 
 #include "php_sdo_int.h"
 
+#include "commonj/sdo/ChangeSummaryImpl.h"
+
 #define CLASS_NAME "SDO_DAS_ChangeSummary"
 
 /* {{{ sdo_das_changesummary_object
@@ -369,6 +371,73 @@ PHP_METHOD(SDO_DAS_ChangeSummary, getOldContainer)
 }
 /* }}} */
 
+/* {{{ SDO_DAS_ChangeSummary::getChangePlan
+ */
+PHP_METHOD(SDO_DAS_ChangeSummary, getChangePlan)
+{
+	sdo_das_changesummary_object *my_object;
+	CHANGE_PLAN			 plan;
+	zval				*z_entry, *z_do, *z_old_values;
+	long				 change_type;
+
+	if (ZEND_NUM_ARGS() != 0) {
+		WRONG_PARAM_COUNT;
+	}
+
+	my_object = sdo_das_changesummary_get_instance(getThis() TSRMLS_CC);
+
+	try {
+		ChangeSummaryImpl *csi = (ChangeSummaryImpl *)(ChangeSummary *)my_object->change_summary;
+		csi->getChangePlan(plan);
+
+		array_init(return_value);
+		for (unsigned int i = 0; i < plan.size(); i++) {
+			const changePlanItem& item = plan[i];
+
+			switch (item.changeType) {
+			case ChangedDataObjectList::Create:
+				change_type = CS_ADDITION;
+				break;
+			case ChangedDataObjectList::Delete:
+				change_type = CS_DELETION;
+				break;
+			default:
+				change_type = CS_MODIFICATION;
+			}
+
+			MAKE_STD_ZVAL(z_do);
+			sdo_do_new(z_do, item.object TSRMLS_CC);
+
+			/* the old values, keyed by property name as the Relational DAS wants them */
+			MAKE_STD_ZVAL(z_old_values);
+			array_init(z_old_values);
+			if (item.oldValues) {
+				SettingList& sl = *item.oldValues;
+				for (int j = 0; j < sl.size(); j++) {
+					Setting *setting = sl.get(j);
+					if (setting->isSet()) {
+						const char *name = setting->getProperty().getName();
+						add_assoc_zval(z_old_values, (char *)name, sdo_das_setting_value(setting TSRMLS_CC));
+					}
+				}
+			}
+
+			MAKE_STD_ZVAL(z_entry);
+			array_init(z_entry);
+			add_assoc_long(z_entry, "change_type", change_type);
+			add_assoc_zval(z_entry, "data_object", z_do);
+			add_assoc_long(z_entry, "depth", item.depth);
+			add_assoc_zval(z_entry, "old_values", z_old_values);
+			add_next_index_zval(return_value, z_entry);
+		}
+	} catch (SDORuntimeException e) {
+		sdo_throw_runtimeexception(&e TSRMLS_CC);
+	}
+
+	return;
+}
+/* }}} */
+
 /*
  * Local variables:
  * tab-width: 4
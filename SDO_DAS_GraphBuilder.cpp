@@ -0,0 +1,415 @@
+/*
++----------------------------------------------------------------------+
+| (c) Copyright IBM Corporation 2005, 2008.                            |
+| All Rights Reserved.                                                 |
++----------------------------------------------------------------------+
+|                                                                      |
+| Licensed under the Apache License, Version 2.0 (the "License"); you  |
+| may not use this file except in compliance with the License. You may |
+| obtain a copy of the License at                                      |
+| http://www.apache.org/licenses/LICENSE-2.0                           |
+|                                                                      |
+| Unless required by applicable law or agreed to in writing, software  |
+| distributed under the License is distributed on an "AS IS" BASIS,    |
+| WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or      |
+| implied. See the License for the specific language governing         |
+| permissions and limitations under the License.                       |
++----------------------------------------------------------------------+
+| Author: Caroline Maynard                                             |
++----------------------------------------------------------------------+
+
+*/
+static char rcs_id[] = "$Id$";
+
+#ifdef PHP_WIN32
+#include <iostream>
+#include <math.h>
+#include "zend_config.w32.h"
+#endif
+
+#include "php.h"
+#include "zend_exceptions.h"
+
+#include "php_sdo_int.h"
+
+#include "commonj/sdo/SDOGraphBuilder.h"
+
+#include <vector>
+
+#define CLASS_NAME "SDO_DAS_GraphBuilder"
+
+/* {{{ sdo_das_gb_object
+ * The instance data for this class - extends the standard zend_object
+ */
+typedef struct {
+	zend_object		 zo;			/* The standard zend_object */
+	SDOGraphBuilder	*builder;		/* The sdo4cpp graph builder */
+} sdo_das_gb_object;
+/* }}} */
+
+static zend_object_handlers sdo_das_gb_object_handlers;
+
+/* {{{ sdo_das_gb_get_instance
+ */
+static sdo_das_gb_object *sdo_das_gb_get_instance(zval *me TSRMLS_DC)
+{
+	return (sdo_das_gb_object *)zend_object_store_get_object(me TSRMLS_CC);
+}
+/* }}} */
+
+/* {{{ debug macro functions
+ */
+SDO_DEBUG_ADDREF(das_gb)
+SDO_DEBUG_DELREF(das_gb)
+SDO_DEBUG_DESTROY(das_gb)
+/* }}} */
+
+/* {{{ sdo_das_gb_object_free_storage
+ */
+static void sdo_das_gb_object_free_storage(void *object TSRMLS_DC)
+{
+	sdo_das_gb_object *my_object;
+
+	SDO_DEBUG_FREE(object);
+
+	my_object = (sdo_das_gb_object *)object;
+	zend_hash_destroy(my_object->zo.properties);
+	FREE_HASHTABLE(my_object->zo.properties);
+
+	if (my_object->zo.guards) {
+	    zend_hash_destroy(my_object->zo.guards);
+	    FREE_HASHTABLE(my_object->zo.guards);
+	}
+
+	delete my_object->builder;
+	my_object->builder = NULL;
+	efree(object);
+}
+/* }}} */
+
+/* {{{ sdo_das_gb_object_create
+ */
+static zend_object_value sdo_das_gb_object_create(zend_class_entry *ce TSRMLS_DC)
+{
+	zend_object_value retval;
+	zval *tmp; /* this must be passed to hash_copy, but doesn't seem to be used */
+	sdo_das_gb_object *my_object;
+
+	my_object = (sdo_das_gb_object *)emalloc(sizeof(sdo_das_gb_object));
+	memset(my_object, 0, sizeof(sdo_das_gb_object));
+	my_object->zo.ce = ce;
+	my_object->zo.guards = NULL;
+	ALLOC_HASHTABLE(my_object->zo.properties);
+	zend_hash_init(my_object->zo.properties, 0, NULL, ZVAL_PTR_DTOR, 0);
+
+	#if PHP_VERSION_ID < 50399
+	  zend_hash_copy(my_object->zo.properties, &ce->default_properties, (copy_ctor_func_t)zval_add_ref, (void *)&tmp, sizeof(zval *));
+	#else
+	  object_properties_init(&my_object->zo, ce);
+	#endif
+	retval.handle = zend_objects_store_put(my_object, SDO_FUNC_DESTROY(das_gb), sdo_das_gb_object_free_storage, NULL TSRMLS_CC);
+	retval.handlers = &sdo_das_gb_object_handlers;
+	SDO_DEBUG_ALLOCATE(retval.handle, my_object);
+
+	return retval;
+}
+/* }}} */
+
+/* {{{ sdo_das_gb_minit
+ */
+void sdo_das_gb_minit(zend_class_entry *tmp_ce TSRMLS_DC)
+{
+	tmp_ce->create_object = sdo_das_gb_object_create;
+	sdo_das_graphbuilder_class_entry = zend_register_internal_class(tmp_ce TSRMLS_CC);
+	sdo_das_graphbuilder_class_entry->ce_flags |= ZEND_ACC_FINAL_CLASS;
+
+	memcpy(&sdo_das_gb_object_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+	sdo_das_gb_object_handlers.add_ref = SDO_FUNC_ADDREF(das_gb);
+	sdo_das_gb_object_handlers.del_ref = SDO_FUNC_DELREF(das_gb);
+	sdo_das_gb_object_handlers.clone_obj = NULL;
+}
+/* }}} */
+
+/* {{{ sdo_das_gb_get_builder
+ */
+static SDOGraphBuilder *sdo_das_gb_get_builder(zval *me TSRMLS_DC)
+{
+	sdo_das_gb_object *my_object = sdo_das_gb_get_instance(me TSRMLS_CC);
+
+	if (!my_object->builder) {
+		const char *space, *class_name = get_active_class_name(&space TSRMLS_CC);
+		sdo_throw_exception_ex(sdo_exception_class_entry, 0, 0 TSRMLS_CC,
+			"%s%s%s(): the graph builder has not been constructed",
+			class_name, space, get_active_function_name(TSRMLS_C));
+	}
+	return my_object->builder;
+}
+/* }}} */
+
+/* {{{ sdo_das_gb_get_table
+ * Look up a table by name, throwing if it has not been added
+ */
+static int sdo_das_gb_get_table(SDOGraphBuilder *builder, const char *name TSRMLS_DC)
+{
+	int table = builder->getTable(name);
+
+	if (table < 0) {
+		const char *space, *class_name = get_active_class_name(&space TSRMLS_CC);
+		sdo_throw_exception_ex(sdo_indexoutofboundsexception_class_entry, 0, 0 TSRMLS_CC,
+			"%s%s%s(): table '%s' has not been added",
+			class_name, space, get_active_function_name(TSRMLS_C), name);
+	}
+	return table;
+}
+/* }}} */
+
+/* {{{ sdo_das_gb_add_row
+ * Pass one row, an array of column values in column order, to the builder.
+ * Strings are passed in place, other scalars are converted on a copy.
+ */
+static int sdo_das_gb_add_row(SDOGraphBuilder *builder, zval *z_row TSRMLS_DC)
+{
+	unsigned int		 count = builder->getColumnCount();
+	std::vector<const char *> values(count);
+	std::vector<unsigned int> lengths(count);
+	std::vector<zval>	 copies;
+	zval				**z_cell;
+	int					 rc = SUCCESS;
+
+	if (Z_TYPE_P(z_row) != IS_ARRAY) {
+		const char *space, *class_name = get_active_class_name(&space TSRMLS_CC);
+		sdo_throw_exception_ex(sdo_unsupportedoperationexception_class_entry, 0, 0 TSRMLS_CC,
+			"%s%s%s(): expected each row to be an array, found %s",
+			class_name, space, get_active_function_name(TSRMLS_C), zend_zval_type_name(z_row));
+		return FAILURE;
+	}
+
+	copies.reserve(count);
+	for (unsigned int i = 0; i < count; i++) {
+		if (zend_hash_index_find(Z_ARRVAL_P(z_row), i, (void **)&z_cell) == FAILURE ||
+			Z_TYPE_PP(z_cell) == IS_NULL) {
+			values[i] = NULL;
+			lengths[i] = 0;
+		} else if (Z_TYPE_PP(z_cell) == IS_STRING) {
+			values[i] = Z_STRVAL_PP(z_cell);
+			lengths[i] = Z_STRLEN_PP(z_cell);
+		} else {
+			copies.push_back(**z_cell);
+			zval *temp_zval = &copies.back();
+			zval_copy_ctor(temp_zval);
+			convert_to_string(temp_zval);
+			values[i] = Z_STRVAL_P(temp_zval);
+			lengths[i] = Z_STRLEN_P(temp_zval);
+		}
+	}
+
+	try {
+		builder->addRow(count ? &values[0] : NULL, count ? &lengths[0] : NULL, count);
+	} catch (SDORuntimeException e) {
+		sdo_throw_runtimeexception(&e TSRMLS_CC);
+		rc = FAILURE;
+	}
+
+	for (unsigned int i = 0; i < copies.size(); i++) {
+		zval_dtor(&copies[i]);
+	}
+	return rc;
+}
+/* }}} */
+
+/* {{{ SDO_DAS_GraphBuilder::__construct
+ */
+PHP_METHOD(SDO_DAS_GraphBuilder, __construct)
+{
+	zval *z_do;
+	sdo_das_gb_object *my_object;
+
+	if (ZEND_NUM_ARGS() != 1) {
+		WRONG_PARAM_COUNT;
+	}
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "O", &z_do, sdo_dataobject_class_entry) == FAILURE) {
+		return;
+	}
+
+	my_object = sdo_das_gb_get_instance(getThis() TSRMLS_CC);
+
+	DataObjectPtr dop = sdo_do_get(z_do TSRMLS_CC);
+	if (!dop) {
+		const char *space, *class_name = get_active_class_name (&space TSRMLS_CC);
+		php_error(E_ERROR, "%s%s%s(): internal error (%i) - SDO_DataObject not found in store",
+			class_name, space, get_active_function_name(TSRMLS_C), __LINE__);
+		RETURN_NULL();
+	}
+
+	delete my_object->builder;
+	my_object->builder = new SDOGraphBuilder(dop);
+}
+/* }}} */
+
+/* {{{ SDO_DAS_GraphBuilder::addTable
+ */
+PHP_METHOD(SDO_DAS_GraphBuilder, addTable)
+{
+	char *name, *parent = NULL;
+	int	  name_len, parent_len = 0;
+	int	  parent_table = -1;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "s|s!",
+		&name, &name_len, &parent, &parent_len) == FAILURE) {
+		return;
+	}
+
+	SDOGraphBuilder *builder = sdo_das_gb_get_builder(getThis() TSRMLS_CC);
+	if (!builder) {
+		return;
+	}
+
+	if (parent) {
+		parent_table = sdo_das_gb_get_table(builder, parent TSRMLS_CC);
+		if (parent_table < 0) {
+			return;
+		}
+	}
+
+	try {
+		RETVAL_LONG(builder->addTable(SDOString(name, name_len), parent_table));
+	} catch (SDORuntimeException e) {
+		sdo_throw_runtimeexception(&e TSRMLS_CC);
+	}
+}
+/* }}} */
+
+/* {{{ SDO_DAS_GraphBuilder::addColumn
+ */
+PHP_METHOD(SDO_DAS_GraphBuilder, addColumn)
+{
+	char	  *table_name, *property_name, *referenced_table = NULL;
+	int		   table_name_len, property_name_len, referenced_table_len = 0;
+	zend_bool  is_key = 0;
+	int		   table;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "ss|bs!",
+		&table_name, &table_name_len, &property_name, &property_name_len,
+		&is_key, &referenced_table, &referenced_table_len) == FAILURE) {
+		return;
+	}
+
+	SDOGraphBuilder *builder = sdo_das_gb_get_builder(getThis() TSRMLS_CC);
+	if (!builder) {
+		return;
+	}
+
+	table = sdo_das_gb_get_table(builder, table_name TSRMLS_CC);
+	if (table < 0) {
+		return;
+	}
+
+	try {
+		if (referenced_table) {
+			RETVAL_LONG(builder->addReferenceColumn(table, SDOString(property_name, property_name_len),
+				SDOString(referenced_table, referenced_table_len)));
+		} else {
+			RETVAL_LONG(builder->addColumn(table, SDOString(property_name, property_name_len),
+				ZEND_TRUTH(is_key)));
+		}
+	} catch (SDORuntimeException e) {
+		sdo_throw_runtimeexception(&e TSRMLS_CC);
+	}
+}
+/* }}} */
+
+/* {{{ SDO_DAS_GraphBuilder::addRows
+ */
+PHP_METHOD(SDO_DAS_GraphBuilder, addRows)
+{
+	zval	**z_row;
+	zval	 *z_rows;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "z", &z_rows) == FAILURE) {
+		return;
+	}
+
+	SDOGraphBuilder *builder = sdo_das_gb_get_builder(getThis() TSRMLS_CC);
+	if (!builder) {
+		return;
+	}
+
+	if (Z_TYPE_P(z_rows) == IS_ARRAY) {
+		HashTable	*rows = Z_ARRVAL_P(z_rows);
+		HashPosition pos;
+
+		for (zend_hash_internal_pointer_reset_ex(rows, &pos);
+			 zend_hash_get_current_data_ex(rows, (void **)&z_row, &pos) == SUCCESS;
+			 zend_hash_move_forward_ex(rows, &pos)) {
+			if (sdo_das_gb_add_row(builder, *z_row TSRMLS_CC) == FAILURE) {
+				return;
+			}
+		}
+	} else if (Z_TYPE_P(z_rows) == IS_OBJECT && Z_OBJCE_P(z_rows)->get_iterator) {
+		/* A Traversable such as a PDOStatement: the rows are fetched as they are added */
+		zend_class_entry	 *ce = Z_OBJCE_P(z_rows);
+#if PHP_MAJOR_VERSION > 5 || (PHP_MAJOR_VERSION == 5 && PHP_MINOR_VERSION > 1)
+		zend_object_iterator *iter = ce->get_iterator(ce, z_rows, 0 TSRMLS_CC);
+#else
+		zend_object_iterator *iter = ce->get_iterator(ce, z_rows TSRMLS_CC);
+#endif
+		if (!iter || EG(exception)) {
+			return;
+		}
+
+		if (iter->funcs->rewind) {
+			iter->funcs->rewind(iter TSRMLS_CC);
+		}
+		while (!EG(exception) && iter->funcs->valid(iter TSRMLS_CC) == SUCCESS) {
+			iter->funcs->get_current_data(iter, &z_row TSRMLS_CC);
+			if (EG(exception) || sdo_das_gb_add_row(builder, *z_row TSRMLS_CC) == FAILURE) {
+				break;
+			}
+			iter->funcs->move_forward(iter TSRMLS_CC);
+		}
+		iter->funcs->dtor(iter TSRMLS_CC);
+		if (EG(exception)) {
+			return;
+		}
+	} else {
+		const char *space, *class_name = get_active_class_name(&space TSRMLS_CC);
+		sdo_throw_exception_ex(sdo_unsupportedoperationexception_class_entry, 0, 0 TSRMLS_CC,
+			"%s%s%s(): expected an array or Traversable of rows, found %s",
+			class_name, space, get_active_function_name(TSRMLS_C), zend_zval_type_name(z_rows));
+		return;
+	}
+
+	RETVAL_LONG(builder->getObjectCount());
+}
+/* }}} */
+
+/* {{{ SDO_DAS_GraphBuilder::resolveReferences
+ */
+PHP_METHOD(SDO_DAS_GraphBuilder, resolveReferences)
+{
+	if (ZEND_NUM_ARGS() != 0) {
+		WRONG_PARAM_COUNT;
+	}
+
+	SDOGraphBuilder *builder = sdo_das_gb_get_builder(getThis() TSRMLS_CC);
+	if (!builder) {
+		return;
+	}
+
+	try {
+		builder->resolveReferences();
+	} catch (SDORuntimeException e) {
+		sdo_throw_runtimeexception(&e TSRMLS_CC);
+	}
+}
+/* }}} */
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * End:
+ * vim600: noet sw=4 ts=4 fdm=marker
+ * vim<600: noet sw=4 ts=4
+ */
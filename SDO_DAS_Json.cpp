@@ -0,0 +1,123 @@
+/*
++----------------------------------------------------------------------+
+| (c) Copyright IBM Corporation 2005, 2008.                            |
+| All Rights Reserved.                                                 |
++----------------------------------------------------------------------+
+|                                                                      |
+| Licensed under the Apache License, Version 2.0 (the "License"); you  |
+| may not use this file except in compliance with the License. You may |
+| obtain a copy of the License at                                      |
+| http://www.apache.org/licenses/LICENSE-2.0                           |
+|                                                                      |
+| Unless required by applicable law or agreed to in writing, software  |
+| distributed under the License is distributed on an "AS IS" BASIS,    |
+| WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or      |
+| implied. See the License for the specific language governing         |
+| permissions and limitations under the License.                       |
++----------------------------------------------------------------------+
+| Author: Caroline Maynard                                             |
++----------------------------------------------------------------------+
+
+*/
+static char rcs_id[] = "$Id$";
+
+#ifdef PHP_WIN32
+#include <iostream>
+#include <math.h>
+#include "zend_config.w32.h"
+#endif
+
+#include "php.h"
+
+#include "php_sdo_int.h"
+
+#include "commonj/sdo/SDOJsonReader.h"
+#include "commonj/sdo/SDOJsonWriter.h"
+
+#define CLASS_NAME "SDO_DAS_JsonImpl"
+
+/* {{{ sdo_das_json_minit
+ */
+void sdo_das_json_minit(zend_class_entry *tmp_ce TSRMLS_DC)
+{
+	sdo_das_jsonimpl_class_entry = zend_register_internal_class(tmp_ce TSRMLS_CC);
+	sdo_das_jsonimpl_class_entry->ce_flags |= ZEND_ACC_FINAL_CLASS;
+}
+/* }}} */
+
+/* {{{ SDO_DAS_JsonImpl::encode
+ */
+PHP_METHOD(SDO_DAS_JsonImpl, encode)
+{
+	zval *z_do;
+
+	if (ZEND_NUM_ARGS() != 1) {
+		WRONG_PARAM_COUNT;
+	}
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "O", &z_do, sdo_dataobject_class_entry) == FAILURE) {
+		return;
+	}
+
+	DataObjectPtr dop = sdo_do_get(z_do TSRMLS_CC);
+	if (!dop) {
+		const char *space, *class_name = get_active_class_name (&space TSRMLS_CC);
+		php_error(E_ERROR, "%s%s%s(): internal error (%i) - SDO_DataObject not found in store",
+			class_name, space, get_active_function_name(TSRMLS_C), __LINE__);
+		RETURN_NULL();
+	}
+
+	try {
+		SDOString json;
+		SDOJsonWriter writer(json);
+		writer.write(dop);
+		RETVAL_STRINGL((char *)json.data(), json.length(), 1);
+	} catch (SDORuntimeException e) {
+		sdo_throw_runtimeexception(&e TSRMLS_CC);
+	}
+}
+/* }}} */
+
+/* {{{ SDO_DAS_JsonImpl::decode
+ */
+PHP_METHOD(SDO_DAS_JsonImpl, decode)
+{
+	char *json;
+	int	  json_len;
+	zval *z_do;
+
+	if (ZEND_NUM_ARGS() != 2) {
+		WRONG_PARAM_COUNT;
+	}
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "sO",
+		&json, &json_len, &z_do, sdo_dataobject_class_entry) == FAILURE) {
+		return;
+	}
+
+	DataObjectPtr dop = sdo_do_get(z_do TSRMLS_CC);
+	if (!dop) {
+		const char *space, *class_name = get_active_class_name (&space TSRMLS_CC);
+		php_error(E_ERROR, "%s%s%s(): internal error (%i) - SDO_DataObject not found in store",
+			class_name, space, get_active_function_name(TSRMLS_C), __LINE__);
+		RETURN_NULL();
+	}
+
+	try {
+		SDOJsonReader reader;
+		reader.read(json, json_len, dop);
+		RETVAL_ZVAL(z_do, 1, 0);
+	} catch (SDORuntimeException e) {
+		sdo_throw_runtimeexception(&e TSRMLS_CC);
+	}
+}
+/* }}} */
+
+/*
+ * Local variables:
+ * tab-width: 4
+ * c-basic-offset: 4
+ * End:
+ * vim600: noet sw=4 ts=4 fdm=marker
+ * vim<600: noet sw=4 ts=4
+ */
@@ -128,11 +128,11 @@ void sdo_das_setting_new(zval *me, Setting *setting TSRMLS_DC)
 }
 /* }}} */
 
-/* {{{ sdo_das_setting_read_value
+/* {{{ sdo_das_setting_value
+ * Returns a new zval holding the old value recorded in a Setting
 */
-static zval *sdo_das_setting_read_value (sdo_das_setting_object *my_object TSRMLS_DC)
+zval *sdo_das_setting_value (Setting *setting TSRMLS_DC)
 {
-	Setting		*setting = my_object->setting;
 	uint		 bytes_len;
 	char		*bytes_value;
 	char		 char_value;
@@ -254,6 +254,14 @@ static zval *sdo_das_setting_read_value (sdo_das_setting_object *my_object TSRML
 }
 /* }}} */
 
+/* {{{ sdo_das_setting_read_value
+*/
+static zval *sdo_das_setting_read_value (sdo_das_setting_object *my_object TSRMLS_DC)
+{
+	return sdo_das_setting_value(my_object->setting TSRMLS_CC);
+}
+/* }}} */
+
 /* {{{ sdo_das_setting_get_properties
 */
 static HashTable *sdo_das_setting_get_properties(zval *object TSRMLS_DC)
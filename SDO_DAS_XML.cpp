@@ -31,7 +31,11 @@ static char rcs_id[] = "$Id: SDO_DAS_XML.cpp 241789 2007-08-24 15:20:26Z mfp $";
 
 #include "php_sdo_das_xml_int.h"
 
+#include <string>
+#include <vector>
+
 #include "zend_interfaces.h" // needed for several uses of zend_call_method()
+#include "ext/libxml/php_libxml.h"
 
 using std::endl;
 using std::istringstream;
@@ -79,6 +83,15 @@ ZEND_BEGIN_ARG_INFO_EX(sdo_das_xml_saveString_args, 0, ZEND_RETURN_VALUE, 1)
     ZEND_ARG_INFO(0, indent)
 ZEND_END_ARG_INFO();
 
+ZEND_BEGIN_ARG_INFO(sdo_das_xml_loadNode_args, 0)
+    ZEND_ARG_INFO(0, node)
+ZEND_END_ARG_INFO();
+
+ZEND_BEGIN_ARG_INFO_EX(sdo_das_xml_saveToDOM_args, 0, ZEND_RETURN_VALUE, 1)
+    ZEND_ARG_INFO(0, document)
+    ZEND_ARG_INFO(0, indent)
+ZEND_END_ARG_INFO();
+
 ZEND_BEGIN_ARG_INFO_EX(sdo_das_xml_createDocument_args, 0, ZEND_RETURN_VALUE, 0)
     ZEND_ARG_INFO(0, namespace_uri)
     ZEND_ARG_INFO(0, element_name)
@@ -107,6 +120,10 @@ zend_function_entry sdo_das_xml_methods[] = {
             ZEND_ACC_PUBLIC)
     ZEND_ME(SDO_DAS_XML, saveString, sdo_das_xml_saveString_args,
             ZEND_ACC_PUBLIC)
+    ZEND_ME(SDO_DAS_XML, loadNode, sdo_das_xml_loadNode_args,
+            ZEND_ACC_PUBLIC)
+    ZEND_ME(SDO_DAS_XML, saveToDOM, sdo_das_xml_saveToDOM_args,
+            ZEND_ACC_PUBLIC)
     ZEND_ME(SDO_DAS_XML, createDocument, sdo_das_xml_createDocument_args,
             ZEND_ACC_PUBLIC)
     ZEND_ME(SDO_DAS_XML, createDataObject, sdo_das_xml_createDataObject_args,
@@ -332,6 +349,7 @@ static int sdo_das_xml_add_types(xmldas_object *xmldas, char *file_name TSRMLS_D
 typedef struct {
   char           	key[MAX_KEY_SIZE];
   DataFactoryPtr   	data_factory_ptr;
+  std::vector<std::string> schema_files; /* the schemas the model came from */
 } saved_data_factory_table_entry;
 
 static saved_data_factory_table_entry data_factory_table[SAVED_DATA_FACTORY_TABLE_SIZE];
@@ -387,30 +405,35 @@ void dump_table()
 	}
 }
 
-void add_to_table(char *key, DataFactoryPtr data_factory_ptr)
+/* returns 1 + the slot the factory is held in, or 0 if the table is full */
+int add_to_table(char *key, DataFactoryPtr data_factory_ptr,
+				 const std::vector<std::string>& schema_files)
 {
 	// TODO find the equivalent of making this a synchronised method
 	for (int i = 0 ; i  < SAVED_DATA_FACTORY_TABLE_SIZE ; i++) {
 		if (strncmp(data_factory_table[i].key, key, MAX_KEY_SIZE) == 0) {
 			//php_printf("We were asked to add %s but it is already there\n",key);
-			return; // it's already there
+			return 0; // it's already there, so this factory is not shared
 		}
 		if (strcmp(data_factory_table[i].key, "") == 0) {
 			//php_printf("Adding %s -> %p\n",key,data_factory_ptr);
 			strncpy(data_factory_table[i].key,key, MAX_KEY_SIZE);
 			data_factory_table[i].data_factory_ptr = data_factory_ptr;
-			return; // we added it
+			data_factory_table[i].schema_files = schema_files;
+			return i + 1; // we added it
 		}
 	}
+	return 0;
 }
 
-DataFactoryPtr retrieve_from_table(char *key)
+DataFactoryPtr retrieve_from_table(char *key, int *slot)
 {
 	// TODO find the equivalent of making this a synchronised method
 	//php_printf("Looking for %s\n",key);
 	for (int i = 0 ; i  < SAVED_DATA_FACTORY_TABLE_SIZE ; i++) {
 		if (strncmp(data_factory_table[i].key, key, MAX_KEY_SIZE) == 0) {
 			//php_printf("Found %s -> %p\n",key, data_factory_table[i].data_factory_ptr);
+			*slot = i + 1;
 			return data_factory_table[i].data_factory_ptr;
 		}
 	}
@@ -418,6 +441,35 @@ DataFactoryPtr retrieve_from_table(char *key)
 	return NULL;
 }
 
+/* {{{ sdo_das_xml_unshare_model
+ * The model of a keyed DAS is frozen and shared with every other DAS
+ * created with the same key. Before types are added to it, the DAS is
+ * given a private factory defined from the same schemas, so that the
+ * new types are seen by this DAS only. Data objects already created
+ * keep their view of the shared model.
+ */
+static int sdo_das_xml_unshare_model(xmldas_object *xmldas TSRMLS_DC)
+{
+	const std::vector<std::string>& schema_files =
+		data_factory_table[xmldas->model_slot - 1].schema_files;
+	DataFactoryPtr dataFactoryPtr = DataFactory::getDataFactory();
+
+	zval_dtor(&xmldas->z_df);
+	INIT_ZVAL(xmldas->z_df);
+	sdo_das_df_new(&xmldas->z_df, dataFactoryPtr TSRMLS_CC);
+	xmldas->xsdHelperPtr = HelperProvider::getXSDHelper((DataFactory *)dataFactoryPtr);
+	xmldas->xmlHelperPtr = HelperProvider::getXMLHelper((DataFactory *)dataFactoryPtr);
+	xmldas->model_slot = 0;
+
+	for (size_t i = 0; i < schema_files.size(); i++) {
+		if (sdo_das_xml_add_types(xmldas, (char *)schema_files[i].c_str() TSRMLS_CC) == FAILURE) {
+			return FAILURE;
+		}
+	}
+	return SUCCESS;
+}
+/* }}} */
+
 #endif
 
 /* {{{ proto SDO_DAS_XML SDO_DAS_XML::create(string xsd_file)
@@ -440,6 +492,7 @@ PHP_METHOD(SDO_DAS_XML, create)
 	int              rc = SUCCESS;
 	zval            *args = NULL;
 	zval	         z_tmp;
+	std::vector<std::string> schema_files;
 
     if (ZEND_NUM_ARGS() > 2) {
         WRONG_PARAM_COUNT;
@@ -505,9 +558,12 @@ PHP_METHOD(SDO_DAS_XML, create)
 #ifdef CACHE_DATA_FACTORY
 	if (ZEND_NUM_ARGS() == 2) {
 		/* Check to see if we can use a cached data factory */
-		dataFactoryPtr = retrieve_from_table(key);
+		dataFactoryPtr = retrieve_from_table(key, &xmldas->model_slot);
 		if (dataFactoryPtr) {
 			//php_printf("!!! retrieving from cache !!!\n");
+			SDOStats::add(SDOStats::FactoryCacheHits);
+			/* each DAS gets its own view of the frozen model */
+			dataFactoryPtr = dataFactoryPtr->createView();
 			sdo_das_df_new(&xmldas->z_df, dataFactoryPtr TSRMLS_CC);
 		    xmldas->xsdHelperPtr = HelperProvider::getXSDHelper((DataFactory *)dataFactoryPtr);
 		    xmldas->xmlHelperPtr = HelperProvider::getXMLHelper((DataFactory *)dataFactoryPtr);
@@ -533,6 +589,7 @@ PHP_METHOD(SDO_DAS_XML, create)
 			//php_printf("!!! seems to be a bit of a failure !!!\n");
 			RETURN_FALSE;
 		}
+		schema_files.push_back(file_name);
 
 	} else if (args) {
 		HashTable *arrht = Z_ARRVAL_P(args);
@@ -555,6 +612,7 @@ PHP_METHOD(SDO_DAS_XML, create)
 				if (rc == FAILURE) {
 					RETURN_FALSE;
 				}
+				schema_files.push_back(file_name);
 			}
 			zval_dtor(&z_tmp);
 		}
@@ -563,8 +621,38 @@ PHP_METHOD(SDO_DAS_XML, create)
 
 #ifdef CACHE_DATA_FACTORY
 	if (ZEND_NUM_ARGS() == 2) {
+		/* Freeze the model once it is cached, so that no later request
+		 * can change the types under another, and switch this DAS over
+		 * to a view of it like any DAS which finds it in the cache.
+		 * addTypes gives a DAS its own copy before changing it.
+		 */
+		try {
 			// store the data factory in the table
-			add_to_table(key, dataFactoryPtr);
+			xmldas->model_slot = add_to_table(key, dataFactoryPtr, schema_files);
+			if (xmldas->model_slot) {
+				dataFactoryPtr->freeze();
+				/* graphs serialized over the model need only its fingerprint */
+				sdo_do_register_model(dataFactoryPtr TSRMLS_CC);
+				dataFactoryPtr = dataFactoryPtr->createView();
+			}
+		} catch (SDORuntimeException e) {
+			sdo_throw_runtimeexception(&e TSRMLS_CC);
+			rc = FAILURE;
+		}
+		/* return outside the catch block, as in loadFile */
+		if (rc == FAILURE) {
+			RETURN_FALSE;
+		}
+		if (!xmldas->model_slot) {
+			/* the table is full, so the factory stays private to this DAS */
+			return;
+		}
+
+		zval_dtor(&xmldas->z_df);
+		INIT_ZVAL(xmldas->z_df);
+		sdo_das_df_new(&xmldas->z_df, dataFactoryPtr TSRMLS_CC);
+		xmldas->xsdHelperPtr = HelperProvider::getXSDHelper((DataFactory *)dataFactoryPtr);
+		xmldas->xmlHelperPtr = HelperProvider::getXMLHelper((DataFactory *)dataFactoryPtr);
 	}
 #endif
 
@@ -592,6 +680,13 @@ PHP_METHOD(SDO_DAS_XML, addTypes)
 
 	 xmldas = (xmldas_object *) zend_object_store_get_object(getThis() TSRMLS_CC);
 
+#ifdef CACHE_DATA_FACTORY
+	 if (xmldas->model_slot &&
+	     sdo_das_xml_unshare_model(xmldas TSRMLS_CC) == FAILURE) {
+		 return;
+	 }
+#endif
+
 	 sdo_das_xml_add_types(xmldas, file_name TSRMLS_CC);
 
  }
@@ -865,6 +960,150 @@ PHP_METHOD(SDO_DAS_XML, saveString)
 }
 /* }}} */
 
+/* {{{ proto SDO_DAS_XML_Document SDO_DAS_XML::loadNode(DOMNode node)
+ */
+PHP_METHOD(SDO_DAS_XML, loadNode)
+{
+    /* Returns SDO_DAS_XML_Document Object containing root SDO object built from
+     * the given DOM document or element, read straight from its libxml2 tree.
+     */
+    xmldocument_object	*xmldocument;
+    xmldas_object		*xmldas;
+    zval				*z_node;
+    xmlNodePtr			 node;
+	bool				exception_thrown = false;
+
+    if (ZEND_NUM_ARGS() != 1) {
+        WRONG_PARAM_COUNT;
+    }
+
+    if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC,
+            "o", &z_node) == FAILURE) {
+        RETURN_FALSE;
+    }
+
+	node = php_libxml_import_node(z_node TSRMLS_CC);
+	if (!node) {
+		const char *space, *class_name = get_active_class_name(&space TSRMLS_CC);
+		php_error(E_WARNING, "%s%s%s(): the argument is not a DOM node",
+			class_name, space, get_active_function_name(TSRMLS_C));
+		RETURN_FALSE;
+	}
+
+	xmldas = (xmldas_object *) zend_object_store_get_object(getThis() TSRMLS_CC);
+
+    Z_TYPE_P(return_value) = IS_OBJECT;
+    if (object_init_ex(return_value, sdo_das_xml_document_class_entry) == FAILURE) {
+		const char *space, *class_name = get_active_class_name(&space TSRMLS_CC);
+		php_error(E_ERROR, "%s%s%s(): internal error (%i) - failed to instantiate %s object",
+			class_name, space, get_active_function_name(TSRMLS_C), __LINE__, CLASS_NAME);
+        return;
+    }
+    xmldocument = (xmldocument_object *) zend_object_store_get_object(return_value TSRMLS_CC);
+    if (!xmldocument) {
+		const char *space, *class_name = get_active_class_name (&space TSRMLS_CC);
+		php_error(E_ERROR, "%s%s%s(): internal error (%i) - SDO_DAS_XML_Document not found in store",
+			class_name, space, get_active_function_name(TSRMLS_C), __LINE__);
+	}
+
+    try {
+        xmldocument->xmlDocumentPtr = xmldas->xmlHelperPtr->loadNode(node, (const char *)NULL);
+        int error_count = xmldas->xmlHelperPtr->getErrorCount();
+        if ((error_count > 0) ||
+			(!xmldocument->xmlDocumentPtr) ||
+			(!xmldocument->xmlDocumentPtr->getRootDataObject())) {
+			ostringstream	 print_buf;
+
+			print_buf << "SDO_DAS_XML::loadNode - Unable to load the supplied node\n";
+			print_buf << error_count << " error(s) occurred when loading the node";
+			if (error_count > MAX_ERRORS) {
+				print_buf << "(only the first " << MAX_ERRORS << " shown)";
+			}
+			print_buf << ":\n" ;
+
+			for (int error_ix = 0; error_ix < min(error_count, MAX_ERRORS); error_ix++) {
+				print_buf << error_ix + 1 << ". " << xmldas->xmlHelperPtr->getErrorMessage(error_ix) << endl;
+			}
+			std::string print_string = print_buf.str();
+			sdo_das_xml_throw_parserexception((char *)print_string.c_str() TSRMLS_CC);
+			RETURN_NULL();
+        }
+    } catch (SDOXMLParserException e) {
+        sdo_das_xml_throw_parserexception((char*)e.getMessageText() TSRMLS_CC);
+        exception_thrown = true;
+    } catch(SDORuntimeException e) {
+        /* See loadString for why the class name is tested again */
+        sdo_temporary_exception_test ( e, "InLoadNodeSoNoFile" TSRMLS_CC);
+        exception_thrown = true;
+    }
+    if (exception_thrown) {
+	/* See loadFile for why the return is not made inside the catch block */
+	RETURN_NULL();
+	}
+}
+/* }}} SDO_DAS_XML::loadNode */
+
+/* {{{ proto DOMDocument SDO_DAS_XML::saveToDOM(SDO_DAS_XML_Document xdoc)
+ */
+PHP_METHOD(SDO_DAS_XML, saveToDOM)
+{
+    zval				*z_document;
+    xmldocument_object	*xmldocument;
+    xmldas_object		*xmldas;
+    long				 indent = -1;
+    zend_class_entry	*dom_document_ce;
+    php_libxml_node_object *intern;
+    xmlDocPtr			 docp = NULL;
+
+    if (ZEND_NUM_ARGS() != 1 && ZEND_NUM_ARGS() != 2) {
+        WRONG_PARAM_COUNT;
+    }
+
+    xmldas = (xmldas_object *) zend_object_store_get_object(getThis() TSRMLS_CC);
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "O|l",
+		&z_document, sdo_das_xml_document_class_entry, &indent) == FAILURE) {
+		RETURN_FALSE;
+	}
+
+	dom_document_ce = zend_fetch_class ("DOMDocument", strlen("DOMDocument"),
+		ZEND_FETCH_CLASS_SILENT TSRMLS_CC);
+	if (!dom_document_ce) {
+		const char *space, *class_name = get_active_class_name(&space TSRMLS_CC);
+		php_error(E_WARNING, "%s%s%s(): the dom extension is not loaded",
+			class_name, space, get_active_function_name(TSRMLS_C));
+		RETURN_FALSE;
+	}
+
+    xmldocument = (xmldocument_object *) zend_object_store_get_object(z_document TSRMLS_CC);
+    if (!xmldocument) {
+		const char *space, *class_name = get_active_class_name (&space TSRMLS_CC);
+		php_error(E_ERROR, "%s%s%s(): internal error (%i) - SDO_DAS_XML_Document not found in store",
+			class_name, space, get_active_function_name(TSRMLS_C), __LINE__);
+    }
+    try {
+        docp = xmldas->xmlHelperPtr->saveToDOM(xmldocument->xmlDocumentPtr, indent);
+    } catch (SDORuntimeException e) {
+        sdo_das_xml_throw_runtimeexception(&e TSRMLS_CC);
+    }
+	if (!docp) {
+		RETURN_NULL();
+	}
+
+	/* Hand the tree to a new DOMDocument, as DOMDocument::__construct would */
+	if (object_init_ex(return_value, dom_document_ce) == FAILURE) {
+		xmlFreeDoc(docp);
+		const char *space, *class_name = get_active_class_name(&space TSRMLS_CC);
+		php_error(E_ERROR, "%s%s%s(): internal error (%i) - failed to instantiate DOMDocument object",
+			class_name, space, get_active_function_name(TSRMLS_C), __LINE__);
+		return;
+	}
+	intern = (php_libxml_node_object *) zend_object_store_get_object(return_value TSRMLS_CC);
+	php_libxml_increment_doc_ref(intern, docp TSRMLS_CC);
+	php_libxml_increment_node_ptr(intern, (xmlNodePtr)docp, (void *)intern TSRMLS_CC);
+}
+/* }}} */
+
 /* {{{ proto SDO_DAS_XML SDO_DAS_XML::createDocument(empty | typename | uri,typename)
  */
 PHP_METHOD(SDO_DAS_XML, createDocument)
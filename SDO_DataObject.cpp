@@ -33,7 +33,10 @@ static char rcs_id[] = "$Id: SDO_DataObject.cpp 254122 2008-03-03 17:56:38Z mfp
 #include "zend_exceptions.h"
 
 #include "php_sdo_int.h"
+#include "commonj/sdo/DataFactoryImpl.h"
 #include "commonj/sdo/DataObjectImpl.h"
+#include "commonj/sdo/SDOModelSnapshot.h"
+#include "commonj/sdo/SDOGraphSnapshot.h"
 
 #define CLASS_NAME "SDO_DataObject"
 
@@ -44,9 +47,25 @@ static char rcs_id[] = "$Id: SDO_DataObject.cpp 254122 2008-03-03 17:56:38Z mfp
 typedef struct {
 	zend_object		 zo;			/* The standard zend_object */
 	DataObjectPtr    dop;			/* The C++ DataObject */
+	HashTable		*lists;			/* SDO_DataObjectLists already made, by property name */
 } sdo_do_object;
 /* }}} */
 
+/* {{{ sdo_do_properties
+ * The instance properties of the data object, taken when the iteration is
+ * rewound, and which of them are valid, taken in one pass over the values.
+ * As the iteration moves, the validity of each property it comes to is looked
+ * up again, so that a property set or unset in the loop body is seen. If an
+ * open property is defined or removed the properties are taken again and the
+ * iteration carries on from the current one.
+ */
+struct sdo_do_properties {
+	std::vector<const PropertyImpl *> properties;
+	std::vector<bool>	valid;
+	unsigned long		generation;
+};
+/* }}} */
+
 /* {{{ sdo_do_iterator
  * The iterator data for this class - extends the standard zend_object_iterator
  */
@@ -54,7 +73,7 @@ typedef struct {
 	zend_object_iterator zoi;		/* The standard zend_object_iterator */
 	ulong				 index;		/* current index */
 	zend_bool			 valid;
-/*	PropertyList		 pl; sdolib crashes when I copy the list here */
+	sdo_do_properties	*properties;	/* the properties being iterated */
 	zval				*value;
 } sdo_do_iterator;
 /* }}} */
@@ -89,6 +108,11 @@ static void sdo_do_object_free_storage(void *object TSRMLS_DC)
 	    FREE_HASHTABLE(my_object->zo.guards);
 	}
 
+	if (my_object->lists) {
+		zend_hash_destroy(my_object->lists);
+		FREE_HASHTABLE(my_object->lists);
+	}
+
 	/* just release the reference, and the reference counting will kick in */
 	if (my_object->dop) {
 		try {
@@ -350,6 +374,9 @@ static int sdo_do_has_dimension(zval *object, zval *offset, int check_empty TSRM
 static zval *sdo_do_read_list(sdo_do_object *sdo, const char *xpath, const Property *propertyp TSRMLS_DC)
 {
 	zval			*return_value;
+	zval			**z_cached;
+	zval			*z_list;
+	uint			 xpath_len = strlen(xpath) + 1;
 
 	try {
 		DataObjectList& list_value = sdo->dop->getList(xpath);
@@ -358,8 +385,34 @@ static zval *sdo_do_read_list(sdo_do_object *sdo, const char *xpath, const Prope
 		} else {
 			ALLOC_INIT_ZVAL(return_value);
             Z_SET_REFCOUNT_P(return_value, 0);
-			/* make a new SDO_DataObjectList */
-			sdo_dataobjectlist_new(return_value, propertyp->getType(), sdo->dop, &list_value TSRMLS_CC);
+			/*
+			 * Reuse the SDO_DataObjectList made for this property before, as long as
+			 * the property still has the same list. The list is only compared, since
+			 * the one the wrapper was made for may have gone.
+			 */
+			if (sdo->lists &&
+				zend_hash_find(sdo->lists, (char *)xpath, xpath_len, (void **)&z_cached) == SUCCESS &&
+				sdo_dataobjectlist_get_list(*z_cached TSRMLS_CC) == &list_value) {
+				Z_TYPE_P(return_value) = IS_OBJECT;
+				Z_OBJVAL_P(return_value) = Z_OBJVAL_PP(z_cached);
+				Z_OBJ_HT_P(return_value)->add_ref(return_value TSRMLS_CC);
+			} else {
+				/* make a new SDO_DataObjectList */
+				sdo_dataobjectlist_new(return_value, propertyp->getType(), sdo->dop, &list_value TSRMLS_CC);
+
+				/* only a list of this object is kept, not one reached by an xpath */
+				if (strcmp(xpath, propertyp->getName()) == 0) {
+					if (!sdo->lists) {
+						ALLOC_HASHTABLE(sdo->lists);
+						zend_hash_init(sdo->lists, 0, NULL, ZVAL_PTR_DTOR, 0);
+					}
+					MAKE_STD_ZVAL(z_list);
+					Z_TYPE_P(z_list) = IS_OBJECT;
+					Z_OBJVAL_P(z_list) = Z_OBJVAL_P(return_value);
+					Z_OBJ_HT_P(z_list)->add_ref(z_list TSRMLS_CC);
+					zend_hash_update(sdo->lists, (char *)xpath, xpath_len, (void *)&z_list, sizeof(zval *), NULL);
+				}
+			}
 		}
 	} catch (SDORuntimeException e) {
 		sdo_throw_runtimeexception(&e TSRMLS_CC);
@@ -374,8 +427,11 @@ static zval *sdo_do_read_list(sdo_do_object *sdo, const char *xpath, const Prope
 static zval *sdo_do_read_value(sdo_do_object *sdo, const char *xpath, const Property *propertyp TSRMLS_DC)
 {
 	DataObjectPtr	 dop = sdo->dop;
+	DataObjectImpl	*doi = (DataObjectImpl *)(DataObject *)dop;
 	uint			 bytes_len;
 	char			*bytes_value;
+	const char		*text_value;
+	unsigned int	 text_len;
 	char			 char_value;
 	wchar_t			 wchar_value;
 	DataObjectPtr	 doh_value;
@@ -426,7 +482,11 @@ static zval *sdo_do_read_value(sdo_do_object *sdo, const char *xpath, const Prop
 			}
 			case Type::BigDecimalType:
 			case Type::BigIntegerType: {
-				RETVAL_STRING((char *)(dop->getCString(xpath)), 1);
+				if (doi->getStringView(xpath, text_value, text_len)) {
+					RETVAL_STRINGL((char *)text_value, text_len, 1);
+				} else {
+					RETVAL_STRING((char *)(dop->getCString(xpath)), 1);
+				}
 				break;
 			}
 			case Type::BooleanType: {
@@ -438,6 +498,11 @@ static zval *sdo_do_read_value(sdo_do_object *sdo, const char *xpath, const Prop
 				break;
 			}
 			case Type::BytesType: {
+				/* Copy straight from the stored bytes when we can */
+				if (doi->getStringView(xpath, text_value, text_len)) {
+					RETVAL_STRINGL((char *)text_value, text_len, 1);
+					break;
+				}
 				bytes_len = dop->getLength(xpath);
 				bytes_value = (char *)emalloc(1 + bytes_len);
 				bytes_len = dop->getBytes(xpath, bytes_value, bytes_len);
@@ -483,7 +548,12 @@ static zval *sdo_do_read_value(sdo_do_object *sdo, const char *xpath, const Prop
 			}
 			case Type::StringType:
 			case Type::UriType: {
-				RETVAL_STRING((char *)dop->getCString(xpath), 1);
+				/* The view saves a strlen and the transient buffer copy */
+				if (doi->getStringView(xpath, text_value, text_len)) {
+					RETVAL_STRINGL((char *)text_value, text_len, 1);
+				} else {
+					RETVAL_STRING((char *)dop->getCString(xpath), 1);
+				}
 				break;
 			}
 			case Type::DataObjectType:
@@ -832,67 +902,13 @@ static HashTable *sdo_do_get_properties(zval *object TSRMLS_DC)
 static int sdo_do_compare_objects(zval *object1, zval *object2 TSRMLS_DC)
 {
 	sdo_do_object	*my_object1, *my_object2;
-	DataObjectPtr	 dop1, dop2;
-	PropertyList	 pl;
-	int				 entries;
-	const char		*propertyName;
-	zval			 offset;
-	zval			 result;
-
-	INIT_PZVAL(&offset);
-	INIT_PZVAL(&result);
 
 	my_object1 = sdo_do_get_instance(object1 TSRMLS_CC);
 	my_object2 = sdo_do_get_instance(object2 TSRMLS_CC);
-	dop1 = my_object1->dop;
-	dop2 = my_object2->dop;
-
-	if (dop1 == dop2)
-		return SUCCESS;
 
 	try {
-		pl = dop1->getInstanceProperties();
-		entries = pl.size();
-		if (entries != dop2->getInstanceProperties().size())
-			return FAILURE;
-		for (int i = 0; i < entries; i++) {
-			const Property& prop1 = pl[i];
-			propertyName = prop1.getName();
-			const Property& prop2 = dop2->getType().getProperty(propertyName);
-			/* if we get here, then the object does have a property of the same name */
-			if (&prop1 != &prop2) {
-				if ((prop1.isMany() != prop2.isMany()) ||
-				/*
-				* When a property is many-valued, it may not return consistent values for isSet,
-				* Let it carry on to the value equality tests.
-				*/
-				((!prop1.isMany()) && dop1->isSet(prop1) != dop2->isSet(prop2)) ||
-				(prop1.getTypeEnum() != prop2.getTypeEnum()) ||
-				/*
-				* The meaning of containment for primitives is somewhat unclear in the spec.
-				* I'm going to ignore it to avoid a discrepancy in unserializing
-				*/
-				(prop1.getType().isDataObjectType() && (prop1.isContainment() != prop2.isContainment())) ||
-				(prop1.isReadOnly() != prop2.isReadOnly()))
-
-				return FAILURE;
-			}
-			/* OK we can consider the properties equal */
-			if (dop1->isSet(prop1)) {
-				/* the property is set, so we must also compare its value */
-				ZVAL_STRING(&offset, (char *)propertyName, 0);
-				zval *value1 = sdo_do_read_dimension(object1, &offset, BP_VAR_R TSRMLS_CC);
-				zval_add_ref(&value1);
-				zval *value2 = sdo_do_read_dimension(object2, &offset, BP_VAR_R TSRMLS_CC);
-				zval_add_ref(&value2);
-				int rc = compare_function(&result, value1, value2 TSRMLS_CC);
-				zval_ptr_dtor(&value1);
-				zval_ptr_dtor(&value2);
-				if (rc || Z_LVAL(result))
-					return FAILURE;
-			}
-		}
-		return SUCCESS;
+		/* compared natively, without reading the values into zvals */
+		return EqualityHelper::equalStructure(my_object1->dop, my_object2->dop) ? SUCCESS : FAILURE;
 	} catch (SDORuntimeException e) {
 		/* In this case we won't rethrow the exception - suffice it to say that the objects are not equal */
 		return FAILURE;
@@ -1010,6 +1026,44 @@ static int sdo_do_count_elements(zval *object, long *count TSRMLS_DC)
 }
 /* }}} */
 
+/* {{{ sdo_do_iterator_take_properties
+ */
+static void sdo_do_iterator_take_properties(sdo_do_iterator *iterator, DataObjectImpl *doi)
+{
+	sdo_do_properties *snapshot = iterator->properties;
+	PropertyList pl = doi->getInstanceProperties();
+
+	snapshot->properties.resize(pl.size());
+	for (unsigned int i = 0; i < pl.size(); i++) {
+		snapshot->properties[i] = (const PropertyImpl *)&pl[i];
+	}
+	doi->getValidProperties(snapshot->valid);
+	snapshot->generation = doi->getInstancePropertiesGeneration();
+}
+/* }}} */
+
+/* {{{ sdo_do_iterator_seek
+ * Move to the first valid property at or after the index. Given the object,
+ * the validity of each property passed is looked up in its values rather
+ * than taken from the snapshot.
+ */
+static void sdo_do_iterator_seek(sdo_do_iterator *iterator, ulong index, DataObjectImpl *doi)
+{
+	sdo_do_properties *snapshot = iterator->properties;
+
+	for (iterator->index = index; iterator->index < snapshot->valid.size(); iterator->index++) {
+		if (doi) {
+			snapshot->valid[iterator->index] =
+				doi->isValid(snapshot->properties[iterator->index], iterator->index);
+		}
+		if (snapshot->valid[iterator->index]) {
+			break;
+		}
+	}
+	iterator->valid = (iterator->index < snapshot->valid.size());
+}
+/* }}} */
+
 /* {{{ sdo_do_iterator_rewind
  */
 static void sdo_do_iterator_rewind (zend_object_iterator *iter TSRMLS_DC)
@@ -1019,11 +1073,8 @@ static void sdo_do_iterator_rewind (zend_object_iterator *iter TSRMLS_DC)
 	sdo_do_object *my_object = (sdo_do_object *)sdo_do_get_instance(z_do_object TSRMLS_CC);
 
 	try {
-		PropertyList pl = my_object->dop->getInstanceProperties();
-		for (iterator->index = 0;
-		    iterator->index < pl.size() && ! my_object->dop->isValid(iterator->index);
-		    iterator->index++);
-		iterator->valid = (iterator->index < pl.size());
+		sdo_do_iterator_take_properties(iterator, (DataObjectImpl *)(DataObject *)my_object->dop);
+		sdo_do_iterator_seek(iterator, 0, NULL);
 	} catch (SDORuntimeException e) {
 		iterator->valid = false;
 		sdo_throw_runtimeexception(&e TSRMLS_CC);
@@ -1054,15 +1105,10 @@ zend_object_iterator *sdo_do_get_iterator(zend_class_entry *ce, zval *object TSR
     Z_ADDREF_P(object);
 	iterator->zoi.data = (void *)object;
 	iterator->zoi.funcs = &sdo_do_iterator_funcs;
+	/* the C++ containers cannot live in the emalloc'ed iterator itself */
+	iterator->properties = new sdo_do_properties;
 	sdo_do_iterator_rewind((zend_object_iterator *)iterator TSRMLS_CC);
 
-	/* TODO
-	 * I'd like to store a reference to the C++ PropertyList in the iterator object at this point.
-	 * But I'm seeing nasty memory corruption problems, so instead I'm reading out the list
-	 * with getInstanceProperties() each time it's needed. This could lead to the iterator state
-	 * becoming inconsistent if the DataObject's properties are modified during the iteration.
-	 */
-
 	return (zend_object_iterator *)iterator;
 }
 /* }}} */
@@ -1077,6 +1123,7 @@ static void sdo_do_iterator_dtor(zend_object_iterator *iter TSRMLS_DC)
 		zval_ptr_dtor((zval **)&iterator->zoi.data);
     }
 
+	delete iterator->properties;
 	efree(iterator);
 }
 /* }}} */
@@ -1104,8 +1151,7 @@ static int sdo_do_iterator_current_key (zend_object_iterator *iter,
 		return HASH_KEY_NON_EXISTANT;
 
 	try {
-		const Property& property = my_object->dop->getInstanceProperties()[iterator->index];
-		const char *key = property.getName();
+		const char *key = iterator->properties->properties[iterator->index]->getName();
 		*str_key_len = 1 + strlen(key);
 		*str_key = (char *)emalloc(1 + *str_key_len);
 		strcpy(*str_key, key);
@@ -1128,7 +1174,7 @@ static void sdo_do_iterator_current_data (zend_object_iterator *iter, zval ***da
 
 	try {
 		/* It's safe to use the property directly here, it cannot be an xpath */
-		const Property& property = my_object->dop->getInstanceProperties()[iterator->index];
+		const Property& property = *iterator->properties->properties[iterator->index];
 		if (property.isMany()) {
 			iterator->value = sdo_do_read_list(my_object,  property.getName(), &property TSRMLS_CC);
 		/* either it is set or it has a default value */
@@ -1156,14 +1202,26 @@ static void sdo_do_iterator_move_forward (zend_object_iterator *iter TSRMLS_DC)
 	if (iterator->valid) {
 		zval *z_do_object = (zval *)iterator->zoi.data;
 		sdo_do_object *my_object = (sdo_do_object *)sdo_do_get_instance(z_do_object TSRMLS_CC);
+		DataObjectImpl *doi = (DataObjectImpl *)(DataObject *)my_object->dop;
+		sdo_do_properties *snapshot = iterator->properties;
+		ulong next = iterator->index + 1;
+		DataObjectImpl *lookup = doi;
 
 		try {
-			PropertyList pl = my_object->dop->getInstanceProperties();
-			for (iterator->index++;
-			iterator->index < pl.size() && ! my_object->dop->isValid(iterator->index);
-			iterator->index++);
-			if (iterator->index >= pl.size())
-				iterator->valid = false;
+			if (snapshot->generation != doi->getInstancePropertiesGeneration()) {
+				/*
+				 * The open properties have changed. The current property may have
+				 * been removed, so it is only compared, never used. If it has gone,
+				 * the properties after it have moved down into its place.
+				 */
+				const PropertyImpl *current = snapshot->properties[iterator->index];
+				sdo_do_iterator_take_properties(iterator, doi);
+				for (next = 0; next < snapshot->properties.size() &&
+					 snapshot->properties[next] != current; next++);
+				next = (next < snapshot->properties.size()) ? next + 1 : iterator->index;
+				lookup = NULL;
+			}
+			sdo_do_iterator_seek(iterator, next, lookup);
 		} catch (SDORuntimeException e) {
 			iterator->valid = false;
 			sdo_throw_runtimeexception(&e TSRMLS_CC);
@@ -1172,46 +1230,160 @@ static void sdo_do_iterator_move_forward (zend_object_iterator *iter TSRMLS_DC)
 }
 /* }}} */
 
+/* {{{ model table
+ * Frozen models are kept with their snapshots, keyed by the fingerprint of
+ * the snapshot. A graph serialized over a model in the table carries only
+ * the fingerprint, and unserializing a graph whose model is already here
+ * needs only a view of it, instead of loading the model again. Models come
+ * here when they are serialized or unserialized, and when the XML DAS
+ * caches one.
+ * The table is shared by every thread of the process, so it is locked under
+ * ZTS, and its models are released at module shutdown.
+ */
+#define SAVED_MODEL_TABLE_SIZE 8
+
+typedef struct {
+	int64_t			 fingerprint;
+	DataFactoryPtr	 model;
+	std::string		 snapshot;
+} saved_model_table_entry;
+
+static saved_model_table_entry model_table[SAVED_MODEL_TABLE_SIZE];
+static int model_table_next = 0;
+
+#ifdef ZTS
+static MUTEX_T model_table_mutex;
+#define MODEL_TABLE_LOCK() tsrm_mutex_lock(model_table_mutex)
+#define MODEL_TABLE_UNLOCK() tsrm_mutex_unlock(model_table_mutex)
+#else
+#define MODEL_TABLE_LOCK()
+#define MODEL_TABLE_UNLOCK()
+#endif
+/* }}} */
+
+/* {{{ sdo_do_find_fingerprint
+ * Gives the fingerprint of a frozen model if it is in the table.
+ */
+static bool sdo_do_find_fingerprint(const DataFactory *model, int64_t& fingerprint)
+{
+	bool found = false;
+
+	MODEL_TABLE_LOCK();
+	for (int i = 0; i < SAVED_MODEL_TABLE_SIZE; i++) {
+		if (model_table[i].model && (const DataFactory *)model_table[i].model == model) {
+			fingerprint = model_table[i].fingerprint;
+			found = true;
+			break;
+		}
+	}
+	MODEL_TABLE_UNLOCK();
+	return found;
+}
+/* }}} */
+
+/* {{{ sdo_do_find_model
+ * Returns the frozen model with the given snapshot if it is in the table.
+ * Without a snapshot, the fingerprint alone identifies the model.
+ */
+static DataFactoryPtr sdo_do_find_model(int64_t fingerprint, const char *snapshot, unsigned int snapshot_length)
+{
+	DataFactoryPtr model;
+
+	MODEL_TABLE_LOCK();
+	for (int i = 0; i < SAVED_MODEL_TABLE_SIZE; i++) {
+		/* with a snapshot, the fingerprint only narrows the search */
+		if (model_table[i].model && model_table[i].fingerprint == fingerprint &&
+			(snapshot_length == 0 ||
+			 (model_table[i].snapshot.length() == snapshot_length &&
+			  memcmp(model_table[i].snapshot.data(), snapshot, snapshot_length) == 0))) {
+			model = model_table[i].model;
+			break;
+		}
+	}
+	MODEL_TABLE_UNLOCK();
+	return model;
+}
+/* }}} */
+
+/* {{{ sdo_do_save_model
+ * Adds a frozen model to the table, replacing the oldest entry when full.
+ */
+static void sdo_do_save_model(DataFactoryPtr model, int64_t fingerprint, const char *snapshot, unsigned int snapshot_length)
+{
+	MODEL_TABLE_LOCK();
+	for (int i = 0; i < SAVED_MODEL_TABLE_SIZE; i++) {
+		if (model_table[i].model == model) {
+			MODEL_TABLE_UNLOCK();
+			return; /* it's already there */
+		}
+	}
+	saved_model_table_entry *entry = &model_table[model_table_next];
+	entry->fingerprint = fingerprint;
+	entry->model = model;
+	entry->snapshot.assign(snapshot, snapshot_length);
+	model_table_next = (model_table_next + 1) % SAVED_MODEL_TABLE_SIZE;
+	MODEL_TABLE_UNLOCK();
+}
+/* }}} */
+
+/* {{{ sdo_do_register_model
+ * Adds a frozen model to the table, if it is not already there, so that
+ * graphs serialized over the same model, here or in another process, can
+ * be unserialized from the fingerprint alone.
+ */
+void sdo_do_register_model(DataFactoryPtr dfp TSRMLS_DC)
+{
+	const DataFactoryImpl *model = ((DataFactoryImpl *)(DataFactory *)dfp)->getModel();
+	int64_t fingerprint;
+
+	if (!model->isFrozen() || sdo_do_find_fingerprint(model, fingerprint)) {
+		return;
+	}
+	std::string snapshot;
+	SDOModelSnapshot::save(dfp, snapshot);
+	fingerprint = SDOModelSnapshot::getFingerprint(snapshot.data(), snapshot.length());
+	sdo_do_save_model((DataFactory *)(DataFactoryImpl *)model, fingerprint,
+		snapshot.data(), snapshot.length());
+}
+/* }}} */
+
 /* {{{ sdo_do_serialize
- * Both the model and the graph are serialized to a buffer.
+ * The graph is serialized to a buffer, after the model unless the model is
+ * in the table.
  */
 static int sdo_do_serialize (zval *object, unsigned char **buffer_p, zend_uint *buf_len_p, zend_serialize_data *data TSRMLS_DC)
 {
 	sdo_do_object		*my_object;
-	char				*serialized_model;
-	char				*serialized_graph;
-	unsigned long		 model_length;
-	unsigned long		 graph_length;
+	int64_t				 fingerprint;
 
 	my_object = sdo_do_get_instance(object TSRMLS_CC);
 
 	try {
         DataFactoryPtr dfp = ((DataObjectImpl*)(DataObject*)my_object->dop)->getDataFactory();
-        XSDHelperPtr xsdhp = HelperProvider::getXSDHelper(dfp);
-  		XMLHelperPtr xmlhp = HelperProvider::getXMLHelper(dfp);
-		/* create an XML representation of the model */
-		serialized_model = xsdhp->generate(dfp->getTypes(),
-			my_object->dop->getType().getURI());
-		model_length = strlen(serialized_model);
-
-		/* serialize the data graph to an unformatted string */
-		/* Note Tuscany is supposed to handle a null as the root element name,
-		 * but currently (549872) barfs, so guard against this here
-		 */
-		serialized_graph = xmlhp->save(my_object->dop, (const char*)0, "", -1);
-		graph_length = strlen(serialized_graph);
+		const DataFactoryImpl *model = ((DataFactoryImpl *)(DataFactory *)dfp)->getModel();
 
-		/*
-		 * The serialized buffer contains the schema followed by the data graph
-		 * These are both null-terminated strings.
+		/* A frozen model in the table is known by the fingerprint the
+		 * graph snapshot carries, so only the graph is written. Otherwise
+		 * the graph follows a binary snapshot of the model, which can be
+		 * restored without parsing a schema, and a frozen model goes into
+		 * the table for next time.
 		 */
-		unsigned long buffer_length = model_length + 1 + graph_length + 1;
-		unsigned char *buffer = (unsigned char *)emalloc(buffer_length);
-		memcpy((void *)&buffer[0], serialized_model, 1 + model_length);
-		memcpy((void *)&buffer[1 + model_length], serialized_graph, 1 + graph_length);
+		std::string serialized_data;
+		if (!model->isFrozen() || !sdo_do_find_fingerprint(model, fingerprint)) {
+			SDOModelSnapshot::save(dfp, serialized_data);
+			fingerprint = SDOModelSnapshot::getFingerprint(
+				serialized_data.data(), serialized_data.length());
+			if (model->isFrozen()) {
+				sdo_do_save_model((DataFactory *)(DataFactoryImpl *)model, fingerprint,
+					serialized_data.data(), serialized_data.length());
+			}
+		}
 
+		SDOGraphSnapshot::save(my_object->dop, fingerprint, serialized_data);
+		unsigned char *buffer = (unsigned char *)emalloc(serialized_data.length());
+		memcpy((void *)buffer, serialized_data.data(), serialized_data.length());
 		*buffer_p = buffer;
-		*buf_len_p = buffer_length;
+		*buf_len_p = serialized_data.length();
 	} catch (SDORuntimeException e) {
 		sdo_throw_runtimeexception(&e TSRMLS_CC);
 		return FAILURE;
@@ -1230,19 +1402,65 @@ static int sdo_do_unserialize (zval **object, zend_class_entry *ce, const unsign
 //	char			*space;
 //	char			*class_name;
 
+	unsigned int	 snapshot_length;
+	unsigned int	 graph_length = 0;
+
 	/*
-	 * The serialized data comprises the model and the graph, both as null-terminated strings
+	 * The serialized data comprises the model and the graph, or just the
+	 * graph when its model was in the table. The model is a binary
+	 * snapshot, or a schema as a null-terminated string in data serialized
+	 * by earlier releases. The graph is a binary snapshot, or a
+	 * null-terminated XML string.
 	 */
 	serialized_model = (char *)&buffer[0];
-	serialized_graph = (char *)&buffer[1 + strlen(serialized_model)];
+	snapshot_length = SDOModelSnapshot::getSnapshotLength(serialized_model, buffer_length);
+	if (snapshot_length) {
+		serialized_graph = (char *)&buffer[snapshot_length];
+		graph_length = SDOGraphSnapshot::getSnapshotLength(serialized_graph,
+			buffer_length - snapshot_length);
+	} else if ((graph_length = SDOGraphSnapshot::getSnapshotLength((char *)&buffer[0], buffer_length))) {
+		serialized_graph = (char *)&buffer[0];
+	} else {
+		serialized_graph = (char *)&buffer[1 + strlen(serialized_model)];
+	}
 
 	try {
+		DataObjectPtr root_dop;
+
+		if (graph_length) {
+			/* Use the model if it is already loaded, otherwise load it
+			 * and keep it for the next time. Each graph gets its own view.
+			 */
+			int64_t fingerprint = SDOGraphSnapshot::getModelFingerprint(serialized_graph, graph_length);
+			DataFactoryPtr model = sdo_do_find_model(fingerprint, serialized_model, snapshot_length);
+			if (!model && !snapshot_length) {
+				const char *space, *class_name = get_active_class_name(&space TSRMLS_CC);
+				sdo_throw_exception_ex (sdo_exception_class_entry, 0,0 TSRMLS_CC,
+					"%s%s%s(): the model of the serialized data object is not loaded",
+					class_name, space, get_active_function_name(TSRMLS_C));
+				return FAILURE;
+			}
+			if (!model) {
+				model = DataFactory::getDataFactory();
+				SDOModelSnapshot::load(model, serialized_model, snapshot_length);
+				model->freeze();
+				sdo_do_save_model(model, fingerprint, serialized_model, snapshot_length);
+			}
+			root_dop = SDOGraphSnapshot::load(model->createView(), serialized_graph, graph_length);
+			sdo_do_new(*object, root_dop TSRMLS_CC);
+			return SUCCESS;
+		}
+
 		DataFactoryPtr dfp = DataFactory::getDataFactory();
-        XSDHelperPtr xsdhp = HelperProvider::getXSDHelper(dfp);
         XMLHelperPtr xmlhp = HelperProvider::getXMLHelper(dfp);
 
 		/* Load the model from the serialized data */
-		xsdhp->define(serialized_model);
+		if (snapshot_length) {
+			SDOModelSnapshot::load(dfp, serialized_model, snapshot_length);
+		} else {
+	        XSDHelperPtr xsdhp = HelperProvider::getXSDHelper(dfp);
+			xsdhp->define(serialized_model);
+		}
 
 		/* Don't create a PHP object wrapper for the data factory.
 		* The C++ library will hold on to it until its last data object
@@ -1252,7 +1470,7 @@ static int sdo_do_unserialize (zval **object, zend_class_entry *ce, const unsign
 
 		/* Load the graph */
 		XMLDocumentPtr doc = xmlhp->load(serialized_graph);
-		DataObjectPtr root_dop = doc->getRootDataObject();
+		root_dop = doc->getRootDataObject();
 		if (root_dop) {
 		   /* Create a PHP object fot the root. Other nodes will be created
 	        * lazily as required.
@@ -1286,6 +1504,9 @@ void sdo_do_minit(zend_class_entry *tmp_ce TSRMLS_DC)
 	sdo_dataobjectimpl_class_entry->get_iterator = sdo_do_get_iterator;
 	sdo_dataobjectimpl_class_entry->serialize = sdo_do_serialize;
 	sdo_dataobjectimpl_class_entry->unserialize = sdo_do_unserialize;
+#ifdef ZTS
+	model_table_mutex = tsrm_mutex_alloc();
+#endif
 	zend_class_implements(sdo_dataobjectimpl_class_entry TSRMLS_CC, 1, sdo_das_dataobject_class_entry);
 
 	memcpy(&sdo_do_object_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
@@ -1315,6 +1536,21 @@ void sdo_do_minit(zend_class_entry *tmp_ce TSRMLS_DC)
 }
 /* }}} */
 
+/* {{{ sdo_do_mshutdown
+ */
+void sdo_do_mshutdown(TSRMLS_D)
+{
+	for (int i = 0; i < SAVED_MODEL_TABLE_SIZE; i++) {
+		model_table[i].model = 0;
+		std::string().swap(model_table[i].snapshot);
+	}
+	model_table_next = 0;
+#ifdef ZTS
+	tsrm_mutex_free(model_table_mutex);
+#endif
+}
+/* }}} */
+
 /* {{{ SDO_DataObjectImpl::__construct
  */
 PHP_METHOD(SDO_DataObjectImpl, __construct)
@@ -1522,6 +1758,336 @@ PHP_METHOD(SDO_DataObjectImpl, count)
 }
 /* }}} */
 
+/* {{{ sdo_do_bulk_property
+ * Whether the property can be read or written through the bulk methods of DataObjectImpl.
+ * Other properties go through the read and write handlers one at a time.
+ */
+static bool sdo_do_bulk_property(const PropertyImpl *propertyp)
+{
+	if (!propertyp->getType().isDataType() || propertyp->isMany() ||
+		propertyp->getTypeImpl()->isFromList()) {
+		return false;
+	}
+
+	switch(propertyp->getTypeEnum()) {
+	case Type::BigDecimalType:
+	case Type::BigIntegerType:
+	case Type::BooleanType:
+	case Type::ByteType:
+	case Type::DateType:
+	case Type::DoubleType:
+	case Type::FloatType:
+	case Type::IntegerType:
+	case Type::LongType:
+	case Type::ShortType:
+	case Type::StringType:
+	case Type::UriType:
+		return true;
+	default:
+		return false;
+	}
+}
+/* }}} */
+
+/* {{{ sdo_do_zval_to_sdovalue
+ * Coerce a php value to the type of the property, as sdo_do_write_dimension does.
+ */
+static SDOValue sdo_do_zval_to_sdovalue(const PropertyImpl *propertyp, zval *z_value TSRMLS_DC)
+{
+	zval	temp_zval;
+	SDOValue sval;
+
+	if (Z_TYPE_P(z_value) == IS_NULL) {
+		return SDOValue::nullSDOValue;
+	}
+
+	temp_zval = *z_value;
+	zval_copy_ctor(&temp_zval);
+
+	switch(propertyp->getTypeEnum()) {
+	case Type::BooleanType:
+		convert_to_boolean(&temp_zval);
+		sval = SDOValue((bool)ZEND_TRUTH(Z_BVAL(temp_zval)));
+		break;
+	case Type::ByteType:
+		convert_to_long(&temp_zval);
+		sval = SDOValue((char)Z_LVAL(temp_zval));
+		break;
+	case Type::DateType:
+		convert_to_long(&temp_zval);
+		sval = SDOValue((SDODate)Z_LVAL(temp_zval));
+		break;
+	case Type::DoubleType:
+		convert_to_double(&temp_zval);
+		sval = SDOValue((long double)Z_DVAL(temp_zval));
+		break;
+	case Type::FloatType:
+		convert_to_double(&temp_zval);
+		sval = SDOValue((float)Z_DVAL(temp_zval));
+		break;
+	case Type::IntegerType:
+		convert_to_long(&temp_zval);
+		sval = SDOValue((long)(int)Z_LVAL(temp_zval));
+		break;
+	case Type::LongType:
+		if (Z_TYPE(temp_zval) == IS_LONG) {
+			sval = SDOValue((int64_t)Z_LVAL(temp_zval));
+			break;
+		}
+		convert_to_string(&temp_zval);
+		sval = SDOValue(SDOString(Z_STRVAL(temp_zval)));
+		break;
+	case Type::ShortType:
+		convert_to_long(&temp_zval);
+		sval = SDOValue((short)Z_LVAL(temp_zval));
+		break;
+	default:
+		/* BigDecimal, BigInteger, String and URI */
+		convert_to_string(&temp_zval);
+		sval = SDOValue(SDOString(Z_STRVAL(temp_zval)));
+	}
+
+	zval_dtor(&temp_zval);
+	return sval;
+}
+/* }}} */
+
+/* {{{ sdo_do_sdovalue_to_zval
+ * Return the value as sdo_do_read_value does.
+ */
+static void sdo_do_sdovalue_to_zval(const PropertyImpl *propertyp, const SDOValue& sval, zval *return_value TSRMLS_DC)
+{
+	if (sval.isNull()) {
+		RETVAL_NULL();
+		return;
+	}
+
+	switch(propertyp->getTypeEnum()) {
+	case Type::BooleanType:
+		RETVAL_BOOL(sval.getBoolean());
+		break;
+	case Type::ByteType:
+		RETVAL_LONG(sval.getByte());
+		break;
+	case Type::DateType:
+		RETVAL_LONG(sval.getDate().getTime());
+		break;
+	case Type::DoubleType:
+		RETVAL_DOUBLE(sval.getDouble());
+		break;
+	case Type::FloatType:
+		RETVAL_DOUBLE(sval.getFloat());
+		break;
+	case Type::IntegerType:
+		RETVAL_LONG(sval.getInteger());
+		break;
+	case Type::ShortType:
+		RETVAL_LONG(sval.getShort());
+		break;
+	default: {
+		/* BigDecimal, BigInteger, Long, String and URI */
+		const char *text_value;
+		unsigned int text_len;
+		if (sval.getStringView(text_value, text_len)) {
+			RETVAL_STRINGL((char *)text_value, text_len, 1);
+		} else {
+			RETVAL_STRING((char *)sval.getCString(), 1);
+		}
+	}
+	}
+}
+/* }}} */
+
+/* {{{ SDO_DataObjectImpl::setValues
+ */
+PHP_METHOD(SDO_DataObjectImpl, setValues)
+{
+	zval			*z_values, **z_value, z_offset;
+	HashPosition	 pos;
+	char			*key;
+	uint			 key_len;
+	ulong			 index;
+	int				 key_type;
+	sdo_do_object	*my_object;
+	DataObjectImpl::PROPERTY_VALUES values;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "a", &z_values) == FAILURE) {
+		return;
+	}
+
+	my_object = sdo_do_get_instance(getThis() TSRMLS_CC);
+	DataObjectImpl *doi = (DataObjectImpl *)(DataObject *)my_object->dop;
+
+	try {
+		/* a sequenced object must record the order in which its properties are set */
+		bool sequenced = doi->getType().isSequencedType();
+
+		for (zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(z_values), &pos);
+			 zend_hash_get_current_data_ex(Z_ARRVAL_P(z_values), (void **)&z_value, &pos) == SUCCESS;
+			 zend_hash_move_forward_ex(Z_ARRVAL_P(z_values), &pos)) {
+			key_type = zend_hash_get_current_key_ex(Z_ARRVAL_P(z_values), &key, &key_len, &index, 0, &pos);
+
+			if (key_type == HASH_KEY_IS_STRING && !sequenced) {
+				PropertyImpl *propertyp = doi->getPropertyImpl(SDOString(key, key_len - 1));
+				if (propertyp && sdo_do_bulk_property(propertyp)) {
+					values.push_back(std::make_pair(doi->getPropertyIndex(*propertyp),
+						sdo_do_zval_to_sdovalue(propertyp, *z_value TSRMLS_CC)));
+					continue;
+				}
+			}
+
+			/* anything else is written as it would be by $do[$key] = $value,
+			 * after the values before it so that the array order is kept */
+			if (!values.empty()) {
+				doi->setValues(values);
+				values.clear();
+			}
+			if (key_type == HASH_KEY_IS_STRING) {
+				ZVAL_STRINGL(&z_offset, key, key_len - 1, 0);
+			} else {
+				ZVAL_LONG(&z_offset, index);
+			}
+			sdo_do_write_dimension(getThis(), &z_offset, *z_value TSRMLS_CC);
+			if (EG(exception)) {
+				return;
+			}
+		}
+
+		doi->setValues(values);
+	} catch (SDORuntimeException e) {
+		sdo_throw_runtimeexception(&e TSRMLS_CC);
+	}
+}
+/* }}} */
+
+/* {{{ SDO_DataObjectImpl::getValues
+ */
+PHP_METHOD(SDO_DataObjectImpl, getValues)
+{
+	zval			*z_names = NULL, **z_name, *z_value, z_offset;
+	HashPosition	 pos;
+	sdo_do_object	*my_object;
+	std::vector<const PropertyImpl *> properties;
+	std::vector<const char *> keys;
+	std::vector<unsigned int> indexes;
+	std::vector<SDOValue> values;
+
+	if (zend_parse_parameters(ZEND_NUM_ARGS() TSRMLS_CC, "|a!", &z_names) == FAILURE) {
+		return;
+	}
+
+	my_object = sdo_do_get_instance(getThis() TSRMLS_CC);
+	DataObjectImpl *doi = (DataObjectImpl *)(DataObject *)my_object->dop;
+
+	array_init(return_value);
+
+	try {
+		/*
+		 * Collect the properties which can be read in bulk, holding their place
+		 * in the result, and read the others as they come, as $do[$name] would.
+		 */
+		if (z_names == NULL) {
+			PropertyList pl = doi->getInstanceProperties();
+			for (unsigned int i = 0; i < pl.size(); i++) {
+				const PropertyImpl *propertyp = doi->getPropertyImpl(i);
+				if (sdo_do_bulk_property(propertyp)) {
+					properties.push_back(propertyp);
+					keys.push_back(propertyp->getName());
+					indexes.push_back(i);
+					add_assoc_null(return_value, (char *)propertyp->getName());
+				} else if (doi->isSet(i)) {
+					ZVAL_STRING(&z_offset, (char *)propertyp->getName(), 0);
+					z_value = sdo_do_read_dimension(getThis(), &z_offset, BP_VAR_R TSRMLS_CC);
+					if (EG(exception)) {
+						return;
+					}
+					Z_ADDREF_P(z_value);
+					add_assoc_zval(return_value, (char *)propertyp->getName(), z_value);
+				}
+			}
+		} else {
+			for (zend_hash_internal_pointer_reset_ex(Z_ARRVAL_P(z_names), &pos);
+				 zend_hash_get_current_data_ex(Z_ARRVAL_P(z_names), (void **)&z_name, &pos) == SUCCESS;
+				 zend_hash_move_forward_ex(Z_ARRVAL_P(z_names), &pos)) {
+				if (Z_TYPE_PP(z_name) == IS_STRING) {
+					const PropertyImpl *propertyp =
+						doi->getPropertyImpl(SDOString(Z_STRVAL_PP(z_name), Z_STRLEN_PP(z_name)));
+					if (propertyp && sdo_do_bulk_property(propertyp)) {
+						properties.push_back(propertyp);
+						keys.push_back(Z_STRVAL_PP(z_name));
+						indexes.push_back(doi->getPropertyIndex(*propertyp));
+						add_assoc_null(return_value, Z_STRVAL_PP(z_name));
+						continue;
+					}
+				}
+				z_value = sdo_do_read_dimension(getThis(), *z_name, BP_VAR_R TSRMLS_CC);
+				if (EG(exception)) {
+					return;
+				}
+				Z_ADDREF_P(z_value);
+				if (Z_TYPE_PP(z_name) == IS_STRING) {
+					add_assoc_zval(return_value, Z_STRVAL_PP(z_name), z_value);
+				} else {
+					add_index_zval(return_value, Z_LVAL_PP(z_name), z_value);
+				}
+			}
+		}
+
+		doi->getValues(indexes, values);
+
+		for (unsigned int i = 0; i < values.size(); i++) {
+			if (values[i].isSet()) {
+				MAKE_STD_ZVAL(z_value);
+				sdo_do_sdovalue_to_zval(properties[i], values[i], z_value TSRMLS_CC);
+			} else {
+				/*
+				 * An unset property is left out when reading the whole object,
+				 * unless it has a default. When it is named it is read as
+				 * $do[$name] would be, giving the default or an exception.
+				 */
+				if (z_names == NULL && !properties[i]->isDefaulted()) {
+					zend_hash_del(Z_ARRVAL_P(return_value), (char *)keys[i], strlen(keys[i]) + 1);
+					continue;
+				}
+				ZVAL_STRING(&z_offset, (char *)keys[i], 0);
+				z_value = sdo_do_read_dimension(getThis(), &z_offset, BP_VAR_R TSRMLS_CC);
+				if (EG(exception)) {
+					return;
+				}
+				Z_ADDREF_P(z_value);
+			}
+			add_assoc_zval(return_value, (char *)keys[i], z_value);
+		}
+	} catch (SDORuntimeException e) {
+		sdo_throw_runtimeexception(&e TSRMLS_CC);
+	}
+}
+/* }}} */
+
+/* {{{ SDO_DataObjectImpl::hash
+ */
+PHP_METHOD(SDO_DataObjectImpl, hash)
+{
+	sdo_do_object	*my_object;
+	char			 buf[17];
+
+	if (ZEND_NUM_ARGS() != 0) {
+		WRONG_PARAM_COUNT;
+	}
+
+	my_object = sdo_do_get_instance(getThis() TSRMLS_CC);
+
+	try {
+		/* the hash is 64 bits, which may not fit a PHP int, so return it as hex */
+		int64_t h = EqualityHelper::hash(my_object->dop);
+		sprintf(buf, "%08lx%08lx", (unsigned long)((h >> 32) & 0xFFFFFFFF), (unsigned long)(h & 0xFFFFFFFF));
+		RETVAL_STRINGL(buf, 16, 1);
+	} catch (SDORuntimeException e) {
+		sdo_throw_runtimeexception(&e TSRMLS_CC);
+	}
+}
+/* }}} */
+
 /*
  * Local variables:
  * tab-width: 4
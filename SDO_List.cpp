@@ -32,6 +32,7 @@ static char rcs_id[] = "$Id: SDO_List.cpp 254122 2008-03-03 17:56:38Z mfp $";
 #include "zend_interfaces.h"
 
 #include "php_sdo_int.h"
+#include "commonj/sdo/DataObjectImpl.h"
 
 #define CLASS_NAME "SDO_List"
 
@@ -66,6 +67,7 @@ typedef struct {
 typedef struct {
 	zend_object_iterator zoi;		/* The standard zend_object_iterator */
 	ulong				 index;		/* current index */
+	zend_bool			 objects;	/* the items are data objects, read straight from the list */
 	zval				*value;
 } sdo_list_iterator;
 /* }}} */
@@ -183,6 +185,33 @@ void sdo_dataobjectlist_new(zval *me, const Type& type, DataObjectPtr dop, DataO
 }
 /* }}} */
 
+/* {{{ sdo_dataobjectlist_get_list
+ * Returns the C++ list of an SDO_DataObjectList, so that a wrapper can be reused
+ * only while it still refers to the list it was made for.
+ */
+DataObjectList *sdo_dataobjectlist_get_list(zval *me TSRMLS_DC)
+{
+	sdo_list_object *my_object = sdo_list_get_instance(me TSRMLS_CC);
+
+	return (my_object->list_type == TYPE_DataObjectList) ? my_object->dolp : NULL;
+}
+/* }}} */
+
+/* {{{ sdo_dataobjectlist_new_item
+ * Find or create the PHP object for a data object item of the list, whose index is in range.
+ */
+static void sdo_dataobjectlist_new_item(zval *return_value, DataObjectList& dol, long index TSRMLS_DC)
+{
+	const RefCountingPointer<DataObjectImpl>& item = ((DataObjectListImpl&)dol).getDataObjects()[index];
+
+	if (!item) {
+		RETVAL_NULL();
+	} else {
+		sdo_do_new(return_value, DataObjectPtr((DataObject *)&*item) TSRMLS_CC);
+	}
+}
+/* }}} */
+
 /* {{{ sdo_changeddataobjectlist_new
  */
 void sdo_changeddataobjectlist_new(zval *me, const ChangedDataObjectList *cdolp TSRMLS_DC)
@@ -217,7 +246,6 @@ static zval *sdo_dataobjectlist_read_value(sdo_list_object *my_object, long inde
 	char			 char_value;
 	wchar_t			 wchar_value;
 	zval			*return_value;
-	DataObjectPtr	 doh_value;
 //	char			*class_name, *space;
 
 	DataObjectList& dol = *my_object->dolp;
@@ -301,13 +329,8 @@ static zval *sdo_dataobjectlist_read_value(sdo_list_object *my_object, long inde
 			}
 			case Type::DataObjectType:
 			case Type::OpenDataObjectType: {
-				doh_value = dol[index];
 				/*find PHP object from C++ object */
-				if (!doh_value) {
-					RETVAL_NULL();
-				} else {
-					sdo_do_new(return_value, doh_value TSRMLS_CC);
-				}
+				sdo_dataobjectlist_new_item(return_value, dol, index TSRMLS_CC);
 				break;
 			}
 			case Type::ChangeSummaryType: {
@@ -1213,6 +1236,16 @@ zend_object_iterator *sdo_list_get_iterator(zend_class_entry *ce, zval *object T
 	iterator->zoi.data = (void *)object;
 	iterator->zoi.funcs = &sdo_list_iterator_funcs;
 	iterator->index = 0;
+	iterator->objects = 0;
+
+	sdo_list_object *my_object = sdo_list_get_instance(object TSRMLS_CC);
+	if (my_object->list_type == TYPE_DataObjectList) {
+		try {
+			iterator->objects = !my_object->dolp->getType().isDataType();
+		} catch (SDORuntimeException e) {
+			/* an open list with no type yet - leave it to the general case */
+		}
+	}
 
 	return (zend_object_iterator *)iterator;
 }
@@ -1298,7 +1331,13 @@ static void sdo_list_iterator_current_data (zend_object_iterator *iter, zval ***
 	try {
 		switch(my_object->list_type) {
 		case TYPE_DataObjectList: {
-			iterator->value = sdo_dataobjectlist_read_value(my_object, iterator->index TSRMLS_CC);
+			if (iterator->objects && iterator->index < my_object->dolp->size()) {
+				ALLOC_INIT_ZVAL(iterator->value);
+				Z_SET_REFCOUNT_P(iterator->value, 0);
+				sdo_dataobjectlist_new_item(iterator->value, *my_object->dolp, iterator->index TSRMLS_CC);
+			} else {
+				iterator->value = sdo_dataobjectlist_read_value(my_object, iterator->index TSRMLS_CC);
+			}
 			break;
 			}
 		case TYPE_ChangedDataObjectList: {
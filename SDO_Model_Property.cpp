@@ -33,6 +33,9 @@ static char rcs_id[] = "$Id: SDO_Model_Property.cpp 234945 2007-05-04 15:05:53Z
 
 #include "php_sdo_int.h"
 
+#include "commonj/sdo/PropertyImpl.h"
+#include "commonj/sdo/TypeImpl.h"
+
 #define CLASS_NAME "SDO_Model_Property"
 
 /* {{{ sdo_model_property_object
@@ -122,12 +125,28 @@ static zend_object_value sdo_model_property_object_create(zend_class_entry *ce T
 /* }}} */
 
 /* {{{ sdo_model_property_new
+ * Find the PHP object for the Property made earlier in this request, or create one.
+ * Open properties belong to a data object rather than to its type, so they
+ * may not outlive the request and are never shared.
  */
 void sdo_model_property_new(zval *me, const Property *propertyp TSRMLS_DC)
 {
 	sdo_model_property_object *my_object;
+	const PropertyImpl *property_implp = (const PropertyImpl *)propertyp;
+	bool shared;
+	zval *wrapper;
 //	char *class_name, *space;
 
+	shared = (((const TypeImpl&)propertyp->getContainingType()).getPropertyImpl(
+		property_implp->getIndex()) == property_implp);
+	if (shared) {
+		wrapper = sdo_model_wrapper_find(propertyp TSRMLS_CC);
+		if (wrapper && sdo_model_property_get_instance(wrapper TSRMLS_CC)->propertyp == propertyp) {
+			ZVAL_ZVAL(me, wrapper, 1, 0);
+			return;
+		}
+	}
+
 	Z_TYPE_P(me) = IS_OBJECT;
 	if (object_init_ex(me, sdo_model_propertyimpl_class_entry) == FAILURE) {
 		const char *space, *class_name = get_active_class_name(&space TSRMLS_CC);
@@ -141,6 +160,10 @@ void sdo_model_property_new(zval *me, const Property *propertyp TSRMLS_DC)
 	my_object->propertyp = propertyp;
 	zend_update_property_string(sdo_model_propertyimpl_class_entry, me,
 		"name", strlen("name"), (char *)propertyp->getName() TSRMLS_CC);
+
+	if (shared) {
+		sdo_model_wrapper_add(propertyp, me TSRMLS_CC);
+	}
 }
 /* }}} */
 
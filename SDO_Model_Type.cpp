@@ -32,14 +32,20 @@ static char rcs_id[] = "$Id: SDO_Model_Type.cpp 234945 2007-05-04 15:05:53Z mfp
 
 #include "php_sdo_int.h"
 
+#include "commonj/sdo/DataFactoryImpl.h"
+
 #define CLASS_NAME "SDO_Model_Type"
 
+/* Bound on the wrappers shared in one request */
+#define SDO_MODEL_WRAPPERS_MAX 4096
+
 /* {{{ sdo_model_type_object
  * The instance data for this class - extends the standard zend_object
  */
 typedef struct {
 	zend_object		 zo;			/* The standard zend_object */
 	const Type		*typep;			/* The sdo4cpp type */
+	zval			*properties;	/* getProperties() result, built once */
 } sdo_model_type_object;
 /* }}} */
 
@@ -77,6 +83,10 @@ static void sdo_model_type_object_free_storage(void *object TSRMLS_DC)
 	    FREE_HASHTABLE(my_object->zo.guards);
 	}
 
+	if (my_object->properties) {
+		zval_ptr_dtor(&my_object->properties);
+	}
+
 	my_object->typep = NULL;
 	efree(my_object);
 
@@ -112,13 +122,83 @@ static zend_object_value sdo_model_type_object_create(zend_class_entry *ce TSRML
 }
 /* }}} */
 
+/* {{{ sdo_model_wrapper_find
+ * The SDO_Model_Type and SDO_Model_Property objects are shared within a
+ * request, keyed by the address of the Type or Property they wrap. Once a
+ * data factory has been released its types may have been freed and the
+ * addresses reused, so the table is dropped at the next look up.
+ */
+zval *sdo_model_wrapper_find(const void *key TSRMLS_DC)
+{
+	HashTable	*wrappers = SDO_G(model_wrappers);
+	zval		**wrapper;
+
+	if (!wrappers) {
+		return NULL;
+	}
+
+	if (SDO_G(model_release_count) != DataFactoryImpl::getReleaseCount()) {
+		zend_hash_clean(wrappers);
+		SDO_G(model_release_count) = DataFactoryImpl::getReleaseCount();
+		return NULL;
+	}
+
+	if (zend_hash_index_find(wrappers, (ulong)key, (void **)&wrapper) == SUCCESS) {
+		return *wrapper;
+	}
+	return NULL;
+}
+/* }}} */
+
+/* {{{ sdo_model_wrapper_add
+ */
+void sdo_model_wrapper_add(const void *key, zval *me TSRMLS_DC)
+{
+	HashTable	*wrappers = SDO_G(model_wrappers);
+	zval		*wrapper;
+
+	if (!wrappers) {
+		ALLOC_HASHTABLE(wrappers);
+		zend_hash_init(wrappers, 0, NULL, ZVAL_PTR_DTOR, 0);
+		SDO_G(model_wrappers) = wrappers;
+		SDO_G(model_release_count) = DataFactoryImpl::getReleaseCount();
+	} else if (zend_hash_num_elements(wrappers) >= SDO_MODEL_WRAPPERS_MAX) {
+		zend_hash_clean(wrappers);
+	}
+
+	MAKE_STD_ZVAL(wrapper);
+	ZVAL_ZVAL(wrapper, me, 1, 0);
+	zend_hash_index_update(wrappers, (ulong)key, &wrapper, sizeof(zval *), NULL);
+}
+/* }}} */
+
+/* {{{ sdo_model_rshutdown
+ */
+void sdo_model_rshutdown(TSRMLS_D)
+{
+	if (SDO_G(model_wrappers)) {
+		zend_hash_destroy(SDO_G(model_wrappers));
+		FREE_HASHTABLE(SDO_G(model_wrappers));
+		SDO_G(model_wrappers) = NULL;
+	}
+}
+/* }}} */
+
 /* {{{ sdo_model_type_new
+ * Find the PHP object for the Type made earlier in this request, or create one.
  */
 void sdo_model_type_new(zval *me, const Type *typep TSRMLS_DC)
 {
 	sdo_model_type_object *my_object;
+	zval *wrapper;
 //	char *class_name, *space;
 
+	wrapper = sdo_model_wrapper_find(typep TSRMLS_CC);
+	if (wrapper && sdo_model_type_get_instance(wrapper TSRMLS_CC)->typep == typep) {
+		ZVAL_ZVAL(me, wrapper, 1, 0);
+		return;
+	}
+
 	Z_TYPE_P(me) = IS_OBJECT;
 	if (object_init_ex(me, sdo_model_typeimpl_class_entry) == FAILURE) {
 		const char *space, *class_name = get_active_class_name(&space TSRMLS_CC);
@@ -134,6 +214,8 @@ void sdo_model_type_new(zval *me, const Type *typep TSRMLS_DC)
 		"name", strlen("name"), (char *)typep->getName() TSRMLS_CC);
 	zend_update_property_string(sdo_model_typeimpl_class_entry, me,
 		"namespaceURI", strlen("namespaceURI"), (char *)typep->getURI() TSRMLS_CC);
+
+	sdo_model_wrapper_add(typep, me TSRMLS_CC);
 }
 /* }}} */
 
@@ -400,16 +482,27 @@ PHP_METHOD(SDO_Model_TypeImpl, getProperties)
 	}
 
 	my_object = sdo_model_type_get_instance(getThis() TSRMLS_CC);
-	try {
-		pl = my_object->typep->getProperties();
-		array_init(return_value);
-		for (int i = 0; i < pl.size(); i++) {
-			MAKE_STD_ZVAL(z_property);
-			sdo_model_property_new(z_property, &pl[i] TSRMLS_CC);
-		    add_next_index_zval(return_value, z_property);
+	if (!my_object->properties) {
+		/* Properties cannot be added to a completed Type, so build the array once */
+		try {
+			pl = my_object->typep->getProperties();
+			MAKE_STD_ZVAL(my_object->properties);
+			array_init(my_object->properties);
+			for (int i = 0; i < pl.size(); i++) {
+				MAKE_STD_ZVAL(z_property);
+				sdo_model_property_new(z_property, &pl[i] TSRMLS_CC);
+				add_next_index_zval(my_object->properties, z_property);
+			}
+		} catch (SDORuntimeException e) {
+			if (my_object->properties) {
+				zval_ptr_dtor(&my_object->properties);
+				my_object->properties = NULL;
+			}
+			sdo_throw_runtimeexception(&e TSRMLS_CC);
 		}
-	} catch (SDORuntimeException e) {
-		sdo_throw_runtimeexception(&e TSRMLS_CC);
+	}
+	if (my_object->properties) {
+		RETVAL_ZVAL(my_object->properties, 1, 0);
 	}
 }
 /* }}} */
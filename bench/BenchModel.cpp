@@ -0,0 +1,182 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/* $Rev$ $Date$ */
+
+#include "BenchModel.h"
+
+#include <sstream>
+
+const char* BenchModel::URI = "http://www.example.org/sdo/bench";
+
+unsigned long BenchShape::getObjectCount() const
+{
+    unsigned long count = 0;
+    unsigned long levelCount = 1;
+    for (unsigned int level = 0; level < depth; level++)
+    {
+        count += levelCount;
+        levelCount *= listSize;
+    }
+    return count;
+}
+
+BenchModel::BenchModel(const BenchShape& s)
+    : shape(s)
+{
+}
+
+const BenchShape& BenchModel::getShape() const
+{
+    return shape;
+}
+
+std::string BenchModel::getSchema() const
+{
+    std::ostringstream xsd;
+
+    xsd << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<xsd:schema xmlns:xsd=\"http://www.w3.org/2001/XMLSchema\"\n"
+        << "    xmlns:sdo=\"commonj.sdo\"\n"
+        << "    xmlns:bench=\"" << URI << "\"\n"
+        << "    targetNamespace=\"" << URI << "\">\n"
+        << "  <xsd:element name=\"root\" type=\"bench:Node0\"/>\n";
+
+    for (unsigned int level = 0; level < shape.depth; level++)
+    {
+        xsd << "  <xsd:complexType name=\"Node" << level << "\">\n"
+            << "    <xsd:sequence>\n";
+        for (unsigned int j = 0; j < shape.width; j++)
+        {
+            xsd << "      <xsd:element name=\"p" << j << "\" type=\""
+                << ((j % 2 == 0) ? "xsd:string" : "xsd:int") << "\"/>\n";
+        }
+        if (level + 1 < shape.depth)
+        {
+            xsd << "      <xsd:element name=\"item\" type=\"bench:Node" << (level + 1)
+                << "\" minOccurs=\"0\" maxOccurs=\"unbounded\"/>\n";
+        }
+        if (level == 0)
+        {
+            xsd << "      <xsd:element name=\"changeSummary\" type=\"sdo:ChangeSummaryType\"/>\n";
+        }
+        xsd << "    </xsd:sequence>\n"
+            << "  </xsd:complexType>\n";
+    }
+
+    xsd << "</xsd:schema>\n";
+    return xsd.str();
+}
+
+void BenchModel::define(DataFactoryPtr df) const
+{
+    XSDHelperPtr xsh = HelperProvider::getXSDHelper(df);
+    xsh->define(getSchema());
+    if (xsh->getErrorCount() > 0)
+    {
+        SDO_THROW_EXCEPTION("BenchModel::define", SDOXMLParserException,
+                            xsh->getErrorMessage(0));
+    }
+}
+
+DataObjectPtr BenchModel::build(DataFactoryPtr df) const
+{
+    DataObjectPtr root = df->create(URI, "Node0");
+    unsigned long n = 0;
+    fill(root, 0, n);
+    return root;
+}
+
+void BenchModel::fill(DataObjectPtr dataObject, unsigned int level, unsigned long& n) const
+{
+    const Type& type = dataObject->getType();
+    unsigned long number = n++;
+
+    for (unsigned int j = 0; j < shape.width; j++)
+    {
+        const Property& p = type.getProperty(j);
+        if (j % 2 == 0)
+        {
+            dataObject->setCString(p, getStringValue(number, j));
+        }
+        else
+        {
+            dataObject->setInteger(p, getIntValue(number, j));
+        }
+    }
+
+    if (level + 1 < shape.depth)
+    {
+        const Property& item = type.getProperty("item");
+        for (unsigned int i = 0; i < shape.listSize; i++)
+        {
+            fill(dataObject->createDataObject(item), level + 1, n);
+        }
+    }
+}
+
+std::string BenchModel::getStringValue(unsigned long n, unsigned int j)
+{
+    std::ostringstream value;
+    value << "value " << n << "." << j;
+    return value.str();
+}
+
+long BenchModel::getIntValue(unsigned long n, unsigned int j)
+{
+    return (long) (n * 31 + j);
+}
+
+std::vector<std::string> BenchModel::getLeafPaths(unsigned int count) const
+{
+    std::vector<std::string> paths;
+
+    unsigned long leaves = 1;
+    for (unsigned int level = 1; level < shape.depth; level++)
+    {
+        leaves *= shape.listSize;
+    }
+    if (leaves == 0 || count == 0)
+    {
+        return paths;
+    }
+
+    unsigned long step = (leaves > count) ? leaves / count : 1;
+    for (unsigned long leaf = 0; leaf < leaves && paths.size() < count; leaf += step)
+    {
+        // Write the leaf number out in base listSize, one digit per level
+        std::vector<unsigned long> digits;
+        unsigned long rest = leaf;
+        for (unsigned int level = 1; level < shape.depth; level++)
+        {
+            digits.push_back(rest % shape.listSize);
+            rest /= shape.listSize;
+        }
+
+        std::ostringstream path;
+        for (size_t d = digits.size(); d > 0; d--)
+        {
+            path << "item." << digits[d - 1] << "/";
+        }
+        path << "p0";
+        paths.push_back(path.str());
+    }
+    return paths;
+}
@@ -0,0 +1,101 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/* $Rev$ $Date$ */
+
+#ifndef _SDO_BENCHMODEL_H_
+#define _SDO_BENCHMODEL_H_
+
+#include "commonj/sdo/SDO.h"
+
+#include <string>
+#include <vector>
+
+using namespace commonj::sdo;
+
+/**
+ * BenchShape gives the size of the synthetic model: the number of scalar
+ * properties on each type, the number of nested levels and the number of
+ * children each non-leaf object holds in its list.
+ */
+struct BenchShape
+{
+    unsigned int width;
+    unsigned int depth;
+    unsigned int listSize;
+
+    /**
+     * The number of data objects in a graph of this shape.
+     */
+    unsigned long getObjectCount() const;
+};
+
+/**
+ * BenchModel generates the schema and graphs the benchmarks run against.
+ *
+ * Level k of the model is the type Node<k>. Each has width scalar
+ * properties p0, p1, ... alternating between String and Int, and all but
+ * the last level hold listSize children of the next level in the many
+ * valued property "item". Node0 also carries a change summary, and is the
+ * type of the document element "root".
+ */
+class BenchModel
+{
+public:
+    static const char* URI;
+
+    explicit BenchModel(const BenchShape& shape);
+
+    const BenchShape& getShape() const;
+
+    /**
+     * The XML schema for the model.
+     */
+    std::string getSchema() const;
+
+    /**
+     * Define the model's types in a data factory, by loading the schema.
+     */
+    void define(DataFactoryPtr df) const;
+
+    /**
+     * Build a complete graph, setting every scalar through its Property.
+     */
+    DataObjectPtr build(DataFactoryPtr df) const;
+
+    /**
+     * The value stored in scalar property j of object number n.
+     */
+    static std::string getStringValue(unsigned long n, unsigned int j);
+    static long getIntValue(unsigned long n, unsigned int j);
+
+    /**
+     * Paths from the root to the p0 property of up to count leaf objects,
+     * spread evenly over the graph, in the "item.3/item.1/p1" form.
+     */
+    std::vector<std::string> getLeafPaths(unsigned int count) const;
+
+private:
+    void fill(DataObjectPtr dataObject, unsigned int level, unsigned long& n) const;
+
+    BenchShape shape;
+};
+
+#endif //_SDO_BENCHMODEL_H_
@@ -0,0 +1,38 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* $Rev$ $Date$ */
+
+/*
+ * Stands in for the PHP header of the same name, which SDOUserMacros.h
+ * includes, when the core is built outside PHP for the benchmark.
+ */
+
+#ifndef BENCH_PHP_REENTRANCY_H
+#define BENCH_PHP_REENTRANCY_H
+
+#include <time.h>
+
+#if defined(WIN32) || defined(_WINDOWS)
+#define php_localtime_r(timep, result) (localtime_s((result), (timep)) == 0 ? (result) : 0)
+#else
+#define php_localtime_r localtime_r
+#endif
+
+#endif // BENCH_PHP_REENTRANCY_H
@@ -0,0 +1,702 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/* $Rev$ $Date$ */
+
+/*
+ * sdo_bench - micro and macro benchmarks for the SDO C++ core.
+ *
+ * Each case runs a number of untimed warm up iterations and then the
+ * timed ones against a synthetic model (see BenchModel.h). The results go
+ * to standard output as one JSON document, giving for every case the
+ * latency percentiles of an iteration, the throughput and the number of
+ * heap allocations made. Run with --help for the options.
+ */
+
+#include "BenchModel.h"
+#include "commonj/sdo/SDOStats.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#if defined(WIN32) || defined(_WINDOWS)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+// Every allocation made through operator new is counted, so that the
+// effect of a change on allocation behaviour can be tracked as well as its
+// effect on time.
+
+#if __cplusplus >= 201103L
+#define BENCH_NOTHROW noexcept
+#else
+#define BENCH_NOTHROW throw()
+#endif
+
+static unsigned long allocationCount = 0;
+static unsigned long allocationBytes = 0;
+
+static void* countedAllocate(size_t size)
+{
+    allocationCount++;
+    allocationBytes += size;
+    void* p = malloc(size != 0 ? size : 1);
+    if (p == 0)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void* operator new(size_t size)
+{
+    return countedAllocate(size);
+}
+
+void* operator new[](size_t size)
+{
+    return countedAllocate(size);
+}
+
+void operator delete(void* p) BENCH_NOTHROW
+{
+    free(p);
+}
+
+void operator delete[](void* p) BENCH_NOTHROW
+{
+    free(p);
+}
+
+#if __cplusplus >= 201402L
+// C++14 may release through the sized forms, which must match the above.
+void operator delete(void* p, size_t) BENCH_NOTHROW
+{
+    free(p);
+}
+
+void operator delete[](void* p, size_t) BENCH_NOTHROW
+{
+    free(p);
+}
+#endif
+
+static double getNanos()
+{
+#if defined(WIN32) || defined(_WINDOWS)
+    LARGE_INTEGER count, frequency;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&frequency);
+    return (double) count.QuadPart * 1e9 / (double) frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec * 1e9 + (double) now.tv_nsec;
+#endif
+}
+
+// Results are folded into this so that no read can be optimised away.
+static volatile unsigned long sink = 0;
+
+/**
+ * The model, factory and graph shared by the cases.
+ */
+struct BenchContext
+{
+    explicit BenchContext(const BenchShape& shape)
+        : model(shape)
+    {
+        df = DataFactory::getDataFactory();
+        model.define(df);
+        xmlHelper = HelperProvider::getXMLHelper(df);
+        root = model.build(df);
+        document = xmlHelper->createDocument(root, BenchModel::URI, "root");
+        char* text = xmlHelper->save(document);
+        xml = text;
+        delete[] text;
+        paths = model.getLeafPaths(1000);
+        collect(root, 0);
+    }
+
+    void collect(DataObjectPtr dataObject, unsigned int level)
+    {
+        objects.push_back(dataObject);
+        if (level + 1 < model.getShape().depth)
+        {
+            DataObjectList& items = dataObject->getList("item");
+            for (unsigned int i = 0; i < items.size(); i++)
+            {
+                collect(items[i], level + 1);
+            }
+        }
+    }
+
+    unsigned long getScalarCount() const
+    {
+        return objects.size() * model.getShape().width;
+    }
+
+    BenchModel model;
+    DataFactoryPtr df;
+    XMLHelperPtr xmlHelper;
+    DataObjectPtr root;
+    XMLDocumentPtr document;
+    std::string xml;
+    std::vector<std::string> paths;
+    std::vector<DataObjectPtr> objects;
+};
+
+/**
+ * One benchmark. setUp and tearDown run outside the timed region of each
+ * iteration, run is timed.
+ */
+class BenchCase
+{
+public:
+    explicit BenchCase(BenchContext& c) : ctx(c) {}
+    virtual ~BenchCase() {}
+
+    virtual const char* getName() const = 0;
+
+    /**
+     * The number of operations one iteration performs.
+     */
+    virtual unsigned long getOps() const = 0;
+
+    virtual bool isApplicable() const { return true; }
+    virtual void setUp() {}
+    virtual void run() = 0;
+    virtual void tearDown() {}
+
+protected:
+    BenchContext& ctx;
+};
+
+class DefineSchemaCase : public BenchCase
+{
+public:
+    explicit DefineSchemaCase(BenchContext& c) : BenchCase(c) {}
+    const char* getName() const { return "define_schema"; }
+    unsigned long getOps() const { return 1; }
+    void run()
+    {
+        df = DataFactory::getDataFactory();
+        ctx.model.define(df);
+    }
+    void tearDown() { df = 0; }
+private:
+    DataFactoryPtr df;
+};
+
+class BuildCase : public BenchCase
+{
+public:
+    explicit BuildCase(BenchContext& c) : BenchCase(c) {}
+    const char* getName() const { return "build"; }
+    unsigned long getOps() const { return ctx.objects.size(); }
+    void run() { built = ctx.model.build(ctx.df); }
+    void tearDown() { built = 0; }
+private:
+    DataObjectPtr built;
+};
+
+class TypedGetCase : public BenchCase
+{
+public:
+    explicit TypedGetCase(BenchContext& c) : BenchCase(c) {}
+    const char* getName() const { return "typed_get"; }
+    unsigned long getOps() const { return ctx.getScalarCount(); }
+    void run()
+    {
+        unsigned long total = 0;
+        unsigned int width = ctx.model.getShape().width;
+        for (size_t n = 0; n < ctx.objects.size(); n++)
+        {
+            DataObject* dataObject = ctx.objects[n];
+            for (unsigned int j = 0; j < width; j++)
+            {
+                if (j % 2 == 0)
+                {
+                    total += strlen(dataObject->getCString(j));
+                }
+                else
+                {
+                    total += dataObject->getInteger(j);
+                }
+            }
+        }
+        sink += total;
+    }
+};
+
+class TypedSetCase : public BenchCase
+{
+public:
+    explicit TypedSetCase(BenchContext& c) : BenchCase(c), round(0) {}
+    const char* getName() const { return "typed_set"; }
+    unsigned long getOps() const { return ctx.getScalarCount(); }
+    void setUp()
+    {
+        // Alternate between two values so that every set is a change
+        round++;
+        text = BenchModel::getStringValue(round % 2, 0);
+    }
+    void run()
+    {
+        unsigned int width = ctx.model.getShape().width;
+        for (size_t n = 0; n < ctx.objects.size(); n++)
+        {
+            DataObject* dataObject = ctx.objects[n];
+            for (unsigned int j = 0; j < width; j++)
+            {
+                if (j % 2 == 0)
+                {
+                    dataObject->setCString(j, text);
+                }
+                else
+                {
+                    dataObject->setInteger(j, (long) (round % 2));
+                }
+            }
+        }
+    }
+protected:
+    unsigned long round;
+    std::string text;
+};
+
+class PathGetCase : public BenchCase
+{
+public:
+    explicit PathGetCase(BenchContext& c) : BenchCase(c) {}
+    const char* getName() const { return "path_get"; }
+    unsigned long getOps() const { return ctx.paths.size(); }
+    void run()
+    {
+        unsigned long total = 0;
+        for (size_t i = 0; i < ctx.paths.size(); i++)
+        {
+            total += strlen(ctx.root->getCString(ctx.paths[i]));
+        }
+        sink += total;
+    }
+};
+
+class ListAppendCase : public BenchCase
+{
+public:
+    explicit ListAppendCase(BenchContext& c) : BenchCase(c) {}
+    const char* getName() const { return "list_append"; }
+    unsigned long getOps() const { return ctx.objects.size(); }
+    bool isApplicable() const { return ctx.model.getShape().depth > 1; }
+    void setUp()
+    {
+        target = ctx.df->create(BenchModel::URI, "Node0");
+        for (size_t i = 0; i < ctx.objects.size(); i++)
+        {
+            children.push_back(ctx.df->create(BenchModel::URI, "Node1"));
+        }
+    }
+    void run()
+    {
+        DataObjectList& items = target->getList("item");
+        for (size_t i = 0; i < children.size(); i++)
+        {
+            items.append(children[i]);
+        }
+    }
+    void tearDown()
+    {
+        children.clear();
+        target = 0;
+    }
+private:
+    DataObjectPtr target;
+    std::vector<DataObjectPtr> children;
+};
+
+class LoadCase : public BenchCase
+{
+public:
+    explicit LoadCase(BenchContext& c) : BenchCase(c) {}
+    const char* getName() const { return "load"; }
+    unsigned long getOps() const { return 1; }
+    void run() { loaded = ctx.xmlHelper->load(ctx.xml.c_str()); }
+    void tearDown()
+    {
+        if (ctx.xmlHelper->getErrorCount() > 0)
+        {
+            SDO_THROW_EXCEPTION("load", SDOXMLParserException,
+                                ctx.xmlHelper->getErrorMessage(0));
+        }
+        loaded = 0;
+    }
+private:
+    XMLDocumentPtr loaded;
+};
+
+class SaveCase : public BenchCase
+{
+public:
+    explicit SaveCase(BenchContext& c) : BenchCase(c) {}
+    const char* getName() const { return "save"; }
+    unsigned long getOps() const { return 1; }
+    void run()
+    {
+        char* text = ctx.xmlHelper->save(ctx.document);
+        sink += strlen(text);
+        delete[] text;
+    }
+};
+
+class CopyCase : public BenchCase
+{
+public:
+    explicit CopyCase(BenchContext& c) : BenchCase(c) {}
+    const char* getName() const { return "copy"; }
+    unsigned long getOps() const { return ctx.objects.size(); }
+    void run() { copied = CopyHelper::copy(ctx.root); }
+    void tearDown() { copied = 0; }
+private:
+    DataObjectPtr copied;
+};
+
+class EqualCase : public BenchCase
+{
+public:
+    explicit EqualCase(BenchContext& c) : BenchCase(c) {}
+    const char* getName() const { return "equal"; }
+    unsigned long getOps() const { return ctx.objects.size(); }
+    void setUp()
+    {
+        if (!other)
+        {
+            other = CopyHelper::copy(ctx.root);
+        }
+    }
+    void run()
+    {
+        if (!EqualityHelper::equal(ctx.root, other))
+        {
+            SDO_THROW_EXCEPTION("equal", SDOUnsupportedOperationException,
+                                "the copy of the graph is not equal to it");
+        }
+    }
+private:
+    DataObjectPtr other;
+};
+
+class ChangeLoggingCase : public TypedSetCase
+{
+public:
+    explicit ChangeLoggingCase(BenchContext& c) : TypedSetCase(c) {}
+    const char* getName() const { return "change_logging"; }
+    void run()
+    {
+        ChangeSummaryPtr cs = ctx.root->getChangeSummary();
+        cs->beginLogging();
+        TypedSetCase::run();
+        cs->endLogging();
+    }
+};
+
+class TeardownCase : public BenchCase
+{
+public:
+    explicit TeardownCase(BenchContext& c) : BenchCase(c) {}
+    const char* getName() const { return "teardown"; }
+    unsigned long getOps() const { return ctx.objects.size(); }
+    void setUp() { built = ctx.model.build(ctx.df); }
+    void run() { built = 0; }
+private:
+    DataObjectPtr built;
+};
+
+/**
+ * The measurements of one case.
+ */
+struct BenchResult
+{
+    std::vector<double> nanos;
+    double allocations;
+    double allocatedBytes;
+    double counters[SDOStats::CounterCount];
+};
+
+static double percentile(const std::vector<double>& sorted, double q)
+{
+    size_t i = (size_t) (q * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(i, sorted.size() - 1)];
+}
+
+static void measure(BenchCase& bench, unsigned int warmup, unsigned int iterations,
+                    BenchResult& result)
+{
+    for (unsigned int i = 0; i < warmup; i++)
+    {
+        bench.setUp();
+        bench.run();
+        bench.tearDown();
+    }
+
+    unsigned long allocations = 0;
+    unsigned long bytes = 0;
+    for (int c = 0; c < SDOStats::CounterCount; c++)
+    {
+        result.counters[c] = 0;
+    }
+
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        bench.setUp();
+        SDOStats::reset();
+        unsigned long startCount = allocationCount;
+        unsigned long startBytes = allocationBytes;
+        double start = getNanos();
+
+        bench.run();
+
+        double end = getNanos();
+        allocations += allocationCount - startCount;
+        bytes += allocationBytes - startBytes;
+        for (int c = 0; c < SDOStats::CounterCount; c++)
+        {
+            result.counters[c] += (double) SDOStats::get((SDOStats::Counter) c);
+        }
+        bench.tearDown();
+        result.nanos.push_back(end - start);
+    }
+
+    result.allocations = (double) allocations / iterations;
+    result.allocatedBytes = (double) bytes / iterations;
+    for (int c = 0; c < SDOStats::CounterCount; c++)
+    {
+        result.counters[c] /= iterations;
+    }
+}
+
+static void writeResult(FILE* out, BenchCase& bench, BenchResult& result, bool counters, bool last)
+{
+    std::vector<double> sorted(result.nanos);
+    std::sort(sorted.begin(), sorted.end());
+
+    double total = 0;
+    for (size_t i = 0; i < sorted.size(); i++)
+    {
+        total += sorted[i];
+    }
+    double mean = total / sorted.size();
+    unsigned long ops = bench.getOps();
+
+    fprintf(out, "    {\n");
+    fprintf(out, "      \"name\": \"%s\",\n", bench.getName());
+    fprintf(out, "      \"ops_per_iteration\": %lu,\n", ops);
+    fprintf(out, "      \"iterations\": %lu,\n", (unsigned long) sorted.size());
+    fprintf(out, "      \"mean_ns\": %.0f,\n", mean);
+    fprintf(out, "      \"min_ns\": %.0f,\n", sorted.front());
+    fprintf(out, "      \"p50_ns\": %.0f,\n", percentile(sorted, 0.50));
+    fprintf(out, "      \"p90_ns\": %.0f,\n", percentile(sorted, 0.90));
+    fprintf(out, "      \"p99_ns\": %.0f,\n", percentile(sorted, 0.99));
+    fprintf(out, "      \"max_ns\": %.0f,\n", sorted.back());
+    fprintf(out, "      \"ns_per_op\": %.1f,\n", ops != 0 ? percentile(sorted, 0.50) / ops : 0.0);
+    fprintf(out, "      \"ops_per_sec\": %.0f,\n", mean > 0 ? ops * 1e9 / mean : 0.0);
+    fprintf(out, "      \"allocations_per_iteration\": %.1f,\n", result.allocations);
+    fprintf(out, "      \"allocated_bytes_per_iteration\": %.0f", result.allocatedBytes);
+    if (counters)
+    {
+        fprintf(out, ",\n      \"counters\": {");
+        bool first = true;
+        for (int c = 0; c < SDOStats::CounterCount; c++)
+        {
+            if (result.counters[c] == 0)
+            {
+                continue;
+            }
+            fprintf(out, "%s\n        \"%s\": %.1f", first ? "" : ",",
+                    SDOStats::getName((SDOStats::Counter) c), result.counters[c]);
+            first = false;
+        }
+        fprintf(out, "%s}", first ? "" : "\n      ");
+    }
+    fprintf(out, "\n    }%s\n", last ? "" : ",");
+}
+
+static void usage(const char* program)
+{
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "  --width=N       scalar properties on each type (default 8)\n"
+        "  --depth=N       levels of nesting (default 3)\n"
+        "  --list=N        children in each list (default 10)\n"
+        "  --iterations=N  timed iterations of each case (default 20)\n"
+        "  --warmup=N      untimed iterations before those (default 2)\n"
+        "  --case=A,B,...  run only the named cases\n"
+        "  --counters      also report the SDOStats counters of each case\n"
+        "  --output=FILE   write the JSON to FILE instead of standard output\n",
+        program);
+}
+
+static bool numberOption(const char* arg, const char* name, unsigned int& value)
+{
+    size_t length = strlen(name);
+    if (strncmp(arg, name, length) != 0 || arg[length] != '=')
+    {
+        return false;
+    }
+    value = (unsigned int) strtoul(arg + length + 1, 0, 10);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    BenchShape shape;
+    shape.width = 8;
+    shape.depth = 3;
+    shape.listSize = 10;
+    unsigned int iterations = 20;
+    unsigned int warmup = 2;
+    bool counters = false;
+    std::string only;
+    const char* output = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        if (numberOption(arg, "--width", shape.width) ||
+            numberOption(arg, "--depth", shape.depth) ||
+            numberOption(arg, "--list", shape.listSize) ||
+            numberOption(arg, "--iterations", iterations) ||
+            numberOption(arg, "--warmup", warmup))
+        {
+            continue;
+        }
+        if (strncmp(arg, "--case=", 7) == 0)
+        {
+            only = std::string(",") + (arg + 7) + ",";
+        }
+        else if (strcmp(arg, "--counters") == 0)
+        {
+            counters = true;
+        }
+        else if (strncmp(arg, "--output=", 9) == 0)
+        {
+            output = arg + 9;
+        }
+        else if (strcmp(arg, "--help") == 0)
+        {
+            usage(argv[0]);
+            return 0;
+        }
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if (shape.width == 0 || shape.depth == 0 || iterations == 0)
+    {
+        fprintf(stderr, "%s: width, depth and iterations must be at least 1\n", argv[0]);
+        return 2;
+    }
+
+    FILE* out = stdout;
+    if (output != 0)
+    {
+        out = fopen(output, "w");
+        if (out == 0)
+        {
+            fprintf(stderr, "%s: cannot write %s\n", argv[0], output);
+            return 2;
+        }
+    }
+
+    SDOStats::setEnabled(counters);
+
+    try
+    {
+        BenchContext ctx(shape);
+
+        std::vector<BenchCase*> cases;
+        cases.push_back(new DefineSchemaCase(ctx));
+        cases.push_back(new BuildCase(ctx));
+        cases.push_back(new TypedGetCase(ctx));
+        cases.push_back(new TypedSetCase(ctx));
+        cases.push_back(new PathGetCase(ctx));
+        cases.push_back(new ListAppendCase(ctx));
+        cases.push_back(new LoadCase(ctx));
+        cases.push_back(new SaveCase(ctx));
+        cases.push_back(new CopyCase(ctx));
+        cases.push_back(new EqualCase(ctx));
+        cases.push_back(new ChangeLoggingCase(ctx));
+        cases.push_back(new TeardownCase(ctx));
+
+        std::vector<BenchCase*> selected;
+        for (size_t i = 0; i < cases.size(); i++)
+        {
+            std::string name = std::string(",") + cases[i]->getName() + ",";
+            if (cases[i]->isApplicable() &&
+                (only.empty() || only.find(name) != std::string::npos))
+            {
+                selected.push_back(cases[i]);
+            }
+        }
+
+        fprintf(out, "{\n");
+        fprintf(out, "  \"benchmark\": \"sdo_bench\",\n");
+        fprintf(out, "  \"sdo_version\": \"%s\",\n", SdoRuntime::getVersion());
+        fprintf(out, "  \"shape\": {\"width\": %u, \"depth\": %u, \"list\": %u, \"objects\": %lu, \"xml_bytes\": %lu},\n",
+                shape.width, shape.depth, shape.listSize,
+                shape.getObjectCount(), (unsigned long) ctx.xml.size());
+        fprintf(out, "  \"warmup\": %u,\n", warmup);
+        fprintf(out, "  \"results\": [\n");
+        for (size_t i = 0; i < selected.size(); i++)
+        {
+            BenchResult result;
+            measure(*selected[i], warmup, iterations, result);
+            writeResult(out, *selected[i], result, counters, i + 1 == selected.size());
+            fflush(out);
+        }
+        fprintf(out, "  ]\n");
+        fprintf(out, "}\n");
+
+        for (size_t i = 0; i < cases.size(); i++)
+        {
+            delete cases[i];
+        }
+    }
+    catch (const SDORuntimeException& e)
+    {
+        fprintf(stderr, "%s: %s\n", argv[0], e.getMessageText());
+        return 1;
+    }
+
+    if (out != stdout)
+    {
+        fclose(out);
+    }
+    return 0;
+}
@@ -31,8 +31,11 @@
 #include "commonj/sdo/DataObjectList.h"
 #include "commonj/sdo/SDORuntimeException.h"
 #include "commonj/sdo/Logging.h"
+#include "commonj/sdo/SDOStats.h"
 
 #include <stdlib.h>
+#include <algorithm>
+#include <set>
 
 namespace commonj{
 namespace sdo{
@@ -265,8 +268,7 @@ namespace sdo{
         deleteLogIter = deletedMap.find(ob);
         SettingList& sl = (deleteLogIter->second).getSettings();
 
-         void* value;
-        unsigned int len;
+        SDOValue value;
 
         for (i=0; i < pl.size(); i++) 
         {
@@ -274,7 +276,7 @@ namespace sdo{
 
             if (!ob->isSet(pl[i]))
             { 
-                sl.append(new Setting(false,false, 0,0,pl[i],0));
+                sl.append(Setting(false,false,SDOValue::unsetSDOValue,pl[i],0));
                 continue;
             }
             if (pl[i].isMany())
@@ -285,19 +287,23 @@ namespace sdo{
                 {
                     // needs to be the data object in cases where...
                     if (pl[i].getType().isDataType()) {
-                        setPropValue(&value,&len,ob,pl[j]);
-                        sl.append(new Setting(true,false,value,len,pl[i],j));
+                        setManyPropValue(value,(DataObjectImpl*)(DataObject*)dol[j]);
+                        sl.append(Setting(true,false,value,pl[i],j));
                     }
                     else {
-                        value = (void*)dol[j];
-                        sl.append(new Setting(true,false,value,0,pl[i],j));
+                        sl.append(Setting(true,false,(DataObject*)dol[j],pl[i],j));
                     }
                 }
             }
-            else 
+            else if (pl[i].getType().isDataType())
             {
-                setPropValue(&value,&len,ob,pl[i]);
-                sl.append(new Setting(true,ob->isNull(pl[i]),value,len,pl[i],0));
+                setPropValue(value,ob,pl[i]);
+                sl.append(Setting(true,ob->isNull(pl[i]),value,pl[i],0));
+            }
+            else
+            {
+                sl.append(Setting(true,ob->isNull(pl[i]),
+                                  (DataObject*)ob->getDataObject(pl[i]),pl[i],0));
             }
 
         }
@@ -327,8 +333,7 @@ namespace sdo{
                     {
                     // these are settings of the same prop/index, we
                     // need the old value to get transferred.
-                        sl.remove(i);
-                        sl.insert(i,new Setting(*(slist.get(j))));
+                        *(sl.get(i)) = *(slist.get(j));
                   
                     }
                 }
@@ -342,6 +347,7 @@ namespace sdo{
         // deleted or created.
         else 
         {
+            SDOStats::add(SDOStats::ChangeSummaryEntries);
             changedDataObjects.append(ob, ChangedDataObjectList::Delete);
         }
         
@@ -422,6 +428,7 @@ namespace sdo{
         // those data objects which have been affected - we then look at their
         // current and old property values to find out whether they have been
         // deleted or created.
+        SDOStats::add(SDOStats::ChangeSummaryEntries);
         changedDataObjects.append(ob, ChangedDataObjectList::Create);
 
         createdMap.insert(std::make_pair(ob,createLogItem(ob->getType(),prop,container)));
@@ -429,325 +436,24 @@ namespace sdo{
     }
 
 
-    void ChangeSummaryImpl::setPropValue(void** value, unsigned int* len, DataObjectImpl* ob, const Property& prop)
+    // The old value is copied as it is held by the data object, so nothing
+    // is allocated for primitive values and nothing is converted until it
+    // is read.
+    void ChangeSummaryImpl::setPropValue(SDOValue& value, DataObjectImpl* ob, const Property& prop)
     {
-
-		*len = 0;
-        switch (prop.getTypeEnum())
+        if (!ob->isSet(prop))
         {
-            case Type::BooleanType:
-                *value = new long;
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *(long*)value = 0; 
-                }
-                else
-                {
-                    *(long*)*value = (long)ob->getBoolean(prop);
-                }
-                break;
-            case Type::ByteType:
-                *value = new long;
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *(long*)value = 0; 
-                }
-                else
-                {
-                    *(long*)*value = (long)ob->getByte(prop);
-                }
-                break;
-            case Type::CharacterType:
-                *value = new long;
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *(long*)value = 0; 
-                }
-                else
-                {
-                    *(long*)*value = (long)ob->getCharacter(prop);
-                }
-                break;
-            case Type::IntegerType: 
-                *value = new long;
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *(long*)value = 0; 
-                }
-                else
-                {
-                    *(long*)*value = (long)ob->getInteger(prop);
-                }
-                break;
-            case Type::ShortType:
-                *value = new long;
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *(long*)value = 0; 
-                }
-                else
-                {
-                    *(long*)*value = (long)ob->getShort(prop);
-                }
-                break;
-            case Type::DoubleType:
-                *value = new long double;
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *(long double*)value = (long double)0; 
-                }
-                else
-                {
-                    *(long double*)*value = (long double)ob->getDouble(prop);
-                }
-                break;
-            case Type::FloatType:
-                *value = new float;
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *(float*)value = (float)0; 
-                }
-                else
-                {
-                    *(float*)*value = (float)ob->getFloat(prop);
-                }
-                break;
-            case Type::LongType:
-                *value = new int64_t;
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *(int64_t*)value = (int64_t)0; 
-                }
-                else
-                {
-                    *(int64_t*)*value = (int64_t)ob->getLong(prop);
-                }
-                break;
-            case Type::DateType:
-                *value = new long;
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *(long*)value = (long)0; 
-                }
-                else
-                {
-                    *(long*)*value = (long)(ob->getDate(prop).getTime());
-                }
-                break;
-            case Type::BigDecimalType: 
-            case Type::BigIntegerType: 
-            case Type::StringType: 
-            case Type::UriType:
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *value = 0;
-                    *len = 0;
-                }
-                else
-                {
-                    unsigned int siz = ob->getLength(prop);
-                    if (siz > 0) {
-                        *value = new wchar_t[siz];
-                        *len = ob->getString(prop,(wchar_t*)*value, siz);
-                    }    
-                    else {
-                        *value = 0;
-                        *len = 0;
-                    }
-                }
-                break;
-            case Type::BytesType:
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *value = 0;
-                    *len = 0;
-                }
-                else
-                {
-                    unsigned int siz = ob->getLength(prop);
-                    if (siz > 0) {
-                        *value = new char[siz];
-                        *len = ob->getBytes(prop,(char*)*value, siz);
-                    }
-                    else {
-                        *value = 0;
-                        *len = 0;
-                    }
-                }
-                break;
-            case Type::OtherTypes:
-            case Type::DataObjectType:
-            case Type::ChangeSummaryType:
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *value = 0; 
-                }
-                else
-                {
-                    *value = (void*)ob->getDataObject(prop);
-                }
-                break;
-            default:
-                SDO_THROW_EXCEPTION("(ChangeSummary)setPropValue" ,
-                SDOUnsupportedOperationException, "Type is not recognised and cannot be saved");
-                break;
+            value = SDOValue::unsetSDOValue;
+            return;
         }
+        PropertyImpl* propertyForDefault = 0;
+        value = ob->getSDOValue(prop, &propertyForDefault);
     }
 
-    void ChangeSummaryImpl::setManyPropValue(void** value, unsigned int *len, DataObjectImpl* ob, 
-                                                DataObjectImpl* listob, const Property& prop)
+    void ChangeSummaryImpl::setManyPropValue(SDOValue& value, DataObjectImpl* listob)
     {
-
-		*len = 0;
-        switch (prop.getTypeEnum())
-        {
-            case Type::BooleanType:
-                *value = new long;
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *(long*)value = (long)0; 
-                }
-                else
-                {
-                    *(long*)*value = (long)listob->getBoolean();
-                }
-                break;
-            case Type::ByteType:
-                *value = new long;
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *(long*)value = (long)0; 
-                }
-                else
-                {
-                    *(long*)*value = (long)listob->getByte();
-                }
-                break;
-            case Type::CharacterType:
-                *value = new long;
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *(long*)value = (long)0; 
-                }
-                else
-                {
-                    *(long*)*value = (long)listob->getCharacter();
-                }
-                break;
-            case Type::IntegerType: 
-                *value = new long;
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *(long*)value = (long)0; 
-                }
-                else
-                {
-                    *(long*)*value = (long)listob->getInteger();
-                }
-                break;
-            case Type::ShortType:
-                *value = new long;
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *(long*)value = (long)0; 
-                }
-                else
-                {
-                    *(long*)*value = (long)listob->getShort();
-                }
-                break;
-            case Type::DoubleType:
-                *value = new long double;
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *(long double*)value = (long double)0; 
-                }
-                else
-                {
-                    *(long double*)*value = (long double)listob->getDouble();
-                }
-                break;
-            case Type::FloatType:
-                *value = new float;
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *(float*)value = (float)0; 
-                }
-                else
-                {
-                    *(float*)*value = (float)listob->getFloat();
-                }
-                break;
-            case Type::LongType:
-                *value = new int64_t;
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *(int64_t*)value = (int64_t)0; 
-                }
-                else
-                {
-                    *(int64_t*)*value = (int64_t)listob->getLong();
-                }
-                break;
-            case Type::DateType:
-                *value = new long;
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *(long*)value = (long)0; 
-                }
-                else
-                {
-                    *(long*)*value = (long)(listob->getDate().getTime());
-                }
-                break;
-            case Type::BigDecimalType: 
-            case Type::BigIntegerType: 
-            case Type::StringType: 
-            case Type::UriType:
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *value = 0;
-                    *len = 0; 
-                }
-                else
-                {
-                    unsigned int siz = listob->getLength(prop);
-                    if (siz > 0) 
-                    {
-                        *value = new wchar_t[siz];
-                        *len = listob->getString((wchar_t*)*value, siz);
-                    }
-                }
-                break;
-            case Type::BytesType:
-                if (!ob->isSet(prop) && !prop.isDefaulted())
-                {
-                    *value = 0;
-                    *len = 0; 
-                }
-                else
-                {
-                    unsigned int siz = listob->getLength(prop);
-                    if (siz > 0) 
-                    {
-                        *value = new char[siz];
-                        *len = listob->getBytes((char*)*value, siz);
-                    }
-                }
-                break;
-
-            case Type::OtherTypes:
-            case Type::DataObjectType:
-            case Type::ChangeSummaryType:
-                SDO_THROW_EXCEPTION("(ChangeSummary)setManyPropValue" ,
-                SDOUnsupportedOperationException, "A many prop data object value is being set");
-                //*value = (void*)ob;
-                break;
-            default:
-                SDO_THROW_EXCEPTION("(ChangeSummary)setManyPropValue" ,
-                SDOUnsupportedOperationException, "Type is not recognised and cannot be saved");
-                break;
-        }
+        PropertyImpl* propertyForDefault = 0;
+        value = listob->getSDOValue(&propertyForDefault);
     }
 
     void ChangeSummaryImpl::logChange(DataObjectImpl* ob,
@@ -761,8 +467,6 @@ namespace sdo{
 
         CREATELOG_MAP::iterator createLogIter;
 
-        unsigned int len;
-
         createLogIter = createdMap.find(ob);
         if (createLogIter != createdMap.end())
         {
@@ -787,6 +491,7 @@ namespace sdo{
             LOGINFO(INFO,"ChangeSummary: A change to an object which was not previously changed");
             changedMap.insert(std::make_pair(ob, changeLogItem(ob->getType(),prop, 
                               ob->getSequence(), ob)));
+            SDOStats::add(SDOStats::ChangeSummaryEntries);
             changedDataObjects.append(ob, ChangedDataObjectList::Change);
         }
         else 
@@ -803,7 +508,7 @@ namespace sdo{
 
         SettingList& slist = (changeLogIter->second).getSettings();
     
-        void* value;
+        SDOValue value;
 
         for (int i=0;i<slist.size();i++)
         {
@@ -820,7 +525,7 @@ namespace sdo{
 
         if (!ob->isSet(prop))
         { 
-            slist.append(new Setting(false,false,0,0,prop,0));
+            slist.append(Setting(false,false,SDOValue::unsetSDOValue,prop,0));
             return;
         }
 
@@ -834,27 +539,30 @@ namespace sdo{
             DataObjectList& dol = ob->getList(prop);
             if (dol.size() == 0)
             {
-                slist.append(new Setting(false,false,0,0,prop,0));
+                slist.append(Setting(false,false,SDOValue::unsetSDOValue,prop,0));
                 return;
             }
             for (unsigned int i=0;i< dol.size(); i++)
             {
                 DataObject* dob = dol[i];
                 if (prop.getType().isDataType()) {
-                    setManyPropValue(&value, &len, (DataObjectImpl*)ob,
-                        (DataObjectImpl*)dob, prop);
-                    slist.append(new Setting(true,false,value,len,prop,i));
+                    setManyPropValue(value, (DataObjectImpl*)dob);
+                    slist.append(Setting(true,false,value,prop,i));
                 }
                 else{
-                    value = (void*)dob;
-                    slist.append(new Setting(true,false,value,0,prop,i));
+                    slist.append(Setting(true,false,dob,prop,i));
                 }
             }
         }
+        else if (prop.getType().isDataType())
+        {
+            setPropValue(value,ob,prop);
+            slist.append(Setting(true,ob->isNull(prop),value,prop,0));
+        }
         else 
         {
-            setPropValue(&value,&len,ob,prop);
-            slist.append(new Setting(true,ob->isNull(prop),value,len,prop,0));
+            slist.append(Setting(true,ob->isNull(prop),
+                                 (DataObject*)ob->getDataObject(prop),prop,0));
         }
 
         return;
@@ -1056,6 +764,101 @@ namespace sdo{
 
     }
 
+    // The number of containers above the object. A deleted object no
+    // longer has a container, so its old one is used instead.
+    unsigned int ChangeSummaryImpl::getChangeDepth(DataObjectImpl* ob)
+    {
+        unsigned int depth = 0;
+        while (ob != 0)
+        {
+            DataObjectImpl* container;
+            DELETELOG_MAP::iterator deleteLogIter = deletedMap.find(ob);
+            if (deleteLogIter != deletedMap.end())
+            {
+                container = (deleteLogIter->second).getOldContainer();
+            }
+            else
+            {
+                container = ob->getContainerImpl();
+            }
+            if (container == 0)
+            {
+                break;
+            }
+            depth++;
+            ob = container;
+        }
+        return depth;
+    }
+
+    static bool outermostFirst(const changePlanItem& a, const changePlanItem& b)
+    {
+        return a.depth < b.depth;
+    }
+
+    static bool innermostFirst(const changePlanItem& a, const changePlanItem& b)
+    {
+        return a.depth > b.depth;
+    }
+
+    void ChangeSummaryImpl::getChangePlan(CHANGE_PLAN& plan)
+    {
+        CHANGE_PLAN creations;
+        CHANGE_PLAN deletions;
+        std::set<DataObjectImpl*> seen;
+
+        plan.clear();
+
+        for (unsigned int i = 0; i < changedDataObjects.size(); i++)
+        {
+            DataObjectImpl* ob = (DataObjectImpl*) changedDataObjects.get(i);
+
+            // An object may be logged more than once, for example when it
+            // is modified and then deleted.
+            if (!seen.insert(ob).second)
+            {
+                continue;
+            }
+
+            changePlanItem item;
+            item.object = ob;
+            item.depth = getChangeDepth(ob);
+            item.oldValues = 0;
+
+            if (createdMap.find(ob) != createdMap.end())
+            {
+                item.changeType = ChangedDataObjectList::Create;
+                creations.push_back(item);
+                continue;
+            }
+
+            DELETELOG_MAP::iterator deleteLogIter = deletedMap.find(ob);
+            if (deleteLogIter != deletedMap.end())
+            {
+                item.changeType = ChangedDataObjectList::Delete;
+                item.oldValues = &(deleteLogIter->second).getSettings();
+                deletions.push_back(item);
+                continue;
+            }
+
+            CHANGELOG_MAP::iterator changeLogIter = changedMap.find(ob);
+            if (changeLogIter != changedMap.end())
+            {
+                item.changeType = ChangedDataObjectList::Change;
+                item.oldValues = &(changeLogIter->second).getSettings();
+                plan.push_back(item);
+            }
+        }
+
+        std::stable_sort(creations.begin(), creations.end(), outermostFirst);
+        std::stable_sort(deletions.begin(), deletions.end(), innermostFirst);
+
+        // Deletions go first, so that a row can be deleted and a new one
+        // with the same key created in the same set of changes.
+        plan.insert(plan.begin(), creations.begin(), creations.end());
+        plan.insert(plan.begin(), deletions.begin(), deletions.end());
+    }
+
     bool ChangeSummaryImpl::isCreated(DataObjectPtr dol)
     {
         CREATELOG_MAP::iterator createLogIter;
@@ -1218,84 +1021,61 @@ namespace sdo{
     }
 
 
-    unsigned int ChangeSummaryImpl::stringConvert(char** value, const char* c, const Property& p)
+    void ChangeSummaryImpl::stringConvert(SDOValue& value, const char* c, const Property& p)
     {
-    // code duplicated from typeimpl
     switch (p.getTypeEnum())
         {
         case Type::BooleanType:
-            *value = new char[sizeof(long)];
-            if ((c == 0) || strcmp(c,"true"))
-            {
-                *(long*)*value = 0;
-            }
-            else 
-            {
-                *(long*)*value = 1;
-            }
-            return sizeof(long);
+            value = SDOValue((bool)((c != 0) && !strcmp(c,"true")));
+            return;
 
         case Type::ByteType:
+            value = SDOValue((char)atoi(c));
+            return;
+
         case Type::CharacterType: 
+            value = SDOValue((wchar_t)atoi(c));
+            return;
+
         case Type::IntegerType: 
+            value = SDOValue((long)atoi(c));
+            return;
+
         case Type::ShortType:
-            *value = new char[sizeof(long)];
-              *(long*)*value = atoi(c);
-            return sizeof(long);
+            value = SDOValue((short)atoi(c));
+            return;
 
         case Type::DoubleType:
-            *value = new char[sizeof(long double)];
             // TODO - atof not suitable here
-            *(long double*)*value = (long double)atof(c);
-            return sizeof(long double);
+            value = SDOValue((long double)atof(c));
+            return;
 
         case Type::FloatType:    
-            *value = new char[sizeof(float)];
-            *(float*)*value = (float)atof(c);
-            return sizeof(float);
+            value = SDOValue((float)atof(c));
+            return;
 
         case Type::LongType:   
-            *value = new char[sizeof(int64_t)];
 #if defined(WIN32)  || defined (_WINDOWS)
-            *(int64_t*)*value = (int64_t)_atoi64(c);
+            value = SDOValue((int64_t)_atoi64(c));
 #else 
-            *(int64_t*)*value = (int64_t)strtoll(c, NULL, 0);
+            value = SDOValue((int64_t)strtoll(c, NULL, 0));
 #endif
-            return sizeof(int64_t);
+            return;
 
         case Type::DateType:
-            *value = new char[sizeof(time_t)];
-            *(time_t*)*value = (time_t)atoi(c);
-            return sizeof(time_t);
+            value = SDOValue(SDODate((time_t)atoi(c)));
+            return;
             
         case Type::BigDecimalType: 
         case Type::BigIntegerType: 
         case Type::StringType:    
         case Type::UriType:
-            {
-                char* vw = new char[(strlen(c)+1)*sizeof(wchar_t)];                
-                wchar_t* pvw = (wchar_t*)vw;
-                for (unsigned int i=0;i< strlen(c);i++)
-                {
-                    pvw[i] = (wchar_t)c[i];
-                }
-                pvw[strlen(c)] = 0;
-                *value = vw;
-                return strlen(c);
-            }
-            break;
+            value = SDOValue(c);
+            return;
+
         case Type::BytesType:
-            {
-                char* vc = new char[strlen(c)+1];
-                for (unsigned int i=0;i< strlen(c);i++)
-                {
-                    vc[i] =  (char)c[i];
-                }
-                vc[strlen(c)] = 0;
-                *value = vc;
-                return strlen(c);
-            }
-            break;
+            value = SDOValue(c, strlen(c));
+            return;
              
         case Type::OtherTypes:
         case Type::DataObjectType: 
@@ -1309,7 +1089,6 @@ namespace sdo{
             break;
             }
         }
-        return 0;
     }
 
     void ChangeSummaryImpl::appendToChanges(const Property& p, 
@@ -1331,6 +1110,7 @@ namespace sdo{
             changedMap.insert(std::make_pair((DataObjectImpl*)pdob, 
                               changeLogItem(dob->getType(),p, 
                               dob->getSequence(), (DataObjectImpl*)pdob)));
+            SDOStats::add(SDOStats::ChangeSummaryEntries);
             changedDataObjects.append((DataObjectImpl*)pdob, 
                                        ChangedDataObjectList::Change);
         }
@@ -1349,13 +1129,11 @@ namespace sdo{
         // simply need to insert a setting - no requirement to validate
         // against existing settings
 
-        char* datavalue = 0;
+        SDOValue datavalue;
 
-        unsigned int len = stringConvert(&datavalue, (const char*)value , p);
+        stringConvert(datavalue, (const char*)value , p);
 
-        slist.append(new Setting(true,false,datavalue,len,p,index));
-        
-        // The datavalue will be freed by the deletion of the setting later
+        slist.append(Setting(true,false,datavalue,p,index));
      }
 
 
@@ -1376,6 +1154,7 @@ namespace sdo{
             changedMap.insert(std::make_pair((DataObjectImpl*)pdob, 
                               changeLogItem(dob->getType(),p, 
                               dob->getSequence(), (DataObjectImpl*)pdob)));
+            SDOStats::add(SDOStats::ChangeSummaryEntries);
             changedDataObjects.append((DataObjectImpl*)pdob, 
                                        ChangedDataObjectList::Change);
         }
@@ -1394,10 +1173,86 @@ namespace sdo{
         // against existing settings
 
 
-        slist.append(new Setting(true,false,(void*)indob,0,p,index));
-    
+        slist.append(Setting(true,false,(DataObject*)indob,p,index));
+
      }
 
+    bool ChangeSummaryImpl::getCreation(DataObjectImpl* ob,
+        DataObjectImpl*& container, const Property*& prop)
+    {
+        CREATELOG_MAP::iterator createLogIter = createdMap.find(ob);
+        if (createLogIter == createdMap.end())
+        {
+            return false;
+        }
+        container = (createLogIter->second).getOldContainer();
+        prop = &(createLogIter->second).getOldContainmentProperty();
+        return true;
+    }
+
+    bool ChangeSummaryImpl::getDeletion(DataObjectImpl* ob,
+        DataObjectImpl*& container, const Property*& prop,
+        const char*& oldpath, SettingList*& oldValues)
+    {
+        DELETELOG_MAP::iterator deleteLogIter = deletedMap.find(ob);
+        if (deleteLogIter == deletedMap.end())
+        {
+            return false;
+        }
+        container = (deleteLogIter->second).getOldContainer();
+        prop = &(deleteLogIter->second).getOldContainmentProperty();
+        oldpath = (deleteLogIter->second).getOldXpath();
+        oldValues = &(deleteLogIter->second).getSettings();
+        return true;
+    }
+
+    bool ChangeSummaryImpl::getChange(DataObjectImpl* ob,
+        const Property*& prop, SettingList*& oldValues)
+    {
+        CHANGELOG_MAP::iterator changeLogIter = changedMap.find(ob);
+        if (changeLogIter == changedMap.end())
+        {
+            return false;
+        }
+        prop = &(changeLogIter->second).getOldContainmentProperty();
+        oldValues = &(changeLogIter->second).getSettings();
+        return true;
+    }
+
+    void ChangeSummaryImpl::restoreEntry(DataObjectImpl* ob,
+        ChangedDataObjectList::ChangeType type)
+    {
+        SDOStats::add(SDOStats::ChangeSummaryEntries);
+        changedDataObjects.append(ob, type);
+    }
+
+    void ChangeSummaryImpl::restoreCreation(DataObjectImpl* ob,
+        DataObjectImpl* container, const Property& prop)
+    {
+        createdMap.insert(std::make_pair(ob,
+            createLogItem(ob->getType(), prop, container)));
+    }
+
+    SettingList& ChangeSummaryImpl::restoreDeletion(DataObjectImpl* ob,
+        DataObjectImpl* container, const Property& prop, const char* oldpath)
+    {
+        DELETELOG_MAP::iterator deleteLogIter = deletedMap.insert(
+            std::make_pair(ob, deleteLogItem((DataObject*)ob, prop,
+                                             ob->getSequence(), oldpath,
+                                             container))).first;
+        return (deleteLogIter->second).getSettings();
+    }
+
+    SettingList& ChangeSummaryImpl::restoreChange(DataObjectImpl* ob,
+        const Property& prop)
+    {
+        // As logged, the object stands as its own old container
+        CHANGELOG_MAP::iterator changeLogIter = changedMap.insert(
+            std::make_pair(ob, changeLogItem(ob->getType(), prop,
+                                             ob->getSequence(), ob))).first;
+        return (changeLogIter->second).getSettings();
+    }
+
 
 
     
@@ -32,6 +32,7 @@
 #include "commonj/sdo/SDOXMLString.h"
 
 #include <map>
+#include <vector>
 
 namespace commonj{
 namespace sdo {
@@ -147,6 +148,29 @@ namespace sdo {
     };
 
 
+    /** 
+     * changePlanItem is one entry in the plan given by
+     * ChangeSummaryImpl::getChangePlan().
+     *
+     * The depth is the number of containers above the object, or above its
+     * old container for a deletion. The old values are those of the
+     * properties which changed, or of all the properties of a deleted
+     * object, and are owned by the change summary; there are none for a
+     * creation.
+     */
+
+    class changePlanItem {
+
+    public:
+
+        ChangedDataObjectList::ChangeType changeType;
+        DataObjectImpl* object;
+        unsigned int depth;
+        SettingList* oldValues;
+    };
+
+    typedef std::vector<changePlanItem> CHANGE_PLAN;
+
     /** ChangeSummaryImpl implements the abstract class ChangeSummary.
      * The change summary consisists of change items, 
      * deletion items and creation items. They are held in three
@@ -310,6 +334,18 @@ namespace sdo {
 
     virtual SDO_API SequencePtr getOldSequence(DataObjectPtr dataObject);
 
+    /**  getChangePlan() - the changes in the order they should be applied.
+     *
+     * Fills the plan with an entry for each changed data object: the
+     * deletions first, innermost first, then the creations, outermost
+     * first so that a container is always created before the objects in
+     * it, and then the modifications in the order they were logged.
+     * An object which was created is a creation whatever else happened
+     * to it, and one which was deleted is a deletion.
+     * The plan is only valid until the change summary next changes.
+     */
+    SDO_API void getChangePlan(CHANGE_PLAN& plan);
+
     bool isInCreatedMap(DataObjectImpl* ob);
 
     void logDeletion(DataObjectImpl* ob,
@@ -353,8 +389,8 @@ namespace sdo {
                             const char* oldpath);
 
 
-    unsigned int stringConvert(
-                            char** value, 
+    void stringConvert(
+                            SDOValue& value, 
                             const char* c, 
                             const Property& p);
 
@@ -376,13 +412,52 @@ namespace sdo {
 
     DataObjectPtr matchDeletedObject(SDOXMLString path);
 
+    /**
+    * getCreation, getDeletion and getChange give what the log holds for
+    * an object, so that the log can be saved. Each returns false if the
+    * object is not in that part of the log.
+    */
+    bool getCreation(DataObjectImpl* ob,
+                     DataObjectImpl*& container,
+                     const Property*& prop);
+
+    bool getDeletion(DataObjectImpl* ob,
+                     DataObjectImpl*& container,
+                     const Property*& prop,
+                     const char*& oldpath,
+                     SettingList*& oldValues);
+
+    bool getChange(DataObjectImpl* ob,
+                   const Property*& prop,
+                   SettingList*& oldValues);
+
+    /**
+    * The restore methods rebuild a saved log as it was, entry by entry,
+    * without logging anything or looking at the current values. The
+    * settings of a deletion or change are appended to the list returned.
+    */
+    void restoreEntry(DataObjectImpl* ob,
+                      ChangedDataObjectList::ChangeType type);
+
+    void restoreCreation(DataObjectImpl* ob,
+                         DataObjectImpl* container,
+                         const Property& prop);
+
+    SettingList& restoreDeletion(DataObjectImpl* ob,
+                                 DataObjectImpl* container,
+                                 const Property& prop,
+                                 const char* oldpath);
+
+    SettingList& restoreChange(DataObjectImpl* ob,
+                               const Property& prop);
+
 
     private:
 
 
-        void setPropValue(void** value, unsigned int *len, DataObjectImpl* ob, const Property& prop);
-        void setManyPropValue(void** value, unsigned int *len, DataObjectImpl* ob, 
-            DataObjectImpl* listob, const Property& prop);
+        unsigned int getChangeDepth(DataObjectImpl* ob);
+        void setPropValue(SDOValue& value, DataObjectImpl* ob, const Property& prop);
+        void setManyPropValue(SDOValue& value, DataObjectImpl* listob);
         bool logging;
 
         typedef std::map<DataObjectImpl*, createLogItem>    CREATELOG_MAP;
@@ -299,8 +299,24 @@ namespace sdo{
      */
     DataObjectPtr CopyHelper::copy(DataObjectPtr dataObject)
     {
-        DataObjectPtr newob = internalCopy(dataObject, true);
-        resolveReferences(dataObject, newob);
+        DataObject* theob = dataObject;
+        if (!theob) return 0;
+
+        DataObjectImpl* from = (DataObjectImpl*)theob;
+        if (!from->getDataFactory()) return 0;
+
+        // Each object's values are copied as they are held, recording the
+        // copy of every object on the way. References are then set once
+        // the whole tree exists, by looking their targets up among the
+        // copies. A reference to an object outside the copied tree is
+        // left unset.
+        ClonedObjects copies;
+        DataObjectPtr newob = from->cloneTree(copies);
+
+        for (unsigned int i = 0; i < copies.size(); i++)
+        {
+            copies.getOriginal(i)->cloneReferences(copies.getCopy(i), copies);
+        }
         return newob;
     }
 
@@ -467,131 +483,6 @@ namespace sdo{
         return newob;
     }
 
-    void CopyHelper::resolveReferences(DataObjectPtr oldDO, DataObjectPtr newDO)
-    {
-        // Iterate through the properties to find references.
-        // If the reference is to a DataObject with the copied tree then we can
-        // set it to reference the DO in the new tree, otherwise it is left unset.
-
-        findReferences(oldDO, newDO, oldDO, newDO);
-
-    }
-
-    void CopyHelper::findReferences(DataObjectPtr oldDO, DataObjectPtr newDO,
-        DataObjectPtr obj, DataObjectPtr newObj)
-    {
-		if (!obj) return;
-
-        if ( obj->getType().isSequencedType() )
-        {
-            Sequence* fromSequence = obj->getSequence();
-            int sequence_length = fromSequence->size();
-
-            Sequence* toSequence = newObj->getSequence();
-
-            for (int i=0;i < sequence_length; i++)
-            {
-                if (!fromSequence->isText(i) )
-                {
-                    const Property& seqProperty = fromSequence->getProperty(i);
-                    SDOXMLString seqPropertyName = seqProperty.getName();
-                    const Type& seqPropertyType = seqProperty.getType();
-
-                    if (seqProperty.isReference())
-                    {
-                        DataObjectPtr ref = findReference(oldDO, newDO, fromSequence->getDataObjectValue(i));
-                        if (ref)
-                        {
-                            if (seqProperty.isMany())
-                            {
-                                int index = fromSequence->getListIndex(i);
-                                newObj->getList(seqProperty).setDataObject(index, ref);
-                            }
-                            else
-                            {
-                                toSequence->setDataObjectValue(i, ref);
-                            }
-
-                        }
-                    }
-                    else if (seqPropertyType.isDataObjectType())
-                    {
-                        findReferences(oldDO, newDO, fromSequence->getDataObjectValue(i), toSequence->getDataObjectValue(i));
-                    }
-                }
-
-             } // for all elements in sequence
-
-        }
-        else
-        {
-            PropertyList pl = obj->getInstanceProperties();
-            for (unsigned int i=0;i < pl.size(); i++)
-            {
-                if (!obj->isSet(pl[i]))
-                    continue;
-
-                if (!pl[i].getType().isDataObjectType())
-                    continue;
-
-                if (pl[i].isMany())
-                {
-                    DataObjectList& dolold = obj->getList(pl[i]);
-                    DataObjectList& dolnew = newObj->getList(pl[i]);
-                    for (unsigned int li=0;li< dolold.size(); li++)
-                    {
-                        if (pl[i].isReference())
-                        {
-                            DataObjectPtr ref = findReference(oldDO, newDO, dolold[li]);
-                            if (ref)
-                            {
-                                dolnew.setDataObject(li, ref);
-                            }
-                        }
-                        else
-                        {
-                            findReferences(oldDO, newDO, dolold[li], dolnew[li]);
-                        }
-                    }
-                }
-                else
-                {
-                    if (pl[i].isReference())
-                    {
-                        DataObjectPtr ref = findReference(oldDO, newDO,  obj->getDataObject(pl[i]));
-                        if (ref)
-                        {
-                            newObj->setDataObject(pl[i], ref);
-                        }
-                    }
-                    else
-                    {
-                        findReferences(oldDO, newDO, obj->getDataObject(pl[i]), newObj->getDataObject(pl[i]));
-                    }
-                }
-            }
-        }
-    }
-
-    DataObjectPtr CopyHelper::findReference(DataObjectPtr oldDO, DataObjectPtr newDO, DataObjectPtr ref)
-    {
-        SDOString rootXPath = oldDO->objectToXPath();
-        SDOString refXPath = ref->objectToXPath();
-
-        DataObjectPtr newRef;
-        if (refXPath.find(refXPath) == 0)
-        {
-            SDOString relXPath = refXPath.substr(rootXPath.length());
-            if (relXPath == "")
-                newRef = newDO;
-            if (relXPath.find("/") == 0)
-                relXPath = relXPath.substr(1);
-            newRef = newDO->getDataObject(relXPath);
-        }
-
-        return newRef;
-    }
-
 
 }
 };
@@ -800,6 +800,27 @@ class DataFactory : public RefCountingObject
 
         virtual void resolve() = 0;
 
+        /**
+         *  DataFactory::freeze makes the types of this factory immutable.
+         *
+         * The types are resolved and given compact lookup tables. Any
+         * later attempt to change them throws SDOUnsupportedOperationException.
+         * A frozen factory can be shared between requests or threads by
+         * handing each of them a view.
+         */
+        SDO_API virtual void freeze() = 0;
+        SDO_API virtual bool isFrozen() const = 0;
+
+        /**
+         *  DataFactory::createView creates a lightweight factory over a
+         *  frozen one.
+         *
+         * The view shares the frozen types, so creating one costs next to
+         * nothing, while open properties defined through it are kept apart
+         * from every other view. The factory is frozen first if necessary.
+         */
+        SDO_API virtual DataFactoryPtr createView() = 0;
+
     };
 };
 };
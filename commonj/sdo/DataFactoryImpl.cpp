@@ -27,6 +27,7 @@
 
 #include "commonj/sdo/DataFactoryImpl.h"
 #include "commonj/sdo/DataObjectImpl.h"
+#include "commonj/sdo/SDOAtomic.h"
 
 #include "commonj/sdo/Logger.h"
 
@@ -48,6 +49,7 @@ namespace sdo {
 // Constructor
 // ===================================================================
 DataFactoryImpl::DataFactoryImpl()
+    : frozen(false), modelImpl(0)
 {
 
     /* add the primitives to every mdg - */
@@ -82,6 +84,11 @@ DataFactoryImpl::DataFactoryImpl()
 // ===================================================================
 DataFactoryImpl::~DataFactoryImpl()
 {
+    // A view frees no types, so pointers to them are still good
+    if (modelImpl == 0)
+    {
+        SDO_ATOMIC_INCREMENT(&releaseCount);
+    }
 
    resolvePending.clear();
    
@@ -95,15 +102,32 @@ DataFactoryImpl::~DataFactoryImpl()
     }
 }
 
+long DataFactoryImpl::releaseCount = 0;
+
+unsigned int DataFactoryImpl::getReleaseCount()
+{
+    return (unsigned int) releaseCount;
+}
+
 // ===================================================================
 // copy constructor
 // ===================================================================
 DataFactoryImpl::DataFactoryImpl(const DataFactoryImpl& inmdg)
+    : frozen(false), modelImpl(0)
 {
     isResolved = false;
     copyTypes(inmdg);
 }
 
+// ===================================================================
+// view constructor - shares the types of a frozen factory
+// ===================================================================
+DataFactoryImpl::DataFactoryImpl(DataFactoryImpl* frozenModel)
+    : frozen(true), model(frozenModel), modelImpl(frozenModel)
+{
+    isResolved = true;
+}
+
 // ===================================================================
 // Assignment operator
 // ===================================================================
@@ -111,6 +135,7 @@ DataFactoryImpl& DataFactoryImpl::operator=(const DataFactoryImpl& inmdg)
 {
     if (this != &inmdg)
     {
+        // The types are added to those already here, none is freed
         copyTypes(inmdg);
     }
     return *this;
@@ -119,8 +144,10 @@ DataFactoryImpl& DataFactoryImpl::operator=(const DataFactoryImpl& inmdg)
 // ===================================================================
 // copy Types to this DataFactory
 // ===================================================================
-void DataFactoryImpl::copyTypes(const DataFactoryImpl& inmdg)
+void DataFactoryImpl::copyTypes(const DataFactoryImpl& from)
 {
+    // A view holds no types of its own
+    const DataFactoryImpl& inmdg = *from.getModel();
 
 
     TYPES_MAP::const_iterator typeIter;
@@ -151,7 +178,7 @@ void DataFactoryImpl::copyTypes(const DataFactoryImpl& inmdg)
 
         
         // Now add all the properties
-        const std::list<PropertyImpl*> props = typeIter->second->getPropertyListReference();
+        const std::list<PropertyImpl*>& props = typeIter->second->getPropertyListReference();
 
         for (std::list<PropertyImpl*>::const_iterator i = props.begin();
              i != props.end();
@@ -233,6 +260,7 @@ void DataFactoryImpl::addType(const char* uri, const char* inTypeName,
                                 bool isFromList)
 {
     assertTypeName(inTypeName, "DataFactory::addType");
+    assertMutable("DataFactory::addType");
 
     SDOString typeUri;
 
@@ -271,7 +299,7 @@ bool DataFactoryImpl::recursiveCheck(TypeImpl* cs, TypeImpl* t)
         return true;
     }
 
-    const std::list<PropertyImpl*> pl = cs->getPropertyListReference();
+    const std::list<PropertyImpl*>& pl = cs->getPropertyListReference();
     
     for (std::list<PropertyImpl*>::const_iterator j = pl.begin();
          j != pl.end();
@@ -370,6 +398,7 @@ void DataFactoryImpl::addPropertyToType(const char* uri,
                                       bool cont)
 {
     assertNames(inTypeName, propname);
+    assertMutable("DataFactory::addPropertyToType");
 
     TYPES_MAP::iterator typeIter, typeIter2;
     
@@ -757,6 +786,8 @@ void DataFactoryImpl::setBaseType( const char* typeuri,
                      const char* basename,
                      bool isRestriction )
 {
+    assertMutable("DataFactory::setBaseType");
+
     const TypeImpl* base = findTypeImpl(baseuri, basename);
     if (base == 0)
     {
@@ -813,6 +844,8 @@ void DataFactoryImpl::setBaseType(const SDOString& typeuri,
             const char* subTypeUri, 
             const char* subTypeName)
     {
+        assertMutable("DataFactory::setPropertySubstitute");
+
         const TypeImpl* cont = findTypeImpl(uri, inTypeName);
         if (cont == 0)
         {
@@ -1023,6 +1056,7 @@ void DataFactoryImpl::setBaseType(const SDOString& typeuri,
         const char* typuri, const char* typnam, 
         const char* propname, bool b ) 
     {
+        assertMutable("DataFactory::setDefault");
         const TypeImpl* ti = findTypeImpl(typuri,typnam);
         PropertyImpl* pi = ti->getPropertyImpl(propname);
         if (pi != 0)pi->setDefault(b);
@@ -1039,6 +1073,7 @@ void DataFactoryImpl::setBaseType(const SDOString& typeuri,
         const char* typuri, const char* typnam, 
         const char* propname , char c) 
     {
+        assertMutable("DataFactory::setDefault");
         const TypeImpl* ti = findTypeImpl(typuri,typnam);
         PropertyImpl* pi = ti->getPropertyImpl(propname);
         if (pi != 0)pi->setDefault(c);
@@ -1055,6 +1090,7 @@ void DataFactoryImpl::setBaseType(const SDOString& typeuri,
         const char* typuri, const char* typnam, 
         const char* propname , wchar_t c) 
     {
+        assertMutable("DataFactory::setDefault");
         const TypeImpl* ti = findTypeImpl(typuri,typnam);
         PropertyImpl* pi = ti->getPropertyImpl(propname);
         if (pi != 0)pi->setDefault(c);
@@ -1071,6 +1107,7 @@ void DataFactoryImpl::setBaseType(const SDOString& typeuri,
         const char* typuri, const char* typnam, 
         const char* propname , char* c) 
     {
+        assertMutable("DataFactory::setDefault");
         const TypeImpl* ti = findTypeImpl(typuri,typnam);
         PropertyImpl* pi = ti->getPropertyImpl(propname);
         if (pi != 0)pi->setDefault(c);
@@ -1089,6 +1126,7 @@ void DataFactoryImpl::setBaseType(const SDOString& typeuri,
         const char* typuri, const char* typnam, 
         const char* propname , short s) 
     {
+        assertMutable("DataFactory::setDefault");
         const TypeImpl* ti = findTypeImpl(typuri,typnam);
         PropertyImpl* pi = ti->getPropertyImpl(propname);
         if (pi != 0)pi->setDefault(s);
@@ -1106,6 +1144,7 @@ void DataFactoryImpl::setBaseType(const SDOString& typeuri,
         const char* typuri, const char* typnam, 
         const char* propname , long l) 
     {
+        assertMutable("DataFactory::setDefault");
         const TypeImpl* ti = findTypeImpl(typuri,typnam);
         PropertyImpl* pi = ti->getPropertyImpl(propname);
         if (pi != 0)pi->setDefault(l);
@@ -1124,6 +1163,7 @@ void DataFactoryImpl::setBaseType(const SDOString& typeuri,
         const char* typuri, const char* typnam, 
         const char* propname , int64_t i) 
     {
+        assertMutable("DataFactory::setDefault");
         const TypeImpl* ti = findTypeImpl(typuri,typnam);
         PropertyImpl* pi = ti->getPropertyImpl(propname);
         if (pi != 0)pi->setDefault(i);
@@ -1140,6 +1180,7 @@ void DataFactoryImpl::setBaseType(const SDOString& typeuri,
         const char* typuri, const char* typnam, 
         const char* propname , float f) 
     {
+        assertMutable("DataFactory::setDefault");
         const TypeImpl* ti = findTypeImpl(typuri,typnam);
         PropertyImpl* pi = ti->getPropertyImpl(propname);
         if (pi != 0)pi->setDefault(f);
@@ -1156,6 +1197,7 @@ void DataFactoryImpl::setBaseType(const SDOString& typeuri,
         const char* typuri, const char* typnam, 
         const char* propname , long double d) 
     {
+        assertMutable("DataFactory::setDefault");
         const TypeImpl* ti = findTypeImpl(typuri,typnam);
         PropertyImpl* pi = ti->getPropertyImpl(propname);
         if (pi != 0)pi->setDefault(d);
@@ -1172,6 +1214,7 @@ void DataFactoryImpl::setBaseType(const SDOString& typeuri,
         const char* typuri, const char* typnam, 
         const char* propname , const SDODate d) 
     {
+        assertMutable("DataFactory::setDefault");
         const TypeImpl* ti = findTypeImpl(typuri,typnam);
         PropertyImpl* pi = ti->getPropertyImpl(propname);
         if (pi != 0)pi->setDefault(d);
@@ -1188,6 +1231,7 @@ void DataFactoryImpl::setBaseType(const SDOString& typeuri,
         const char* typuri, const char* typnam, 
         const char* propname , const wchar_t* c, unsigned int len) 
     {
+        assertMutable("DataFactory::setDefault");
         const TypeImpl* ti = findTypeImpl(typuri,typnam);
         PropertyImpl* pi = ti->getPropertyImpl(propname);
         if (pi != 0)pi->setDefault(c,len);
@@ -1204,6 +1248,7 @@ void DataFactoryImpl::setBaseType(const SDOString& typeuri,
         const char* typuri, const char* typnam, 
         const char* propname , const char* c, unsigned int len) 
     {
+        assertMutable("DataFactory::setDefault");
         const TypeImpl* ti = findTypeImpl(typuri,typnam);
         PropertyImpl* pi = ti->getPropertyImpl(propname);
         if (pi != 0)pi->setDefault(c,len);
@@ -1267,6 +1312,11 @@ const Type* DataFactoryImpl::findType(const SDOString uri, const SDOString inTyp
 
 const TypeImpl* DataFactoryImpl::findTypeImpl(const SDOString& uri, const SDOString& inTypeName) const
 {
+    if (modelImpl != 0)
+    {
+        return modelImpl->findTypeImpl(uri, inTypeName);
+    }
+
     SDOString fullTypeName;
 	getFullTypeName(fullTypeName, uri, inTypeName);
     TYPES_MAP::const_iterator typeIter;
@@ -1296,6 +1346,7 @@ void DataFactoryImpl::setAlias(const char* typeuri,
                               const char* typenam,
                               const char* alias)
 {
+    assertMutable("DataFactory::setAlias");
 
     SDOString fullTypeName;
 	getFullTypeName(fullTypeName, typeuri, typenam);
@@ -1326,6 +1377,8 @@ void DataFactoryImpl::setAlias(const char* typeuri,
                               const char* propname,
                               const char* alias)
 {
+    assertMutable("DataFactory::setAlias");
+
     const TypeImpl&  t = getTypeImpl(typeuri, typenam);
     PropertyImpl* p  = t.getPropertyImpl(propname); 
     if (p != 0)p->setAlias(alias);
@@ -1346,6 +1399,11 @@ void DataFactoryImpl::setAlias(const SDOString& typeuri,
 
 TypeList DataFactoryImpl::getTypes() const
 {
+    if (frozen)
+    {
+        return getModel()->frozenTypes;
+    }
+
     TYPES_MAP::const_iterator typeIter;
     
 
@@ -1384,6 +1442,57 @@ void DataFactoryImpl::resolve()
 
 }
 
+// ===================================================================
+//  freeze - resolves the types and builds their compact lookup
+//  tables. After this has been called the types may not be changed,
+//  and may be shared by any number of views.
+// ===================================================================
+
+void DataFactoryImpl::freeze()
+{
+    if (frozen) return;
+
+    resolve();
+
+    TYPES_MAP::iterator typeIter;
+    for (typeIter = types.begin() ; typeIter != types.end(); ++typeIter)
+    {
+        if (strncmp((typeIter->first).c_str(),"ALIAS::", 7))
+        {
+            (typeIter->second)->freeze();
+            frozenTypes.push_back(typeIter->second);
+        }
+    }
+
+    frozen = true;
+}
+
+bool DataFactoryImpl::isFrozen() const
+{
+    return frozen;
+}
+
+DataFactoryPtr DataFactoryImpl::createView()
+{
+    freeze();
+    DataFactory* dob = (DataFactory*)(new DataFactoryImpl((DataFactoryImpl*)getModel()));
+    return DataFactoryPtr(dob);
+}
+
+const DataFactoryImpl* DataFactoryImpl::getModel() const
+{
+    return modelImpl != 0 ? modelImpl : this;
+}
+
+void DataFactoryImpl::assertMutable(const char* function) const
+{
+    if (frozen)
+    {
+        SDO_THROW_EXCEPTION(function,
+            SDOUnsupportedOperationException, "DataFactory is frozen");
+    }
+}
+
 // ===================================================================
 //  create - creates a data object from the types available.
 //  This first resolves the type hierarchy, and thus no further changes
@@ -1398,7 +1507,7 @@ RefCountingPointer<DataObject> DataFactoryImpl::create(const char* uri, const ch
 // resolved, do them now. The isResolved boolean is superseded by the
 // resolvePending set being non-empty.
 
-   if (!resolvePending.empty())
+   if (!frozen && !resolvePending.empty())
     {
         // Allow creation of types and properties before resolve.
         if (uri != 0 && !strcmp(uri,Type::SDOTypeNamespaceURI.c_str())) {
@@ -1432,7 +1541,7 @@ RefCountingPointer<DataObject> DataFactoryImpl::create(const char* uri, const ch
         SDOUnsupportedOperationException, msg.c_str());
     }
 
-    DataObject* dob = (DataObject*)(new DataObjectImpl(this, getTypeImpl(uri, typeName)));
+    DataObject* dob = (DataObject*)(new DataObjectImpl(this, *ti));
     return dob;
 }
 
@@ -1515,6 +1624,8 @@ void DataFactoryImpl::setDASValue(const char* typeuri,
                                         const char* name, 
                                         DASValue* value)
 {
+    assertMutable("DataFactory::setDASValue");
+
     TypeImpl* type = (TypeImpl*)findTypeImpl(typeuri, typenam);
     if (type != NULL)
     {
@@ -1594,6 +1705,8 @@ void DataFactoryImpl::setDASValue(
                 const char* name,
                 DASValue* value)
 {
+    assertMutable("DataFactory::setDASValue");
+
     const TypeImpl* type = findTypeImpl(typeuri, typenam);
     if (type != NULL)
     {
@@ -653,6 +653,18 @@ public:
 
     virtual    void resolve();
 
+    virtual void freeze();
+    virtual bool isFrozen() const;
+    virtual DataFactoryPtr createView();
+
+    // The factory whose types this one uses - the frozen model of a view,
+    // otherwise this factory itself.
+    const DataFactoryImpl* getModel() const;
+
+    // Counts the factories which have freed their types, so that code
+    // holding on to Type and Property pointers can tell they may be stale.
+    static unsigned int getReleaseCount();
+
     const Type* findType(const SDOString uri, const SDOString inTypeName) const;
 
     const TypeImpl* findTypeImpl(const SDOString& uri, const SDOString& inTypeName) const;
@@ -676,6 +688,20 @@ private:
 
     propertyMap openProperties;
 
+    // A frozen factory's types can no longer change. A view is a frozen
+    // factory which shares the types of another (keeping it alive) and
+    // holds only its own open properties.
+    bool frozen;
+    DataFactoryPtr model;
+    DataFactoryImpl* modelImpl;
+    std::vector<const Type*> frozenTypes;
+
+    // Counted atomically, as factories may be released on any thread
+    static long releaseCount;
+
+    DataFactoryImpl(DataFactoryImpl* frozenModel);
+    void assertMutable(const char* function) const;
+
     // Need to validate and 'lock' the data model for base types to
     // work properly.
 
@@ -39,7 +39,9 @@
 #include "commonj/sdo/ChangeSummaryImpl.h"
 #include "commonj/sdo/DataFactoryImpl.h"
 #include "commonj/sdo/SDOUtils.h"
+#include "commonj/sdo/SDOStats.h"
 
+#include <algorithm>
 #include <string>
 #include <stdio.h>
 #include <stdlib.h>
@@ -76,6 +78,68 @@ namespace sdo {
     {
     }
 
+    ClonedObjects::ClonedObjects() : slots(64, 0)
+    {
+    }
+
+    unsigned int ClonedObjects::slotOf(DataObjectImpl* original) const
+    {
+        // Objects are at least 8 byte aligned, so the low bits are dropped
+        // and the rest spread with a multiplicative hash.
+        unsigned int h = (unsigned int) (((size_t) original) >> 3);
+        h *= 2654435761U;
+        h ^= h >> 15;
+
+        unsigned int mask = slots.size() - 1;
+        unsigned int slot = h & mask;
+        while (slots[slot] != 0 &&
+               objects[slots[slot] - 1].first != original)
+        {
+            slot = (slot + 1) & mask;
+        }
+        return slot;
+    }
+
+    void ClonedObjects::grow()
+    {
+        slots.assign(slots.size() * 2, 0);
+        for (unsigned int i = 0; i < objects.size(); i++)
+        {
+            slots[slotOf(objects[i].first)] = i + 1;
+        }
+    }
+
+    void ClonedObjects::add(DataObjectImpl* original, DataObjectImpl* copy)
+    {
+        if ((objects.size() + 1) * 2 > slots.size())
+        {
+            grow();
+        }
+        objects.push_back(std::make_pair(original, copy));
+        slots[slotOf(original)] = objects.size();
+    }
+
+    DataObjectImpl* ClonedObjects::find(DataObjectImpl* original) const
+    {
+        unsigned int slot = slots[slotOf(original)];
+        return slot == 0 ? 0 : objects[slot - 1].second;
+    }
+
+    unsigned int ClonedObjects::size() const
+    {
+        return objects.size();
+    }
+
+    DataObjectImpl* ClonedObjects::getOriginal(unsigned int index) const
+    {
+        return objects[index].first;
+    }
+
+    DataObjectImpl* ClonedObjects::getCopy(unsigned int index) const
+    {
+        return objects[index].second;
+    }
+
 #define ASSERT_SETTABLE(property,primval) ASSERT_WRITABLE(*property, set##primval)
 
  /**  DataObject
@@ -342,6 +406,7 @@ namespace sdo {
    const PropertyImpl* DataObjectImpl::defineProperty(const SDOString& propname, 
                                                       const Type& t)
    {
+      openGeneration++;
       openProperties.insert(openProperties.end(),
                             PropertyImpl(getType(),
                                          propname,
@@ -349,6 +414,7 @@ namespace sdo {
                                          false,
                                          false,
                                          true));
+      openProperties.back().setIndex(openBase + openProperties.size() - 1);
       DataFactory* df = factory;
       ((DataFactoryImpl*)df)->addOpenProperty(PropertyImpl(getType(),
                                                            propname,
@@ -391,7 +457,12 @@ namespace sdo {
         DataFactory* df = factory;
         ((DataFactoryImpl*)df)->removeOpenProperty((*it).getName());
         
-        openProperties.erase(it);
+        it = openProperties.erase(it);
+        for (; it != openProperties.end(); ++it)
+        {
+            (*it).setIndex((*it).getIndex() - 1);
+        }
+        openGeneration++;
         
         return;
     }
@@ -399,9 +470,11 @@ namespace sdo {
     const PropertyImpl* DataObjectImpl::defineList(const char* propname)
     {
         const Type& t = factory->getType(Type::SDOTypeNamespaceURI, "OpenDataObject");
+        openGeneration++;
         openProperties.insert(
             openProperties.end(), PropertyImpl(getType(),propname,
             (TypeImpl&)t, true, false, true));
+        openProperties.back().setIndex(openBase + openProperties.size() - 1);
 
         DataFactory* df = factory;
         ((DataFactoryImpl*)df)->addOpenProperty(PropertyImpl(getType(),propname,
@@ -602,6 +675,7 @@ namespace sdo {
          {
             logChange(propertyIndex);
             (*i).second->setNull();
+            predicateKeyChanged(propertyIndex);
             return;
          }
       }
@@ -613,6 +687,7 @@ namespace sdo {
       b->setContainer(this);
       PropertyValues.push_back(rdo(propertyIndex,b));
       b->setNull();
+      predicateKeyChanged(propertyIndex);
    }
 
     void DataObjectImpl::setNull(const Property& property)
@@ -801,7 +876,16 @@ namespace sdo {
 
     unsigned int DataObjectImpl::getPropertyIndex(const Property& p)
     {
-       const std::list<PropertyImpl*> props = getType().getPropertyListReference();
+       // A property of this type or one of its base types knows its slot,
+       // so only a property from elsewhere (another factory, or another
+       // object's open content) is looked up by name.
+       const PropertyImpl* pi = (const PropertyImpl*)&p;
+       if (ObjectType->getPropertyImpl(pi->getIndex()) == pi)
+       {
+           return pi->getIndex();
+       }
+
+       const std::list<PropertyImpl*>& props = ObjectType->getPropertyListReference();
 
        unsigned int i = 0;
        for (std::list<PropertyImpl*>::const_iterator j = props.begin();
@@ -917,12 +1001,10 @@ namespace sdo {
 
     PropertyImpl* DataObjectImpl::getPropertyImpl(unsigned int index)
     {
-       // Cannot use getPropertyListReference because we will return a
-       // writeable PropertyImpl.
-        PropertyList props = getType().getProperties();  
-        if (index < props.size())
+        PropertyImpl* pi = ObjectType->getPropertyImpl(index);
+        if (pi != 0)
         {
-            return (PropertyImpl*)&props[index];
+            return pi;
         }
 
         if (getType().isOpenType())
@@ -973,6 +1055,8 @@ namespace sdo {
 
     void DataObjectImpl::stripPath(const SDOString& path, SDOString& result)
     {
+       SDOStats::add(SDOStats::PathResolutions);
+
        result.erase();
        result.reserve(path.length());
        
@@ -1065,6 +1149,19 @@ namespace sdo {
         // eq is now propval
         
         DataObjectList& list = getList(p);
+
+        // A long list answers the predicate from an index of the property
+        DataObjectImpl* found;
+        unsigned int position;
+        if (((DataObjectListImpl&) list).findByPredicate(PropertyName, PropertyValue, found, position))
+        {
+            if (found != 0)
+            {
+                *index = position;
+            }
+            return found;
+        }
+
         for (unsigned int li = 0 ; li < list.size() ; ++li)
         {
             // TODO  comparison for double not ok
@@ -1321,7 +1418,8 @@ namespace sdo {
     PropertyList /* Property */ DataObjectImpl::getInstanceProperties()
     {
         std::vector<PropertyImpl*> theVec;
-        const std::list<PropertyImpl*> propList = getType().getPropertyListReference();
+        const std::list<PropertyImpl*>& propList = getType().getPropertyListReference();
+        theVec.reserve(propList.size() + openProperties.size());
 
         for (std::list<PropertyImpl*>::const_iterator i = propList.begin();
              i != propList.end();
@@ -1337,6 +1435,195 @@ namespace sdo {
         }
         return PropertyList(theVec);
     }
+
+    void DataObjectImpl::getValidProperties(std::vector<bool>& valid)
+    {
+        std::vector<const PropertyImpl*> props;
+        getValidProperties(props, valid);
+    }
+
+    void DataObjectImpl::getValidProperties(std::vector<const PropertyImpl*>& props,
+                                            std::vector<bool>& valid)
+    {
+        const std::list<PropertyImpl*>& propList = getType().getPropertyListReference();
+        props.clear();
+        props.reserve(propList.size() + openProperties.size());
+
+        std::list<PropertyImpl*>::const_iterator i;
+        for (i = propList.begin(); i != propList.end(); ++i)
+        {
+            props.push_back(*i);
+        }
+        std::list<PropertyImpl>::const_iterator j;
+        for (j = openProperties.begin(); j != openProperties.end(); ++j)
+        {
+            props.push_back(&(*j));
+        }
+
+        valid.resize(props.size());
+        for (unsigned int k = 0; k < props.size(); k++)
+        {
+            valid[k] = props[k]->isDefaulted();
+        }
+
+        // Mark the properties with values as isSet(const Property&, unsigned int)
+        // does, but without searching the values once per property.
+        PropertyValueMap::iterator pit;
+        for (pit = PropertyValues.begin(); pit != PropertyValues.end(); ++pit)
+        {
+            if ((*pit).first >= props.size())
+            {
+                continue;
+            }
+            DataObjectImpl* dol = (*pit).second;
+            if (props[(*pit).first]->isMany() &&
+                dol != 0 && dol->getList().size() == 0)
+            {
+                continue;
+            }
+            valid[(*pit).first] = true;
+        }
+    }
+
+    void DataObjectImpl::getPropertySlots(std::vector<DataObjectImpl*>& values,
+                                          std::vector<bool>& set)
+    {
+        unsigned int count = openBase + openProperties.size();
+        values.assign(count, 0);
+        set.assign(count, false);
+
+        PropertyValueMap::iterator pit;
+        for (pit = PropertyValues.begin(); pit != PropertyValues.end(); ++pit)
+        {
+            if ((*pit).first < count)
+            {
+                values[(*pit).first] = (*pit).second;
+                set[(*pit).first] = true;
+            }
+        }
+    }
+
+    DataObjectImpl* DataObjectImpl::cloneTree(ClonedObjects& copies)
+    {
+        DataFactory* df = factory;
+        DataObjectImpl* copy = new DataObjectImpl(df, *ObjectType);
+
+        // Values of data types are held in objects of their own, which
+        // nothing can refer to, so only the others are recorded.
+        if (!ObjectType->isDataType())
+        {
+            copies.add(this, copy);
+        }
+
+        copy->sdoValue = sdoValue;
+        copy->isnull = isnull;
+
+        // The open properties come first, as the values and lists below
+        // look their properties up by index.
+        copy->openBase = openBase;
+        copy->openProperties.insert(copy->openProperties.end(),
+                                    openProperties.begin(),
+                                    openProperties.end());
+        copy->openGeneration = openGeneration;
+
+        PropertyValueMap::iterator i;
+        for (i = PropertyValues.begin(); i != PropertyValues.end(); ++i)
+        {
+            unsigned int propertyIndex = (*i).first;
+            DataObjectImpl* value = (*i).second;
+
+            const PropertyImpl* p = getPropertyImpl(propertyIndex);
+            if (p == 0 || p->getTypeEnum() == Type::ChangeSummaryType)
+            {
+                continue;
+            }
+
+            if (value == 0)
+            {
+                // set to null
+                copy->PropertyValues.push_back(rdo(propertyIndex, (DataObjectImpl*) 0));
+                continue;
+            }
+
+            if ((p->isMany() || p->getTypeImpl()->isFromList()) &&
+                value->listValue != 0)
+            {
+                DataObjectImpl* holder = new DataObjectImpl(df, *value->ObjectType);
+                copy->PropertyValues.push_back(rdo(propertyIndex, holder));
+                holder->setContainer(copy);
+                holder->setList(value->listValue->cloneList(copy, copies));
+            }
+            else if (p->isReference())
+            {
+                // set by cloneReferences
+                continue;
+            }
+            else
+            {
+                DataObjectImpl* valueCopy = value->cloneTree(copies);
+                copy->PropertyValues.push_back(rdo(propertyIndex, valueCopy));
+                valueCopy->setContainer(copy);
+                valueCopy->setContainmentHint(propertyIndex, 0);
+            }
+        }
+
+        return copy;
+    }
+
+    void DataObjectImpl::cloneReferences(DataObjectImpl* copy,
+                                         const ClonedObjects& copies)
+    {
+        PropertyValueMap::iterator i;
+        for (i = PropertyValues.begin(); i != PropertyValues.end(); ++i)
+        {
+            DataObjectImpl* value = (*i).second;
+            if (value == 0)
+            {
+                continue;
+            }
+
+            const PropertyImpl* p = getPropertyImpl((*i).first);
+            if (p == 0 || !p->isReference())
+            {
+                continue;
+            }
+
+            if (p->isMany())
+            {
+                PropertyValueMap::iterator j;
+                for (j = copy->PropertyValues.begin();
+                     j != copy->PropertyValues.end(); ++j)
+                {
+                    if ((*j).first == (*i).first)
+                    {
+                        value->listValue->cloneReferences(
+                            (*j).second->listValue, copies);
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                DataObjectImpl* target = copies.find(value);
+                if (target != 0)
+                {
+                    copy->PropertyValues.push_back(rdo((*i).first, target));
+                    target->setReference(copy,
+                                         *copy->getPropertyImpl((*i).first));
+                }
+            }
+        }
+
+        if (sequence != 0)
+        {
+            copy->sequence->cloneEntries(sequence, copies);
+        }
+    }
+
+    unsigned long DataObjectImpl::getInstancePropertiesGeneration() const
+    {
+        return openGeneration;
+    }
   
     void DataObjectImpl::setInstancePropertyType(unsigned int index,
         const Type* t)
@@ -1350,13 +1637,14 @@ namespace sdo {
             {
                 if (count == index)
                 {
-                    openProperties.insert(j,
+                    std::list<PropertyImpl>::iterator k = openProperties.insert(j,
                         PropertyImpl(getType(),
                         (*j).getName(),
                         (TypeImpl&)*t,
                         (*j).isMany(),
                         (*j).isReadOnly(),
                         (*j).isContainment()));
+                    (*k).setIndex(index);
 
                     DataFactory* df = factory;
                     ((DataFactoryImpl*)df)->addOpenProperty(
@@ -1368,6 +1656,7 @@ namespace sdo {
                         (*j).isContainment()));
 
                     openProperties.erase(j);
+                    openGeneration++;
                     
                     return;
                 }
@@ -1587,9 +1876,7 @@ namespace sdo {
 
     void DataObjectImpl::validateIndex(unsigned int index)
     {
-        const std::list<PropertyImpl*> pl = getType().getPropertyListReference();
-
-        if (index >= pl.size()) {
+        if (index >= ObjectType->getPropertiesSize()) {
 
             // open type support
             if (getType().isOpenType())
@@ -1616,6 +1903,11 @@ namespace sdo {
 
         if (d->getDataFactory() == getDataFactory()) return;
 
+        // Views of one frozen model share its types
+        const DataFactoryImpl* dfi = (DataFactoryImpl*)d->getDataFactory();
+        const DataFactoryImpl* myDfi = (DataFactoryImpl*)getDataFactory();
+        if (dfi != 0 && myDfi != 0 && dfi->getModel() == myDfi->getModel()) return;
+
         if (d->getContainer() != 0)
         {
             string msg("Insertion of object from another factory is only allowed if the parent is null: ");
@@ -1648,12 +1940,10 @@ namespace sdo {
             (objectType.getURI(),objectType.getName());
         if (ti != 0)
         {
-            do 
+            if (ti->isDerivedFrom(propType))
             {
-                ti = (const TypeImpl*)ti->getBaseType();
-                if (ti == 0) break;
-                if (propType.equals(*ti)) return;
-            } while (ti != 0);
+                return;
+            }
 
             // allow types of any substitutes
             const PropertyImpl* pi = 
@@ -1927,6 +2217,11 @@ void DataObjectImpl::setDataObject(const Property& prop,
         return false;
     }
 
+    bool DataObjectImpl::isValid(const PropertyImpl* p, unsigned int propertyIndex)
+    {
+        return p->isDefaulted() || isSet(*p, propertyIndex);
+    }
+
     bool DataObjectImpl::isSet(unsigned int propertyIndex)
     {
         return isSet(getProperty(propertyIndex), propertyIndex);
@@ -2107,6 +2402,7 @@ void DataObjectImpl::setDataObject(const Property& prop,
                         PropertyValues.erase(i);
                     }
                 }
+                predicateKeyChanged(index);
                 if (getType().isOpenType() && index >= openBase)
                 {
                     if (p.isMany())
@@ -2378,6 +2674,10 @@ void DataObjectImpl::setDataObject(const Property& prop,
 
     void DataObjectImpl::setList( DataObjectList* theList)
     {
+        if (listValue == 0 && theList != 0 && !ObjectType->isDataType())
+        {
+            SDOStats::add(SDOStats::ObjectsCreated, -1);
+        }
         listValue = (DataObjectListImpl*)theList;
     }
 
@@ -2493,10 +2793,86 @@ void DataObjectImpl::setDataObject(const Property& prop,
     // Return the Property of the data Object containing this data Object
     // or 0 if there is no container.
 
+    const PropertyImpl* DataObjectImpl::findContainment(DataObjectImpl* ob, unsigned int& listIndex)
+    {
+        // Try the property recorded in the object first, then all of them.
+        PropertyValueMap::iterator i;
+        for (int pass = 0; pass < 2; pass++)
+        {
+            for (i = PropertyValues.begin(); i != PropertyValues.end(); ++i)
+            {
+                if (pass == 0 && (*i).first != ob->containmentHint) continue;
+
+                const PropertyImpl* p = getPropertyImpl((*i).first);
+                if (p == 0 || p->isReference()) continue;
+                if (p->isMany())
+                {
+                    DataObjectListImpl* dl = ((*i).second)->getListImpl();
+                    if (dl != 0 && dl->indexOf(ob, listIndex))
+                    {
+                        ob->containmentHint = (*i).first;
+                        return p;
+                    }
+                }
+                else
+                {
+                    DataObjectImpl* value = (*i).second;
+                    if (value == ob)
+                    {
+                        ob->containmentHint = (*i).first;
+                        return p;
+                    }
+                }
+            }
+        }
+        return 0;
+    }
+
+    void DataObjectImpl::setContainmentHint(unsigned int propertyIndex, unsigned int listIndex)
+    {
+        containmentHint = propertyIndex;
+        listIndexHint = listIndex;
+    }
+
+    unsigned int DataObjectImpl::getListIndexHint() const
+    {
+        return listIndexHint;
+    }
+
+    void DataObjectImpl::setPredicateIndexed()
+    {
+        predicateIndexed = true;
+    }
+
+    void DataObjectImpl::predicateKeyChanged(unsigned int propertyIndex)
+    {
+        if (container == 0 || !container->predicateIndexed)
+        {
+            return;
+        }
+
+        // Most properties are not keys of any index, so do not look for
+        // the list holding this object unless the property is one
+        const PropertyImpl* key = getPropertyImpl(propertyIndex);
+        if (key == 0 || !key->isPredicateKey())
+        {
+            return;
+        }
+
+        unsigned int listIndex;
+        const PropertyImpl* p = container->findContainment(this, listIndex);
+        if (p != 0 && p->isMany())
+        {
+            DataObjectListImpl* dl = (DataObjectListImpl*) &container->getList(*p);
+            dl->predicateKeyChanged(this, key);
+        }
+    }
+
     const Property& DataObjectImpl::getContainmentProperty()
     {
         if (container != 0) {
-            const Property* p = container->findInProperties(this);
+            unsigned int listIndex;
+            const Property* p = container->findContainment(this, listIndex);
             if (p != 0)return *p;
         }
         SDO_THROW_EXCEPTION("getContainmentProperty" ,SDOPropertyNotFoundException,
@@ -3192,12 +3568,17 @@ void DataObjectImpl::setDataObject(const Property& prop,
    DataObjectImpl::DataObjectImpl(const TypeImpl& t) :
       ObjectType((TypeImpl*) &t),
       container(0),
+      listValue(0),
       doValue(0),
       isnull(false),
       userdata((void*) 0xFFFFFFFF)
    {
       // open type support
       openBase = t.getPropertiesSize() ;
+      openGeneration = 0;
+      containmentHint = 0;
+      listIndexHint = 0;
+      predicateIndexed = false;
 
       if (t.isChangeSummaryType())
       {
@@ -3216,6 +3597,14 @@ void DataObjectImpl::setDataObject(const Property& prop,
       {
          sequence = 0;
       }
+
+      // Values of data types are held in objects too; count only the
+      // objects of the graph itself. The holder of a list is uncounted
+      // again by setList.
+      if (!ObjectType->isDataType())
+      {
+         SDOStats::add(SDOStats::ObjectsCreated);
+      }
    }
 
 
@@ -3223,11 +3612,16 @@ void DataObjectImpl::setDataObject(const Property& prop,
       ObjectType((TypeImpl*) &t),
       factory(df),
       container(0),
+      listValue(0),
       isnull(false),
       userdata((void*) 0xFFFFFFFF)
    {
       // open type support
       openBase = ObjectType->getPropertiesSize() ;
+      openGeneration = 0;
+      containmentHint = 0;
+      listIndexHint = 0;
+      predicateIndexed = false;
 
 
       if (ObjectType->isChangeSummaryType())
@@ -3247,11 +3641,21 @@ void DataObjectImpl::setDataObject(const Property& prop,
       {
          sequence = 0;
       }
+
+      if (!ObjectType->isDataType())
+      {
+         SDOStats::add(SDOStats::ObjectsCreated);
+      }
    }
 
 
     DataObjectImpl::~DataObjectImpl()
     {
+        if (!ObjectType->isDataType() && listValue == 0)
+        {
+            SDOStats::add(SDOStats::ObjectsDestroyed);
+        }
+
         // We do not want to log changes to our own deletion
         // if this DO owns the ChangeSummary. Do not delete
         // it here as contained DOs still have a reference to it.
@@ -3300,6 +3704,14 @@ void DataObjectImpl::setDataObject(const Property& prop,
             if (sequence != 0) delete sequence;
         }
 
+        // A list holder owns its list. Lists used to be leaked here, which
+        // would also keep an arena pinned for good.
+        if (listValue != 0)
+        {
+            delete listValue;
+            listValue = 0;
+        }
+
 
         if (getTypeImpl().isChangeSummaryType()    )
         {
@@ -3365,6 +3777,11 @@ void DataObjectImpl::setDataObject(const Property& prop,
 
         refs.push_back(new Reference(dol,prop));
     }
+    void DataObjectImpl::reserveReferences(unsigned int count)
+    {
+        refs.reserve(refs.size() + count);
+    }
+
     void DataObjectImpl::unsetReference(DataObject* dol, const Property& prop)
     {
         LOGINFO_1(INFO,"ChangeSummary:Unsetting a reference to %s",prop.getName());
@@ -3401,38 +3818,46 @@ void DataObjectImpl::setDataObject(const Property& prop,
 
     const char* DataObjectImpl::objectToXPath()
     {
-        asXPathBuffer = "";
+        // The path is written backwards, from this object up to the root,
+        // and the buffer is reversed at the end.
+        asXPathBuffer.erase();
 
         DataObjectImpl* dob = getContainerImpl();
-        DataObject*thisob = this;
+        DataObjectImpl* thisob = this;
         while (dob != 0){
-            const Property& p = thisob->getContainmentProperty();
-            if (asXPathBuffer != "")
+            unsigned int listIndex;
+            const PropertyImpl* p = dob->findContainment(thisob, listIndex);
+            if (p == 0)
             {
-                asXPathBuffer = "/" + asXPathBuffer;
+                SDO_THROW_EXCEPTION("getContainmentProperty" ,SDOPropertyNotFoundException,
+                    "Object cannot find its containment property");
             }
 
-            if (p.isMany()) {
-                DataObjectList& dol = dob->getList(p);
-                for (unsigned int i=0;i<dol.size();i++)
+            if (p->isMany()) {
+                do
                 {
-                    if (dol[i] == thisob)
-                    {
-                        char index[64];
-                        sprintf(index,"%d",i);
-                        asXPathBuffer = index + asXPathBuffer;
-                        asXPathBuffer = "." + asXPathBuffer;
-                        break;
-                    }
-                }
+                    asXPathBuffer += (char) ('0' + listIndex % 10);
+                    listIndex /= 10;
+                } while (listIndex != 0);
+                asXPathBuffer += '.';
+            }
+            const char* name = p->getName();
+            for (size_t n = strlen(name); n > 0; n--)
+            {
+                asXPathBuffer += name[n - 1];
             }
-            asXPathBuffer = p.getName() + asXPathBuffer;
+            asXPathBuffer += '/';
 
             thisob = dob;
             dob = dob->getContainerImpl();
         }
 
-        asXPathBuffer = "#/" + asXPathBuffer;
+        if (asXPathBuffer.empty())
+        {
+            asXPathBuffer += '/';
+        }
+        asXPathBuffer += '#';
+        std::reverse(asXPathBuffer.begin(), asXPathBuffer.end());
 
         return asXPathBuffer.c_str();
 /*
@@ -3778,6 +4203,7 @@ void DataObjectImpl::setDataObject(const Property& prop,
             logChange(propertyIndex);
             (*i).second->unsetNull();
             (*i).second->setSDOValue(sval);
+            predicateKeyChanged(propertyIndex);
 
             // If this is a sequenced data object then update the sequence. We
             // already know that a) the property is already set and b) it
@@ -3803,6 +4229,7 @@ void DataObjectImpl::setDataObject(const Property& prop,
       logChange(propertyIndex);
       PropertyValues.push_back(rdo(propertyIndex, b));
       b->setSDOValue(sval);
+      predicateKeyChanged(propertyIndex);
 
       // If this is a sequenced data object then update the sequence. We
       // already know that a) the property is not already set and b) it
@@ -3970,6 +4397,72 @@ void DataObjectImpl::setDataObject(const Property& prop,
       return sdoValue;
    }
 
+   // Only single valued data type properties can be read or written in bulk.
+   static void checkBulkProperty(PropertyImpl* p)
+   {
+      if (!p->getType().isDataType() || p->isMany() || p->getTypeImpl()->isFromList())
+      {
+         string msg("Only single valued data type properties are available: ");
+         msg += p->getName();
+         SDO_THROW_EXCEPTION("checkBulkProperty", SDOUnsupportedOperationException, msg.c_str());
+      }
+   }
+
+   void DataObjectImpl::setValues(const PROPERTY_VALUES& values)
+   {
+      unsigned int i;
+
+      for (i = 0; i < values.size(); i++)
+      {
+         validateIndex(values[i].first);
+         PropertyImpl* p = getPropertyImpl(values[i].first);
+         checkBulkProperty(p);
+         if (p->isReadOnly())
+         {
+            SDOString stringBuffer = p->getName();
+            stringBuffer += " is read-only.";
+            SDO_THROW_EXCEPTION("DataObjectImpl::setValues",
+                                SDOUnsupportedOperationException,
+                                stringBuffer.c_str());
+         }
+      }
+
+      for (i = 0; i < values.size(); i++)
+      {
+         const unsigned int propertyIndex = values[i].first;
+         const SDOValue& sval = values[i].second;
+
+         if (sval.isNull())
+         {
+            setNull(propertyIndex);
+         }
+         else if (!sval.isSet())
+         {
+            unset(propertyIndex);
+         }
+         else
+         {
+            setSDOValue(propertyIndex, sval, sval.convertTypeEnumToString());
+         }
+      }
+   }
+
+   void DataObjectImpl::getValues(const std::vector<unsigned int>& propertyIndexes,
+                                  std::vector<SDOValue>& values)
+   {
+      values.clear();
+      values.reserve(propertyIndexes.size());
+
+      for (unsigned int i = 0; i < propertyIndexes.size(); i++)
+      {
+         validateIndex(propertyIndexes[i]);
+         checkBulkProperty(getPropertyImpl(propertyIndexes[i]));
+
+         PropertyImpl* propertyForDefault = 0;
+         values.push_back(getSDOValue(propertyIndexes[i], &propertyForDefault));
+      }
+   }
+
    // End of SDOValue methods
    // ---
 
@@ -4602,6 +5095,38 @@ void DataObjectImpl::setDataObject(const Property& prop,
       }
    }
 
+   bool DataObjectImpl::getStringView(const SDOString& path,
+                                      const char*& data,
+                                      unsigned int& length)
+   {
+      PropertyImpl* propertyForDefault = 0;
+      const SDOValue& result = getSDOValue(path, &propertyForDefault);
+
+      if (!result.isSet() || result.isNull())
+      {
+         data = 0;
+         length = 0;
+         return false;
+      }
+      return result.getStringView(data, length);
+   }
+
+   bool DataObjectImpl::getStringView(unsigned int propertyIndex,
+                                      const char*& data,
+                                      unsigned int& length)
+   {
+      PropertyImpl* propertyForDefault = 0;
+      const SDOValue& result = getSDOValue(propertyIndex, &propertyForDefault);
+
+      if (!result.isSet() || result.isNull())
+      {
+         data = 0;
+         length = 0;
+         return false;
+      }
+      return result.getStringView(data, length);
+   }
+
    // End of getCString using SDOValue methods
    // ---
 
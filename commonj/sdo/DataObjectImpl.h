@@ -30,6 +30,7 @@
 #include <map>
 
 #include <string>
+#include <vector>
 
 
 #include "commonj/sdo/Property.h"
@@ -43,6 +44,7 @@
 #include "commonj/sdo/ChangeSummaryImpl.h"
 #include "commonj/sdo/SDODate.h"
 #include "commonj/sdo/SDOValue.h"
+#include "commonj/sdo/SDOArena.h"
 
 namespace commonj{
 namespace sdo{
@@ -70,7 +72,40 @@ public:
     virtual ~rdo();
 };
 
-typedef std::list< rdo > PropertyValueMap;
+typedef std::list< rdo, SDOArenaAllocator<rdo> > PropertyValueMap;
+
+/**
+ * ClonedObjects records each data object copied while a tree is cloned,
+ * together with its copy. The objects are kept in the order they were
+ * copied, and are also hashed by address so that the copy of an object
+ * can be found in constant time when references are remapped.
+ */
+
+class ClonedObjects
+{
+public:
+    ClonedObjects();
+
+    void add(DataObjectImpl* original, DataObjectImpl* copy);
+
+    // Returns the copy of original, or 0 if it was not copied.
+    DataObjectImpl* find(DataObjectImpl* original) const;
+
+    unsigned int size() const;
+    DataObjectImpl* getOriginal(unsigned int index) const;
+    DataObjectImpl* getCopy(unsigned int index) const;
+
+private:
+    unsigned int slotOf(DataObjectImpl* original) const;
+    void grow();
+
+    std::vector<std::pair<DataObjectImpl*, DataObjectImpl*> > objects;
+
+    // Open addressed, a power of two in size and at most half full. Each
+    // slot holds one more than the position of the object in objects, or
+    // 0 if it is free.
+    std::vector<unsigned int> slots;
+};
 
 
  /**  
@@ -106,6 +141,9 @@ class DataObjectImpl : public DataObject
 {
      public:
 
+    // Allocated from the current SDOArena, if any
+    SDO_ARENA_ALLOCATED
+
     DataObjectImpl();
     DataObjectImpl(const TypeImpl& t);
     DataObjectImpl(DataFactory* dataFactory, const Type& t);
@@ -163,6 +201,33 @@ class DataObjectImpl : public DataObject
     
     virtual PropertyList getInstanceProperties();
 
+   /**  getValidProperties records which instance properties are valid.
+     *
+     * The vector is filled in the order of getInstanceProperties(), with true
+     * for each property which is set or has a default, as isValid() would
+     * report it. The values of the object are read in a single pass.
+     */
+
+    virtual void getValidProperties(std::vector<bool>& valid);
+
+   /**  getValidProperties as above, also giving the instance properties.
+     *
+     * The properties are those of the type followed by the open properties,
+     * in the order of getInstanceProperties(), without building a list.
+     */
+
+    void getValidProperties(std::vector<const PropertyImpl*>& props,
+                            std::vector<bool>& valid);
+
+   /**  getInstancePropertiesGeneration counts changes to the instance properties.
+     *
+     * The count changes whenever an open property is defined, removed or
+     * given a new type, so a caller holding the instance properties or their
+     * indexes can tell whether they are still current.
+     */
+
+    unsigned long getInstancePropertiesGeneration() const;
+
      /**  getContainer get the containing object
      *
      * Returns the containing data object
@@ -349,6 +414,16 @@ class DataObjectImpl : public DataObject
     virtual const char* getCString(const SDOString& path);
     virtual const char* getCString(unsigned int propertyIndex);
     virtual const char* getCString(const Property& prop);
+
+    /**
+     * getStringView returns the characters and length of a string or bytes
+     * value as it is stored, with no conversion and no copy. The view is
+     * valid until the property is next changed. It returns false when the
+     * value is null, defaulted or held in another form, in which case the
+     * converting getters must be used instead.
+     */
+    virtual bool getStringView(const SDOString& path, const char*& data, unsigned int& length);
+    virtual bool getStringView(unsigned int propertyIndex, const char*& data, unsigned int& length);
     
     virtual void setCString(const char* path, const char* value);
     virtual void setCString(unsigned int propertyIndex, const char* value);
@@ -387,6 +462,13 @@ class DataObjectImpl : public DataObject
     virtual bool isValid(unsigned int propertyIndex);
     virtual bool isValid(const Property& property);
 
+   /**  isValid for the instance property at propertyIndex, which is p.
+     *
+     * Neither the property nor its index is looked up, only its value.
+     */
+
+    bool isValid(const PropertyImpl* p, unsigned int propertyIndex);
+
     virtual void unset(const char* path);
     virtual void unset(const SDOString& path);
     virtual void unset(unsigned int propertyIndex);
@@ -531,6 +613,9 @@ class DataObjectImpl : public DataObject
     virtual void setReference(DataObject* dob, const Property& prop);
     virtual void unsetReference(DataObject* dob, const Property& prop);
     virtual void clearReferences();
+
+    // makes room for count more references, when several are about to be set
+    void reserveReferences(unsigned int count);
     
     // user data support
     virtual void setUserData(const char* path,void* value);
@@ -547,6 +632,20 @@ class DataObjectImpl : public DataObject
     virtual void setContainer(DataObjectImpl* d);
     DataObjectImpl* getContainerImpl();
 
+    // The property of the container holding this object, and the position
+    // of this object in it if it is a list, as last known. These are hints
+    // which are checked before they are used, so they may go out of date.
+    void setContainmentHint(unsigned int propertyIndex, unsigned int listIndex);
+    unsigned int getListIndexHint() const;
+
+    // Returns the property of this object which contains ob, or 0, and
+    // the position of ob in it if the property is many valued.
+    const PropertyImpl* findContainment(DataObjectImpl* ob, unsigned int& listIndex);
+
+    // Called by a list of this object once it has built a predicate
+    // index, after which its items report changes to their values.
+    void setPredicateIndexed();
+
     // builds a temporary XPath for this object.
     const char* objectToXPath();
 
@@ -606,6 +705,52 @@ class DataObjectImpl : public DataObject
     virtual void setSDOValue(const Property& p, const SDOValue& sval, const SDOString& dataType);
     virtual void setSDOValue(const Property& p, const SDOValue& sval, const SDOString& dataType, bool updateSequence);
 
+    typedef std::vector<std::pair<unsigned int, SDOValue> > PROPERTY_VALUES;
+
+    /**
+     * setValues sets several single valued data type properties in one
+     * call. A null value sets the property to null and an unset value
+     * unsets it. All the properties are checked before any is set, so a
+     * property which is read-only or not single valued data leaves the
+     * object unchanged.
+     */
+    virtual void setValues(const PROPERTY_VALUES& values);
+
+    /**
+     * getValues reads several single valued data type properties in one
+     * call. A property which is not set gives the unset value, and its
+     * default is then that of the property.
+     */
+    virtual void getValues(const std::vector<unsigned int>& propertyIndexes,
+                           std::vector<SDOValue>& values);
+
+    /**
+     * getPropertySlots gives the value held for each instance property by
+     * index, in one pass over the values. A property with no value
+     * holder, or one explicitly set to null, gives 0, and set tells the
+     * two apart. A many valued property gives the holder of its list.
+     */
+    virtual void getPropertySlots(std::vector<DataObjectImpl*>& values,
+                                  std::vector<bool>& set);
+
+    /**
+     * cloneTree copies this data object and the data objects it contains,
+     * copying the values it holds directly rather than through its
+     * properties. Each data object copied is added to copies. References
+     * and sequences are left for cloneReferences, which is called for
+     * each entry in copies once the whole tree has been copied.
+     */
+    virtual DataObjectImpl* cloneTree(ClonedObjects& copies);
+
+    /**
+     * cloneReferences sets the references of copy, made from this object
+     * by cloneTree, to the copies of the objects this object refers to.
+     * A reference to an object outside the copied tree is left unset.
+     * The sequence, if any, is copied last.
+     */
+    virtual void cloneReferences(DataObjectImpl* copy,
+                                 const ClonedObjects& copies);
+
 
 
 private:
@@ -662,6 +807,17 @@ private:
     // holds the Xpath to this object if requested.
     std::string asXPathBuffer;
 
+    // Where this object was last known to be held in its container.
+    unsigned int containmentHint;
+    unsigned int listIndexHint;
+
+    // Whether any list of this object keeps a predicate index.
+    bool predicateIndexed;
+
+    // Tells the list holding this object, if it is indexed, that the
+    // value of a property of this object has changed.
+    void predicateKeyChanged(unsigned int propertyIndex);
+
     // The data object holds a counted reference to the data factory.
     DataFactoryPtr factory;
 
@@ -669,6 +825,7 @@ private:
     // Support for open types
     unsigned int openBase;
     std::list<PropertyImpl> openProperties;
+    unsigned long openGeneration;
 
     static const char* templateString;
 
@@ -31,6 +31,8 @@
 #include "commonj/sdo/DataFactory.h"
 #include "commonj/sdo/DataObjectImpl.h"
 #include "commonj/sdo/DataFactoryImpl.h"
+#include "commonj/sdo/PropertyImpl.h"
+#include "commonj/sdo/SDOPredicateIndex.h"
 
 #include <stdio.h>
 
@@ -130,6 +132,10 @@ DataObjectListImpl::DataObjectListImpl(DataFactory* df,
 
 DataObjectListImpl::~DataObjectListImpl()
 {
+    for (unsigned int i = 0; i < predicateIndexes.size(); i++)
+    {
+        delete predicateIndexes[i];
+    }
     if (typeURI != 0) {
         delete[] typeURI;
         typeURI = 0;
@@ -165,6 +171,141 @@ DATAOBJECT_VECTOR DataObjectListImpl::getVec() const
     return plist;
 }
 
+const DATAOBJECT_VECTOR& DataObjectListImpl::getDataObjects() const
+{
+    return plist;
+}
+
+bool DataObjectListImpl::indexOf(DataObjectImpl* item, unsigned int& index)
+{
+    unsigned int hint = item->getListIndexHint();
+    if (hint < plist.size() && (DataObjectImpl*) plist[hint] == item)
+    {
+        index = hint;
+        return true;
+    }
+
+    bool found = false;
+    for (unsigned int i = 0; i < plist.size(); i++)
+    {
+        DataObjectImpl* d = plist[i];
+        if (d == 0) continue;
+        if (container != 0 && !isReference)
+        {
+            d->setContainmentHint(pindex, i);
+        }
+        if (d == item)
+        {
+            index = i;
+            found = true;
+        }
+    }
+    return found;
+}
+
+bool DataObjectListImpl::findByPredicate(const SDOString& keyName,
+                                         const SDOString& value,
+                                         DataObjectImpl*& found,
+                                         unsigned int& index)
+{
+    // Only the items of a containment list tell it when their keys
+    // change, so other lists are not indexed.
+    if (isReference || container == 0)
+    {
+        return false;
+    }
+    const TypeImpl* itemType = ((PropertyImpl&) container->getProperty(pindex)).getTypeImpl();
+    if (itemType == 0 || itemType->isDataType())
+    {
+        return false;
+    }
+
+    // The key is resolved in the item type, so that a name and an alias
+    // of the same property find the same index
+    const PropertyImpl* key = itemType->getPropertyImpl(keyName);
+    if (key == 0)
+    {
+        return false;
+    }
+
+    SDOPredicateIndex* predicateIndex = 0;
+    for (unsigned int i = 0; i < predicateIndexes.size(); i++)
+    {
+        if (predicateIndexes[i]->getKeyProperty() == key)
+        {
+            predicateIndex = predicateIndexes[i];
+            break;
+        }
+    }
+
+    if (predicateIndex == 0)
+    {
+        if (plist.size() < SDO_PREDICATE_INDEX_MIN_SIZE)
+        {
+            return false;
+        }
+
+        predicateIndex = new SDOPredicateIndex(key);
+        for (unsigned int i = 0; i < plist.size() && predicateIndex->isUsable(); i++)
+        {
+            predicateIndex->add(plist[i]);
+        }
+        predicateIndexes.push_back(predicateIndex);
+        if (predicateIndex->isUsable())
+        {
+            key->setPredicateKey();
+            container->setPredicateIndexed();
+        }
+    }
+
+    if (!predicateIndex->isUsable())
+    {
+        return false;
+    }
+
+    // Where keys are repeated the first match in the list is the one found
+    std::vector<DataObjectImpl*> candidates;
+    predicateIndex->find(value, candidates);
+    found = 0;
+    for (unsigned int i = 0; i < candidates.size(); i++)
+    {
+        unsigned int position;
+        if (indexOf(candidates[i], position) && (found == 0 || position < index))
+        {
+            found = candidates[i];
+            index = position;
+        }
+    }
+    return true;
+}
+
+void DataObjectListImpl::predicateKeyChanged(DataObjectImpl* item, const PropertyImpl* key)
+{
+    for (unsigned int i = 0; i < predicateIndexes.size(); i++)
+    {
+        if (predicateIndexes[i]->getKeyProperty() == key)
+        {
+            predicateIndexes[i]->update(item);
+        }
+    }
+}
+
+void DataObjectListImpl::predicateItemAdded(DataObjectImpl* item)
+{
+    for (unsigned int i = 0; i < predicateIndexes.size(); i++)
+    {
+        predicateIndexes[i]->add(item);
+    }
+}
+
+void DataObjectListImpl::predicateItemRemoved(DataObjectImpl* item)
+{
+    for (unsigned int i = 0; i < predicateIndexes.size(); i++)
+    {
+        predicateIndexes[i]->remove(item);
+    }
+}
+
 
 
 const Type& DataObjectListImpl::getType()
@@ -189,6 +330,47 @@ const Type::Types DataObjectListImpl::getTypeEnum()
     return theFactory->getType(typeURI, typeName).getTypeEnum();
 }
 
+DataObjectListImpl* DataObjectListImpl::cloneList(DataObjectImpl* cont,
+                                                  ClonedObjects& copies)
+{
+    DataObjectListImpl* copy = new DataObjectListImpl(theFactory, cont, pindex,
+                                                      typeURI, typeName);
+    copy->typeUnset = typeUnset;
+
+    if (!isReference)
+    {
+        copy->plist.reserve(plist.size());
+        for (unsigned int i = 0; i < plist.size(); i++)
+        {
+            DataObjectImpl* item = plist[i];
+            DataObjectImpl* itemCopy = item->cloneTree(copies);
+            itemCopy->setContainer(cont);
+            itemCopy->setContainmentHint(pindex, i);
+            copy->plist.push_back(RefCountingPointer<DataObjectImpl>(itemCopy));
+        }
+    }
+    return copy;
+}
+
+void DataObjectListImpl::cloneReferences(DataObjectListImpl* copy,
+                                         const ClonedObjects& copies)
+{
+    if (!isReference)
+    {
+        return;
+    }
+
+    copy->plist.reserve(plist.size());
+    for (unsigned int i = 0; i < plist.size(); i++)
+    {
+        DataObjectImpl* target = copies.find(plist[i]);
+        if (target != 0)
+        {
+            copy->plist.push_back(RefCountingPointer<DataObjectImpl>(target));
+        }
+    }
+}
+
 
 void DataObjectListImpl::insert (unsigned int index, DataObjectPtr d)
 {
@@ -261,6 +443,12 @@ void DataObjectListImpl::insert (unsigned int index, DataObjectPtr d)
     }
 
     plist.insert(plist.begin()+index, RefCountingPointer<DataObjectImpl>((DataObjectImpl*)dob));
+    if (!isReference)
+    {
+        // the items after it now have stale positions, found again when needed
+        ((DataObjectImpl*)dob)->setContainmentHint(pindex, index);
+        predicateItemAdded((DataObjectImpl*)dob);
+    }
 
     if (container != 0) 
     {
@@ -310,12 +498,10 @@ void DataObjectListImpl::checkType(const Type& listType, const Type& objectType)
             (objectType.getURI(),objectType.getName());
         if (ti != 0)
         {
-            do  
+            if (ti->isDerivedFrom(listType))
             {
-                ti  = (const TypeImpl*)ti->getBaseType();
-                if (ti == 0) break;
-                if (listType.equals(*ti)) return;
-            } while (ti != 0);
+                return;
+            }
 
             // allow types of any substitutes
             if (container != 0)
@@ -410,7 +596,13 @@ void DataObjectListImpl::append (DataObjectPtr d)
       container->logChange(pindex);
    }
 
-   for (unsigned int i = 0; i < plist.size(); i++)
+   // An object which is not contained anywhere cannot be in a
+   // containment list, so only the others need to be looked for.
+   DataObject* candidate = d;
+   bool mayBeListed = isReference ||
+      ((DataObjectImpl*) candidate)->getContainerImpl() != 0;
+
+   for (unsigned int i = 0; mayBeListed && i < plist.size(); i++)
    {
       if (plist[i] == d)
       {
@@ -463,6 +655,11 @@ void DataObjectListImpl::append (DataObjectPtr d)
       }
    }
    plist.push_back(RefCountingPointer<DataObjectImpl>((DataObjectImpl*) dob));
+   if (!isReference)
+   {
+      ((DataObjectImpl*) dob)->setContainmentHint(pindex, plist.size() - 1);
+      predicateItemAdded((DataObjectImpl*) dob);
+   }
 
    if (container != 0) {
       if (container->getType().isSequencedType())
@@ -826,6 +1023,7 @@ RefCountingPointer<DataObject> DataObjectListImpl::remove(unsigned int index)
             (getVec()[index])->logDeletion();
         }
     }
+    predicateItemRemoved(plist[index]);
     plist.erase(plist.begin()+index);
     DataObject* dob = d;
     ((DataObjectImpl*)dob)->setContainer(0);
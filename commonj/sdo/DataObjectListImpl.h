@@ -25,6 +25,7 @@
 #include "commonj/sdo/DataObjectList.h"
 #include "commonj/sdo/SDODate.h"
 #include "commonj/sdo/SDOValue.h"
+#include "commonj/sdo/SDOArena.h"
 
 #include "commonj/sdo/disable_warn.h"
 
@@ -35,7 +36,10 @@ namespace commonj{
 namespace sdo{
 
 class DataObjectImpl;
+class PropertyImpl;
 class DataFactory;
+class ClonedObjects;
+class SDOPredicateIndex;
 
 typedef std::vector< RefCountingPointer<DataObjectImpl> > DATAOBJECT_VECTOR;
 
@@ -52,6 +56,10 @@ class DataObjectListImpl : public DataObjectList
 {
 
 public:
+
+    // Allocated from the current SDOArena, if any
+    SDO_ARENA_ALLOCATED
+
     DataObjectListImpl(DATAOBJECT_VECTOR p);
     DataObjectListImpl(const DataObjectListImpl &pin);
     DataObjectListImpl();
@@ -66,6 +74,47 @@ public:
     virtual DataObjectPtr operator[] (unsigned int pos);
     virtual const DataObjectPtr operator[] (unsigned int pos) const;
 
+    /*  getDataObjects returns the items of the list
+     *
+     * Returns the list's own vector, for callers which walk the list
+     * without checking each index. For a list of data types the items
+     * are the objects holding the values.
+     */
+
+    const DATAOBJECT_VECTOR& getDataObjects() const;
+
+    /*  indexOf finds the position of an item in the list
+     *
+     * The position recorded in the item is used if it is still right.
+     * Otherwise the list is searched, and the positions of all the items
+     * of a containment list are recorded again.
+     * Returns false if the item is not in the list.
+     */
+
+    bool indexOf(DataObjectImpl* item, unsigned int& index);
+
+    /*  findByPredicate answers a path step such as depts[number=10]
+     *
+     * The first item whose keyName property matches value is found through
+     * an index of that property, built the first time it is asked for.
+     * keyName may be the name or an alias of a property of the item type.
+     * Returns false if the list is not indexed for keyName, such as a short
+     * list or one of references, and the caller must search it instead.
+     * Otherwise found is the item, or 0 if none matches, and index is its
+     * position.
+     */
+
+    bool findByPredicate(const SDOString& keyName, const SDOString& value,
+                         DataObjectImpl*& found, unsigned int& index);
+
+    /*  predicateKeyChanged keeps the index of key up to date
+     *
+     * Called by an item of the list when the value of its property key
+     * has been set or unset.
+     */
+
+    void predicateKeyChanged(DataObjectImpl* item, const PropertyImpl* key);
+
     // set/get primitive values 
     virtual bool getBoolean(unsigned int index) const;
     virtual char getByte(unsigned int index) const;
@@ -173,6 +222,23 @@ public:
 
     virtual const Type::Types getTypeEnum();
 
+    /**
+     * cloneList creates a list like this one for cont, the copy of its
+     * container, holding copies of its items. The items of a list of
+     * references are added by cloneReferences once the whole tree has
+     * been copied.
+     */
+    virtual DataObjectListImpl* cloneList(DataObjectImpl* cont,
+                                          ClonedObjects& copies);
+
+    /**
+     * cloneReferences appends to copy, made by cloneList, the copies of
+     * the objects in this list of references. Objects which were not
+     * copied are left out.
+     */
+    virtual void cloneReferences(DataObjectListImpl* copy,
+                                 const ClonedObjects& copies);
+
 
 private: 
     DATAOBJECT_VECTOR plist;
@@ -195,6 +261,11 @@ private:
     unsigned int pindex;
     bool isReference;
 
+    // Indexes of key properties used in predicates, built on demand
+    std::vector<SDOPredicateIndex*> predicateIndexes;
+    void predicateItemAdded(DataObjectImpl* item);
+    void predicateItemRemoved(DataObjectImpl* item);
+
     void validateIndex(unsigned int index) const;
 
     static const SDOString BooleanLiteral;
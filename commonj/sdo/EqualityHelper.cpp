@@ -26,10 +26,16 @@
 
 #include "commonj/sdo/DataObject.h"
 
-
+#include "commonj/sdo/DataObjectImpl.h"
+#include "commonj/sdo/DataObjectListImpl.h"
+#include "commonj/sdo/PropertyImpl.h"
+#include "commonj/sdo/TypeImpl.h"
 
 #include "commonj/sdo/EqualityHelper.h"
 
+#include <string.h>
+#include <vector>
+
 namespace commonj{
 namespace sdo{
 
@@ -366,7 +372,451 @@ namespace sdo{
         } 
         return true;
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Structural equality and hashing, reading the value holders of the
+    // data objects directly.
+    ///////////////////////////////////////////////////////////////////////////
+
+#if defined(WIN32)  || defined (_WINDOWS)
+    typedef unsigned __int64 StructureHashValue;
+#else
+    typedef uint64_t StructureHashValue;
+#endif
+
+    // 64 bit FNV-1a. Values are added a byte at a time, least significant
+    // first, so the hash does not depend on the byte order.
+    class StructureHash
+    {
+    public:
+        StructureHash() : value(14695981039346656037ULL)
+        {
+        }
+
+        void add(unsigned char c)
+        {
+            value = (value ^ c) * 1099511628211ULL;
+        }
+
+        void add32(unsigned long l)
+        {
+            for (int i = 0; i < 4; i++, l >>= 8)
+            {
+                add((unsigned char) (l & 0xFF));
+            }
+        }
+
+        void add64(StructureHashValue l)
+        {
+            for (int i = 0; i < 8; i++, l >>= 8)
+            {
+                add((unsigned char) (l & 0xFF));
+            }
+        }
+
+        void addString(const char* s)
+        {
+            for (; *s != 0; s++)
+            {
+                add((unsigned char) *s);
+            }
+            add(0);
+        }
+
+        StructureHashValue value;
+    };
+
+    // The characters of a text value, taken in place when the value is
+    // held as text. They are widened (or narrowed, for bytes) as the
+    // getString and getBytes getters would.
+    class StructureText
+    {
+    public:
+        StructureText(const SDOValue& sval, bool inbytes)
+            : narrow(0), wide(0), length(0), bytes(inbytes)
+        {
+            const SDOString* text = sval.getTextString();
+            if (text == 0)
+            {
+                wide = sval.getWideString(length);
+                if (wide != 0)
+                {
+                    return;
+                }
+                converted = sval.getCString();
+                text = &converted;
+            }
+            narrow = text->data();
+            length = text->length();
+        }
+
+        unsigned long unit(unsigned int i) const
+        {
+            if (bytes)
+            {
+                return (unsigned char) (narrow != 0 ? narrow[i] : (char) wide[i]);
+            }
+            return (unsigned long) (narrow != 0 ? (wchar_t) narrow[i] : wide[i]);
+        }
+
+        const char* narrow;
+        const wchar_t* wide;
+        unsigned int length;
+
+    private:
+        bool bytes;
+        SDOString converted;
+    };
+
+    static bool isTextType(Type::Types t)
+    {
+        switch (t)
+        {
+        case Type::BigDecimalType:
+        case Type::BigIntegerType:
+        case Type::UriType:
+        case Type::StringType:
+        case Type::BytesType:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    static bool equalSDOValues(const SDOValue& v1, const SDOValue& v2, Type::Types t)
+    {
+        switch (t)
+        {
+        case Type::BooleanType:
+            return v1.getBoolean() == v2.getBoolean();
+        case Type::ByteType:
+            return v1.getByte() == v2.getByte();
+        case Type::CharacterType:
+            return v1.getCharacter() == v2.getCharacter();
+        case Type::ShortType:
+            return v1.getShort() == v2.getShort();
+        case Type::IntegerType:
+            return v1.getInteger() == v2.getInteger();
+        case Type::LongType:
+            return v1.getLong() == v2.getLong();
+        case Type::FloatType:
+            return v1.getFloat() == v2.getFloat();
+        case Type::DoubleType:
+            return v1.getDouble() == v2.getDouble();
+        case Type::DateType:
+            return v1.getDate().getTime() == v2.getDate().getTime();
+        default:
+            if (isTextType(t))
+            {
+                StructureText text1(v1, t == Type::BytesType);
+                StructureText text2(v2, t == Type::BytesType);
+                if (text1.length != text2.length) return false;
+                for (unsigned int i = 0; i < text1.length; i++)
+                {
+                    if (text1.unit(i) != text2.unit(i)) return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    static void hashSDOValue(StructureHash& h, const SDOValue& sval, Type::Types t)
+    {
+        switch (t)
+        {
+        case Type::BooleanType:
+            h.add(sval.getBoolean() ? 1 : 0);
+            break;
+        case Type::ByteType:
+            h.add64((StructureHashValue) (int64_t) sval.getByte());
+            break;
+        case Type::CharacterType:
+            h.add64((StructureHashValue) (int64_t) sval.getCharacter());
+            break;
+        case Type::ShortType:
+            h.add64((StructureHashValue) (int64_t) sval.getShort());
+            break;
+        case Type::IntegerType:
+            h.add64((StructureHashValue) (int64_t) sval.getInteger());
+            break;
+        case Type::LongType:
+            h.add64((StructureHashValue) sval.getLong());
+            break;
+        case Type::FloatType:
+        case Type::DoubleType:
+            {
+                double d = (t == Type::FloatType) ? sval.getFloat() : (double) sval.getDouble();
+                if (d == 0)
+                {
+                    d = 0; // -0 equals 0
+                }
+                StructureHashValue bits;
+                memcpy(&bits, &d, sizeof(bits));
+                h.add64(bits);
+            }
+            break;
+        case Type::DateType:
+            h.add64((StructureHashValue) (int64_t) sval.getDate().getTime());
+            break;
+        default:
+            if (isTextType(t))
+            {
+                StructureText text(sval, t == Type::BytesType);
+                h.add32(text.length);
+                for (unsigned int i = 0; i < text.length; i++)
+                {
+                    h.add32(text.unit(i));
+                }
+            }
+            break;
+        }
+    }
+
+    // A property whose values are held in a list.
+    static bool isListProperty(const PropertyImpl& p)
+    {
+        return p.isMany() || p.getTypeImpl()->isFromList();
+    }
+
+    // The primitive value of a holder, or 0 if it is null.
+    static const SDOValue* holderValue(DataObjectImpl* holder)
+    {
+        if (holder == 0 || holder->isNull())
+        {
+            return 0;
+        }
+        PropertyImpl* pd;
+        const SDOValue& sval = holder->getSDOValue(&pd);
+        if (!sval.isSet() || sval.isNull())
+        {
+            return 0;
+        }
+        return &sval;
+    }
+
+    // The type a value is compared as - that of its property, or for
+    // the items of an open list, that of the item.
+    static const TypeImpl& valueType(DataObjectImpl* value, const PropertyImpl& p)
+    {
+        if (p.getTypeImpl()->isDataType())
+        {
+            return *p.getTypeImpl();
+        }
+        return value->getTypeImpl();
+    }
+
+    static bool equalObjects(DataObjectImpl* do1, DataObjectImpl* do2);
+    static StructureHashValue hashObject(DataObjectImpl* dob);
+
+    static bool equalValues(DataObjectImpl* v1, DataObjectImpl* v2, const PropertyImpl& p)
+    {
+        if (v1 == v2) return true;
+
+        bool null1 = (v1 == 0) || v1->isNull();
+        bool null2 = (v2 == 0) || v2->isNull();
+        if (null1 || null2) return null1 && null2;
+
+        const TypeImpl& t1 = valueType(v1, p);
+        const TypeImpl& t2 = valueType(v2, p);
+        if (t1.isDataType() != t2.isDataType()) return false;
+
+        if (t1.isDataType())
+        {
+            if (t1.getTypeEnum() != t2.getTypeEnum()) return false;
+            const SDOValue* s1 = holderValue(v1);
+            const SDOValue* s2 = holderValue(v2);
+            if (s1 == 0 || s2 == 0) return s1 == s2;
+            return equalSDOValues(*s1, *s2, t1.getTypeEnum());
+        }
+        if (p.isReference())
+        {
+            return strcmp(v1->objectToXPath(), v2->objectToXPath()) == 0;
+        }
+        return equalObjects(v1, v2);
+    }
+
+    static void hashValue(StructureHash& h, DataObjectImpl* v, const PropertyImpl& p)
+    {
+        if (v == 0 || v->isNull())
+        {
+            h.add(0);
+            return;
+        }
+        const TypeImpl& t = valueType(v, p);
+        if (t.isDataType())
+        {
+            const SDOValue* sval = holderValue(v);
+            if (sval == 0)
+            {
+                h.add(0);
+                return;
+            }
+            h.add(1);
+            hashSDOValue(h, *sval, t.getTypeEnum());
+        }
+        else if (p.isReference())
+        {
+            h.add(2);
+            h.addString(v->objectToXPath());
+        }
+        else
+        {
+            h.add(3);
+            h.add64(hashObject(v));
+        }
+    }
+
+    static const DATAOBJECT_VECTOR* listItems(DataObjectImpl* holder)
+    {
+        if (holder == 0) return 0;
+        DataObjectListImpl* dl = holder->getListImpl();
+        if (dl == 0 || dl->size() == 0) return 0;
+        return &dl->getDataObjects();
+    }
+
+    static DataObjectImpl* listItem(const DATAOBJECT_VECTOR& items, unsigned int i)
+    {
+        return !items[i] ? 0 : (DataObjectImpl*) &*items[i];
+    }
+
+    static bool equalObjects(DataObjectImpl* do1, DataObjectImpl* do2)
+    {
+        if (do1 == do2) return true;
+
+        std::vector<DataObjectImpl*> values1, values2;
+        std::vector<bool> set1, set2;
+        do1->getPropertySlots(values1, set1);
+        do2->getPropertySlots(values2, set2);
+        if (values1.size() != values2.size()) return false;
+
+        bool sameType = (&do1->getTypeImpl() == &do2->getTypeImpl());
+        unsigned int typeProperties = do1->getTypeImpl().getPropertiesSize();
+
+        for (unsigned int i = 0; i < values1.size(); i++)
+        {
+            const PropertyImpl* p1 = do1->getPropertyImpl(i);
+            unsigned int j = i;
+
+            if (!sameType || i >= typeProperties)
+            {
+                const PropertyImpl* p2 = do2->getPropertyImpl(SDOString(p1->getName()));
+                if (p2 == 0) return false;
+                if (p1 != p2)
+                {
+                    if ((p1->isMany() != p2->isMany()) ||
+                        (p1->getTypeEnum() != p2->getTypeEnum()) ||
+                        (p1->getType().isDataObjectType() &&
+                         (p1->isContainment() != p2->isContainment())) ||
+                        (p1->isReadOnly() != p2->isReadOnly()))
+                    {
+                        return false;
+                    }
+                }
+                j = do2->getPropertyIndex(*p2);
+                if (j >= values2.size()) return false;
+            }
+
+            if (p1->getTypeEnum() == Type::ChangeSummaryType)
+            {
+                continue;
+            }
+
+            if (isListProperty(*p1))
+            {
+                // An empty list is the same as an unset one
+                const DATAOBJECT_VECTOR* items1 = listItems(values1[i]);
+                const DATAOBJECT_VECTOR* items2 = listItems(values2[j]);
+                if (items1 == 0 || items2 == 0)
+                {
+                    if (items1 != items2) return false;
+                    continue;
+                }
+                if (items1->size() != items2->size()) return false;
+                for (unsigned int k = 0; k < items1->size(); k++)
+                {
+                    if (!equalValues(listItem(*items1, k), listItem(*items2, k), *p1))
+                    {
+                        return false;
+                    }
+                }
+            }
+            else
+            {
+                if (set1[i] != set2[j]) return false;
+                if (set1[i] && !equalValues(values1[i], values2[j], *p1))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static StructureHashValue hashObject(DataObjectImpl* dob)
+    {
+        std::vector<DataObjectImpl*> values;
+        std::vector<bool> set;
+        dob->getPropertySlots(values, set);
+
+        // Properties are matched by name, not position, so their hashes
+        // are combined in a way which does not depend on the order.
+        StructureHashValue properties = 0;
+
+        for (unsigned int i = 0; i < values.size(); i++)
+        {
+            const PropertyImpl* p = dob->getPropertyImpl(i);
+            if (p->getTypeEnum() == Type::ChangeSummaryType)
+            {
+                continue;
+            }
+
+            StructureHash h;
+            if (isListProperty(*p))
+            {
+                const DATAOBJECT_VECTOR* items = listItems(values[i]);
+                if (items == 0) continue;
+                h.addString(p->getName());
+                h.add32(items->size());
+                for (unsigned int k = 0; k < items->size(); k++)
+                {
+                    hashValue(h, listItem(*items, k), *p);
+                }
+            }
+            else
+            {
+                if (!set[i]) continue;
+                h.addString(p->getName());
+                hashValue(h, values[i], *p);
+            }
+            properties += h.value;
+        }
+
+        StructureHash h;
+        h.add32(values.size());
+        h.add64(properties);
+        return h.value;
+    }
+
+    bool EqualityHelper::equalStructure(DataObjectPtr dataObject1, DataObjectPtr dataObject2)
+    {
+        DataObject* dob1 = dataObject1;
+        DataObject* dob2 = dataObject2;
+        if (dob1 == 0 || dob2 == 0)
+        {
+            return dob1 == dob2;
+        }
+        return equalObjects((DataObjectImpl*) dob1, (DataObjectImpl*) dob2);
+    }
+
+    int64_t EqualityHelper::hash(DataObjectPtr dataObject)
+    {
+        DataObject* dob = dataObject;
+        if (dob == 0)
+        {
+            return 0;
+        }
+        return (int64_t) hashObject((DataObjectImpl*) dob);
+    }
     
 }
 };
-
@@ -81,6 +81,38 @@ namespace sdo{
     */
     static SDO_API bool equal(DataObjectPtr dataObject1, DataObjectPtr dataObject2);
 
+    /**
+    *  Structural compare of DataObjects
+    *    Compares the instance properties of dataObject1 and dataObject2
+    *      by name, and the values of those which are set, and all their
+    *      contained DataObjects recursively. The types need not be the
+    *      same, only their properties.
+    *    Values are compared as the type of their property, so a value
+    *      set as a string on an integer property equals the same integer.
+    *    A referenced DataObject is compared by its path from the root
+    *      of its tree rather than by value. Change summaries are not
+    *      compared.
+    *    The values are read from the objects directly, and the compare
+    *      stops at the first difference.
+    *
+    *  @param dataObject1 DataObject to be compared
+    *  @param dataObject2 DataObject to be compared
+    *  @return true if the trees have the same properties and values
+    */
+    static SDO_API bool equalStructure(DataObjectPtr dataObject1, DataObjectPtr dataObject2);
+
+    /**
+    *  Structural hash of a DataObject tree
+    *    Returns a 64 bit hash of what equalStructure compares, so trees
+    *      which compare equal have the same hash. The hash does not depend
+    *      on the order of the properties, nor on the process, so it may
+    *      be kept and compared later on the same platform.
+    *
+    *  @param dataObject DataObject to be hashed
+    *  @return the hash
+    */
+    static SDO_API int64_t hash(DataObjectPtr dataObject);
+
     private: 
 
     static bool internalEqual(DataObjectPtr dataObject1,
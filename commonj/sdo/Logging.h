@@ -51,6 +51,16 @@
 #define OUTDENT -1
 #define NODENT 0
 
+/**
+ * Compile time ceiling on trace points. Trace points more detailed than
+ * this level are removed entirely, so that they cost nothing even in
+ * debug builds. Define SDO_MAX_LOG_LEVEL=HIGHVOLUME to keep them all.
+ */
+
+#ifndef SDO_MAX_LOG_LEVEL
+#define SDO_MAX_LOG_LEVEL INFO
+#endif
+
 
 /**
  * Macro for simplifying addition of trace points
@@ -58,63 +68,63 @@
 
 #ifdef _DEBUG
 #define LOGENTRY(level, methodName) \
-if (Logger::loggingLevel >= level) \
+if ((level) <= SDO_MAX_LOG_LEVEL && Logger::loggingLevel >= level) \
 Logger::logArgs(INDENT, level, "Entering: %s", methodName);
 
 /**
  * Macro for simplifying addition of trace points
  */
 #define LOGEXIT(level, methodName) \
-if (Logger::loggingLevel >= level) \
+if ((level) <= SDO_MAX_LOG_LEVEL && Logger::loggingLevel >= level) \
 Logger::logArgs(OUTDENT, level, "Exiting: %s" ,methodName);
 
 /**
  * Macro for simplifying addition of trace points
  */
 #define LOGINFO(level, message) \
-if (Logger::loggingLevel >= level) \
+if ((level) <= SDO_MAX_LOG_LEVEL && Logger::loggingLevel >= level) \
 Logger::log(NODENT, level, message);
 
 /**
  * Macro for simplifying addition of trace points
  */
 #define LOGINFO_1(level, message, arg1) \
-if (Logger::loggingLevel >= level) \
+if ((level) <= SDO_MAX_LOG_LEVEL && Logger::loggingLevel >= level) \
 Logger::logArgs(NODENT,level, message, arg1);
 
 /**
  * Macro for simplifying addition of trace points
  */
 #define LOGINFO_2(level, message, arg1, arg2) \
-if (Logger::loggingLevel >= level) \
+if ((level) <= SDO_MAX_LOG_LEVEL && Logger::loggingLevel >= level) \
 Logger::logArgs(NODENT,level, message, arg1, arg2);
 
 /**
  * Macro for simplifying addition of trace points
  */
 #define LOGERROR(level, message) \
-if (Logger::loggingLevel >= level) \
+if ((level) <= SDO_MAX_LOG_LEVEL && Logger::loggingLevel >= level) \
 Logger::log(NODENT,level, message);
 
 /**
  * Macro for simplifying addition of trace points
  */
 #define LOGERROR_1(level, message, arg1) \
-if (Logger::loggingLevel >= level) \
+if ((level) <= SDO_MAX_LOG_LEVEL && Logger::loggingLevel >= level) \
 Logger::logArgs(NODENT,level, message, arg1);
 
 /**
  * Macro for simplifying addition of trace points
  */
 #define LOGERROR_2(level, message, arg1, arg2) \
-if (Logger::loggingLevel >= level) \
+if ((level) <= SDO_MAX_LOG_LEVEL && Logger::loggingLevel >= level) \
 Logger::logArgs(NODENT,level, message, arg1, arg2);
 
 /**
  * Macro for simplifying addition of trace points
  */
 #define LOGSDOEXCEPTION(level, message, arg1) \
-if (Logger::loggingLevel >= level) \
+if ((level) <= SDO_MAX_LOG_LEVEL && Logger::loggingLevel >= level) \
 Logger::log(NODENT,level, message);\
 Logger::logArgs(NODENT,level, "%s:%s\nIn %s\nAt %s line %ld\n",\
                 ((SDORuntimeException)arg1).getEClassName(),\
@@ -85,7 +85,9 @@ namespace commonj{
           bisReadOnly(ro),
           bisContainer(contain),
           bDefaulted(false),
-          bisReference(false)
+          bisReference(false),
+          index(0),
+          predicateKey(false)
        {
           if (inname != 0)
           {
@@ -119,7 +121,9 @@ namespace commonj{
           stringdef(0),
           defvalue(0),
           defvaluelength(0),
-          bisReference(false)
+          bisReference(false),
+          index(0),
+          predicateKey(false)
        {
           if (contain == false && intype.isDataObjectType())
           {
@@ -140,7 +144,9 @@ namespace commonj{
           defvalue(0),
           defvaluelength(0),
           stringdef(0),
-          bisReference(false)
+          bisReference(false),
+          index(p.index),
+          predicateKey(false)
        {
           if (bisContainer == false && type.isDataObjectType())
           {
@@ -587,6 +593,26 @@ namespace commonj{
     {
           return bisReadOnly;
     }
+
+    unsigned int PropertyImpl::getIndex() const
+    {
+        return index;
+    }
+
+    void PropertyImpl::setIndex(unsigned int inindex)
+    {
+        index = inindex;
+    }
+
+    bool PropertyImpl::isPredicateKey() const
+    {
+        return predicateKey;
+    }
+
+    void PropertyImpl::setPredicateKey() const
+    {
+        predicateKey = true;
+    }
   
 };
 };
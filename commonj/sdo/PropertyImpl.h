@@ -252,6 +252,24 @@ class PropertyImpl :public DASProperty
     */
     virtual bool SDO_API isReadOnly() const;
 
+    /**
+     * The position of this property in the properties of its containing
+     * type. Derived types list the properties of their base type first,
+     * so the position is the same in every type derived from it.
+     * Set when the containing type is resolved.
+     */
+    SDO_API unsigned int getIndex() const;
+    SDO_API void setIndex(unsigned int index);
+
+    /**
+     * Whether a list of objects of the containing type keeps a predicate
+     * index of this property, so that setting it must update the index.
+     * Once set it stays set; derived types share the property, so their
+     * objects are covered too.
+     */
+    SDO_API bool isPredicateKey() const;
+    SDO_API void setPredicateKey() const;
+
     SDO_API PropertyImpl(const PropertyImpl& p);
 
   private:
@@ -277,6 +295,10 @@ class PropertyImpl :public DASProperty
     // in the event of a bytes and string, this holds the length
     unsigned int defvaluelength;
 
+    unsigned int index;
+
+    mutable bool predicateKey;
+
     // alias support
     // std::vector<char*> aliases;
     std::vector<SDOString> aliases;
@@ -48,12 +48,12 @@ SDO_API PropertyList::PropertyList(PROPERTY_LIST p)
 
 SDO_API PropertyList::PropertyList(PROPERTY_VECTOR p) 
 {
-    plist = PROPERTY_VECTOR(p);
+    plist.swap(p);
 }
 
 SDO_API PropertyList::PropertyList(const PropertyList &pin)
+    : plist(pin.plist)
 {
-    plist = PROPERTY_VECTOR(pin.getVec());
 }
 
 SDO_API PropertyList::PropertyList()
@@ -21,6 +21,7 @@
 
 #include "commonj/sdo/RefCountingObject.h"
 #include "commonj/sdo/Logging.h"
+#include "commonj/sdo/SDOAtomic.h"
 
 #include <iostream>
 using namespace std;
@@ -33,13 +34,13 @@ long RefCountingObject::allObs = 0;
 RefCountingObject::RefCountingObject()
 : refCount(0)
 {
-    LOGINFO_2(HIGHVOLUME,"RCO:CREATE:%p Count:%ld",this, ++allObs);
+    LOGINFO_2(HIGHVOLUME,"RCO:CREATE:%p Count:%ld",this, SDO_ATOMIC_INCREMENT(&allObs));
 }
 
 RefCountingObject::RefCountingObject(const RefCountingObject& rc)
 : refCount(0)
 {
-    LOGINFO_2(HIGHVOLUME,"RCO:COPCON:%p Count:%ld",this,++allObs);
+    LOGINFO_2(HIGHVOLUME,"RCO:COPCON:%p Count:%ld",this, SDO_ATOMIC_INCREMENT(&allObs));
 }
 
 RefCountingObject& RefCountingObject::operator=(const RefCountingObject& rc)
@@ -49,7 +50,7 @@ RefCountingObject& RefCountingObject::operator=(const RefCountingObject& rc)
 
 RefCountingObject::~RefCountingObject()
 {
-    LOGINFO_2(HIGHVOLUME,"RCO:DELETE:%p Count:%ld",this, --allObs);
+    LOGINFO_2(HIGHVOLUME,"RCO:DELETE:%p Count:%ld",this, SDO_ATOMIC_DECREMENT(&allObs));
     //
     //if (allObs < 0) 
     //    LOGINFO(HIGHVOLUME,"RCO:More objects deleted than created");
@@ -60,15 +61,15 @@ RefCountingObject::~RefCountingObject()
 void RefCountingObject::addRef()
 
 {
-    
-    ++refCount;
-     LOGINFO_2(HIGHVOLUME,"RCO:ADDREF:%p:%ld",this,refCount);
+    SDO_ATOMIC_INCREMENT(&refCount);
+    LOGINFO_2(HIGHVOLUME,"RCO:ADDREF:%p:%ld",this,refCount);
 }
 
 void RefCountingObject::releaseRef()
 {
-    LOGINFO_2(HIGHVOLUME,"RCO:DECREF:%p:%ld",this,refCount-1);
-    if (--refCount == 0) delete this;
+    long count = SDO_ATOMIC_DECREMENT(&refCount);
+    LOGINFO_2(HIGHVOLUME,"RCO:DECREF:%p:%ld",this,count);
+    if (count == 0) delete this;
 }
 
 
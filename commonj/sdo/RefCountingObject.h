@@ -33,6 +33,8 @@ namespace commonj {
  * RefcountingObject is the base class for all objects in SDO
  * These objects keep a count of references to themselves, then
  * free themselves when they are unused.
+ * The count is only atomic when built with SDO_THREADSAFE_REFCOUNT,
+ * see SDOAtomic.h.
  */
     class RefCountingObject 
     {
@@ -57,7 +59,9 @@ namespace commonj {
 
 
         private:
-        unsigned int refCount;
+        long refCount;
+
+        // Live object count, only reported by HIGHVOLUME tracing
         static long allObs;
     };
 
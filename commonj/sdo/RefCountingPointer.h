@@ -28,6 +28,12 @@
 
 #include <iostream>
 
+// Rvalue references let temporaries hand over their reference instead of
+// taking a new one and dropping the old.
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1600)
+#define SDO_HAS_RVALUE_REFERENCES
+#endif
+
 namespace commonj{
 namespace sdo{
 
@@ -49,6 +55,10 @@ class RefCountingPointer {
         /*SDO_API*/ RefCountingPointer(const RefCountingPointer& rhs);
         /*SDO_API*/ ~RefCountingPointer();
         /*SDO_API*/ RefCountingPointer& operator=(const RefCountingPointer& rhs);
+#ifdef SDO_HAS_RVALUE_REFERENCES
+        /*SDO_API*/ RefCountingPointer(RefCountingPointer&& rhs);
+        /*SDO_API*/ RefCountingPointer& operator=(RefCountingPointer&& rhs);
+#endif
         /*SDO_API*/ bool operator==(RefCountingPointer& test) const;
         /*SDO_API*/ T* operator->() const;
         /*SDO_API*/ T& operator*() const;
@@ -148,6 +158,28 @@ template<class T>
     return *this;
 }
 
+#ifdef SDO_HAS_RVALUE_REFERENCES
+template<class T>
+/*SDO_API*/ RefCountingPointer<T>::RefCountingPointer(RefCountingPointer&& rhs)
+: pointee(rhs.pointee)
+{
+    rhs.pointee = 0;
+}
+
+template<class T>
+/*SDO_API*/ RefCountingPointer<T>& RefCountingPointer<T>::operator=(RefCountingPointer&& rhs)
+{
+    if (this != &rhs)
+    {
+        T *oldP = pointee;
+        pointee = rhs.pointee;
+        rhs.pointee = 0;
+        if (oldP) oldP->releaseRef();
+    }
+    return *this;
+}
+#endif
+
 template<class T>
 /*SDO_API*/ bool RefCountingPointer<T>::operator!() const
 {
@@ -23,6 +23,7 @@
 #include "libxml/SAX2.h"
 #include "commonj/sdo/SDORuntimeException.h"
 #include "commonj/sdo/SDOUtils.h"
+#include "commonj/sdo/SDOStats.h"
 using namespace commonj::sdo;
 
 /**
@@ -332,7 +333,9 @@ namespace commonj
 
          int SAX2Parser::parse(const char* filename)
         {
-            
+            SDOStatsTimer timer(SDOStats::XMLParseMicros);
+            SDOStats::addFileSize(SDOStats::XMLBytesParsed, filename);
+
             parserError = false;
             xmlSAXHandlerPtr handler = &SDOSAX2HandlerStruct;
 
@@ -405,23 +408,29 @@ namespace commonj
  
         void SAX2Parser::stream(std::istream& input)
         {
+            SDOStatsTimer timer(SDOStats::XMLParseMicros);
             char buffer[100];
             xmlSAXHandlerPtr handler = &SDOSAX2HandlerStruct;
             parserError = false;
             xmlParserCtxtPtr ctxt;
+            int64_t total;
 
             input.read(buffer,4);
+            total = input.gcount();
             ctxt = xmlCreatePushParserCtxt(handler, this,
                 buffer, input.gcount(), NULL);
             
             while (input.read(buffer,100))
             {
+                total += input.gcount();
                 xmlParseChunk(ctxt, buffer, input.gcount(), 0);
                 
             }
             
+            total += input.gcount();
             xmlParseChunk(ctxt, buffer, input.gcount(), 1);
             xmlFreeParserCtxt(ctxt);
+            SDOStats::add(SDOStats::XMLBytesParsed, total);
 
             if (parserError)
             {
@@ -432,6 +441,9 @@ namespace commonj
 
         int SAX2Parser::parse_twice(const char* filename)
         {
+            SDOStatsTimer timer(SDOStats::XMLParseMicros);
+            SDOStats::addFileSize(SDOStats::XMLBytesParsed, filename);
+
             parserError = false;
             xmlSAXHandlerPtr handler = &SDOSAX2HandlerStruct;
 
@@ -460,6 +472,7 @@ namespace commonj
         void SAX2Parser::stream_twice(std::istream& input)
         {
 
+            SDOStatsTimer timer(SDOStats::XMLParseMicros);
             std::vector<parse_buf_element> buffer_vec;
             int count = 0;
             parserError = false;
@@ -491,6 +504,8 @@ namespace commonj
             xmlParseChunk(ctxt, buffer_vec[count].buf,
                                 buffer_vec[count].len, 1);
             xmlFreeParserCtxt(ctxt);
+            SDOStats::add(SDOStats::XMLBytesParsed,
+                          (int64_t) bcount + (int64_t) count * 1000 + buffer_vec[count].len);
 
             if (parserError)
             {
@@ -519,6 +534,143 @@ namespace commonj
         }
 
 
+        int SAX2Parser::walk(xmlNodePtr node)
+        {
+            SDOStatsTimer timer(SDOStats::XMLParseMicros);
+            parserError = false;
+
+            if (node != 0 && node->type == XML_DOCUMENT_NODE)
+            {
+                node = xmlDocGetRootElement((xmlDocPtr)node);
+            }
+            if (node == 0 || node->type != XML_ELEMENT_NODE)
+            {
+                SDO_THROW_EXCEPTION("walk", SDOXMLParserException,
+                    "walk - the node is neither an element nor a document with a root element");
+            }
+
+            startDocument();
+            walkElement(node, true);
+            if (!parserError)
+            {
+                endDocument();
+            }
+
+            if (parserError)
+            {
+               SDO_THROW_EXCEPTION("walk", SDOXMLParserException,messageBuffer);
+            }
+            return 0;
+        }
+
+        void SAX2Parser::walkElement(xmlNodePtr node, bool topElement)
+        {
+            // prefix/URI pairs, as the parser hands them to sdo_startElementNs
+            std::vector<const xmlChar*> namespaces;
+            if (topElement)
+            {
+                // Declarations made further up the tree are still in scope
+                xmlNsPtr* inScope = xmlGetNsList(node->doc, node);
+                if (inScope != 0)
+                {
+                    for (int i = 0; inScope[i] != 0; i++)
+                    {
+                        namespaces.push_back(inScope[i]->prefix);
+                        namespaces.push_back(inScope[i]->href);
+                    }
+                    xmlFree(inScope);
+                }
+            }
+            else
+            {
+                for (xmlNsPtr ns = node->nsDef; ns != 0; ns = ns->next)
+                {
+                    namespaces.push_back(ns->prefix);
+                    namespaces.push_back(ns->href);
+                }
+            }
+
+            // localname/prefix/URI/value/end, as for sdo_startElementNs
+            std::vector<const xmlChar*> attrs;
+            std::vector<xmlChar*> values;
+            for (xmlAttrPtr attr = node->properties; attr != 0; attr = attr->next)
+            {
+                const xmlChar* value = 0;
+                xmlNodePtr text = attr->children;
+                if (text != 0 && text->next == 0 && text->type == XML_TEXT_NODE)
+                {
+                    value = text->content;
+                }
+                else if (text != 0)
+                {
+                    // entity references have to be expanded into a copy
+                    xmlChar* expanded = xmlNodeListGetString(node->doc, text, 1);
+                    values.push_back(expanded);
+                    value = expanded;
+                }
+                if (value == 0)
+                {
+                    value = (const xmlChar*)"";
+                }
+                attrs.push_back(attr->name);
+                attrs.push_back(attr->ns != 0 ? attr->ns->prefix : 0);
+                attrs.push_back(attr->ns != 0 ? attr->ns->href : 0);
+                attrs.push_back(value);
+                attrs.push_back(value + xmlStrlen(value));
+            }
+
+            const xmlChar* prefix = node->ns != 0 ? node->ns->prefix : 0;
+            const xmlChar* uri = node->ns != 0 ? node->ns->href : 0;
+
+            SAX2Namespaces elementNamespaces(namespaces.size() / 2,
+                namespaces.empty() ? 0 : &namespaces[0]);
+            SAX2Attributes elementAttributes(attrs.size() / 5, 0,
+                attrs.empty() ? 0 : &attrs[0]);
+            for (unsigned int i = 0; i < values.size(); i++)
+            {
+                if (values[i] != 0) xmlFree(values[i]);
+            }
+
+            if (parserError) return;
+            startElementNs(node->name, prefix, uri, elementNamespaces, elementAttributes);
+
+            for (xmlNodePtr child = node->children;
+                 child != 0 && !parserError;
+                 child = child->next)
+            {
+                switch (child->type)
+                {
+                case XML_ELEMENT_NODE:
+                    walkElement(child, false);
+                    break;
+                case XML_TEXT_NODE:
+                    characters(SDOXMLString(child->content));
+                    break;
+                case XML_CDATA_SECTION_NODE:
+                    sdo_cdataBlock(this, child->content, xmlStrlen(child->content));
+                    break;
+                case XML_ENTITY_REF_NODE:
+                    {
+                        xmlChar* content = xmlNodeGetContent(child);
+                        if (content != 0)
+                        {
+                            characters(SDOXMLString(content));
+                            xmlFree(content);
+                        }
+                    }
+                    break;
+                default:
+                    // comments and processing instructions are dropped
+                    // by the parser callbacks too
+                    break;
+                }
+            }
+
+            if (!parserError)
+                endElementNs(node->name, prefix, uri);
+        }
+
+
         std::istream& operator>>(std::istream& input, SAX2Parser& parser)
         {
             parser.stream(input);                            
@@ -28,6 +28,7 @@
 #include "commonj/sdo/SAX2Namespaces.h"
 #include "commonj/sdo/SAX2Attributes.h"
 #include "commonj/sdo/ParserErrorSetter.h"
+#include "libxml/tree.h"
 
 
 
@@ -93,6 +94,14 @@ namespace commonj
 
             virtual void stream(std::istream& input);
             virtual void stream_twice(std::istream& input);
+
+            /**
+             * walk delivers the callbacks for an already parsed libxml2
+             * tree, so that a DOM can be loaded without being written
+             * out and parsed again. The namespaces in scope at the
+             * starting node are reported as declared on it.
+             */
+            virtual int walk(xmlNodePtr node);
             
              friend std::istream& operator>>(std::istream& input, SAX2Parser& parser);
             
@@ -108,6 +117,8 @@ namespace commonj
 
             char* currentFile;
 
+            void walkElement(xmlNodePtr node, bool topElement);
+
 
         };
     } // End - namespace sdo
@@ -0,0 +1,273 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* $Rev$ $Date$ */
+
+#include "commonj/sdo/SDOArena.h"
+#include "commonj/sdo/SDOAtomic.h"
+
+#include <stdlib.h>
+#include <algorithm>
+
+// The current arena is per thread, so that a scope opened while loading a
+// document on one thread never captures allocations made on another.
+#if defined(WIN32) || defined(_WINDOWS)
+#define SDO_THREAD_LOCAL __declspec(thread)
+#else
+#define SDO_THREAD_LOCAL __thread
+#endif
+
+namespace commonj
+{
+    namespace sdo
+    {
+
+        // Every block is preceded by a header holding its arena (0 for
+        // heap blocks). 16 bytes keeps the block suitably aligned for any
+        // of the types stored in a data object.
+        static const size_t ARENA_ALIGN = 16;
+        static const size_t BLOCK_HEADER = ARENA_ALIGN;
+
+        // Chunk size and the size above which a block gets its own chunk.
+        static const size_t CHUNK_SIZE = 64 * 1024;
+        static const size_t LARGE_BLOCK = CHUNK_SIZE / 4;
+
+        static SDO_THREAD_LOCAL SDOArena* currentArena = 0;
+
+        static inline size_t roundUp(size_t size)
+        {
+            return (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+        }
+
+        // The open scope holds one count of its own, so that the arena is
+        // deleted exactly once whichever of close() and the last release()
+        // comes second, even when they happen on different threads.
+        SDOArena::SDOArena()
+            : chunks(0), reserved(0), liveBlocks(1), open(true)
+        {
+        }
+
+        SDOArena::~SDOArena()
+        {
+            while (chunks != 0)
+            {
+                Chunk* next = chunks->next;
+                free(chunks);
+                chunks = next;
+            }
+        }
+
+        SDOArena* SDOArena::getCurrent()
+        {
+            return currentArena;
+        }
+
+        long SDOArena::getLiveBlocks() const
+        {
+            return open ? liveBlocks - 1 : liveBlocks;
+        }
+
+        size_t SDOArena::getReservedBytes() const
+        {
+            return reserved;
+        }
+
+        void* SDOArena::allocate(size_t size)
+        {
+            size_t total = BLOCK_HEADER + roundUp(size);
+            SDOArena* arena = currentArena;
+            void* block;
+
+            if (arena != 0)
+            {
+                block = arena->bump(total);
+            }
+            else
+            {
+                block = malloc(total);
+                if (block == 0)
+                {
+                    throw std::bad_alloc();
+                }
+            }
+
+            *(SDOArena**)block = arena;
+            return (char*)block + BLOCK_HEADER;
+        }
+
+        void SDOArena::deallocate(void* p)
+        {
+            if (p == 0) return;
+
+            void* block = (char*)p - BLOCK_HEADER;
+            SDOArena* arena = *(SDOArena**)block;
+
+            if (arena != 0)
+            {
+                arena->release();
+            }
+            else
+            {
+                free(block);
+            }
+        }
+
+        void* SDOArena::bump(size_t total)
+        {
+            const size_t chunkHeader = roundUp(sizeof(Chunk));
+
+            if (chunks == 0 || chunks->size - chunks->used < total)
+            {
+                size_t size = CHUNK_SIZE;
+                if (total > LARGE_BLOCK)
+                {
+                    size = chunkHeader + total;
+                }
+
+                Chunk* chunk = (Chunk*)malloc(size);
+                if (chunk == 0)
+                {
+                    throw std::bad_alloc();
+                }
+                chunk->size = size;
+                chunk->used = chunkHeader;
+                reserved += size;
+
+                if (total > LARGE_BLOCK && chunks != 0)
+                {
+                    // Keep bumping from the current chunk; the large block
+                    // has this one to itself.
+                    chunk->next = chunks->next;
+                    chunks->next = chunk;
+                }
+                else
+                {
+                    chunk->next = chunks;
+                    chunks = chunk;
+                }
+
+                chunk->used += total;
+                SDO_ATOMIC_INCREMENT(&liveBlocks);
+                return (char*)chunk + chunk->used - total;
+            }
+
+            void* block = (char*)chunks + chunks->used;
+            chunks->used += total;
+            SDO_ATOMIC_INCREMENT(&liveBlocks);
+            return block;
+        }
+
+        void* SDOArena::allocateBlock(size_t size)
+        {
+            if (open)
+            {
+                return bump(roundUp(size));
+            }
+            return ::operator new(size);
+        }
+
+        void SDOArena::releaseBlock(void* p)
+        {
+            if (owns(p))
+            {
+                release();
+            }
+            else
+            {
+                ::operator delete(p);
+            }
+        }
+
+        // While the scope is open every block comes from the arena. After
+        // that the chunks no longer change, so they can be searched
+        // without a lock.
+        bool SDOArena::owns(const void* p) const
+        {
+            if (open)
+            {
+                return true;
+            }
+
+            std::vector<const Chunk*>::const_iterator i =
+                std::upper_bound(closedChunks.begin(), closedChunks.end(), (const Chunk*) p);
+            if (i == closedChunks.begin())
+            {
+                return false;
+            }
+            --i;
+            return (const char*) p < (const char*) (*i) + (*i)->size;
+        }
+
+        void SDOArena::retain()
+        {
+            SDO_ATOMIC_INCREMENT(&liveBlocks);
+        }
+
+        void SDOArena::release()
+        {
+            if (SDO_ATOMIC_DECREMENT(&liveBlocks) == 0)
+            {
+                delete this;
+            }
+        }
+
+        void SDOArena::close()
+        {
+            for (Chunk* c = chunks; c != 0; c = c->next)
+            {
+                closedChunks.push_back(c);
+            }
+            std::sort(closedChunks.begin(), closedChunks.end());
+            open = false;
+            release();
+        }
+
+        SDOArenaScope::SDOArenaScope(bool enable)
+        {
+            if (!enable || currentArena != 0)
+            {
+                arena = currentArena;
+                owner = false;
+            }
+            else
+            {
+                arena = new SDOArena();
+                owner = true;
+                currentArena = arena;
+            }
+        }
+
+        SDOArenaScope::~SDOArenaScope()
+        {
+            if (owner)
+            {
+                currentArena = 0;
+                // The arena outlives the scope for as long as any of the
+                // objects allocated in it do.
+                arena->close();
+            }
+        }
+
+        SDOArena* SDOArenaScope::getArena() const
+        {
+            return arena;
+        }
+
+    } // End - namespace sdo
+} // End - namespace commonj
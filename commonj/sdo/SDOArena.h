@@ -0,0 +1,284 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* $Rev$ $Date$ */
+
+#ifndef _SDO_SDOARENA_H_
+#define _SDO_SDOARENA_H_
+
+#include "commonj/sdo/export.h"
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace commonj
+{
+    namespace sdo
+    {
+
+/**
+ * SDOArena is a monotonic region allocator for the pieces of a data graph.
+ *
+ * While an SDOArenaScope is active on a thread, data objects, their
+ * property value nodes, lists and sequences are bump-allocated from the
+ * scope's arena instead of being individually taken from the heap.
+ * Freeing a block only decrements the arena's count of live blocks; the
+ * chunks themselves are returned to the heap in one go once the scope has
+ * ended and the last block allocated in it has been freed.
+ *
+ * An object which escapes the region (for example one appended into a
+ * graph created elsewhere) simply pins the arena until it dies, so escaping
+ * is always safe - it just delays the release of the region.
+ *
+ * Blocks from allocate() carry a small header naming their arena, so
+ * objects allocated outside any scope are freed to the heap as before.
+ * The node containers of a data object use SDOArenaAllocator instead,
+ * which remembers the arena itself, so that their nodes carry no header.
+ *
+ * Only the thread of the scope allocates from an arena, and only while
+ * the scope is open. Containers which grow later, as a loaded graph is
+ * edited, take their new nodes from the heap, so the region never grows
+ * after the load and is never bumped by two threads. Blocks may be freed
+ * on any thread when built with SDO_THREADSAFE_REFCOUNT.
+ */
+    class SDOArena
+    {
+    public:
+
+        /**
+         * Allocate size bytes from the arena current on this thread, or
+         * from the heap when no arena scope is active.
+         */
+        SDO_SPI static void* allocate(size_t size);
+
+        /**
+         * Free a block returned by allocate().
+         */
+        SDO_SPI static void deallocate(void* p);
+
+        /**
+         * The arena current on this thread, or 0.
+         */
+        SDO_SPI static SDOArena* getCurrent();
+
+        /**
+         * Allocate size bytes from this arena without a header, or from
+         * the heap once its scope has closed. The block is freed by
+         * releaseBlock() on the same arena.
+         */
+        SDO_SPI void* allocateBlock(size_t size);
+
+        /**
+         * Free a block returned by allocateBlock().
+         */
+        SDO_SPI void releaseBlock(void* p);
+
+        /**
+         * Keep this arena alive until a matching release(), as an
+         * allocator which may still free blocks to it does.
+         */
+        SDO_SPI void retain();
+        SDO_SPI void release();
+
+        /**
+         * The number of blocks allocated in this arena and not yet freed,
+         * counting each allocator which holds on to it as one.
+         */
+        SDO_SPI long getLiveBlocks() const;
+
+        /**
+         * The number of bytes of chunk storage held by this arena.
+         */
+        SDO_SPI size_t getReservedBytes() const;
+
+    private:
+        friend class SDOArenaScope;
+
+        SDOArena();
+        ~SDOArena();
+
+        // Not copyable
+        SDOArena(const SDOArena&);
+        SDOArena& operator=(const SDOArena&);
+
+        void* bump(size_t size);
+        bool owns(const void* p) const;
+        void close();
+
+        struct Chunk
+        {
+            Chunk* next;
+            size_t size;
+            size_t used;
+        };
+
+        Chunk* chunks;
+        size_t reserved;
+        long liveBlocks;
+        bool open;
+
+        // The chunks, ordered by address once the scope has closed, so
+        // that releaseBlock() can tell a region block from a heap one.
+        std::vector<const Chunk*> closedChunks;
+    };
+
+/**
+ * SDOArenaScope makes a new arena current for the lifetime of the scope.
+ * Scopes nest; an inner scope joins the arena of the outer one so that a
+ * graph built across several calls ends up in a single region. A scope
+ * constructed with enable false does nothing, which lets callers make
+ * arena allocation optional without duplicating code paths.
+ *
+ * {
+ *     SDOArenaScope scope;
+ *     DataObjectPtr root = df->create("companyNS", "CompanyType");
+ *     ...
+ * }
+ */
+    class SDOArenaScope
+    {
+    public:
+        SDO_SPI explicit SDOArenaScope(bool enable = true);
+        SDO_SPI ~SDOArenaScope();
+
+        /**
+         * The arena objects created in this scope are allocated from, or 0
+         * for a disabled scope outside any other.
+         */
+        SDO_SPI SDOArena* getArena() const;
+
+    private:
+        // Not copyable
+        SDOArenaScope(const SDOArenaScope&);
+        SDOArenaScope& operator=(const SDOArenaScope&);
+
+        SDOArena* arena;
+        bool owner;
+    };
+
+/**
+ * SDOArenaAllocator is a standard allocator over SDOArena, used for the
+ * node based containers which hold a data object's values. It takes the
+ * arena current when the container is constructed, and holds on to it,
+ * so that the nodes need no header. Outside any scope, and once the scope
+ * of its arena has closed, it allocates straight from the heap.
+ */
+    template <class T>
+    class SDOArenaAllocator
+    {
+    public:
+        typedef size_t    size_type;
+        typedef ptrdiff_t difference_type;
+        typedef T*        pointer;
+        typedef const T*  const_pointer;
+        typedef T&        reference;
+        typedef const T&  const_reference;
+        typedef T         value_type;
+
+        template <class U> struct rebind { typedef SDOArenaAllocator<U> other; };
+
+        SDOArenaAllocator() : arena(SDOArena::getCurrent())
+        {
+            if (arena != 0) arena->retain();
+        }
+
+        SDOArenaAllocator(const SDOArenaAllocator& other) : arena(other.arena)
+        {
+            if (arena != 0) arena->retain();
+        }
+
+        template <class U> SDOArenaAllocator(const SDOArenaAllocator<U>& other)
+            : arena(other.getArena())
+        {
+            if (arena != 0) arena->retain();
+        }
+
+        ~SDOArenaAllocator()
+        {
+            if (arena != 0) arena->release();
+        }
+
+        SDOArenaAllocator& operator=(const SDOArenaAllocator& other)
+        {
+            if (other.arena != 0) other.arena->retain();
+            if (arena != 0) arena->release();
+            arena = other.arena;
+            return *this;
+        }
+
+        SDOArena* getArena() const { return arena; }
+
+        pointer address(reference x) const { return &x; }
+        const_pointer address(const_reference x) const { return &x; }
+
+        pointer allocate(size_type n, const void* = 0)
+        {
+            if (arena != 0)
+            {
+                return static_cast<pointer>(arena->allocateBlock(n * sizeof(T)));
+            }
+            return static_cast<pointer>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(pointer p, size_type)
+        {
+            if (arena != 0)
+            {
+                arena->releaseBlock(p);
+            }
+            else
+            {
+                ::operator delete(p);
+            }
+        }
+
+        size_type max_size() const { return size_t(-1) / sizeof(T); }
+
+        void construct(pointer p, const T& val) { new(p) T(val); }
+        void destroy(pointer p) { p->~T(); }
+
+    private:
+        SDOArena* arena;
+    };
+
+    template <class T, class U>
+    inline bool operator==(const SDOArenaAllocator<T>& a, const SDOArenaAllocator<U>& b)
+    {
+        return a.getArena() == b.getArena();
+    }
+
+    template <class T, class U>
+    inline bool operator!=(const SDOArenaAllocator<T>& a, const SDOArenaAllocator<U>& b)
+    {
+        return a.getArena() != b.getArena();
+    }
+
+/**
+ * Class-level operator new/delete routing instances through SDOArena.
+ */
+#define SDO_ARENA_ALLOCATED \
+    static void* operator new(size_t size) \
+    { return commonj::sdo::SDOArena::allocate(size); } \
+    static void operator delete(void* p) \
+    { commonj::sdo::SDOArena::deallocate(p); }
+
+    } // End - namespace sdo
+} // End - namespace commonj
+
+#endif //_SDO_SDOARENA_H_
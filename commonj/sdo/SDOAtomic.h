@@ -0,0 +1,56 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* $Rev$ $Date$ */
+
+#ifndef _SDO_SDOATOMIC_H_
+#define _SDO_SDOATOMIC_H_
+
+/*
+ * Counter operations used for reference counts and arena block counts.
+ *
+ * Building with SDO_THREADSAFE_REFCOUNT defined (done automatically for
+ * thread safe PHP builds) makes them atomic, so that immutable metadata
+ * and read-only graphs can be shared between threads. Increments are
+ * relaxed, since taking a new reference needs no ordering; decrements
+ * are acquire/release, so that every write made through a reference
+ * happens before the object is deleted by whoever drops the last one.
+ *
+ * Both macros operate on a long and yield the new value.
+ */
+
+#if defined(SDO_THREADSAFE_REFCOUNT)
+
+#if defined(WIN32) || defined(_WINDOWS)
+#include <windows.h>
+#define SDO_ATOMIC_INCREMENT(p) InterlockedIncrement(p)
+#define SDO_ATOMIC_DECREMENT(p) InterlockedDecrement(p)
+#else
+#define SDO_ATOMIC_INCREMENT(p) __atomic_add_fetch((p), 1, __ATOMIC_RELAXED)
+#define SDO_ATOMIC_DECREMENT(p) __atomic_sub_fetch((p), 1, __ATOMIC_ACQ_REL)
+#endif
+
+#else
+
+#define SDO_ATOMIC_INCREMENT(p) (++*(p))
+#define SDO_ATOMIC_DECREMENT(p) (--*(p))
+
+#endif
+
+#endif //_SDO_SDOATOMIC_H_
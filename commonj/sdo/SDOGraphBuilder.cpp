@@ -0,0 +1,336 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* $Rev$ $Date$ */
+
+#include "commonj/sdo/SDOGraphBuilder.h"
+#include "commonj/sdo/DataObjectImpl.h"
+#include "commonj/sdo/SDORuntimeException.h"
+
+#include <string.h>
+
+namespace commonj
+{
+    namespace sdo
+    {
+
+        SDOGraphBuilder::SDOGraphBuilder(DataObjectPtr rootObject)
+            : root(rootObject), objectCount(0), planChecked(false)
+        {
+            if (!root)
+            {
+                SDO_THROW_EXCEPTION("SDOGraphBuilder",
+                    SDONullPointerException, "No root data object");
+            }
+        }
+
+        SDOGraphBuilder::~SDOGraphBuilder()
+        {
+        }
+
+        // FNV-1a, as used for the ID table of the SAX2 parser
+        unsigned int SDOGraphBuilder::hashKey(const char* key, unsigned int length)
+        {
+            unsigned int hash = 2166136261u;
+            for (unsigned int i = 0; i < length; i++)
+            {
+                hash = (hash ^ (unsigned char) key[i]) * 16777619u;
+            }
+            return hash;
+        }
+
+        DataObjectImpl* SDOGraphBuilder::findObject(const Table& t,
+                                                    const char* key,
+                                                    unsigned int length,
+                                                    unsigned int hash)
+        {
+            if (t.keyBuckets.empty())
+            {
+                return 0;
+            }
+            for (int i = t.keyBuckets[hash & (t.keyBuckets.size() - 1)]; i >= 0; i = t.keys[i].next)
+            {
+                const KeyEntry& e = t.keys[i];
+                if (e.hash == hash && e.key.length() == length
+                    && memcmp(e.key.data(), key, length) == 0)
+                {
+                    return e.object;
+                }
+            }
+            return 0;
+        }
+
+        void SDOGraphBuilder::addObject(Table& t,
+                                        const char* key,
+                                        unsigned int length,
+                                        unsigned int hash,
+                                        DataObjectImpl* object)
+        {
+            // Keep the buckets a power of two, at least as many as the entries
+            if (t.keys.size() >= t.keyBuckets.size())
+            {
+                t.keyBuckets.assign(t.keyBuckets.empty() ? 64 : t.keyBuckets.size() * 2, -1);
+                for (unsigned int i = 0; i < t.keys.size(); i++)
+                {
+                    int& bucket = t.keyBuckets[t.keys[i].hash & (t.keyBuckets.size() - 1)];
+                    t.keys[i].next = bucket;
+                    bucket = i;
+                }
+            }
+
+            int& bucket = t.keyBuckets[hash & (t.keyBuckets.size() - 1)];
+            t.keys.push_back(KeyEntry(SDOString(key, length), hash, object, bucket));
+            bucket = t.keys.size() - 1;
+        }
+
+        unsigned int SDOGraphBuilder::addTable(const SDOString& name, int parentTable)
+        {
+            if (parentTable >= (int) tables.size())
+            {
+                SDOString msg("The parent of table ");
+                msg += name;
+                msg += " has not been added";
+                SDO_THROW_EXCEPTION("SDOGraphBuilder::addTable",
+                    SDOIndexOutOfRangeException, msg.c_str());
+            }
+
+            const Type& parentType = (parentTable < 0)
+                ? root->getType()
+                : *(tables[parentTable].type);
+
+            Table t;
+            t.name = name;
+            t.parent = parentTable;
+            t.propertyIndex = parentType.getPropertyIndex(name);
+            t.type = &(parentType.getProperty(t.propertyIndex).getType());
+            t.keyColumn = -1;
+            tables.push_back(t);
+
+            planChecked = false;
+            return tables.size() - 1;
+        }
+
+        int SDOGraphBuilder::getTable(const SDOString& name) const
+        {
+            for (unsigned int i = 0; i < tables.size(); i++)
+            {
+                if (tables[i].name == name)
+                {
+                    return i;
+                }
+            }
+            return -1;
+        }
+
+        unsigned int SDOGraphBuilder::addColumn(unsigned int table,
+                                                const SDOString& propertyName,
+                                                bool isKey)
+        {
+            if (table >= tables.size())
+            {
+                SDO_THROW_EXCEPTION("SDOGraphBuilder::addColumn",
+                    SDOIndexOutOfRangeException, "No such table");
+            }
+
+            Table& t = tables[table];
+            if (isKey && t.keyColumn >= 0)
+            {
+                SDOString msg("Table ");
+                msg += t.name;
+                msg += " already has a key column";
+                SDO_THROW_EXCEPTION("SDOGraphBuilder::addColumn",
+                    SDOIllegalArgumentException, msg.c_str());
+            }
+
+            Column c;
+            c.table = table;
+            c.propertyIndex = t.type->getPropertyIndex(propertyName);
+            c.isReference = false;
+            c.referencedIndex = -1;
+            columns.push_back(c);
+
+            unsigned int index = columns.size() - 1;
+            t.columns.push_back(index);
+            if (isKey)
+            {
+                t.keyColumn = index;
+            }
+
+            planChecked = false;
+            return index;
+        }
+
+        unsigned int SDOGraphBuilder::addReferenceColumn(unsigned int table,
+                                                         const SDOString& propertyName,
+                                                         const SDOString& referencedTable)
+        {
+            unsigned int index = addColumn(table, propertyName, false);
+            columns[index].isReference = true;
+            columns[index].referencedTable = referencedTable;
+            columns[index].referencedIndex = getTable(referencedTable);
+            return index;
+        }
+
+        unsigned int SDOGraphBuilder::getColumnCount() const
+        {
+            return columns.size();
+        }
+
+        void SDOGraphBuilder::checkPlan()
+        {
+            for (unsigned int i = 0; i < tables.size(); i++)
+            {
+                if (tables[i].keyColumn < 0)
+                {
+                    SDOString msg("Data retrieved from table ");
+                    msg += tables[i].name;
+                    msg += " did not include the primary key for this table";
+                    SDO_THROW_EXCEPTION("SDOGraphBuilder::addRow",
+                        SDOIllegalArgumentException, msg.c_str());
+                }
+            }
+            // A referenced table may have been added after the column
+            for (unsigned int i = 0; i < columns.size(); i++)
+            {
+                Column& c = columns[i];
+                if (c.isReference && c.referencedIndex < 0)
+                {
+                    c.referencedIndex = getTable(c.referencedTable);
+                }
+            }
+            rowObjects.resize(tables.size());
+            planChecked = true;
+        }
+
+        void SDOGraphBuilder::addRow(const char* const* values,
+                                     const unsigned int* lengths,
+                                     unsigned int count)
+        {
+            if (!planChecked)
+            {
+                checkPlan();
+            }
+
+            if (count != columns.size())
+            {
+                SDO_THROW_EXCEPTION("SDOGraphBuilder::addRow",
+                    SDOIllegalArgumentException,
+                    "The row does not have a value for each column");
+            }
+
+            for (unsigned int i = 0; i < tables.size(); i++)
+            {
+                Table& t = tables[i];
+                rowObjects[i] = 0;
+
+                unsigned int kc = t.keyColumn;
+                if (values[kc] == 0)
+                {
+                    continue;
+                }
+
+                unsigned int keyLength = lengths ? lengths[kc] : strlen(values[kc]);
+                unsigned int hash = hashKey(values[kc], keyLength);
+                DataObjectImpl* found = findObject(t, values[kc], keyLength, hash);
+                if (found != 0)
+                {
+                    rowObjects[i] = found;
+                    continue;
+                }
+
+                DataObject* parent = (t.parent < 0) ? (DataObject*) root : rowObjects[t.parent];
+                if (parent == 0)
+                {
+                    continue;
+                }
+
+                DataObjectPtr created = parent->createDataObject(t.propertyIndex);
+                DataObject* dob = created;
+                DataObjectImpl* d = (DataObjectImpl*) dob;
+
+                for (unsigned int j = 0; j < t.columns.size(); j++)
+                {
+                    unsigned int c = t.columns[j];
+                    const Column& column = columns[c];
+
+                    if (column.isReference)
+                    {
+                        // The object referred to may not have been read yet
+                        Reference r;
+                        r.object = d;
+                        r.column = c;
+                        r.isNull = (values[c] == 0);
+                        r.hash = 0;
+                        if (!r.isNull)
+                        {
+                            r.key.assign(values[c], lengths ? lengths[c] : strlen(values[c]));
+                            r.hash = hashKey(r.key.data(), r.key.length());
+                        }
+                        references.push_back(r);
+                    }
+                    else if (values[c] == 0)
+                    {
+                        d->setNull(column.propertyIndex);
+                    }
+                    else
+                    {
+                        d->setCString(column.propertyIndex,
+                            SDOString(values[c], lengths ? lengths[c] : strlen(values[c])));
+                    }
+                }
+
+                addObject(t, values[kc], keyLength, hash, d);
+                rowObjects[i] = d;
+                objectCount++;
+            }
+        }
+
+        void SDOGraphBuilder::resolveReferences()
+        {
+            for (unsigned int i = 0; i < references.size(); i++)
+            {
+                const Reference& r = references[i];
+                const Column& column = columns[r.column];
+
+                DataObjectImpl* target = 0;
+                if (!r.isNull && column.referencedIndex >= 0)
+                {
+                    target = findObject(tables[column.referencedIndex],
+                                        r.key.data(), r.key.length(), r.hash);
+                }
+
+                if (target == 0)
+                {
+                    r.object->setNull(column.propertyIndex);
+                }
+                else
+                {
+                    r.object->setDataObject(column.propertyIndex, target);
+                }
+            }
+            references.clear();
+        }
+
+        unsigned long SDOGraphBuilder::getObjectCount() const
+        {
+            return objectCount;
+        }
+
+    } // End - namespace sdo
+} // End - namespace commonj
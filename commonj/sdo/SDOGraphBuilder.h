@@ -0,0 +1,195 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* $Rev$ $Date$ */
+
+#ifndef _SDOGRAPHBUILDER_H_
+#define _SDOGRAPHBUILDER_H_
+
+#include "commonj/sdo/export.h"
+#include "commonj/sdo/DataObject.h"
+#include "commonj/sdo/SDOString.h"
+
+#include <vector>
+
+namespace commonj
+{
+    namespace sdo
+    {
+        class DataObjectImpl;
+
+/**
+ * SDOGraphBuilder turns the rows of a tabular result set, such as a
+ * database join, into a normalised data graph below a root object.
+ *
+ * The plan is set up first. Each table names the containment property
+ * which holds its objects, either on the root or on the type of a parent
+ * table added before it. Each column of a row sets a property of the
+ * object for its table; one column of every table is its key, and a
+ * column may instead hold the key of an object of another table, which
+ * becomes a non-containment reference.
+ *
+ * Rows are then added in any number of batches. For each table, the
+ * first row with a given key creates the object in the object for the
+ * parent table on the same row and sets its properties; later rows with
+ * that key reuse it. A table whose key is null on a row, or whose parent
+ * has no object on that row, has no object for that row. References are
+ * set by resolveReferences() once all the rows have been added, since
+ * the object referred to may come later in the result set. A reference
+ * whose key is not found is set to null.
+ *
+ * Column values are taken as strings, with a null pointer for a null.
+ */
+        class SDOGraphBuilder
+        {
+        public:
+
+            SDO_SPI SDOGraphBuilder(DataObjectPtr root);
+
+            SDO_SPI virtual ~SDOGraphBuilder();
+
+            /**
+             * Adds a table whose objects are held in the named containment
+             * property of the parent table's type, or of the root for a
+             * parent of -1. Returns the index of the table.
+             * Throws SDOPropertyNotFoundException if there is no such
+             * property, and SDOIndexOutOfRangeException if the parent has
+             * not been added.
+             */
+            SDO_SPI unsigned int addTable(const SDOString& name, int parentTable = -1);
+
+            /**
+             * The index of the named table, or -1 if it has not been added.
+             */
+            SDO_SPI int getTable(const SDOString& name) const;
+
+            /**
+             * Adds the next column of the rows, which sets the named
+             * property of the table's objects. Returns the column index.
+             */
+            SDO_SPI unsigned int addColumn(unsigned int table,
+                                           const SDOString& propertyName,
+                                           bool isKey = false);
+
+            /**
+             * Adds the next column of the rows, which holds the key of an
+             * object of the referenced table, to be set in the named
+             * non-containment property. The referenced table need not
+             * be in the plan, in which case the reference is always null.
+             */
+            SDO_SPI unsigned int addReferenceColumn(unsigned int table,
+                                                    const SDOString& propertyName,
+                                                    const SDOString& referencedTable);
+
+            SDO_SPI unsigned int getColumnCount() const;
+
+            /**
+             * Adds a row of column values, with a null pointer for a null
+             * value. lengths may be 0 when the values are terminated.
+             * Throws SDOIllegalArgumentException if a table has no key
+             * column or the row has the wrong number of values.
+             */
+            SDO_SPI void addRow(const char* const* values,
+                                const unsigned int* lengths,
+                                unsigned int count);
+
+            /**
+             * Sets the references read since the last call.
+             */
+            SDO_SPI void resolveReferences();
+
+            /**
+             * The number of objects created so far.
+             */
+            SDO_SPI unsigned long getObjectCount() const;
+
+        private:
+            SDOGraphBuilder(const SDOGraphBuilder&);
+            SDOGraphBuilder& operator=(const SDOGraphBuilder&);
+
+            void checkPlan();
+
+            // The objects of a table are found by key through a hash.
+            // Entries are chained from a power of two bucket table.
+            struct KeyEntry
+            {
+                KeyEntry(const SDOString& k, unsigned int h, DataObjectImpl* o, int n)
+                    : key(k), hash(h), object(o), next(n)
+                {
+                }
+                SDOString key;
+                unsigned int hash;
+                DataObjectImpl* object;
+                int next;           // the next entry in the bucket, or -1
+            };
+
+            struct Table
+            {
+                SDOString name;
+                int parent;
+                unsigned int propertyIndex;
+                const Type* type;
+                int keyColumn;
+                std::vector<unsigned int> columns;
+                std::vector<KeyEntry> keys;
+                std::vector<int> keyBuckets;
+            };
+
+            struct Column
+            {
+                unsigned int table;
+                unsigned int propertyIndex;
+                bool isReference;
+                SDOString referencedTable;
+                int referencedIndex;    // the referenced table, or -1
+            };
+
+            struct Reference
+            {
+                DataObjectImpl* object;
+                unsigned int column;
+                bool isNull;
+                unsigned int hash;
+                SDOString key;
+            };
+
+            static unsigned int hashKey(const char* key, unsigned int length);
+            static DataObjectImpl* findObject(const Table& t,
+                                              const char* key,
+                                              unsigned int length,
+                                              unsigned int hash);
+            static void addObject(Table& t,
+                                  const char* key,
+                                  unsigned int length,
+                                  unsigned int hash,
+                                  DataObjectImpl* object);
+
+            DataObjectPtr root;
+            std::vector<Table> tables;
+            std::vector<Column> columns;
+            std::vector<Reference> references;
+            std::vector<DataObjectImpl*> rowObjects;
+            unsigned long objectCount;
+            bool planChecked;
+        };
+    } // End - namespace sdo
+} // End - namespace commonj
+
+
+#endif //_SDOGRAPHBUILDER_H_
@@ -0,0 +1,1595 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* $Rev$ $Date$ */
+
+#include "commonj/sdo/SDOGraphSnapshot.h"
+#include "commonj/sdo/DataObjectImpl.h"
+#include "commonj/sdo/DataObjectListImpl.h"
+#include "commonj/sdo/SequenceImpl.h"
+#include "commonj/sdo/TypeImpl.h"
+#include "commonj/sdo/PropertyImpl.h"
+#include "commonj/sdo/ChangeSummaryImpl.h"
+#include "commonj/sdo/DataFactoryImpl.h"
+#include "commonj/sdo/Setting.h"
+#include "commonj/sdo/SDOValue.h"
+#include "commonj/sdo/SDORuntimeException.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <vector>
+#include <deque>
+#include <map>
+#include <set>
+#include <algorithm>
+
+namespace commonj
+{
+    namespace sdo
+    {
+
+        const unsigned int SDOGraphSnapshot::version = 3;
+
+        // The oldest version which still loads. Version 2 had neither the
+        // deleted objects nor the change logs.
+        static const unsigned int OLDEST_VERSION = 2;
+
+        // Header words, each held little endian
+        enum
+        {
+            HDR_MAGIC = 0,
+            HDR_VERSION,
+            HDR_LENGTH,
+            HDR_MODEL_LO,
+            HDR_MODEL_HI,
+            HDR_RESERVED,
+            HDR_SIZE
+        };
+
+        static const unsigned int WORD_SIZE = 4;
+        static const unsigned int HEADER_LENGTH = HDR_SIZE * WORD_SIZE;
+
+        static const char SNAPSHOT_MAGIC[4] = { 'S', 'D', 'O', 'G' };
+
+        // The kinds of value held for a property
+        static const unsigned int VALUE_NONE    = 1;   // a data object set to 0
+        static const unsigned int VALUE_NULL    = 2;   // set to null
+        static const unsigned int VALUE_DATA    = 3;   // a data type value
+        static const unsigned int VALUE_OBJECT  = 4;   // a contained data object
+        static const unsigned int VALUE_LIST    = 5;   // the items of a list
+
+        // Sequence entries
+        static const unsigned int ENTRY_TEXT    = 1;
+        static const unsigned int ENTRY_SETTING = 2;   // plus the property index
+
+        // Open property flags
+        static const unsigned int OPEN_MANY     = 0x01;
+
+        // What the change log holds for an object
+        static const unsigned int LOG_CREATED   = 0x01;
+        static const unsigned int LOG_DELETED   = 0x02;
+        static const unsigned int LOG_CHANGED   = 0x04;
+
+        // Old value flags
+        static const unsigned int OLD_SET       = 0x01;
+        static const unsigned int OLD_NULL      = 0x02;
+
+        // Marks an object which is not part of the graph
+        static const unsigned int NONE = 0xFFFFFFFF;
+
+#if defined(WIN32)  || defined (_WINDOWS)
+        typedef unsigned __int64 SnapshotNumber;
+#else
+        typedef uint64_t SnapshotNumber;
+#endif
+
+        static void throwInvalid(const char* reason)
+        {
+            SDOString msg("Invalid graph snapshot: ");
+            msg += reason;
+            SDO_THROW_EXCEPTION("SDOGraphSnapshot::load",
+                SDOIllegalArgumentException, msg.c_str());
+        }
+
+        static void appendWord(SDOString& buffer, unsigned int w)
+        {
+            char b[WORD_SIZE];
+            for (unsigned int i = 0; i < WORD_SIZE; i++)
+            {
+                b[i] = (char) ((w >> (8 * i)) & 0xFF);
+            }
+            buffer.append(b, WORD_SIZE);
+        }
+
+        static unsigned int wordAt(const char* p)
+        {
+            const unsigned char* b = (const unsigned char*) p;
+            return (unsigned int) b[0]
+                | ((unsigned int) b[1] << 8)
+                | ((unsigned int) b[2] << 16)
+                | ((unsigned int) b[3] << 24);
+        }
+
+        static bool isList(const PropertyImpl* p)
+        {
+            return p->isMany() || p->getTypeImpl()->isFromList();
+        }
+
+        static const DATAOBJECT_VECTOR& listItems(DataObjectImpl* ob, unsigned int index)
+        {
+            return ((DataObjectListImpl&) ob->getList(index)).getDataObjects();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // GraphWriter walks the graph by containment, giving each data
+        // object its position in the walk, then writes the references,
+        // sequences and change summaries in terms of those positions.
+        ///////////////////////////////////////////////////////////////////////
+
+        class GraphWriter
+        {
+        public:
+            GraphWriter(SDOString& out) : out(out), graphSize(0) {}
+
+            void write(DataObjectImpl* root);
+
+        private:
+            void putNumber(SnapshotNumber n);
+            void putSigned(int64_t n);
+            void putBytes(const char* b, unsigned int len);
+            void putString(const char* s);
+            void putSDOValue(const SDOValue& sval);
+            void putValue(DataObjectImpl* holder);
+            void putObject(DataObjectImpl* ob);
+            void putDeleted();
+            void putReferences();
+            void putSequences();
+            void putChangeSummaries();
+            void putChangeLog(ChangeSummaryImpl* cs);
+            void putContainment(DataObjectImpl* container, const Property& prop);
+            void putOldValues(DataObjectImpl* ob, SettingList& oldValues);
+            void putId(DataObject* ob);
+            unsigned int idOf(DataObjectImpl* ob) const;
+
+            SDOString& out;
+            std::map<SDOString, unsigned int> strings;
+
+            // The objects in the order they were written, and the same
+            // sorted by address to look them up. The graph comes first,
+            // then the deleted objects the change logs refer to.
+            std::vector<DataObjectImpl*> objects;
+            unsigned int graphSize;
+            std::vector<std::pair<DataObjectImpl*, unsigned int> > ids;
+        };
+
+        void GraphWriter::putNumber(SnapshotNumber n)
+        {
+            while (n >= 0x80)
+            {
+                out += (char) ((n & 0x7F) | 0x80);
+                n >>= 7;
+            }
+            out += (char) n;
+        }
+
+        void GraphWriter::putSigned(int64_t n)
+        {
+            // Zig zag, so that small negative numbers stay short
+            putNumber(((SnapshotNumber) n << 1) ^ (SnapshotNumber) (n >> 63));
+        }
+
+        void GraphWriter::putBytes(const char* b, unsigned int len)
+        {
+            putNumber(len);
+            out.append(b, len);
+        }
+
+        void GraphWriter::putString(const char* s)
+        {
+            if (s == 0)
+            {
+                s = "";
+            }
+            std::map<SDOString, unsigned int>::iterator i = strings.find(s);
+            if (i != strings.end())
+            {
+                putNumber(i->second);
+                return;
+            }
+            // Each new string takes the next number, from 1
+            unsigned int id = strings.size() + 1;
+            strings[s] = id;
+            putNumber(0);
+            putBytes(s, strlen(s));
+        }
+
+        void GraphWriter::putValue(DataObjectImpl* holder)
+        {
+            const Type& t = holder->getType();
+            putString(t.getURI());
+            putString(t.getName());
+
+            if (holder->isNull())
+            {
+                putNumber(DataTypeInfo::SDOnull - DataTypeInfo::SDOunset);
+                return;
+            }
+
+            PropertyImpl* pd;
+            putSDOValue(holder->getSDOValue(&pd));
+        }
+
+        void GraphWriter::putSDOValue(const SDOValue& sval)
+        {
+            DataTypeInfo::RawDataType raw = sval.getRawType();
+            putNumber(raw - DataTypeInfo::SDOunset);
+
+            switch (raw)
+            {
+            case DataTypeInfo::SDObool:
+                putNumber(sval.getBoolean() ? 1 : 0);
+                break;
+            case DataTypeInfo::SDOchar:
+                putSigned(sval.getByte());
+                break;
+            case DataTypeInfo::SDOwchar_t:
+                putNumber((SnapshotNumber) sval.getCharacter());
+                break;
+            case DataTypeInfo::SDOshort:
+                putSigned(sval.getShort());
+                break;
+            case DataTypeInfo::SDOlong:
+                putSigned(sval.getInteger());
+                break;
+            case DataTypeInfo::SDOint64_t:
+                putSigned(sval.getLong());
+                break;
+            case DataTypeInfo::SDOfloat:
+                {
+                    // IEEE single precision is the same everywhere
+                    float f = sval.getFloat();
+                    unsigned int w;
+                    memcpy(&w, &f, sizeof(w));
+                    putNumber(w);
+                }
+                break;
+            case DataTypeInfo::SDOdouble:
+                {
+                    // The size of a long double varies, so it is kept as text
+                    char text[64];
+                    sprintf(text, "%.*Lg", LDBL_DIG + 3, sval.getDouble());
+                    putBytes(text, strlen(text));
+                }
+                break;
+            case DataTypeInfo::SDOSDODate:
+                putSigned((int64_t) sval.getDate().getTime());
+                break;
+            case DataTypeInfo::SDOCString:
+            case DataTypeInfo::SDOByteArray:
+                {
+                    const SDOString* text = sval.getTextString();
+                    putBytes(text->data(), text->length());
+                }
+                break;
+            case DataTypeInfo::SDOWideString:
+                {
+                    // Characters are kept as code points, whatever the size
+                    // of wchar_t
+                    unsigned int len;
+                    const wchar_t* w = sval.getWideString(len);
+                    std::vector<SnapshotNumber> code;
+                    code.reserve(len);
+                    for (unsigned int i = 0; i < len; i++)
+                    {
+                        SnapshotNumber c = (SnapshotNumber) w[i];
+                        if (sizeof(wchar_t) == 2 && c >= 0xD800 && c < 0xDC00 && i + 1 < len
+                            && (SnapshotNumber) w[i + 1] >= 0xDC00 && (SnapshotNumber) w[i + 1] < 0xE000)
+                        {
+                            c = 0x10000 + ((c - 0xD800) << 10) + ((SnapshotNumber) w[++i] - 0xDC00);
+                        }
+                        code.push_back(c);
+                    }
+                    putNumber(code.size());
+                    for (unsigned int i = 0; i < code.size(); i++)
+                    {
+                        putNumber(code[i]);
+                    }
+                }
+                break;
+            default:
+                // unset or null
+                break;
+            }
+        }
+
+        void GraphWriter::putObject(DataObjectImpl* ob)
+        {
+            ids.push_back(std::make_pair(ob, (unsigned int) objects.size()));
+            objects.push_back(ob);
+
+            const TypeImpl& t = ob->getTypeImpl();
+            putString(t.getURI());
+            putString(t.getName());
+
+            std::vector<DataObjectImpl*> values;
+            std::vector<bool> set;
+            ob->getPropertySlots(values, set);
+
+            unsigned int base = t.getPropertiesSize();
+            putNumber(values.size() - base);
+            for (unsigned int o = base; o < values.size(); o++)
+            {
+                const PropertyImpl* p = ob->getPropertyImpl(o);
+                putString(p->getName());
+                putString(p->getType().getURI());
+                putString(p->getType().getName());
+                putNumber(p->isMany() ? OPEN_MANY : 0);
+            }
+
+            for (unsigned int i = 0; i < values.size(); i++)
+            {
+                if (!set[i])
+                {
+                    continue;
+                }
+                const PropertyImpl* p = ob->getPropertyImpl(i);
+                if (p == 0 || p->getTypeEnum() == Type::ChangeSummaryType)
+                {
+                    continue;
+                }
+
+                DataObjectImpl* value = values[i];
+                if (value == 0)
+                {
+                    putNumber(i + 1);
+                    putNumber(VALUE_NONE);
+                }
+                else if (isList(p))
+                {
+                    if (p->isReference())
+                    {
+                        continue;
+                    }
+                    const DATAOBJECT_VECTOR& items = listItems(ob, i);
+                    putNumber(i + 1);
+                    putNumber(VALUE_LIST);
+                    putNumber(items.size());
+                    for (unsigned int j = 0; j < items.size(); j++)
+                    {
+                        DataObjectImpl* item = (DataObjectImpl*) &*items[j];
+                        if (item->getTypeImpl().isDataType())
+                        {
+                            putNumber(VALUE_DATA);
+                            putValue(item);
+                        }
+                        else
+                        {
+                            putNumber(VALUE_OBJECT);
+                            putObject(item);
+                        }
+                    }
+                }
+                else if (value->isNull())
+                {
+                    putNumber(i + 1);
+                    putNumber(VALUE_NULL);
+                }
+                else if (p->isReference())
+                {
+                    // written once the whole graph is numbered
+                    continue;
+                }
+                else if (value->getTypeImpl().isDataType())
+                {
+                    putNumber(i + 1);
+                    putNumber(VALUE_DATA);
+                    putValue(value);
+                }
+                else
+                {
+                    putNumber(i + 1);
+                    putNumber(VALUE_OBJECT);
+                    putObject(value);
+                }
+            }
+            putNumber(0);
+        }
+
+        unsigned int GraphWriter::idOf(DataObjectImpl* ob) const
+        {
+            std::vector<std::pair<DataObjectImpl*, unsigned int> >::const_iterator i =
+                std::lower_bound(ids.begin(), ids.end(),
+                                 std::make_pair(ob, (unsigned int) 0));
+            if (i == ids.end() || i->first != ob)
+            {
+                return NONE;
+            }
+            return i->second;
+        }
+
+        void GraphWriter::putReferences()
+        {
+            std::vector<DataObjectImpl*> values;
+            std::vector<bool> set;
+            std::vector<unsigned int> targets;
+
+            for (unsigned int k = 0; k < objects.size(); k++)
+            {
+                DataObjectImpl* ob = objects[k];
+                ob->getPropertySlots(values, set);
+                for (unsigned int i = 0; i < values.size(); i++)
+                {
+                    if (values[i] == 0)
+                    {
+                        continue;
+                    }
+                    const PropertyImpl* p = ob->getPropertyImpl(i);
+                    if (p == 0 || !p->isReference() || values[i]->isNull())
+                    {
+                        continue;
+                    }
+
+                    // References to objects outside the graph are left out
+                    targets.clear();
+                    if (isList(p))
+                    {
+                        const DATAOBJECT_VECTOR& items = listItems(ob, i);
+                        for (unsigned int j = 0; j < items.size(); j++)
+                        {
+                            unsigned int id = idOf((DataObjectImpl*) &*items[j]);
+                            if (id != NONE)
+                            {
+                                targets.push_back(id);
+                            }
+                        }
+                    }
+                    else
+                    {
+                        unsigned int id = idOf(values[i]);
+                        if (id != NONE)
+                        {
+                            targets.push_back(id);
+                        }
+                    }
+                    if (targets.empty())
+                    {
+                        continue;
+                    }
+
+                    putNumber(k + 1);
+                    putNumber(i);
+                    putNumber(targets.size());
+                    for (unsigned int t = 0; t < targets.size(); t++)
+                    {
+                        putNumber(targets[t]);
+                    }
+                }
+            }
+            putNumber(0);
+        }
+
+        void GraphWriter::putSequences()
+        {
+            for (unsigned int k = 0; k < objects.size(); k++)
+            {
+                DataObjectImpl* ob = objects[k];
+                if (!ob->getType().isSequencedType())
+                {
+                    continue;
+                }
+                SequenceImpl* seq = ob->getSequenceImpl();
+                if (seq == 0)
+                {
+                    continue;
+                }
+
+                // For each many valued reference, the number of items before
+                // each position which are outside the graph, with one more
+                // entry for the end.
+                std::map<unsigned int, std::vector<unsigned int> > outside;
+
+                putNumber(k + 1);
+                for (unsigned int e = 0; e < seq->size(); e++)
+                {
+                    if (seq->isText(e))
+                    {
+                        const char* text = seq->getCStringValue(e);
+                        putNumber(ENTRY_TEXT);
+                        putBytes(text, strlen(text));
+                        continue;
+                    }
+
+                    const Property& prop = seq->getProperty(e);
+                    unsigned int listIndex = prop.isMany() ? seq->getListIndex(e) : 0;
+                    unsigned int propertyIndex = ob->getPropertyIndex(prop);
+
+                    if (prop.isReference())
+                    {
+                        // As for the references, entries for objects outside
+                        // the graph are left out and the rest close up.
+                        if (prop.isMany())
+                        {
+                            std::vector<unsigned int>& skipped = outside[propertyIndex];
+                            if (skipped.empty())
+                            {
+                                const DATAOBJECT_VECTOR& items = listItems(ob, propertyIndex);
+                                skipped.resize(items.size() + 1, 0);
+                                for (unsigned int j = 0; j < items.size(); j++)
+                                {
+                                    skipped[j + 1] = skipped[j] +
+                                        (idOf((DataObjectImpl*) &*items[j]) == NONE ? 1 : 0);
+                                }
+                            }
+                            if (listIndex + 1 >= skipped.size()
+                                || skipped[listIndex + 1] != skipped[listIndex])
+                            {
+                                continue;
+                            }
+                            listIndex -= skipped[listIndex];
+                        }
+                        else
+                        {
+                            DataObjectPtr value = ob->getDataObject(propertyIndex);
+                            DataObject* target = value;
+                            if (target != 0 && idOf((DataObjectImpl*) target) == NONE)
+                            {
+                                continue;
+                            }
+                        }
+                    }
+
+                    putNumber(ENTRY_SETTING + propertyIndex);
+                    putNumber(listIndex);
+                }
+                putNumber(0);
+            }
+            putNumber(0);
+        }
+
+        void GraphWriter::putId(DataObject* ob)
+        {
+            // 0 for no object, or one outside the graph
+            unsigned int id = ob == 0 ? NONE : idOf((DataObjectImpl*) ob);
+            putNumber(id == NONE ? 0 : (SnapshotNumber) id + 1);
+        }
+
+        static bool indexOf(DataObjectImpl* ob, const Property& prop, unsigned int& index)
+        {
+            try
+            {
+                index = ob->getPropertyIndex(prop);
+            }
+            catch (SDOPropertyNotFoundException&)
+            {
+                // an open property since removed
+                return false;
+            }
+            return true;
+        }
+
+        static ChangeSummaryImpl* changeSummaryOf(DataObjectImpl* ob)
+        {
+            if (!ob->getType().isChangeSummaryType())
+            {
+                return 0;
+            }
+            return (ChangeSummaryImpl*) ob->getChangeSummary();
+        }
+
+        void GraphWriter::putDeleted()
+        {
+            // An object deleted while a change summary was logging is no
+            // longer in the graph, but the log still refers to it and holds
+            // it. Each subtree of such objects follows the graph, from the
+            // outermost deleted object, so that every object logged in it
+            // has a position.
+            std::set<DataObjectImpl*> deleted;
+            std::vector<DataObjectImpl*> order;
+            for (unsigned int k = 0; k < graphSize; k++)
+            {
+                ChangeSummaryImpl* cs = changeSummaryOf(objects[k]);
+                if (cs == 0)
+                {
+                    continue;
+                }
+                ChangedDataObjectListImpl& changed =
+                    (ChangedDataObjectListImpl&) cs->getChangedDataObjects();
+                for (unsigned int i = 0; i < changed.size(); i++)
+                {
+                    DataObjectImpl* ob = (DataObjectImpl*) changed.get(i);
+                    if (cs->isDeleted(ob) && deleted.insert(ob).second)
+                    {
+                        order.push_back(ob);
+                    }
+                }
+            }
+
+            std::set<DataObjectImpl*> written;
+            std::vector<DataObjectImpl*> tops;
+            for (unsigned int d = 0; d < order.size(); d++)
+            {
+                if (idOf(order[d]) != NONE)
+                {
+                    // deleted, then put back
+                    continue;
+                }
+                DataObjectImpl* top = order[d];
+                for (DataObjectImpl* c = top->getContainerImpl(); c != 0; c = c->getContainerImpl())
+                {
+                    if (deleted.find(c) != deleted.end())
+                    {
+                        top = c;
+                    }
+                }
+                if (idOf(top) == NONE && written.insert(top).second)
+                {
+                    tops.push_back(top);
+                }
+            }
+
+            putNumber(tops.size());
+            for (unsigned int t = 0; t < tops.size(); t++)
+            {
+                putObject(tops[t]);
+            }
+        }
+
+        void GraphWriter::putContainment(DataObjectImpl* container, const Property& prop)
+        {
+            unsigned int id = container == 0 ? NONE : idOf(container);
+            unsigned int index;
+            if (id != NONE && indexOf(container, prop, index))
+            {
+                putNumber((SnapshotNumber) id + 1);
+                putNumber(index);
+                return;
+            }
+            // The container is not written, so the property is named
+            putNumber(0);
+            putString(prop.getContainingType().getURI());
+            putString(prop.getContainingType().getName());
+            putString(prop.getName());
+        }
+
+        void GraphWriter::putOldValues(DataObjectImpl* ob, SettingList& oldValues)
+        {
+            std::vector<std::pair<unsigned int, Setting*> > settings;
+            for (int j = 0; j < oldValues.size(); j++)
+            {
+                Setting* setting = oldValues.get(j);
+                unsigned int index;
+                if (indexOf(ob, setting->getProperty(), index))
+                {
+                    settings.push_back(std::make_pair(index, setting));
+                }
+            }
+
+            putNumber(settings.size());
+            for (unsigned int j = 0; j < settings.size(); j++)
+            {
+                Setting* setting = settings[j].second;
+                putNumber(settings[j].first);
+                putNumber((setting->isSet() ? OLD_SET : 0)
+                          | (setting->isNull() ? OLD_NULL : 0));
+                putNumber(setting->getIndex());
+                if (setting->getType().isDataType())
+                {
+                    putSDOValue(setting->getSDOValue());
+                }
+                else
+                {
+                    DataObjectPtr value = setting->getDataObjectValue();
+                    putId(value);
+                }
+            }
+        }
+
+        void GraphWriter::putChangeLog(ChangeSummaryImpl* cs)
+        {
+            // The entries in the order they were logged, then what the log
+            // holds for each object, in the order the objects first appear.
+            ChangedDataObjectListImpl& changed =
+                (ChangedDataObjectListImpl&) cs->getChangedDataObjects();
+            std::vector<std::pair<unsigned int, unsigned int> > entries;
+            std::vector<DataObjectImpl*> logged;
+            std::set<DataObjectImpl*> seen;
+            for (unsigned int i = 0; i < changed.size(); i++)
+            {
+                DataObjectImpl* ob = (DataObjectImpl*) changed.get(i);
+                unsigned int id = idOf(ob);
+                if (id == NONE)
+                {
+                    continue;
+                }
+                entries.push_back(std::make_pair((unsigned int) changed.getType(i), id));
+                if (seen.insert(ob).second)
+                {
+                    logged.push_back(ob);
+                }
+            }
+
+            putNumber(entries.size());
+            for (unsigned int e = 0; e < entries.size(); e++)
+            {
+                putNumber(entries[e].first);
+                putNumber(entries[e].second);
+            }
+
+            for (unsigned int l = 0; l < logged.size(); l++)
+            {
+                DataObjectImpl* ob = logged[l];
+                DataObjectImpl* createdIn = 0;
+                const Property* createdAs = 0;
+                DataObjectImpl* deletedFrom = 0;
+                const Property* deletedAs = 0;
+                const char* oldpath = 0;
+                SettingList* deletedValues = 0;
+                const Property* changedFirst = 0;
+                SettingList* changedValues = 0;
+                unsigned int changedIndex = 0;
+
+                unsigned int flags = 0;
+                if (cs->getCreation(ob, createdIn, createdAs))
+                {
+                    flags |= LOG_CREATED;
+                }
+                if (cs->getDeletion(ob, deletedFrom, deletedAs, oldpath, deletedValues))
+                {
+                    flags |= LOG_DELETED;
+                }
+                if (cs->getChange(ob, changedFirst, changedValues)
+                    && indexOf(ob, *changedFirst, changedIndex))
+                {
+                    flags |= LOG_CHANGED;
+                }
+
+                putNumber(flags);
+                if (flags & LOG_CREATED)
+                {
+                    putContainment(createdIn, *createdAs);
+                }
+                if (flags & LOG_DELETED)
+                {
+                    putContainment(deletedFrom, *deletedAs);
+                    putBytes(oldpath == 0 ? "" : oldpath, oldpath == 0 ? 0 : strlen(oldpath));
+                    putOldValues(ob, *deletedValues);
+                }
+                if (flags & LOG_CHANGED)
+                {
+                    putNumber(changedIndex);
+                    putOldValues(ob, *changedValues);
+                }
+            }
+        }
+
+        void GraphWriter::putChangeSummaries()
+        {
+            std::vector<unsigned int> logging;
+            std::vector<unsigned int> changed;
+            for (unsigned int k = 0; k < graphSize; k++)
+            {
+                ChangeSummaryImpl* cs = changeSummaryOf(objects[k]);
+                if (cs == 0)
+                {
+                    continue;
+                }
+                if (cs->isLogging())
+                {
+                    logging.push_back(k);
+                }
+                if (cs->getChangedDataObjects().size() > 0)
+                {
+                    changed.push_back(k);
+                }
+            }
+
+            putNumber(logging.size());
+            for (unsigned int l = 0; l < logging.size(); l++)
+            {
+                putNumber(logging[l]);
+            }
+
+            for (unsigned int c = 0; c < changed.size(); c++)
+            {
+                putNumber(changed[c] + 1);
+                putChangeLog(changeSummaryOf(objects[changed[c]]));
+            }
+            putNumber(0);
+        }
+
+        void GraphWriter::write(DataObjectImpl* root)
+        {
+            putObject(root);
+            graphSize = objects.size();
+            std::sort(ids.begin(), ids.end());
+            putDeleted();
+            std::sort(ids.begin(), ids.end());
+            putReferences();
+            putSequences();
+            putChangeSummaries();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // GraphReader builds the objects in the order they were written.
+        // Every count and index is checked against the buffer and the model
+        // so that a damaged snapshot cannot be read past its end.
+        ///////////////////////////////////////////////////////////////////////
+
+        class GraphReader
+        {
+        public:
+            GraphReader(DataFactoryPtr df, unsigned int version,
+                        const char* buffer, unsigned int length)
+                : df(df), version(version), pos(buffer), end(buffer + length) {}
+
+            DataObjectPtr read();
+
+        private:
+            SnapshotNumber getNumber();
+            unsigned int getSmall();
+            unsigned int getCount();
+            int64_t getSigned();
+            const char* getBytes(unsigned int& len);
+            const SDOString& getString();
+            void getValue(SDOValue& sval);
+            const PropertyImpl* getProperty(DataObjectImpl* ob, unsigned int& index);
+            DataObjectImpl* getObject();
+            DataObjectImpl* getId();
+            DataObjectImpl* getLoggedId();
+            void setValue(DataObjectImpl* ob, unsigned int index);
+            void getReferences();
+            void getSequences();
+            void getChangeSummaries();
+            void getChangeLog(ChangeSummaryImpl* cs);
+            const Property* getContainment(DataObjectImpl*& container);
+            void getOldValues(DataObjectImpl* ob, SettingList& oldValues);
+
+            DataFactoryPtr df;
+            unsigned int version;
+            const char* pos;
+            const char* end;
+
+            // A deque, so that strings already read do not move
+            std::deque<SDOString> strings;
+
+            // Holding the objects keeps them alive until they are contained
+            std::vector<DataObjectPtr> objects;
+        };
+
+        SnapshotNumber GraphReader::getNumber()
+        {
+            SnapshotNumber n = 0;
+            for (unsigned int shift = 0; shift < 64; shift += 7)
+            {
+                if (pos >= end)
+                {
+                    throwInvalid("truncated");
+                }
+                unsigned char b = (unsigned char) *pos++;
+                n |= (SnapshotNumber) (b & 0x7F) << shift;
+                if ((b & 0x80) == 0)
+                {
+                    return n;
+                }
+            }
+            throwInvalid("bad number");
+            return 0;
+        }
+
+        unsigned int GraphReader::getSmall()
+        {
+            SnapshotNumber n = getNumber();
+            if (n > 0xFFFFFFFF)
+            {
+                throwInvalid("bad number");
+            }
+            return (unsigned int) n;
+        }
+
+        unsigned int GraphReader::getCount()
+        {
+            // Each item counted takes at least a byte
+            SnapshotNumber n = getNumber();
+            if (n > (SnapshotNumber) (end - pos))
+            {
+                throwInvalid("bad count");
+            }
+            return (unsigned int) n;
+        }
+
+        int64_t GraphReader::getSigned()
+        {
+            SnapshotNumber n = getNumber();
+            return (int64_t) (n >> 1) ^ -(int64_t) (n & 1);
+        }
+
+        const char* GraphReader::getBytes(unsigned int& len)
+        {
+            SnapshotNumber n = getNumber();
+            if (n > (SnapshotNumber) (end - pos))
+            {
+                throwInvalid("bad length");
+            }
+            len = (unsigned int) n;
+            const char* b = pos;
+            pos += len;
+            return b;
+        }
+
+        const SDOString& GraphReader::getString()
+        {
+            SnapshotNumber id = getNumber();
+            if (id == 0)
+            {
+                unsigned int len;
+                const char* s = getBytes(len);
+                strings.push_back(SDOString(s, len));
+                return strings.back();
+            }
+            if (id > strings.size())
+            {
+                throwInvalid("bad string");
+            }
+            return strings[(unsigned int) id - 1];
+        }
+
+        void GraphReader::getValue(SDOValue& sval)
+        {
+            SnapshotNumber raw = getNumber();
+            if (raw > DataTypeInfo::SDOWideString - DataTypeInfo::SDOunset)
+            {
+                throwInvalid("bad value");
+            }
+
+            switch ((int) raw + DataTypeInfo::SDOunset)
+            {
+            case DataTypeInfo::SDOunset:
+                sval = SDOValue::unsetSDOValue;
+                break;
+            case DataTypeInfo::SDOnull:
+                sval = SDOValue::nullSDOValue;
+                break;
+            case DataTypeInfo::SDObool:
+                sval = SDOValue(getNumber() != 0);
+                break;
+            case DataTypeInfo::SDOchar:
+                sval = SDOValue((char) getSigned());
+                break;
+            case DataTypeInfo::SDOwchar_t:
+                {
+                    SnapshotNumber c = getNumber();
+                    if (c > (sizeof(wchar_t) == 2 ? 0xFFFF : 0x10FFFF))
+                    {
+                        throwInvalid("character out of range");
+                    }
+                    sval = SDOValue((wchar_t) c);
+                }
+                break;
+            case DataTypeInfo::SDOshort:
+                sval = SDOValue((short) getSigned());
+                break;
+            case DataTypeInfo::SDOlong:
+                sval = SDOValue((long) getSigned());
+                break;
+            case DataTypeInfo::SDOint64_t:
+                sval = SDOValue(getSigned());
+                break;
+            case DataTypeInfo::SDOfloat:
+                {
+                    unsigned int w = getSmall();
+                    float f;
+                    memcpy(&f, &w, sizeof(f));
+                    sval = SDOValue(f);
+                }
+                break;
+            case DataTypeInfo::SDOdouble:
+                {
+                    unsigned int len;
+                    const char* b = getBytes(len);
+                    SDOString text(b, len);
+#if defined(WIN32)  || defined (_WINDOWS)
+                    sval = SDOValue((long double) strtod(text.c_str(), 0));
+#else
+                    sval = SDOValue(strtold(text.c_str(), 0));
+#endif
+                }
+                break;
+            case DataTypeInfo::SDOSDODate:
+                sval = SDOValue(SDODate((time_t) getSigned()));
+                break;
+            case DataTypeInfo::SDOCString:
+                {
+                    unsigned int len;
+                    const char* s = getBytes(len);
+                    sval = SDOValue(SDOString(s, len));
+                }
+                break;
+            case DataTypeInfo::SDOByteArray:
+                {
+                    unsigned int len;
+                    const char* s = getBytes(len);
+                    sval = SDOValue(s, len);
+                }
+                break;
+            case DataTypeInfo::SDOWideString:
+                {
+                    unsigned int len = getCount();
+                    std::vector<wchar_t> w;
+                    w.reserve(len + 1);
+                    for (unsigned int i = 0; i < len; i++)
+                    {
+                        SnapshotNumber c = getNumber();
+                        if (c > 0x10FFFF)
+                        {
+                            throwInvalid("character out of range");
+                        }
+                        if (sizeof(wchar_t) == 2 && c >= 0x10000)
+                        {
+                            c -= 0x10000;
+                            w.push_back((wchar_t) (0xD800 + (c >> 10)));
+                            w.push_back((wchar_t) (0xDC00 + (c & 0x3FF)));
+                        }
+                        else
+                        {
+                            w.push_back((wchar_t) c);
+                        }
+                    }
+                    unsigned int count = w.size();
+                    w.push_back(0);
+                    sval = SDOValue(&w[0], count);
+                }
+                break;
+            }
+        }
+
+        const PropertyImpl* GraphReader::getProperty(DataObjectImpl* ob, unsigned int& index)
+        {
+            index = getSmall();
+            const PropertyImpl* p = ob->getPropertyImpl(index);
+            if (p == 0)
+            {
+                throwInvalid("bad property index");
+            }
+            return p;
+        }
+
+        void GraphReader::setValue(DataObjectImpl* ob, unsigned int index)
+        {
+            const PropertyImpl* p = ob->getPropertyImpl(index);
+            unsigned int kind = getSmall();
+            if (kind != VALUE_LIST && isList(p))
+            {
+                throwInvalid("single value for list property");
+            }
+            if ((kind == VALUE_NONE || kind == VALUE_OBJECT) && p->getType().isDataType())
+            {
+                throwInvalid("data object for data type property");
+            }
+
+            switch (kind)
+            {
+            case VALUE_NONE:
+                ob->setDataObject(index, DataObjectPtr(), false);
+                break;
+            case VALUE_NULL:
+                ob->setNull(index);
+                break;
+            case VALUE_DATA:
+                {
+                    const SDOString& uri = getString();
+                    const SDOString& name = getString();
+                    SDOValue sval;
+                    getValue(sval);
+                    if (sval.isNull())
+                    {
+                        ob->setNull(index);
+                    }
+                    else if (sval.isSet())
+                    {
+                        // Values are held as the SDO type of their name,
+                        // and any other type only once the property is null.
+                        if (uri != Type::SDOTypeNamespaceURI)
+                        {
+                            ob->setNull(index);
+                        }
+                        ob->setSDOValue(index, sval, name, false);
+                    }
+                }
+                break;
+            case VALUE_OBJECT:
+                ob->setDataObject(index, DataObjectPtr(getObject()), false);
+                break;
+            case VALUE_LIST:
+                {
+                    if (!isList(p))
+                    {
+                        throwInvalid("list for single valued property");
+                    }
+                    DataObjectList& list = ob->getList(index);
+                    unsigned int count = getCount();
+                    for (unsigned int j = 0; j < count; j++)
+                    {
+                        unsigned int itemKind = getSmall();
+                        if (itemKind == VALUE_OBJECT)
+                        {
+                            list.append(DataObjectPtr(getObject()));
+                            continue;
+                        }
+                        if (itemKind != VALUE_DATA)
+                        {
+                            throwInvalid("bad list item");
+                        }
+                        const SDOString& uri = getString();
+                        const SDOString& name = getString();
+                        SDOValue sval;
+                        getValue(sval);
+                        DataObjectPtr item = df->create(uri, name);
+                        DataObjectImpl* holder = (DataObjectImpl*) (DataObject*) item;
+                        if (sval.isNull())
+                        {
+                            holder->setNull();
+                        }
+                        else
+                        {
+                            holder->setSDOValue(sval);
+                        }
+                        list.append(item);
+                    }
+                }
+                break;
+            default:
+                throwInvalid("bad value kind");
+            }
+        }
+
+        DataObjectImpl* GraphReader::getObject()
+        {
+            const SDOString& uri = getString();
+            const SDOString& name = getString();
+            DataObjectPtr dob = df->create(uri, name);
+            objects.push_back(dob);
+            DataObjectImpl* ob = (DataObjectImpl*) (DataObject*) dob;
+
+            unsigned int base = ob->getTypeImpl().getPropertiesSize();
+            unsigned int openCount = getCount();
+            for (unsigned int o = 0; o < openCount; o++)
+            {
+                const SDOString& propertyName = getString();
+                const SDOString& typeUri = getString();
+                const SDOString& typeName = getString();
+                unsigned int flags = getSmall();
+                const Type& t = df->getType(typeUri.c_str(), typeName.c_str());
+                if (flags & OPEN_MANY)
+                {
+                    ob->defineList(propertyName.c_str());
+                    if (typeUri != Type::SDOTypeNamespaceURI || typeName != "OpenDataObject")
+                    {
+                        ob->setInstancePropertyType(base + o, &t);
+                    }
+                }
+                else
+                {
+                    ob->defineProperty(propertyName, t);
+                }
+            }
+
+            for (;;)
+            {
+                SnapshotNumber index = getNumber();
+                if (index == 0)
+                {
+                    break;
+                }
+                if (index > base + openCount)
+                {
+                    throwInvalid("bad property index");
+                }
+                setValue(ob, (unsigned int) index - 1);
+            }
+            return ob;
+        }
+
+        DataObjectImpl* GraphReader::getId()
+        {
+            SnapshotNumber id = getNumber();
+            if (id >= objects.size())
+            {
+                throwInvalid("bad object");
+            }
+            DataObject* ob = objects[(unsigned int) id];
+            return (DataObjectImpl*) ob;
+        }
+
+        DataObjectImpl* GraphReader::getLoggedId()
+        {
+            SnapshotNumber id = getNumber();
+            if (id == 0)
+            {
+                return 0;
+            }
+            if (id > objects.size())
+            {
+                throwInvalid("bad object");
+            }
+            DataObject* ob = objects[(unsigned int) id - 1];
+            return (DataObjectImpl*) ob;
+        }
+
+        void GraphReader::getReferences()
+        {
+            for (;;)
+            {
+                SnapshotNumber referer = getNumber();
+                if (referer == 0)
+                {
+                    break;
+                }
+                if (referer > objects.size())
+                {
+                    throwInvalid("bad object");
+                }
+                DataObject* dob = objects[(unsigned int) referer - 1];
+                DataObjectImpl* ob = (DataObjectImpl*) dob;
+                unsigned int index;
+                const PropertyImpl* p = getProperty(ob, index);
+                if (!p->isReference())
+                {
+                    throwInvalid("not a reference");
+                }
+                unsigned int count = getCount();
+                if (isList(p))
+                {
+                    DataObjectList& list = ob->getList(index);
+                    for (unsigned int t = 0; t < count; t++)
+                    {
+                        list.append(DataObjectPtr(getId()));
+                    }
+                }
+                else
+                {
+                    if (count != 1)
+                    {
+                        throwInvalid("bad reference");
+                    }
+                    ob->setDataObject(index, DataObjectPtr(getId()), false);
+                }
+            }
+        }
+
+        void GraphReader::getSequences()
+        {
+            // The entries made as the values were set are replaced with
+            // those saved.
+            for (;;)
+            {
+                SnapshotNumber id = getNumber();
+                if (id == 0)
+                {
+                    break;
+                }
+                if (id > objects.size())
+                {
+                    throwInvalid("bad object");
+                }
+                DataObject* dob = objects[(unsigned int) id - 1];
+                DataObjectImpl* ob = (DataObjectImpl*) dob;
+                SequenceImpl* seq = ob->getSequenceImpl();
+                if (seq == 0)
+                {
+                    throwInvalid("not sequenced");
+                }
+                while (seq->size() > 0)
+                {
+                    seq->remove(seq->size() - 1);
+                }
+
+                for (;;)
+                {
+                    SnapshotNumber entry = getNumber();
+                    if (entry == 0)
+                    {
+                        break;
+                    }
+                    if (entry == ENTRY_TEXT)
+                    {
+                        unsigned int len;
+                        const char* text = getBytes(len);
+                        seq->addText(SDOString(text, len).c_str());
+                        continue;
+                    }
+                    const PropertyImpl* p = 0;
+                    if (entry - ENTRY_SETTING <= 0xFFFFFFFF)
+                    {
+                        p = ob->getPropertyImpl((unsigned int) (entry - ENTRY_SETTING));
+                    }
+                    if (p == 0)
+                    {
+                        throwInvalid("bad property index");
+                    }
+                    unsigned int listIndex = getSmall();
+                    if (p->isMany() ? listIndex >= ob->getList(*p).size() : listIndex != 0)
+                    {
+                        throwInvalid("bad list index");
+                    }
+                    seq->push(*p, listIndex);
+                }
+            }
+        }
+
+        void GraphReader::getChangeSummaries()
+        {
+            unsigned int count = getCount();
+            for (unsigned int l = 0; l < count; l++)
+            {
+                DataObjectImpl* ob = getId();
+                if (!ob->getType().isChangeSummaryType())
+                {
+                    throwInvalid("no change summary");
+                }
+                ob->getChangeSummary()->beginLogging();
+            }
+
+            if (version < 3)
+            {
+                return;
+            }
+            for (;;)
+            {
+                SnapshotNumber id = getNumber();
+                if (id == 0)
+                {
+                    break;
+                }
+                if (id > objects.size())
+                {
+                    throwInvalid("bad object");
+                }
+                DataObject* dob = objects[(unsigned int) id - 1];
+                DataObjectImpl* ob = (DataObjectImpl*) dob;
+                if (!ob->getType().isChangeSummaryType())
+                {
+                    throwInvalid("no change summary");
+                }
+                getChangeLog((ChangeSummaryImpl*) ob->getChangeSummary());
+            }
+        }
+
+        const Property* GraphReader::getContainment(DataObjectImpl*& container)
+        {
+            SnapshotNumber id = getNumber();
+            if (id != 0)
+            {
+                if (id > objects.size())
+                {
+                    throwInvalid("bad object");
+                }
+                DataObject* dob = objects[(unsigned int) id - 1];
+                container = (DataObjectImpl*) dob;
+                unsigned int index;
+                return getProperty(container, index);
+            }
+
+            // A property of a container which was not written; it is left
+            // out of the log if the model does not define it.
+            container = 0;
+            const SDOString& uri = getString();
+            const SDOString& typeName = getString();
+            const SDOString& name = getString();
+            const TypeImpl* t = ((DataFactoryImpl*) (DataFactory*) df)->findTypeImpl(uri, typeName);
+            if (t == 0)
+            {
+                return 0;
+            }
+            return t->getPropertyImpl(name);
+        }
+
+        void GraphReader::getOldValues(DataObjectImpl* ob, SettingList& oldValues)
+        {
+            unsigned int count = getCount();
+            for (unsigned int j = 0; j < count; j++)
+            {
+                unsigned int index;
+                const PropertyImpl* p = getProperty(ob, index);
+                unsigned int flags = getSmall();
+                bool isSet = (flags & OLD_SET) != 0;
+                bool isNull = (flags & OLD_NULL) != 0;
+                unsigned int listIndex = getSmall();
+                if (p->getType().isDataType())
+                {
+                    SDOValue sval;
+                    getValue(sval);
+                    oldValues.append(Setting(isSet, isNull, sval, *p, listIndex));
+                }
+                else
+                {
+                    DataObject* value = getLoggedId();
+                    oldValues.append(Setting(isSet, isNull, value, *p, listIndex));
+                }
+            }
+        }
+
+        void GraphReader::getChangeLog(ChangeSummaryImpl* cs)
+        {
+            // The log is put back as it was written, after any logging
+            // has begun, since beginning clears it.
+            unsigned int count = getCount();
+            std::vector<DataObjectImpl*> logged;
+            std::set<DataObjectImpl*> seen;
+            for (unsigned int e = 0; e < count; e++)
+            {
+                unsigned int type = getSmall();
+                if (type < ChangedDataObjectList::Create || type > ChangedDataObjectList::Delete)
+                {
+                    throwInvalid("bad change type");
+                }
+                DataObjectImpl* ob = getId();
+                cs->restoreEntry(ob, (ChangedDataObjectList::ChangeType) type);
+                if (seen.insert(ob).second)
+                {
+                    logged.push_back(ob);
+                }
+            }
+
+            for (unsigned int l = 0; l < logged.size(); l++)
+            {
+                DataObjectImpl* ob = logged[l];
+                unsigned int flags = getSmall();
+                DataObjectImpl* container;
+                const Property* p;
+
+                if (flags & LOG_CREATED)
+                {
+                    p = getContainment(container);
+                    if (p != 0)
+                    {
+                        cs->restoreCreation(ob, container, *p);
+                    }
+                }
+                if (flags & LOG_DELETED)
+                {
+                    p = getContainment(container);
+                    unsigned int len;
+                    const char* b = getBytes(len);
+                    SDOString oldpath(b, len);
+                    SettingList unused;
+                    getOldValues(ob, p == 0 ? unused
+                                 : cs->restoreDeletion(ob, container, *p, oldpath.c_str()));
+                }
+                if (flags & LOG_CHANGED)
+                {
+                    unsigned int index;
+                    p = getProperty(ob, index);
+                    getOldValues(ob, cs->restoreChange(ob, *p));
+                }
+            }
+        }
+
+        DataObjectPtr GraphReader::read()
+        {
+            DataObjectPtr root = getObject();
+            if (version >= 3)
+            {
+                // The deleted objects the change logs refer to
+                unsigned int count = getCount();
+                for (unsigned int d = 0; d < count; d++)
+                {
+                    getObject();
+                }
+            }
+            getReferences();
+            getSequences();
+            getChangeSummaries();
+            if (pos != end)
+            {
+                throwInvalid("trailing data");
+            }
+            return root;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // SDOGraphSnapshot
+        ///////////////////////////////////////////////////////////////////////
+
+        void SDOGraphSnapshot::save(DataObjectPtr dataObject,
+                                    int64_t modelFingerprint,
+                                    SDOString& buffer)
+        {
+            if (!dataObject)
+            {
+                SDO_THROW_EXCEPTION("SDOGraphSnapshot::save",
+                    SDONullPointerException, "No data object to save");
+            }
+
+            unsigned int header[HDR_SIZE];
+            SDOString snapshot(HEADER_LENGTH, '\0');
+
+            GraphWriter writer(snapshot);
+            DataObject* root = dataObject;
+            writer.write((DataObjectImpl*) root);
+
+            SnapshotNumber model = (SnapshotNumber) modelFingerprint;
+            header[HDR_MAGIC] = wordAt(SNAPSHOT_MAGIC);
+            header[HDR_VERSION] = SDOGraphSnapshot::version;
+            header[HDR_LENGTH] = snapshot.length();
+            header[HDR_MODEL_LO] = (unsigned int) (model & 0xFFFFFFFF);
+            header[HDR_MODEL_HI] = (unsigned int) (model >> 32);
+            header[HDR_RESERVED] = 0;
+
+            SDOString words;
+            for (unsigned int h = 0; h < HDR_SIZE; h++)
+            {
+                appendWord(words, header[h]);
+            }
+            snapshot.replace(0, HEADER_LENGTH, words);
+
+            buffer.append(snapshot);
+        }
+
+        DataObjectPtr SDOGraphSnapshot::load(DataFactoryPtr df,
+                                             const char* buffer,
+                                             unsigned int length)
+        {
+            if (getSnapshotLength(buffer, length) == 0)
+            {
+                throwInvalid("bad header");
+            }
+
+            unsigned int snapshotVersion = wordAt(buffer + HDR_VERSION * WORD_SIZE);
+            if (snapshotVersion < OLDEST_VERSION || snapshotVersion > SDOGraphSnapshot::version)
+            {
+                throwInvalid("unsupported version");
+            }
+
+            GraphReader reader(df, snapshotVersion, buffer + HEADER_LENGTH,
+                               wordAt(buffer + HDR_LENGTH * WORD_SIZE) - HEADER_LENGTH);
+            return reader.read();
+        }
+
+        unsigned int SDOGraphSnapshot::getSnapshotLength(const char* buffer,
+                                                         unsigned int length)
+        {
+            if (buffer == 0 || length < HEADER_LENGTH)
+            {
+                return 0;
+            }
+            unsigned int snapshotLength = wordAt(buffer + HDR_LENGTH * WORD_SIZE);
+            if (memcmp(buffer, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0
+                || snapshotLength > length
+                || snapshotLength < HEADER_LENGTH)
+            {
+                return 0;
+            }
+            return snapshotLength;
+        }
+
+        int64_t SDOGraphSnapshot::getModelFingerprint(const char* buffer,
+                                                      unsigned int length)
+        {
+            if (getSnapshotLength(buffer, length) == 0)
+            {
+                throwInvalid("bad header");
+            }
+            return (int64_t) (((SnapshotNumber) wordAt(buffer + HDR_MODEL_HI * WORD_SIZE) << 32)
+                              | wordAt(buffer + HDR_MODEL_LO * WORD_SIZE));
+        }
+
+    } // End - namespace sdo
+} // End - namespace commonj
@@ -0,0 +1,102 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* $Rev$ $Date$ */
+
+#ifndef _SDOGRAPHSNAPSHOT_H_
+#define _SDOGRAPHSNAPSHOT_H_
+
+#include "commonj/sdo/export.h"
+#include "commonj/sdo/DataFactory.h"
+#include "commonj/sdo/DataObject.h"
+#include "commonj/sdo/SDOString.h"
+
+namespace commonj
+{
+    namespace sdo
+    {
+
+    /**
+     * SDOGraphSnapshot saves a data graph in a compact binary form, and
+     * builds it again in a data factory holding the same model.
+     *
+     * The snapshot records the data objects below the root by containment,
+     * with their open properties, values, lists and sequences, and the
+     * change logs of any change summaries, with the objects they deleted
+     * and the old values. Properties
+     * are given by index, counts and numbers as variable length integers
+     * and type names once each. References are given by the position of
+     * their target among the objects of the graph; a reference to an
+     * object outside the graph is not kept.
+     *
+     * The model is not part of the snapshot. It is identified instead by a
+     * fingerprint, such as SDOModelSnapshot::getFingerprint gives, which
+     * the caller uses to find or load the model before loading the graph.
+     * Like a model snapshot, the format does not depend on the byte order
+     * or type sizes of the platform which wrote it.
+     */
+
+    class SDOGraphSnapshot
+        {
+        public:
+
+            /**
+             * Appends a snapshot of the graph below the data object to the
+             * buffer, tagged with the fingerprint of its model.
+             */
+            static SDO_API void save(DataObjectPtr dataObject,
+                                     int64_t modelFingerprint,
+                                     SDOString& buffer);
+
+            /**
+             * Builds the graph held in a snapshot in the data factory,
+             * which must hold the model the graph was saved from, and
+             * returns its root. A snapshot of version 2, from before the
+             * change logs were kept, still loads.
+             * Throws SDOIllegalArgumentException if the buffer does not
+             * hold a valid snapshot.
+             */
+            static SDO_API DataObjectPtr load(DataFactoryPtr df,
+                                              const char* buffer,
+                                              unsigned int length);
+
+            /**
+             * Returns the number of bytes of the snapshot at the start of
+             * the buffer, or 0 if the buffer does not start with one.
+             */
+            static SDO_API unsigned int getSnapshotLength(const char* buffer,
+                                                          unsigned int length);
+
+            /**
+             * Returns the model fingerprint of the snapshot at the start of
+             * the buffer, which must start with one.
+             */
+            static SDO_API int64_t getModelFingerprint(const char* buffer,
+                                                       unsigned int length);
+
+            /**
+             * The current version of the snapshot format.
+             */
+            static SDO_API const unsigned int version;
+        };
+    } // End - namespace sdo
+} // End - namespace commonj
+
+
+#endif //_SDOGRAPHSNAPSHOT_H_
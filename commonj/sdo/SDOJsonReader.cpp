@@ -0,0 +1,588 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* $Rev$ $Date$ */
+
+#include "commonj/sdo/SDOJsonReader.h"
+#include "commonj/sdo/SDOJsonWriter.h"
+#include "commonj/sdo/DataObjectImpl.h"
+#include "commonj/sdo/DataObjectList.h"
+#include "commonj/sdo/PropertyImpl.h"
+#include "commonj/sdo/SDORuntimeException.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+
+namespace commonj
+{
+    namespace sdo
+    {
+
+        const unsigned int SDOJsonReader::maxDepth = 512;
+
+        SDOJsonReader::SDOJsonReader() : begin(0), cur(0), end(0), depth(0)
+        {
+        }
+
+        SDOJsonReader::~SDOJsonReader()
+        {
+        }
+
+        void SDOJsonReader::read(const char* json,
+                                 unsigned int length,
+                                 DataObjectPtr root)
+        {
+            if (!root)
+            {
+                SDO_THROW_EXCEPTION("SDOJsonReader::read",
+                    SDONullPointerException, "No data object to read into");
+            }
+
+            begin = cur = json;
+            end = json + length;
+            depth = 0;
+
+            DataObject* dob = root;
+            skipWhitespace();
+            readObject((DataObjectImpl*) dob);
+            skipWhitespace();
+            if (cur != end)
+            {
+                throwSyntax("unexpected text after the object");
+            }
+        }
+
+        void SDOJsonReader::readObject(DataObjectImpl* dataObject)
+        {
+            expect('{');
+            enter();
+
+            skipWhitespace();
+            if (peek('}'))
+            {
+                cur++;
+                depth--;
+                return;
+            }
+
+            SDOString name;
+            for (;;)
+            {
+                skipWhitespace();
+                readString(name);
+                skipWhitespace();
+                expect(':');
+                readValue(dataObject, name);
+
+                skipWhitespace();
+                if (peek(','))
+                {
+                    cur++;
+                    continue;
+                }
+                expect('}');
+                break;
+            }
+            depth--;
+        }
+
+        void SDOJsonReader::readValue(DataObjectImpl* dataObject, const SDOString& name)
+        {
+            skipWhitespace();
+
+            if (peek('{') || peek('['))
+            {
+                const PropertyImpl* p = dataObject->getPropertyImpl(name);
+                if (p == 0 && dataObject->getType().isOpenType())
+                {
+                    // An undefined open property holds an object of the
+                    // same type as its container
+                    p = dataObject->defineDataObject(name, dataObject->getType());
+                }
+                if (p == 0)
+                {
+                    SDOString msg("Property not found: ");
+                    msg += name;
+                    SDO_THROW_EXCEPTION("SDOJsonReader::read",
+                        SDOPropertyNotFoundException, msg.c_str());
+                }
+
+                if (peek('{'))
+                {
+                    DataObjectPtr child = dataObject->createDataObject(*p);
+                    DataObject* dob = child;
+                    readObject((DataObjectImpl*) dob);
+                }
+                else if (p->isMany())
+                {
+                    readArray(dataObject, p);
+                }
+                else if (!p->getType().isDataType())
+                {
+                    DataObjectPtr child = dataObject->createDataObject(*p);
+                    DataObject* dob = child;
+                    readArrayEntries((DataObjectImpl*) dob, name);
+                }
+                else
+                {
+                    SDOString msg("An array cannot be held in single valued property ");
+                    msg += name;
+                    SDO_THROW_EXCEPTION("SDOJsonReader::read",
+                        SDOUnsupportedOperationException, msg.c_str());
+                }
+                return;
+            }
+
+            SDOValue value;
+            bool isNull = !readPrimitive(value);
+
+            const PropertyImpl* p = dataObject->getPropertyImpl(name);
+            if (isNull)
+            {
+                // A null has no type from which to define an open property
+                if (p != 0 && !p->isMany())
+                {
+                    dataObject->setNull(*p);
+                }
+                return;
+            }
+
+            if (p == 0 && dataObject->getType().isOpenType())
+            {
+                p = dataObject->defineSDOValue(name, value);
+            }
+            if (p == 0)
+            {
+                SDOString msg("Property not found: ");
+                msg += name;
+                SDO_THROW_EXCEPTION("SDOJsonReader::read",
+                    SDOPropertyNotFoundException, msg.c_str());
+            }
+
+            if (p->getTypeEnum() == Type::BytesType)
+            {
+                textToBytes(value);
+            }
+
+            if (p->isMany())
+            {
+                dataObject->getList(*p).append(value);
+            }
+            else
+            {
+                dataObject->setSDOValue(*p, value, value.convertTypeEnumToString());
+            }
+        }
+
+        void SDOJsonReader::readArray(DataObjectImpl* dataObject, const PropertyImpl* p)
+        {
+            expect('[');
+            enter();
+
+            DataObjectList& list = dataObject->getList(*p);
+
+            skipWhitespace();
+            if (peek(']'))
+            {
+                cur++;
+                depth--;
+                return;
+            }
+
+            SDOValue value;
+            bool bytes = p->getTypeEnum() == Type::BytesType;
+            for (;;)
+            {
+                skipWhitespace();
+                if (peek('{'))
+                {
+                    DataObjectPtr child = dataObject->createDataObject(*p);
+                    DataObject* dob = child;
+                    readObject((DataObjectImpl*) dob);
+                }
+                else if (peek('['))
+                {
+                    SDOString msg("An array cannot be held in an entry of ");
+                    msg += p->getName();
+                    SDO_THROW_EXCEPTION("SDOJsonReader::read",
+                        SDOUnsupportedOperationException, msg.c_str());
+                }
+                else if (readPrimitive(value))
+                {
+                    if (bytes)
+                    {
+                        textToBytes(value);
+                    }
+                    list.append(value);
+                }
+
+                skipWhitespace();
+                if (peek(','))
+                {
+                    cur++;
+                    continue;
+                }
+                expect(']');
+                break;
+            }
+            depth--;
+        }
+
+        void SDOJsonReader::readArrayEntries(DataObjectImpl* dataObject, const SDOString& name)
+        {
+            expect('[');
+            enter();
+
+            skipWhitespace();
+            if (peek(']'))
+            {
+                cur++;
+                depth--;
+                return;
+            }
+
+            char index[16];
+            for (unsigned int i = 0; ; i++)
+            {
+                sprintf(index, "%u", i);
+                readValue(dataObject, name + index);
+
+                skipWhitespace();
+                if (peek(','))
+                {
+                    cur++;
+                    continue;
+                }
+                expect(']');
+                break;
+            }
+            depth--;
+        }
+
+        bool SDOJsonReader::readPrimitive(SDOValue& value)
+        {
+            if (cur == end)
+            {
+                throwSyntax("value expected");
+            }
+
+            switch (*cur)
+            {
+                case '"':
+                {
+                    SDOString s;
+                    readString(s);
+                    value = SDOValue(s);
+                    return true;
+                }
+                case 't':
+                    if (end - cur >= 4 && strncmp(cur, "true", 4) == 0)
+                    {
+                        cur += 4;
+                        value = SDOValue(true);
+                        return true;
+                    }
+                    break;
+                case 'f':
+                    if (end - cur >= 5 && strncmp(cur, "false", 5) == 0)
+                    {
+                        cur += 5;
+                        value = SDOValue(false);
+                        return true;
+                    }
+                    break;
+                case 'n':
+                    if (end - cur >= 4 && strncmp(cur, "null", 4) == 0)
+                    {
+                        cur += 4;
+                        return false;
+                    }
+                    break;
+                default:
+                    if (*cur == '-' || (*cur >= '0' && *cur <= '9'))
+                    {
+                        readNumber(value);
+                        return true;
+                    }
+                    break;
+            }
+            throwSyntax("value expected");
+            return false;
+        }
+
+        void SDOJsonReader::textToBytes(SDOValue& value)
+        {
+            if (value.getRawType() != DataTypeInfo::SDOCString)
+            {
+                return;
+            }
+
+            // Each character stands for one byte, so those above 0x7F
+            // arrive as two byte UTF-8 sequences
+            const SDOString& text = *value.getTextString();
+            SDOString bytes;
+            bytes.reserve(text.length());
+            for (unsigned int i = 0; i < text.length(); i++)
+            {
+                unsigned char c = (unsigned char) text[i];
+                if (c < 0x80)
+                {
+                    bytes += (char) c;
+                }
+                else if ((c == 0xc2 || c == 0xc3) && i + 1 < text.length())
+                {
+                    bytes += (char) (((c & 0x03) << 6) | (text[++i] & 0x3f));
+                }
+                else
+                {
+                    throwSyntax("character out of range for bytes");
+                }
+            }
+            value = SDOValue(bytes.data(), bytes.length());
+        }
+
+        void SDOJsonReader::readNumber(SDOValue& value)
+        {
+            const char* start = cur;
+            bool integral = true;
+
+            if (*cur == '-')
+            {
+                cur++;
+            }
+            if (cur == end || *cur < '0' || *cur > '9')
+            {
+                throwSyntax("digit expected");
+            }
+            while (cur != end && *cur >= '0' && *cur <= '9')
+            {
+                cur++;
+            }
+            if (cur != end && *cur == '.')
+            {
+                integral = false;
+                cur++;
+                if (cur == end || *cur < '0' || *cur > '9')
+                {
+                    throwSyntax("digit expected");
+                }
+                while (cur != end && *cur >= '0' && *cur <= '9')
+                {
+                    cur++;
+                }
+            }
+            if (cur != end && (*cur == 'e' || *cur == 'E'))
+            {
+                integral = false;
+                cur++;
+                if (cur != end && (*cur == '+' || *cur == '-'))
+                {
+                    cur++;
+                }
+                if (cur == end || *cur < '0' || *cur > '9')
+                {
+                    throwSyntax("digit expected");
+                }
+                while (cur != end && *cur >= '0' && *cur <= '9')
+                {
+                    cur++;
+                }
+            }
+
+            // The text is not terminated, so convert from a copy
+            SDOString text(start, cur - start);
+
+            if (integral)
+            {
+                errno = 0;
+                long l = strtol(text.c_str(), 0, 10);
+                if (errno == 0)
+                {
+                    value = SDOValue(l);
+                    return;
+                }
+                errno = 0;
+                int64_t ll = (int64_t) strtoll(text.c_str(), 0, 10);
+                if (errno == 0)
+                {
+                    value = SDOValue(ll);
+                    return;
+                }
+            }
+            value = SDOValue((long double) strtod(text.c_str(), 0));
+        }
+
+        void SDOJsonReader::readString(SDOString& value)
+        {
+            expect('"');
+            value.erase();
+
+            const char* start = cur;
+            for (;;)
+            {
+                if (cur == end)
+                {
+                    throwSyntax("unterminated string");
+                }
+
+                unsigned char c = (unsigned char) *cur;
+                if (c == '"')
+                {
+                    value.append(start, cur - start);
+                    cur++;
+                    return;
+                }
+                if (c < 0x20)
+                {
+                    throwSyntax("control character in string");
+                }
+                if (c != '\\')
+                {
+                    cur++;
+                    continue;
+                }
+
+                value.append(start, cur - start);
+                cur++;
+                if (cur == end)
+                {
+                    throwSyntax("unterminated string");
+                }
+                switch (*cur++)
+                {
+                    case '"':  value += '"'; break;
+                    case '\\': value += '\\'; break;
+                    case '/':  value += '/'; break;
+                    case 'b':  value += '\b'; break;
+                    case 'f':  value += '\f'; break;
+                    case 'n':  value += '\n'; break;
+                    case 'r':  value += '\r'; break;
+                    case 't':  value += '\t'; break;
+                    case 'u':
+                    {
+                        unsigned long u = readHex4();
+                        if (u >= 0xd800 && u < 0xdc00
+                            && end - cur >= 6 && cur[0] == '\\' && cur[1] == 'u')
+                        {
+                            // A surrogate pair
+                            const char* save = cur;
+                            cur += 2;
+                            unsigned long low = readHex4();
+                            if (low >= 0xdc00 && low < 0xe000)
+                            {
+                                u = 0x10000 + ((u - 0xd800) << 10) + (low - 0xdc00);
+                            }
+                            else
+                            {
+                                cur = save;
+                            }
+                        }
+                        SDOJsonWriter::appendUTF8(value, u);
+                        break;
+                    }
+                    default:
+                        cur--;
+                        throwSyntax("invalid escape in string");
+                }
+                start = cur;
+            }
+        }
+
+        unsigned long SDOJsonReader::readHex4()
+        {
+            if (end - cur < 4)
+            {
+                throwSyntax("invalid unicode escape");
+            }
+
+            unsigned long u = 0;
+            for (int i = 0; i < 4; i++)
+            {
+                char c = *cur++;
+                u <<= 4;
+                if (c >= '0' && c <= '9')
+                {
+                    u |= c - '0';
+                }
+                else if (c >= 'a' && c <= 'f')
+                {
+                    u |= c - 'a' + 10;
+                }
+                else if (c >= 'A' && c <= 'F')
+                {
+                    u |= c - 'A' + 10;
+                }
+                else
+                {
+                    cur--;
+                    throwSyntax("invalid unicode escape");
+                }
+            }
+            return u;
+        }
+
+        void SDOJsonReader::skipWhitespace()
+        {
+            while (cur != end
+                   && (*cur == ' ' || *cur == '\t' || *cur == '\n' || *cur == '\r'))
+            {
+                cur++;
+            }
+        }
+
+        bool SDOJsonReader::peek(char c)
+        {
+            return cur != end && *cur == c;
+        }
+
+        void SDOJsonReader::expect(char c)
+        {
+            if (!peek(c))
+            {
+                char reason[16];
+                sprintf(reason, "'%c' expected", c);
+                throwSyntax(reason);
+            }
+            cur++;
+        }
+
+        void SDOJsonReader::enter()
+        {
+            if (++depth > maxDepth)
+            {
+                throwSyntax("nesting too deep");
+            }
+        }
+
+        void SDOJsonReader::throwSyntax(const char* reason)
+        {
+            char position[32];
+            sprintf(position, " at offset %lu", (unsigned long) (cur - begin));
+
+            SDOString msg("Invalid JSON: ");
+            msg += reason;
+            msg += position;
+            SDO_THROW_EXCEPTION("SDOJsonReader::read",
+                SDOIllegalArgumentException, msg.c_str());
+        }
+
+    } // End - namespace sdo
+} // End - namespace commonj
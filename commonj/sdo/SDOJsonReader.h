@@ -0,0 +1,106 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* $Rev$ $Date$ */
+
+#ifndef _SDOJSONREADER_H_
+#define _SDOJSONREADER_H_
+
+#include "commonj/sdo/export.h"
+#include "commonj/sdo/DataObject.h"
+#include "commonj/sdo/SDOString.h"
+#include "commonj/sdo/SDOValue.h"
+
+namespace commonj
+{
+    namespace sdo
+    {
+        class DataObjectImpl;
+        class PropertyImpl;
+
+/**
+ * SDOJsonReader reads JSON text into a data object tree.
+ *
+ * The text is parsed in a single pass and the graph is built as each
+ * value is met, with no intermediate tree. The text must hold a JSON
+ * object, whose members are set on the root data object given:
+ *
+ * - an object creates a data object in the named containment property.
+ * - an array appends its entries to a many valued property.
+ * - a primitive sets the named property, converting from the JSON type
+ *   (string, integer, real number or boolean) to the type of the property.
+ *   A string read into a Bytes property gives one byte per character, as
+ *   SDOJsonWriter writes them.
+ *
+ * When an open type has no property of the name, one is defined as for any
+ * other open setting. Objects in such properties are created with the type
+ * of the object holding them, and an array becomes an object of that type
+ * whose properties are named after the array with the index appended
+ * ("item0", "item1" ...). Reading into a single open type therefore gives
+ * a generic graph for JSON which has no model.
+ *
+ * Throws SDOIllegalArgumentException if the text is not valid JSON.
+ */
+        class SDOJsonReader
+        {
+        public:
+
+            SDO_SPI SDOJsonReader();
+
+            SDO_SPI virtual ~SDOJsonReader();
+
+            /**
+             * Reads the JSON object in the text into the root data object.
+             */
+            SDO_SPI void read(const char* json,
+                              unsigned int length,
+                              DataObjectPtr root);
+
+            /**
+             * The maximum nesting of objects and arrays accepted.
+             */
+            static SDO_SPI const unsigned int maxDepth;
+
+        private:
+            void readObject(DataObjectImpl* dataObject);
+            void readValue(DataObjectImpl* dataObject, const SDOString& name);
+            void readArray(DataObjectImpl* dataObject, const PropertyImpl* property);
+            void readArrayEntries(DataObjectImpl* dataObject, const SDOString& name);
+            bool readPrimitive(SDOValue& value);
+            void textToBytes(SDOValue& value);
+            void readNumber(SDOValue& value);
+            void readString(SDOString& value);
+            unsigned long readHex4();
+
+            void skipWhitespace();
+            bool peek(char c);
+            void expect(char c);
+            void enter();
+            void throwSyntax(const char* reason);
+
+            const char* begin;
+            const char* cur;
+            const char* end;
+            unsigned int depth;
+        };
+    } // End - namespace sdo
+} // End - namespace commonj
+
+
+#endif //_SDOJSONREADER_H_
@@ -0,0 +1,378 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* $Rev$ $Date$ */
+
+#include "commonj/sdo/SDOJsonWriter.h"
+#include "commonj/sdo/DataObjectImpl.h"
+#include "commonj/sdo/DataObjectList.h"
+#include "commonj/sdo/PropertyImpl.h"
+#include "commonj/sdo/Type.h"
+#include "commonj/sdo/SDODataConverter.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace commonj
+{
+    namespace sdo
+    {
+
+        SDOJsonWriter::SDOJsonWriter(SDOString& buffer) : out(buffer)
+        {
+        }
+
+        SDOJsonWriter::~SDOJsonWriter()
+        {
+        }
+
+        void SDOJsonWriter::write(DataObjectPtr dataObject)
+        {
+            if (!dataObject)
+            {
+                out += "null";
+                return;
+            }
+            writeDO(dataObject);
+        }
+
+        void SDOJsonWriter::writeDO(DataObject* dataObject)
+        {
+            out += '{';
+            bool first = true;
+
+            // One pass over the values marks the properties to write
+            std::vector<const PropertyImpl*> props;
+            std::vector<bool> valid;
+            ((DataObjectImpl*) dataObject)->getValidProperties(props, valid);
+            for (unsigned int i = 0; i < props.size(); i++)
+            {
+                if (!valid[i])
+                {
+                    continue;
+                }
+                const Property& p = *props[i];
+                if (!p.getType().isDataType() && !p.isContainment())
+                {
+                    continue;
+                }
+                if (!first)
+                {
+                    out += ',';
+                }
+                first = false;
+
+                const char* name = p.getName();
+                writeString(name, strlen(name));
+                out += ':';
+                writeValue(dataObject, p);
+            }
+            out += '}';
+        }
+
+        void SDOJsonWriter::writeValue(DataObject* dataObject, const Property& p)
+        {
+            const Type& t = p.getType();
+
+            if (p.isMany())
+            {
+                DataObjectList& list = dataObject->getList(p);
+                out += '[';
+                for (unsigned int j = 0; j < list.size(); j++)
+                {
+                    if (j > 0)
+                    {
+                        out += ',';
+                    }
+                    writeListValue(list, j, t);
+                }
+                out += ']';
+                return;
+            }
+
+            if (dataObject->isNull(p))
+            {
+                out += "null";
+                return;
+            }
+
+            switch (t.getTypeEnum())
+            {
+                case Type::BooleanType:
+                    out += dataObject->getBoolean(p) ? "true" : "false";
+                    break;
+
+                case Type::CharacterType:
+                {
+                    SDOString s;
+                    appendUTF8(s, (unsigned long) dataObject->getCharacter(p));
+                    writeString(s.data(), s.length());
+                    break;
+                }
+
+                case Type::BytesType:
+                    writeString(dataObject->getCString(p), dataObject->getLength(p), true);
+                    break;
+
+                case Type::ByteType:
+                case Type::DateType:
+                case Type::StringType:
+                case Type::UriType:
+                case Type::TextType:
+                {
+                    const char* s = dataObject->getCString(p);
+                    writeString(s, s == 0 ? 0 : strlen(s));
+                    break;
+                }
+
+                case Type::DoubleType:
+                case Type::FloatType:
+                    writeNumber(dataObject->getDouble(p));
+                    break;
+
+                case Type::BigDecimalType:
+                case Type::BigIntegerType:
+                case Type::IntegerType:
+                case Type::LongType:
+                case Type::ShortType:
+                    writeDecimal(dataObject->getCString(p));
+                    break;
+
+                default:
+                {
+                    DataObjectPtr dob = dataObject->getDataObject(p);
+                    if (!dob)
+                    {
+                        out += "null";
+                    }
+                    else
+                    {
+                        writeDO(dob);
+                    }
+                    break;
+                }
+            }
+        }
+
+        void SDOJsonWriter::writeListValue(DataObjectList& list,
+                                           unsigned int index,
+                                           const Type& t)
+        {
+            switch (t.getTypeEnum())
+            {
+                case Type::BooleanType:
+                    out += list.getBoolean(index) ? "true" : "false";
+                    break;
+
+                case Type::CharacterType:
+                {
+                    SDOString s;
+                    appendUTF8(s, (unsigned long) list.getCharacter(index));
+                    writeString(s.data(), s.length());
+                    break;
+                }
+
+                case Type::BytesType:
+                    writeString(list.getCString(index), list.getLength(index), true);
+                    break;
+
+                case Type::ByteType:
+                case Type::DateType:
+                case Type::StringType:
+                case Type::UriType:
+                case Type::TextType:
+                {
+                    const char* s = list.getCString(index);
+                    writeString(s, s == 0 ? 0 : strlen(s));
+                    break;
+                }
+
+                case Type::DoubleType:
+                case Type::FloatType:
+                    writeNumber(list.getDouble(index));
+                    break;
+
+                case Type::BigDecimalType:
+                case Type::BigIntegerType:
+                case Type::IntegerType:
+                case Type::LongType:
+                case Type::ShortType:
+                    writeDecimal(list.getCString(index));
+                    break;
+
+                default:
+                {
+                    DataObjectPtr dob = list.getDataObject(index);
+                    if (!dob)
+                    {
+                        out += "null";
+                    }
+                    else
+                    {
+                        writeDO(dob);
+                    }
+                    break;
+                }
+            }
+        }
+
+        void SDOJsonWriter::writeString(const char* value, unsigned int length, bool bytes)
+        {
+            static const char hex[] = "0123456789abcdef";
+
+            out += '"';
+            unsigned int start = 0;
+            for (unsigned int i = 0; i < length; i++)
+            {
+                // Text is already UTF-8, but a byte above 0x7f is not a
+                // character of its own
+                unsigned char c = (unsigned char) value[i];
+                if (c >= 0x20 && c != '"' && c != '\\' && (c < 0x7f || !bytes))
+                {
+                    continue;
+                }
+
+                // Copy the run of characters which need no escape in one go
+                out.append(value + start, i - start);
+                start = i + 1;
+
+                switch (c)
+                {
+                    case '"':  out += "\\\""; break;
+                    case '\\': out += "\\\\"; break;
+                    case '\b': out += "\\b"; break;
+                    case '\f': out += "\\f"; break;
+                    case '\n': out += "\\n"; break;
+                    case '\r': out += "\\r"; break;
+                    case '\t': out += "\\t"; break;
+                    default:
+                        out += "\\u00";
+                        out += hex[c >> 4];
+                        out += hex[c & 0xf];
+                        break;
+                }
+            }
+            out.append(value + start, length - start);
+            out += '"';
+        }
+
+        void SDOJsonWriter::writeNumber(long double value)
+        {
+            // JSON has no representation for infinities or NaN
+            if (value != value || (value - value) != 0)
+            {
+                out += "null";
+                return;
+            }
+
+            char buffer[64];
+            sprintf(buffer, "%.*Lg", (int) SDODataConverter::precision, value);
+            out += buffer;
+        }
+
+        // Steps over a run of digits, returning false if there are none
+        static bool skipDigits(const char*& c)
+        {
+            const char* start = c;
+            while (*c >= '0' && *c <= '9')
+            {
+                c++;
+            }
+            return c != start;
+        }
+
+        // Decimal text, such as a BigDecimal, is written as a number only if
+        // it follows the JSON number grammar, which leaves out forms such as
+        // "+1", ".5", "1." or "007". Anything else is kept as a string.
+        void SDOJsonWriter::writeDecimal(const char* value)
+        {
+            if (value == 0)
+            {
+                out += "null";
+                return;
+            }
+
+            const char* c = value;
+            if (*c == '-')
+            {
+                c++;
+            }
+            bool valid;
+            if (*c == '0')
+            {
+                c++;
+                valid = true;
+            }
+            else
+            {
+                valid = skipDigits(c);
+            }
+            if (valid && *c == '.')
+            {
+                c++;
+                valid = skipDigits(c);
+            }
+            if (valid && (*c == 'e' || *c == 'E'))
+            {
+                c++;
+                if (*c == '+' || *c == '-')
+                {
+                    c++;
+                }
+                valid = skipDigits(c);
+            }
+
+            if (valid && *c == 0)
+            {
+                out.append(value, c - value);
+            }
+            else
+            {
+                writeString(value, strlen(value));
+            }
+        }
+
+        void SDOJsonWriter::appendUTF8(SDOString& buffer, unsigned long c)
+        {
+            if (c < 0x80)
+            {
+                buffer += (char) c;
+            }
+            else if (c < 0x800)
+            {
+                buffer += (char) (0xc0 | (c >> 6));
+                buffer += (char) (0x80 | (c & 0x3f));
+            }
+            else if (c < 0x10000)
+            {
+                buffer += (char) (0xe0 | (c >> 12));
+                buffer += (char) (0x80 | ((c >> 6) & 0x3f));
+                buffer += (char) (0x80 | (c & 0x3f));
+            }
+            else
+            {
+                buffer += (char) (0xf0 | ((c >> 18) & 0x07));
+                buffer += (char) (0x80 | ((c >> 12) & 0x3f));
+                buffer += (char) (0x80 | ((c >> 6) & 0x3f));
+                buffer += (char) (0x80 | (c & 0x3f));
+            }
+        }
+
+    } // End - namespace sdo
+} // End - namespace commonj
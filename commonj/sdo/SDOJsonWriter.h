@@ -0,0 +1,85 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* $Rev$ $Date$ */
+
+#ifndef _SDOJSONWRITER_H_
+#define _SDOJSONWRITER_H_
+
+#include "commonj/sdo/export.h"
+#include "commonj/sdo/DataObject.h"
+#include "commonj/sdo/SDOString.h"
+
+namespace commonj
+{
+    namespace sdo
+    {
+
+/**
+ * SDOJsonWriter writes a data object tree to JSON.
+ *
+ * The text is appended to the buffer as the tree is walked, without
+ * building any intermediate form. A data object becomes a JSON object
+ * holding its set properties, a many valued property becomes an array,
+ * and a primitive becomes a JSON value according to the type of the
+ * property - Byte, Bytes, Character, Date, String and URI values are
+ * written as strings, booleans as true or false, numbers as numbers and
+ * null values as null. A BigDecimal or BigInteger whose text is not a
+ * valid JSON number is written as a string. Bytes are written one character per byte, with
+ * every byte outside printable ASCII escaped as \u00XX, so that binary
+ * data still gives valid JSON. Open properties are written like any other, since
+ * they carry the type they were defined with.
+ *
+ * JSON has no way to express a reference, so non-containment properties
+ * are left out. The text written is a tree which SDOJsonReader reads back
+ * into the same graph.
+ */
+        class SDOJsonWriter
+        {
+        public:
+
+            SDO_SPI SDOJsonWriter(SDOString& buffer);
+
+            SDO_SPI virtual ~SDOJsonWriter();
+
+            /**
+             * Appends the JSON for the data object and everything below it.
+             */
+            SDO_SPI void write(DataObjectPtr dataObject);
+
+            /**
+             * Appends a character as UTF-8.
+             */
+            SDO_SPI static void appendUTF8(SDOString& buffer, unsigned long c);
+
+        private:
+            void writeDO(DataObject* dataObject);
+            void writeValue(DataObject* dataObject, const Property& property);
+            void writeListValue(DataObjectList& list, unsigned int index, const Type& type);
+            void writeString(const char* value, unsigned int length, bool bytes = false);
+            void writeNumber(long double value);
+            void writeDecimal(const char* value);
+
+            SDOString& out;
+        };
+    } // End - namespace sdo
+} // End - namespace commonj
+
+
+#endif //_SDOJSONWRITER_H_
@@ -0,0 +1,1021 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* $Rev$ $Date$ */
+
+#include "commonj/sdo/SDOModelSnapshot.h"
+#include "commonj/sdo/DataFactoryImpl.h"
+#include "commonj/sdo/TypeImpl.h"
+#include "commonj/sdo/PropertyImpl.h"
+#include "commonj/sdo/XSDTypeInfo.h"
+#include "commonj/sdo/XSDPropertyInfo.h"
+#include "commonj/sdo/SDORuntimeException.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <vector>
+#include <map>
+
+namespace commonj
+{
+    namespace sdo
+    {
+
+        const unsigned int SDOModelSnapshot::version = 2;
+
+#if defined(WIN32)  || defined (_WINDOWS)
+        typedef unsigned __int64 Unsigned64;
+#else
+        typedef uint64_t Unsigned64;
+#endif
+
+        // Header words
+        enum
+        {
+            HDR_MAGIC = 0,
+            HDR_VERSION,
+            HDR_LENGTH,
+            HDR_WORDS,
+            HDR_STRINGS,
+            HDR_RESERVED,
+            HDR_SIZE
+        };
+
+        static const char SNAPSHOT_MAGIC[4] = { 'S', 'D', 'O', 'M' };
+
+        // Every word is held as four bytes, least significant first
+        static const unsigned int WORD_SIZE = 4;
+        static const unsigned int HEADER_LENGTH = HDR_SIZE * WORD_SIZE;
+
+        // Marks a null string or a missing type
+        static const unsigned int NONE = 0xFFFFFFFF;
+
+        // Type flags
+        static const unsigned int TYPE_SEQUENCED    = 0x01;
+        static const unsigned int TYPE_OPEN         = 0x02;
+        static const unsigned int TYPE_ABSTRACT     = 0x04;
+        static const unsigned int TYPE_DATATYPE     = 0x08;
+        static const unsigned int TYPE_FROMLIST     = 0x10;
+        static const unsigned int TYPE_RESTRICTION  = 0x20;
+        static const unsigned int TYPE_BUILTIN      = 0x40;
+        static const unsigned int TYPE_INFO         = 0x80;
+
+        // Property flags
+        static const unsigned int PROP_MANY         = 0x01;
+        static const unsigned int PROP_READONLY     = 0x02;
+        static const unsigned int PROP_CONTAINMENT  = 0x04;
+        static const unsigned int PROP_DEFAULTED    = 0x08;
+        static const unsigned int PROP_OPPOSITE     = 0x10;
+        static const unsigned int PROP_INFO         = 0x20;
+
+        // Flags of the XML DAS definitions
+        static const unsigned int DEF_RESTRICTION   = 0x0001;
+        static const unsigned int DEF_DATATYPE      = 0x0002;
+        static const unsigned int DEF_OPEN          = 0x0004;
+        static const unsigned int DEF_SEQUENCED     = 0x0008;
+        static const unsigned int DEF_ABSTRACT      = 0x0010;
+        static const unsigned int DEF_EXTENDED      = 0x0020;
+        static const unsigned int DEF_FROMLIST      = 0x0040;
+        static const unsigned int DEF_MANY          = 0x0080;
+        static const unsigned int DEF_QNAME         = 0x0100;
+        static const unsigned int DEF_CONTAINMENT   = 0x0200;
+        static const unsigned int DEF_READONLY      = 0x0400;
+        static const unsigned int DEF_ID            = 0x0800;
+        static const unsigned int DEF_IDREF         = 0x1000;
+        static const unsigned int DEF_REFERENCE     = 0x2000;
+        static const unsigned int DEF_ELEMENT       = 0x4000;
+        static const unsigned int DEF_SUBSTITUTE    = 0x8000;
+
+        static inline unsigned int flag(bool b, unsigned int f)
+        {
+            return b ? f : 0;
+        }
+
+        static void throwInvalid(const char* reason)
+        {
+            SDOString msg("Invalid model snapshot: ");
+            msg += reason;
+            SDO_THROW_EXCEPTION("SDOModelSnapshot::load",
+                SDOIllegalArgumentException, msg.c_str());
+        }
+
+        static void appendWord(SDOString& buffer, unsigned int w)
+        {
+            char b[WORD_SIZE];
+            for (unsigned int i = 0; i < WORD_SIZE; i++)
+            {
+                b[i] = (char) ((w >> (8 * i)) & 0xFF);
+            }
+            buffer.append(b, WORD_SIZE);
+        }
+
+        static unsigned int wordAt(const char* p)
+        {
+            const unsigned char* b = (const unsigned char*) p;
+            return (unsigned int) b[0]
+                | ((unsigned int) b[1] << 8)
+                | ((unsigned int) b[2] << 16)
+                | ((unsigned int) b[3] << 24);
+        }
+
+        // Wide strings are held as UTF-8, whatever the size of wchar_t
+        static void appendUTF8(SDOString& buffer, const wchar_t* w, unsigned int len)
+        {
+            for (unsigned int i = 0; i < len; i++)
+            {
+                unsigned long c = (unsigned long) w[i];
+                if (sizeof(wchar_t) == 2 && c >= 0xD800 && c < 0xDC00 && i + 1 < len
+                    && (unsigned long) w[i + 1] >= 0xDC00 && (unsigned long) w[i + 1] < 0xE000)
+                {
+                    c = 0x10000 + ((c - 0xD800) << 10) + ((unsigned long) w[++i] - 0xDC00);
+                }
+                if (c < 0x80)
+                {
+                    buffer += (char) c;
+                }
+                else if (c < 0x800)
+                {
+                    buffer += (char) (0xC0 | (c >> 6));
+                    buffer += (char) (0x80 | (c & 0x3F));
+                }
+                else if (c < 0x10000)
+                {
+                    buffer += (char) (0xE0 | (c >> 12));
+                    buffer += (char) (0x80 | ((c >> 6) & 0x3F));
+                    buffer += (char) (0x80 | (c & 0x3F));
+                }
+                else
+                {
+                    buffer += (char) (0xF0 | ((c >> 18) & 0x07));
+                    buffer += (char) (0x80 | ((c >> 12) & 0x3F));
+                    buffer += (char) (0x80 | ((c >> 6) & 0x3F));
+                    buffer += (char) (0x80 | (c & 0x3F));
+                }
+            }
+        }
+
+        static void decodeUTF8(const SDOString& bytes, std::vector<wchar_t>& w)
+        {
+            const unsigned char* b = (const unsigned char*) bytes.data();
+            unsigned int len = bytes.length();
+            unsigned int i = 0;
+            while (i < len)
+            {
+                unsigned long c = b[i++];
+                unsigned int more = 0;
+                if (c >= 0xF0)      { c &= 0x07; more = 3; }
+                else if (c >= 0xE0) { c &= 0x0F; more = 2; }
+                else if (c >= 0xC0) { c &= 0x1F; more = 1; }
+                else if (c >= 0x80) throwInvalid("bad string default");
+                if (more > len - i)
+                {
+                    throwInvalid("bad string default");
+                }
+                while (more-- > 0)
+                {
+                    if ((b[i] & 0xC0) != 0x80) throwInvalid("bad string default");
+                    c = (c << 6) | (b[i++] & 0x3F);
+                }
+                if (sizeof(wchar_t) == 2 && c >= 0x10000)
+                {
+                    c -= 0x10000;
+                    w.push_back((wchar_t) (0xD800 + (c >> 10)));
+                    c = 0xDC00 + (c & 0x3FF);
+                }
+                w.push_back((wchar_t) c);
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // SnapshotWriter collects the words and the string pool.
+        ///////////////////////////////////////////////////////////////////////
+
+        class SnapshotWriter
+        {
+        public:
+            void writeTypes(const std::vector<const TypeImpl*>& types);
+            void finish(SDOString& buffer);
+
+        private:
+            void put(unsigned int w) { words.push_back(w); }
+            void putString(const char* s);
+            void putBytes(const char* b, unsigned int len);
+            void putLong(int64_t l);
+            void putType(const Type* t);
+            void putDefault(const PropertyImpl* p);
+            void putTypeDefinition(const TypeDefinitionImpl& td);
+            void putPropertyDefinition(const PropertyDefinitionImpl& pd);
+
+            std::vector<unsigned int> words;
+            SDOString strings;
+            std::map<SDOString, unsigned int> stringOffsets;
+            std::map<const Type*, unsigned int> typeIndex;
+        };
+
+        void SnapshotWriter::putString(const char* s)
+        {
+            if (s == 0)
+            {
+                put(NONE);
+                return;
+            }
+
+            std::map<SDOString, unsigned int>::iterator i = stringOffsets.find(s);
+            if (i != stringOffsets.end())
+            {
+                put(i->second);
+                return;
+            }
+
+            unsigned int offset = strings.length();
+            strings.append(s, strlen(s) + 1);
+            stringOffsets[s] = offset;
+            put(offset);
+        }
+
+        void SnapshotWriter::putBytes(const char* b, unsigned int len)
+        {
+            put(len);
+            for (unsigned int i = 0; i < len; i += WORD_SIZE)
+            {
+                unsigned int w = 0;
+                for (unsigned int k = 0; k < WORD_SIZE && i + k < len; k++)
+                {
+                    w |= (unsigned int) (unsigned char) b[i + k] << (8 * k);
+                }
+                put(w);
+            }
+        }
+
+        void SnapshotWriter::putLong(int64_t l)
+        {
+            put((unsigned int) ((Unsigned64) l & 0xFFFFFFFF));
+            put((unsigned int) ((Unsigned64) l >> 32));
+        }
+
+        void SnapshotWriter::putType(const Type* t)
+        {
+            if (t == 0)
+            {
+                put(NONE);
+                return;
+            }
+            std::map<const Type*, unsigned int>::iterator i = typeIndex.find(t);
+            if (i == typeIndex.end())
+            {
+                SDOString msg("Type is not part of the model: ");
+                msg += t->getURI();
+                msg += "#";
+                msg += t->getName();
+                SDO_THROW_EXCEPTION("SDOModelSnapshot::save",
+                    SDOTypeNotFoundException, msg.c_str());
+            }
+            put(i->second);
+        }
+
+        void SnapshotWriter::putDefault(const PropertyImpl* p)
+        {
+            switch (p->getTypeEnum())
+            {
+            case Type::BooleanType:
+                put(p->getBooleanDefault() ? 1 : 0);
+                break;
+            case Type::ByteType:
+                put((unsigned char)p->getByteDefault());
+                break;
+            case Type::CharacterType:
+                put((unsigned int)p->getCharacterDefault());
+                break;
+            case Type::ShortType:
+            case Type::IntegerType:
+            case Type::LongType:
+                putLong(p->getLongDefault());
+                break;
+            case Type::DateType:
+                putLong((int64_t)p->getDateDefault().getTime());
+                break;
+            case Type::FloatType:
+                {
+                    // IEEE single precision is the same everywhere
+                    float f = p->getFloatDefault();
+                    unsigned int w;
+                    memcpy(&w, &f, sizeof(w));
+                    put(w);
+                }
+                break;
+            case Type::DoubleType:
+                {
+                    // The size of a long double varies, so it is kept as text
+                    char text[64];
+                    sprintf(text, "%.*Lg", LDBL_DIG + 3, p->getDoubleDefault());
+                    putString(text);
+                }
+                break;
+            case Type::StringType:
+                {
+                    unsigned int len = p->getStringDefault(0, 0);
+                    std::vector<wchar_t> buf(len + 1);
+                    len = p->getStringDefault(&buf[0], len);
+                    SDOString utf8;
+                    appendUTF8(utf8, &buf[0], len);
+                    putBytes(utf8.data(), utf8.length());
+                }
+                break;
+            case Type::BytesType:
+                {
+                    SDOString bytes;
+                    unsigned int len = p->getBytesDefault(bytes, 0);
+                    if (len > 0)
+                    {
+                        len = p->getBytesDefault(bytes, len);
+                    }
+                    putBytes(bytes.data(), bytes.length());
+                }
+                break;
+            default:
+                putString(p->getCStringDefault());
+                break;
+            }
+        }
+
+        void SnapshotWriter::putPropertyDefinition(const PropertyDefinitionImpl& pd)
+        {
+            putString(pd.substituteName);
+            putString(pd.substituteUri);
+            put(pd.substituteNames.size());
+            for (unsigned int i = 0; i < pd.substituteNames.size(); i++)
+            {
+                putString(pd.substituteNames[i]);
+            }
+            put(pd.substituteLocalNames.size());
+            for (unsigned int j = 0; j < pd.substituteLocalNames.size(); j++)
+            {
+                putString(pd.substituteLocalNames[j]);
+            }
+            putString(pd.aliases);
+            putString(pd.name);
+            putString(pd.localname);
+            putString(pd.namespaceURI);
+            putString(pd.typeUri);
+            putString(pd.typeName);
+            putString(pd.fullTypeName);
+            putString(pd.fullLocalTypeName);
+            putString(pd.defaultValue);
+            put(flag(pd.isMany, DEF_MANY)
+                | flag(pd.isContainment, DEF_CONTAINMENT)
+                | flag(pd.isReadOnly, DEF_READONLY)
+                | flag(pd.isID, DEF_ID)
+                | flag(pd.isIDREF, DEF_IDREF)
+                | flag(pd.isReference, DEF_REFERENCE)
+                | flag(pd.isElement, DEF_ELEMENT)
+                | flag(pd.isQName, DEF_QNAME)
+                | flag(pd.isSubstitute, DEF_SUBSTITUTE));
+        }
+
+        void SnapshotWriter::putTypeDefinition(const TypeDefinitionImpl& td)
+        {
+            putString(td.uri);
+            putString(td.name);
+            putString(td.localname);
+            putString(td.aliases);
+            putString(td.parentTypeUri);
+            putString(td.parentTypeName);
+            putString(td.IDPropertyName);
+            put(flag(td.isRestriction, DEF_RESTRICTION)
+                | flag(td.dataType, DEF_DATATYPE)
+                | flag(td.isOpen, DEF_OPEN)
+                | flag(td.isSequenced, DEF_SEQUENCED)
+                | flag(td.isAbstract, DEF_ABSTRACT)
+                | flag(td.isExtendedPrimitive, DEF_EXTENDED)
+                | flag(td.isFromList, DEF_FROMLIST)
+                | flag(td.isMany, DEF_MANY)
+                | flag(td.isQName, DEF_QNAME));
+            put((unsigned int)td.groupElementCount);
+            put(td.properties.size());
+            XmlDasPropertyDefs::const_iterator i;
+            for (i = td.properties.begin(); i != td.properties.end(); ++i)
+            {
+                putPropertyDefinition(*i);
+            }
+        }
+
+        void SnapshotWriter::writeTypes(const std::vector<const TypeImpl*>& types)
+        {
+            // The types built into every data factory are only referred to
+            static const DataFactoryImpl builtins;
+
+            for (unsigned int i = 0; i < types.size(); i++)
+            {
+                typeIndex[types[i]] = i;
+            }
+
+            put(types.size());
+            for (unsigned int t = 0; t < types.size(); t++)
+            {
+                const TypeImpl* ti = types[t];
+                XSDTypeInfo* typeInfo = (XSDTypeInfo*)
+                    ((DASType*)ti)->getDASValue("XMLDAS::TypeInfo");
+
+                putString(ti->getURI());
+                putString(ti->getName());
+                put(flag(ti->isSequencedType(), TYPE_SEQUENCED)
+                    | flag(ti->isOpenType() && !ti->isOpenTypeImplicitly(), TYPE_OPEN)
+                    | flag(ti->isAbstractType(), TYPE_ABSTRACT)
+                    | flag(ti->isDataType(), TYPE_DATATYPE)
+                    | flag(ti->isFromList(), TYPE_FROMLIST)
+                    | flag(ti->isRestrictionType(), TYPE_RESTRICTION)
+                    | flag(builtins.findTypeImpl(ti->getURI(), ti->getName()) != 0, TYPE_BUILTIN)
+                    | flag(typeInfo != 0, TYPE_INFO));
+                putType(ti->getBaseType());
+                put(ti->getAliasCount());
+                for (unsigned int a = 0; a < ti->getAliasCount(); a++)
+                {
+                    putString(ti->getAlias(a));
+                }
+                if (typeInfo != 0)
+                {
+                    putTypeDefinition(typeInfo->getTypeDefinition());
+                }
+            }
+
+            for (unsigned int t = 0; t < types.size(); t++)
+            {
+                const TypeImpl* ti = types[t];
+
+                // Only the properties declared by the type itself; the rest
+                // come back when it is resolved against its base type.
+                std::vector<PropertyImpl*> local;
+                const std::list<PropertyImpl*>& props = ti->getPropertyListReference();
+                std::list<PropertyImpl*>::const_iterator i;
+                for (i = props.begin(); i != props.end(); ++i)
+                {
+                    if (&(*i)->getContainingType() == ti)
+                    {
+                        local.push_back(*i);
+                    }
+                }
+
+                put(local.size());
+                for (unsigned int p = 0; p < local.size(); p++)
+                {
+                    PropertyImpl* pi = local[p];
+                    XSDPropertyInfo* propInfo = (XSDPropertyInfo*)
+                        ((DASProperty*)pi)->getDASValue("XMLDAS::PropertyInfo");
+
+                    putString(pi->getName());
+                    putType(pi->getTypeImpl());
+                    put(flag(pi->isMany(), PROP_MANY)
+                        | flag(pi->isReadOnly(), PROP_READONLY)
+                        | flag(pi->isContainment(), PROP_CONTAINMENT)
+                        | flag(pi->isDefaulted(), PROP_DEFAULTED)
+                        | flag(pi->getOpposite() != 0, PROP_OPPOSITE)
+                        | flag(propInfo != 0, PROP_INFO));
+                    put(pi->getAliasCount());
+                    for (unsigned int a = 0; a < pi->getAliasCount(); a++)
+                    {
+                        putString(pi->getAlias(a));
+                    }
+                    put(pi->getSubstitutionCount());
+                    for (unsigned int s = 0; s < pi->getSubstitutionCount(); s++)
+                    {
+                        putString(pi->getSubstitutionName(s));
+                        putType(pi->getSubstitutionType(s));
+                    }
+                    if (pi->getOpposite() != 0)
+                    {
+                        putType(&pi->getOpposite()->getContainingType());
+                        putString(pi->getOpposite()->getName());
+                    }
+                    if (pi->isDefaulted())
+                    {
+                        putDefault(pi);
+                    }
+                    if (propInfo != 0)
+                    {
+                        putPropertyDefinition(propInfo->getPropertyDefinition());
+                    }
+                }
+            }
+        }
+
+        void SnapshotWriter::finish(SDOString& buffer)
+        {
+            unsigned int header[HDR_SIZE];
+            header[HDR_MAGIC] = wordAt(SNAPSHOT_MAGIC);
+            header[HDR_VERSION] = SDOModelSnapshot::version;
+            header[HDR_WORDS] = words.size();
+            header[HDR_STRINGS] = strings.length();
+            header[HDR_LENGTH] = HEADER_LENGTH
+                + words.size() * WORD_SIZE
+                + strings.length();
+            header[HDR_RESERVED] = 0;
+
+            buffer.reserve(buffer.length() + header[HDR_LENGTH]);
+            for (unsigned int h = 0; h < HDR_SIZE; h++)
+            {
+                appendWord(buffer, header[h]);
+            }
+            for (unsigned int w = 0; w < words.size(); w++)
+            {
+                appendWord(buffer, words[w]);
+            }
+            buffer.append(strings);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // SnapshotReader walks the words of a snapshot. Strings point
+        // straight into the pool; every offset and count is checked against
+        // the buffer so that a damaged snapshot cannot be read past its end.
+        ///////////////////////////////////////////////////////////////////////
+
+        class SnapshotReader
+        {
+        public:
+            SnapshotReader(const char* buffer, unsigned int length);
+
+            unsigned int get();
+            int64_t getLong();
+            const char* getString();
+            void getBytes(SDOString& bytes);
+            unsigned int getCount();
+            void getTypeDefinition(TypeDefinitionImpl& td);
+            void getPropertyDefinition(PropertyDefinitionImpl& pd);
+            bool atEnd() const { return pos == wordCount; }
+
+        private:
+            const char* words;
+            unsigned int wordCount;
+            unsigned int pos;
+            const char* strings;
+            unsigned int stringsLength;
+        };
+
+        SnapshotReader::SnapshotReader(const char* buffer, unsigned int length)
+        {
+            if (SDOModelSnapshot::getSnapshotLength(buffer, length) == 0)
+            {
+                throwInvalid("bad header");
+            }
+
+            if (wordAt(buffer + HDR_VERSION * WORD_SIZE) != SDOModelSnapshot::version)
+            {
+                throwInvalid("unsupported version");
+            }
+
+            words = buffer + HEADER_LENGTH;
+            wordCount = wordAt(buffer + HDR_WORDS * WORD_SIZE);
+            pos = 0;
+            strings = words + wordCount * WORD_SIZE;
+            stringsLength = wordAt(buffer + HDR_STRINGS * WORD_SIZE);
+        }
+
+        unsigned int SnapshotReader::get()
+        {
+            if (pos >= wordCount)
+            {
+                throwInvalid("truncated");
+            }
+            return wordAt(words + (pos++) * WORD_SIZE);
+        }
+
+        int64_t SnapshotReader::getLong()
+        {
+            Unsigned64 lo = get();
+            Unsigned64 hi = get();
+            return (int64_t) ((hi << 32) | lo);
+        }
+
+        unsigned int SnapshotReader::getCount()
+        {
+            unsigned int count = get();
+            if (count > wordCount - pos)
+            {
+                throwInvalid("bad count");
+            }
+            return count;
+        }
+
+        const char* SnapshotReader::getString()
+        {
+            unsigned int offset = get();
+            if (offset == NONE)
+            {
+                return 0;
+            }
+            if (offset >= stringsLength
+                || memchr(strings + offset, 0, stringsLength - offset) == 0)
+            {
+                throwInvalid("bad string offset");
+            }
+            return strings + offset;
+        }
+
+        void SnapshotReader::getBytes(SDOString& bytes)
+        {
+            unsigned int len = get();
+            unsigned int count = (len + WORD_SIZE - 1) / WORD_SIZE;
+            if (count > wordCount - pos)
+            {
+                throwInvalid("bad length");
+            }
+            // Bytes are packed least significant first, so they read in order
+            bytes.assign(words + pos * WORD_SIZE, len);
+            pos += count;
+        }
+
+        void SnapshotReader::getPropertyDefinition(PropertyDefinitionImpl& pd)
+        {
+            pd.substituteName = getString();
+            pd.substituteUri = getString();
+            unsigned int count = getCount();
+            for (unsigned int i = 0; i < count; i++)
+            {
+                pd.substituteNames.push_back(getString());
+            }
+            count = getCount();
+            for (unsigned int j = 0; j < count; j++)
+            {
+                pd.substituteLocalNames.push_back(getString());
+            }
+            pd.aliases = getString();
+            pd.name = getString();
+            pd.localname = getString();
+            pd.namespaceURI = getString();
+            pd.typeUri = getString();
+            pd.typeName = getString();
+            pd.fullTypeName = getString();
+            pd.fullLocalTypeName = getString();
+            pd.defaultValue = getString();
+            unsigned int flags = get();
+            pd.isMany = (flags & DEF_MANY) != 0;
+            pd.isContainment = (flags & DEF_CONTAINMENT) != 0;
+            pd.isReadOnly = (flags & DEF_READONLY) != 0;
+            pd.isID = (flags & DEF_ID) != 0;
+            pd.isIDREF = (flags & DEF_IDREF) != 0;
+            pd.isReference = (flags & DEF_REFERENCE) != 0;
+            pd.isElement = (flags & DEF_ELEMENT) != 0;
+            pd.isQName = (flags & DEF_QNAME) != 0;
+            pd.isSubstitute = (flags & DEF_SUBSTITUTE) != 0;
+        }
+
+        void SnapshotReader::getTypeDefinition(TypeDefinitionImpl& td)
+        {
+            td.uri = getString();
+            td.name = getString();
+            td.localname = getString();
+            td.aliases = getString();
+            td.parentTypeUri = getString();
+            td.parentTypeName = getString();
+            td.IDPropertyName = getString();
+            unsigned int flags = get();
+            td.isRestriction = (flags & DEF_RESTRICTION) != 0;
+            td.dataType = (flags & DEF_DATATYPE) != 0;
+            td.isOpen = (flags & DEF_OPEN) != 0;
+            td.isSequenced = (flags & DEF_SEQUENCED) != 0;
+            td.isAbstract = (flags & DEF_ABSTRACT) != 0;
+            td.isExtendedPrimitive = (flags & DEF_EXTENDED) != 0;
+            td.isFromList = (flags & DEF_FROMLIST) != 0;
+            td.isMany = (flags & DEF_MANY) != 0;
+            td.isQName = (flags & DEF_QNAME) != 0;
+            td.groupElementCount = (int)get();
+            unsigned int count = getCount();
+            for (unsigned int i = 0; i < count; i++)
+            {
+                td.properties.push_back(PropertyDefinitionImpl());
+                getPropertyDefinition(td.properties.back());
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Loading helpers
+        ///////////////////////////////////////////////////////////////////////
+
+        static const TypeImpl* typeAt(const std::vector<const TypeImpl*>& types,
+                                      unsigned int index)
+        {
+            if (index >= types.size())
+            {
+                throwInvalid("bad type index");
+            }
+            return types[index];
+        }
+
+        static void loadDefault(SnapshotReader& reader, PropertyImpl* pi)
+        {
+            SDOString bytes;
+            switch (pi->getTypeEnum())
+            {
+            case Type::BooleanType:
+                pi->setDefaultBoolean(reader.get() != 0);
+                break;
+            case Type::ByteType:
+                pi->setDefaultByte((char)reader.get());
+                break;
+            case Type::CharacterType:
+                pi->setDefaultCharacter((wchar_t)reader.get());
+                break;
+            case Type::ShortType:
+            case Type::IntegerType:
+            case Type::LongType:
+            case Type::DateType:
+                {
+                    int64_t l = reader.getLong();
+                    if (pi->getTypeEnum() == Type::ShortType)
+                    {
+                        pi->setDefaultShort((short)l);
+                    }
+                    else if (pi->getTypeEnum() == Type::IntegerType)
+                    {
+                        pi->setDefaultInteger((long)l);
+                    }
+                    else if (pi->getTypeEnum() == Type::LongType)
+                    {
+                        pi->setDefaultLong(l);
+                    }
+                    else
+                    {
+                        pi->setDefaultDate(SDODate((time_t)l));
+                    }
+                }
+                break;
+            case Type::FloatType:
+                {
+                    unsigned int w = reader.get();
+                    float f;
+                    memcpy(&f, &w, sizeof(f));
+                    pi->setDefaultFloat(f);
+                }
+                break;
+            case Type::DoubleType:
+                {
+                    const char* text = reader.getString();
+                    if (text == 0) throwInvalid("bad default");
+#if defined(WIN32)  || defined (_WINDOWS)
+                    pi->setDefaultDouble(strtod(text, 0));
+#else
+                    pi->setDefaultDouble(strtold(text, 0));
+#endif
+                }
+                break;
+            case Type::StringType:
+                {
+                    reader.getBytes(bytes);
+                    std::vector<wchar_t> buf;
+                    decodeUTF8(bytes, buf);
+                    unsigned int len = buf.size();
+                    buf.push_back(0);
+                    pi->setDefaultString(&buf[0], len);
+                }
+                break;
+            case Type::BytesType:
+                reader.getBytes(bytes);
+                pi->setDefaultBytes(bytes, bytes.length());
+                break;
+            default:
+                {
+                    const char* s = reader.getString();
+                    if (s != 0) pi->setDefaultCString(s);
+                }
+                break;
+            }
+        }
+
+        struct PendingOpposite
+        {
+            const TypeImpl* type;
+            const char* name;
+            const TypeImpl* oppositeType;
+            const char* oppositeName;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // SDOModelSnapshot
+        ///////////////////////////////////////////////////////////////////////
+
+        void SDOModelSnapshot::save(DataFactoryPtr df, SDOString& buffer)
+        {
+            DataFactoryImpl* dfi = (DataFactoryImpl*)((DataFactoryImpl*)(DataFactory*)df)->getModel();
+            if (!dfi->isFrozen())
+            {
+                dfi->resolve();
+            }
+
+            TypeList tl = dfi->getTypes();
+            std::vector<const TypeImpl*> types;
+            for (unsigned int i = 0; i < tl.size(); i++)
+            {
+                types.push_back((const TypeImpl*)&tl[i]);
+            }
+
+            SnapshotWriter writer;
+            writer.writeTypes(types);
+            writer.finish(buffer);
+        }
+
+        void SDOModelSnapshot::load(DataFactoryPtr df,
+                                    const char* buffer,
+                                    unsigned int length)
+        {
+            DataFactoryImpl* dfi = (DataFactoryImpl*)(DataFactory*)df;
+            SnapshotReader reader(buffer, length);
+
+            // Add the types first, so that properties and base types can
+            // refer to any of them
+            unsigned int typeCount = reader.getCount();
+            std::vector<const TypeImpl*> types;
+            std::vector<unsigned int> baseTypes;
+            std::vector<bool> restrictions;
+
+            for (unsigned int t = 0; t < typeCount; t++)
+            {
+                const char* uri = reader.getString();
+                const char* name = reader.getString();
+                unsigned int flags = reader.get();
+                baseTypes.push_back(reader.get());
+                restrictions.push_back((flags & TYPE_RESTRICTION) != 0);
+
+                if (uri == 0 || name == 0)
+                {
+                    throwInvalid("type has no name");
+                }
+
+                if ((flags & TYPE_BUILTIN) == 0)
+                {
+                    dfi->addType(uri, name,
+                        (flags & TYPE_SEQUENCED) != 0,
+                        (flags & TYPE_OPEN) != 0,
+                        (flags & TYPE_ABSTRACT) != 0,
+                        (flags & TYPE_DATATYPE) != 0,
+                        (flags & TYPE_FROMLIST) != 0);
+                }
+                const TypeImpl* ti = dfi->findTypeImpl(uri, name);
+                if (ti == 0)
+                {
+                    throwInvalid("unknown built in type");
+                }
+                types.push_back(ti);
+
+                unsigned int aliasCount = reader.getCount();
+                for (unsigned int a = 0; a < aliasCount; a++)
+                {
+                    const char* alias = reader.getString();
+                    if (alias != 0) dfi->setAlias(uri, name, alias);
+                }
+
+                if (flags & TYPE_INFO)
+                {
+                    TypeDefinitionImpl td;
+                    reader.getTypeDefinition(td);
+                    dfi->setDASValue(uri, name, "XMLDAS::TypeInfo", new XSDTypeInfo(td));
+                }
+            }
+
+            for (unsigned int b = 0; b < typeCount; b++)
+            {
+                if (baseTypes[b] != NONE)
+                {
+                    dfi->setBaseType(*types[b], *typeAt(types, baseTypes[b]), restrictions[b]);
+                }
+            }
+
+            std::vector<PendingOpposite> opposites;
+
+            for (unsigned int t = 0; t < typeCount; t++)
+            {
+                const TypeImpl* ti = types[t];
+                unsigned int propCount = reader.getCount();
+                for (unsigned int p = 0; p < propCount; p++)
+                {
+                    const char* name = reader.getString();
+                    const TypeImpl* propType = typeAt(types, reader.get());
+                    unsigned int flags = reader.get();
+
+                    if (name == 0)
+                    {
+                        throwInvalid("property has no name");
+                    }
+
+                    dfi->addPropertyToType(*ti, name, *propType,
+                        (flags & PROP_MANY) != 0,
+                        (flags & PROP_READONLY) != 0,
+                        (flags & PROP_CONTAINMENT) != 0);
+                    PropertyImpl* pi = ti->getPropertyImpl(name);
+                    if (pi == 0)
+                    {
+                        throwInvalid("property not defined");
+                    }
+
+                    unsigned int aliasCount = reader.getCount();
+                    for (unsigned int a = 0; a < aliasCount; a++)
+                    {
+                        const char* alias = reader.getString();
+                        if (alias != 0) pi->setAlias(alias);
+                    }
+
+                    unsigned int subCount = reader.getCount();
+                    for (unsigned int s = 0; s < subCount; s++)
+                    {
+                        const char* subName = reader.getString();
+                        const TypeImpl* subType = typeAt(types, reader.get());
+                        if (subName != 0) pi->setSubstitution(df, subName, *subType);
+                    }
+
+                    if (flags & PROP_OPPOSITE)
+                    {
+                        PendingOpposite opp;
+                        opp.type = ti;
+                        opp.name = name;
+                        opp.oppositeType = typeAt(types, reader.get());
+                        opp.oppositeName = reader.getString();
+                        opposites.push_back(opp);
+                    }
+
+                    if (flags & PROP_DEFAULTED)
+                    {
+                        loadDefault(reader, pi);
+                    }
+
+                    if (flags & PROP_INFO)
+                    {
+                        PropertyDefinitionImpl pd;
+                        reader.getPropertyDefinition(pd);
+                        pi->setDASValue("XMLDAS::PropertyInfo", new XSDPropertyInfo(pd));
+                    }
+                }
+            }
+
+            if (!reader.atEnd())
+            {
+                throwInvalid("trailing data");
+            }
+
+            for (unsigned int o = 0; o < opposites.size(); o++)
+            {
+                if (opposites[o].oppositeName != 0)
+                {
+                    dfi->setOpposite(*opposites[o].type, opposites[o].name,
+                        *opposites[o].oppositeType, opposites[o].oppositeName);
+                }
+            }
+
+            dfi->resolve();
+        }
+
+        unsigned int SDOModelSnapshot::getSnapshotLength(const char* buffer,
+                                                         unsigned int length)
+        {
+            unsigned int header[HDR_SIZE];
+            if (buffer == 0 || length < HEADER_LENGTH)
+            {
+                return 0;
+            }
+            for (unsigned int h = 0; h < HDR_SIZE; h++)
+            {
+                header[h] = wordAt(buffer + h * WORD_SIZE);
+            }
+            if (memcmp(buffer, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0
+                || header[HDR_LENGTH] > length
+                || header[HDR_LENGTH] < HEADER_LENGTH
+                || header[HDR_WORDS] > (header[HDR_LENGTH] - HEADER_LENGTH) / WORD_SIZE
+                || header[HDR_LENGTH] != HEADER_LENGTH
+                    + header[HDR_WORDS] * WORD_SIZE
+                    + header[HDR_STRINGS])
+            {
+                return 0;
+            }
+            return header[HDR_LENGTH];
+        }
+
+        int64_t SDOModelSnapshot::getFingerprint(const char* buffer,
+                                                 unsigned int length)
+        {
+            // 64 bit FNV-1a
+            Unsigned64 h = 14695981039346656037ULL;
+            for (unsigned int i = 0; i < length; i++)
+            {
+                h ^= (unsigned char) buffer[i];
+                h *= 1099511628211ULL;
+            }
+            return (int64_t) h;
+        }
+
+    } // End - namespace sdo
+} // End - namespace commonj
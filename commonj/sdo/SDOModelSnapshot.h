@@ -0,0 +1,97 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* $Rev$ $Date$ */
+
+#ifndef _SDOMODELSNAPSHOT_H_
+#define _SDOMODELSNAPSHOT_H_
+
+#include "commonj/sdo/export.h"
+#include "commonj/sdo/DataFactory.h"
+#include "commonj/sdo/SDOString.h"
+
+namespace commonj
+{
+    namespace sdo
+    {
+
+    /**
+     * SDOModelSnapshot saves the resolved types of a data factory in a
+     * compact binary form, and defines them again without parsing any
+     * schema.
+     *
+     * A snapshot holds the types and their properties, aliases, base types,
+     * substitutes, opposites and defaults, together with the XML DAS type
+     * and property information, so that documents load and save exactly as
+     * they would with the types defined from the original schema.
+     * Other DAS values are not kept.
+     *
+     * The snapshot starts with a versioned header followed by a table of
+     * fixed size words, in which strings and types are referred to by
+     * offset and index. Strings are held once each in a trailing pool and
+     * are used in place while loading. Words are held least significant
+     * byte first and wide strings as UTF-8, with double defaults written
+     * as text, so a snapshot loads on any platform.
+     */
+
+    class SDOModelSnapshot
+        {
+        public:
+
+            /**
+             * Appends a snapshot of the types of the data factory to the
+             * buffer. The types are resolved first.
+             */
+            static SDO_API void save(DataFactoryPtr df, SDOString& buffer);
+
+            /**
+             * Defines the types held in a snapshot in the data factory,
+             * which would normally be a new one.
+             * Throws SDOIllegalArgumentException if the buffer does not
+             * hold a valid snapshot for this version.
+             */
+            static SDO_API void load(DataFactoryPtr df,
+                                     const char* buffer,
+                                     unsigned int length);
+
+            /**
+             * Returns the number of bytes of the snapshot at the start of
+             * the buffer, or 0 if the buffer does not start with one.
+             */
+            static SDO_API unsigned int getSnapshotLength(const char* buffer,
+                                                          unsigned int length);
+
+            /**
+             * Returns a 64 bit hash of a snapshot, which identifies the
+             * model it holds. Equal models on the same platform give equal
+             * snapshots, and so equal fingerprints.
+             */
+            static SDO_API int64_t getFingerprint(const char* buffer,
+                                                  unsigned int length);
+
+            /**
+             * The current version of the snapshot format.
+             */
+            static SDO_API const unsigned int version;
+        };
+    } // End - namespace sdo
+} // End - namespace commonj
+
+
+#endif //_SDOMODELSNAPSHOT_H_
@@ -0,0 +1,367 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* $Rev$ $Date$ */
+
+#include "commonj/sdo/SDOPredicateIndex.h"
+#include "commonj/sdo/DataObjectImpl.h"
+#include "commonj/sdo/PropertyImpl.h"
+#include "commonj/sdo/SDORuntimeException.h"
+
+#include <stdlib.h>
+
+namespace commonj
+{
+    namespace sdo
+    {
+
+    SDOPredicateIndex::SDOPredicateIndex(const PropertyImpl* key)
+        : keyProperty(key),
+          keyType(key->getTypeEnum()),
+          usable(true),
+          keyBuckets(16, -1),
+          itemBuckets(16, -1),
+          freeEntries(-1),
+          liveEntries(0)
+    {
+    }
+
+    const PropertyImpl* SDOPredicateIndex::getKeyProperty() const
+    {
+        return keyProperty;
+    }
+
+    bool SDOPredicateIndex::isUsable() const
+    {
+        return usable;
+    }
+
+    // FNV-1a, as used for the ID table of the SAX2 parser
+    unsigned int SDOPredicateIndex::hashKey(const SDOString& key)
+    {
+        unsigned int hash = 2166136261u;
+        for (size_t i = 0; i < key.length(); i++)
+        {
+            hash = (hash ^ (unsigned char) key[i]) * 16777619u;
+        }
+        return hash;
+    }
+
+    unsigned int SDOPredicateIndex::hashItem(const DataObjectImpl* item)
+    {
+        // Objects are at least 8 byte aligned, so the low bits carry nothing
+        size_t p = (size_t) item;
+        return (unsigned int) ((p >> 3) ^ (p >> 19)) * 2654435761u;
+    }
+
+    // Works out the key of an item in the form it is compared in. Returns
+    // false if the item has no key to index, which is also the case once
+    // the index has been found to be unusable.
+    bool SDOPredicateIndex::itemKey(DataObjectImpl* item, SDOString& key)
+    {
+        // Items of a derived type share the property at the same index;
+        // an item of any other type cannot be indexed by it.
+        const PropertyImpl* pi = item->getPropertyImpl(keyProperty->getIndex());
+        if (pi != keyProperty || keyProperty->isMany())
+        {
+            usable = false;
+            return false;
+        }
+        const Property& p = *pi;
+
+        switch (keyType)
+        {
+        case Type::BooleanType:
+        case Type::BytesType:
+        case Type::BigDecimalType:
+        case Type::BigIntegerType:
+        case Type::StringType:
+        case Type::UriType:
+            {
+                // getCString gives "true" or "false" for a boolean
+                const char* value = item->getCString(p);
+                if (value == 0)
+                {
+                    return false;
+                }
+                key = value;
+            }
+            return true;
+
+        case Type::ByteType:
+            key.assign(1, item->getByte(p));
+            return true;
+
+        case Type::IntegerType:
+            {
+                long value = item->getInteger(p);
+                key.assign((const char*) &value, sizeof(value));
+            }
+            return true;
+
+        case Type::DateType:
+            {
+                long value = (long) item->getDate(p).getTime();
+                key.assign((const char*) &value, sizeof(value));
+            }
+            return true;
+
+        case Type::LongType:
+            {
+                int64_t value = item->getLong(p);
+                key.assign((const char*) &value, sizeof(value));
+            }
+            return true;
+
+        case Type::ShortType:
+            {
+                short value = item->getShort(p);
+                key.assign((const char*) &value, sizeof(value));
+            }
+            return true;
+
+        default:
+            // Characters and floating point values are compared in ways
+            // which do not reduce to equal keys, so they are searched.
+            usable = false;
+            return false;
+        }
+    }
+
+    void SDOPredicateIndex::disable()
+    {
+        usable = false;
+        entries.clear();
+        keyBuckets.clear();
+        itemBuckets.clear();
+        freeEntries = -1;
+        liveEntries = 0;
+    }
+
+    void SDOPredicateIndex::link(int entry)
+    {
+        Entry& e = entries[entry];
+        int& byKey = keyBuckets[e.hash & (keyBuckets.size() - 1)];
+        e.nextByKey = byKey;
+        byKey = entry;
+        int& byItem = itemBuckets[hashItem(e.item) & (itemBuckets.size() - 1)];
+        e.nextByItem = byItem;
+        byItem = entry;
+    }
+
+    // Doubles the bucket tables and chains the live entries again. Free
+    // entries keep their place on the free list.
+    void SDOPredicateIndex::grow()
+    {
+        keyBuckets.assign(keyBuckets.size() * 2, -1);
+        itemBuckets.assign(itemBuckets.size() * 2, -1);
+        for (unsigned int i = 0; i < entries.size(); i++)
+        {
+            if (entries[i].item != 0)
+            {
+                link(i);
+            }
+        }
+    }
+
+    void SDOPredicateIndex::add(DataObjectImpl* item)
+    {
+        if (!usable)
+        {
+            return;
+        }
+
+        SDOString key;
+        try
+        {
+            if (!itemKey(item, key))
+            {
+                if (!usable)
+                {
+                    disable();
+                }
+                return;
+            }
+        }
+        catch (SDORuntimeException&)
+        {
+            // The value could not be read. Searching the list reports it.
+            disable();
+            return;
+        }
+
+        if (liveEntries >= keyBuckets.size())
+        {
+            grow();
+        }
+
+        int entry;
+        if (freeEntries >= 0)
+        {
+            entry = freeEntries;
+            freeEntries = entries[entry].nextByKey;
+            entries[entry].key = key;
+            entries[entry].hash = hashKey(key);
+            entries[entry].item = item;
+        }
+        else
+        {
+            entry = entries.size();
+            entries.push_back(Entry(key, hashKey(key), item));
+        }
+        link(entry);
+        liveEntries++;
+    }
+
+    void SDOPredicateIndex::remove(DataObjectImpl* item)
+    {
+        if (!usable)
+        {
+            return;
+        }
+
+        int* byItem = &itemBuckets[hashItem(item) & (itemBuckets.size() - 1)];
+        while (*byItem >= 0 && entries[*byItem].item != item)
+        {
+            byItem = &entries[*byItem].nextByItem;
+        }
+        if (*byItem < 0)
+        {
+            // The item had no key, such as a null string
+            return;
+        }
+
+        int entry = *byItem;
+        Entry& e = entries[entry];
+        *byItem = e.nextByItem;
+
+        int* byKey = &keyBuckets[e.hash & (keyBuckets.size() - 1)];
+        while (*byKey != entry)
+        {
+            byKey = &entries[*byKey].nextByKey;
+        }
+        *byKey = e.nextByKey;
+
+        e.item = 0;
+        e.key.erase();
+        e.nextByItem = -1;
+        e.nextByKey = freeEntries;
+        freeEntries = entry;
+        liveEntries--;
+    }
+
+    void SDOPredicateIndex::update(DataObjectImpl* item)
+    {
+        remove(item);
+        add(item);
+    }
+
+    void SDOPredicateIndex::lookup(const SDOString& key,
+                                   std::vector<DataObjectImpl*>& candidates) const
+    {
+        unsigned int hash = hashKey(key);
+        for (int i = keyBuckets[hash & (keyBuckets.size() - 1)]; i >= 0; i = entries[i].nextByKey)
+        {
+            if (entries[i].hash == hash && entries[i].key == key)
+            {
+                candidates.push_back(entries[i].item);
+            }
+        }
+    }
+
+    // The predicate value is converted as DataObjectImpl::findDataObject
+    // converts it when it searches a list.
+    void SDOPredicateIndex::find(const SDOString& value,
+                                 std::vector<DataObjectImpl*>& candidates) const
+    {
+        if (!usable || liveEntries == 0)
+        {
+            return;
+        }
+
+        SDOString key;
+        switch (keyType)
+        {
+        case Type::BooleanType:
+            lookup(value, candidates);
+            break;
+
+        case Type::ByteType:
+            key.assign(1, value.c_str()[0]);
+            lookup(key, candidates);
+            break;
+
+        case Type::IntegerType:
+        case Type::DateType:
+            {
+                long l = atol(value.c_str());
+                key.assign((const char*) &l, sizeof(l));
+                lookup(key, candidates);
+            }
+            break;
+
+        case Type::LongType:
+            {
+#if defined(WIN32)  || defined (_WINDOWS)
+                int64_t l = (int64_t)_atoi64(value.c_str());
+#else
+                int64_t l = (int64_t)strtoll(value.c_str(), NULL, 0);
+#endif
+                key.assign((const char*) &l, sizeof(l));
+                lookup(key, candidates);
+            }
+            break;
+
+        case Type::ShortType:
+            {
+                short s = atoi(value.c_str());
+                key.assign((const char*) &s, sizeof(s));
+                lookup(key, candidates);
+            }
+            break;
+
+        case Type::BytesType:
+        case Type::BigDecimalType:
+        case Type::BigIntegerType:
+        case Type::StringType:
+        case Type::UriType:
+            {
+                lookup(value, candidates);
+
+                // The value may also be quoted, with whichever of " and '
+                // comes first.
+                size_t quote = value.find_first_of("\"'");
+                if (quote != SDOString::npos)
+                {
+                    size_t ender = value.find(value[quote], quote + 1);
+                    if (ender != SDOString::npos)
+                    {
+                        lookup(value.substr(quote + 1, ender - (quote + 1)), candidates);
+                    }
+                }
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    };
+};
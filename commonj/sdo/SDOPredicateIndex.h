@@ -0,0 +1,146 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* $Rev$ $Date$ */
+
+#ifndef _SDO_SDOPREDICATEINDEX_H_
+#define _SDO_SDOPREDICATEINDEX_H_
+
+#include "commonj/sdo/SDOString.h"
+#include "commonj/sdo/Type.h"
+
+#include <vector>
+
+/**
+ * Lists with fewer items than this are always searched item by item for a
+ * predicate such as depts[number=10], since building an index would cost
+ * more than it saves. Define it as 0 to index every list that is queried.
+ */
+
+#ifndef SDO_PREDICATE_INDEX_MIN_SIZE
+#define SDO_PREDICATE_INDEX_MIN_SIZE 32
+#endif
+
+namespace commonj
+{
+    namespace sdo
+    {
+
+    class DataObjectImpl;
+    class PropertyImpl;
+
+/**
+ * SDOPredicateIndex maps the values of one key property of the items of a
+ * containment list to the items, so that a path step such as
+ * depts[number=10] does not have to look at every item of depts.
+ *
+ * The key is the property itself rather than the name it was asked for
+ * by, so a step using an alias of the property shares the index.
+ *
+ * A key is held in the form the item is compared in: the C string for
+ * string like types and booleans, and the bytes of the number for numeric
+ * types. The predicate value is converted to that form once per query.
+ * Character, floating point and data object keys are not indexed, and an
+ * index with an item whose type does not have the key property is marked
+ * unusable; the list is then searched as before.
+ *
+ * The index holds the items rather than their positions, so inserting or
+ * removing an item does not renumber the others. The owning list works
+ * out the position of a match from the hint recorded in the item.
+ */
+    class SDOPredicateIndex
+    {
+    public:
+
+        /**
+         * An empty index of the key property. The list adds its items to it.
+         */
+        explicit SDOPredicateIndex(const PropertyImpl* key);
+
+        const PropertyImpl* getKeyProperty() const;
+
+        /**
+         * False once the items turned out not to be indexable by the key.
+         */
+        bool isUsable() const;
+
+        /**
+         * Enter an item added to the list.
+         */
+        void add(DataObjectImpl* item);
+
+        /**
+         * Forget an item removed from the list.
+         */
+        void remove(DataObjectImpl* item);
+
+        /**
+         * Enter an item again after the value of its key has changed.
+         */
+        void update(DataObjectImpl* item);
+
+        /**
+         * Append to candidates every item whose key matches the predicate
+         * value, in no particular order.
+         */
+        void find(const SDOString& value,
+                  std::vector<DataObjectImpl*>& candidates) const;
+
+    private:
+
+        struct Entry
+        {
+            Entry(const SDOString& k, unsigned int h, DataObjectImpl* i)
+                : key(k), hash(h), item(i), nextByKey(-1), nextByItem(-1)
+            {
+            }
+            SDOString key;
+            unsigned int hash;
+            DataObjectImpl* item;   // 0 for a free entry
+            int nextByKey;          // the next entry in the bucket, or free
+            int nextByItem;
+        };
+
+        bool itemKey(DataObjectImpl* item, SDOString& key);
+        void lookup(const SDOString& key,
+                    std::vector<DataObjectImpl*>& candidates) const;
+        void link(int entry);
+        void grow();
+        void disable();
+
+        static unsigned int hashKey(const SDOString& key);
+        static unsigned int hashItem(const DataObjectImpl* item);
+
+        const PropertyImpl* keyProperty;
+        Type::Types keyType;
+        bool usable;
+
+        // Entries are chained from two power of two bucket tables, one by
+        // key and one by item. Removed entries are reused.
+        std::vector<Entry> entries;
+        std::vector<int> keyBuckets;
+        std::vector<int> itemBuckets;
+        int freeEntries;
+        unsigned int liveEntries;
+    };
+
+    };
+};
+
+#endif //_SDO_SDOPREDICATEINDEX_H_
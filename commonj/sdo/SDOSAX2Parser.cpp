@@ -82,8 +82,9 @@ namespace commonj
             isDataGraph = false;
             ignoreEvents = false;
             changeSummary = false;
-            IDMap.empty();
-            IDRefs.empty();
+            IDEntries.clear();
+            IDBuckets.clear();
+            IDRefs.clear();
             rootElementURI = "";
             rootElementName = "";
         }
@@ -105,64 +106,135 @@ namespace commonj
             reset();
         }
         
+        unsigned int SDOSAX2Parser::internID(const SDOXMLString& key)
+        {
+            // FNV-1a
+            unsigned int hash = 2166136261u;
+            for (const xmlChar* c = (const xmlChar*)key; c != 0 && *c != 0; c++)
+            {
+                hash = (hash ^ *c) * 16777619u;
+            }
+
+            if (!IDBuckets.empty())
+            {
+                for (int i = IDBuckets[hash & (IDBuckets.size() - 1)]; i >= 0; i = IDEntries[i].next)
+                {
+                    if (IDEntries[i].hash == hash && IDEntries[i].key.equals(key))
+                    {
+                        return i;
+                    }
+                }
+            }
+
+            // Keep the buckets a power of two, at least as many as the entries
+            if (IDEntries.size() >= IDBuckets.size())
+            {
+                IDBuckets.assign(IDBuckets.empty() ? 64 : IDBuckets.size() * 2, -1);
+                for (unsigned int i = 0; i < IDEntries.size(); i++)
+                {
+                    int& bucket = IDBuckets[IDEntries[i].hash & (IDBuckets.size() - 1)];
+                    IDEntries[i].next = bucket;
+                    bucket = i;
+                }
+            }
+
+            int& bucket = IDBuckets[hash & (IDBuckets.size() - 1)];
+            IDEntries.push_back(IDEntry(key, hash, bucket));
+            bucket = IDEntries.size() - 1;
+            return bucket;
+        }
+
+        void SDOSAX2Parser::addIDRef(DataObjectPtr dataObject,
+                                     const SDOXMLString& propertyName,
+                                     const SDOXMLString& value)
+        {
+            IDRef ref(dataObject, internID(propertyName), internID(value));
+            IDEntries[ref.value].referenceCount++;
+            IDRefs.push_back(ref);
+        }
+
+        DataObjectPtr SDOSAX2Parser::findIDTarget(unsigned int value)
+        {
+            IDEntry& entry = IDEntries[value];
+            if (!entry.dataObject && !entry.resolved)
+            {
+                // Not an ID, so assume it is an XPath. It is only looked up
+                // once, however many references use it.
+                entry.resolved = true;
+                entry.dataObject = rootDataObject->getDataObject((const char*)entry.key);
+            }
+            if (entry.dataObject && entry.referenceCount > 0)
+            {
+                // Size the target's reference list once for every reference
+                // to it, rather than letting it grow one setting at a time
+                DataObject* target = entry.dataObject;
+                ((DataObjectImpl*)target)->reserveReferences(entry.referenceCount);
+                entry.referenceCount = 0;
+            }
+            return entry.dataObject;
+        }
+
         void SDOSAX2Parser::endDocument()
         {
             LOGENTRY(INFO,"SDOSAX2Parser: endDocument");
-            // Iterate over IDREFs list and set references
+            // Iterate over IDREFs list and set references. The references
+            // of one property of an object are recorded together, so the
+            // property is looked up once for each run of them.
+            DataObject* lastObject = 0;
+            unsigned int lastProperty = 0;
+            const Property* prop = 0;
+            bool isReference = false;
+            DataObjectList* dol = 0;
+
             ID_REFS::iterator refsIter;
             for (refsIter = IDRefs.begin(); refsIter != IDRefs.end(); refsIter++)
             {
                 try
                 {
-                    const Type& type = refsIter->dataObject->getType();
-                    const Property& prop = refsIter->dataObject->getProperty((const char*)refsIter->property);
-                    const Type& propType =    ((TypeImpl&)type).getRealPropertyType(refsIter->property);
-
-                    // Allowing referenes to DataObjects only
-                    if (!propType.isDataType())
+                    DataObject* dob = refsIter->dataObject;
+                    if (dob != lastObject || refsIter->property != lastProperty)
                     {
-                        DataObjectPtr reffedDO;
-                        ID_MAP::iterator idIter = IDMap.find(refsIter->value);
-                        if (idIter != IDMap.end())
-                        {
-                            reffedDO = idIter->second;
-                        }
-                        else
-                        {
-                            // assume it is an XPath?
-
-                            // Remove #/ from front of XPATH as getDataObject doeesnt
-                            // support this yet - it does now
-                            //SDOXMLString xpath(refsIter->value);
-                            //if (xpath.firstIndexOf('#') == 0)
-                            //    xpath = xpath.substring(1);
-                            //if (xpath.firstIndexOf('/') == 0)
-                            //    xpath = xpath.substring(1);
-
-                            reffedDO = rootDataObject->getDataObject((const char*)refsIter->value);
-                        }
+                        lastObject = 0;
+                        const SDOXMLString& propertyName = IDEntries[refsIter->property].key;
+                        const Type& type = dob->getType();
+                        prop = &dob->getProperty((const char*)propertyName);
+                        const Type& propType = ((TypeImpl&)type).getRealPropertyType(propertyName);
+
+                        // Allowing referenes to DataObjects only
+                        isReference = !propType.isDataType();
+                        dol = (isReference && prop->isMany()) ? &dob->getList(*prop) : 0;
+                        lastObject = dob;
+                        lastProperty = refsIter->property;
+                    }
 
-                        if (!reffedDO)
-                        {
-                            continue;
-                        }
+                    if (!isReference)
+                    {
+                        continue;
+                    }
 
-                        if (prop.isMany())
-                        {
-                            DataObjectList& dol = refsIter->dataObject->getList(prop);
-                            dol.append(reffedDO);
-                        }
-                        else
-                        {
-                            refsIter->dataObject->setDataObject(prop, reffedDO); 
-                        }
+                    DataObjectPtr reffedDO = findIDTarget(refsIter->value);
+                    if (!reffedDO)
+                    {
+                        continue;
                     }
 
+                    if (dol != 0)
+                    {
+                        dol->append(reffedDO);
+                    }
+                    else
+                    {
+                        dob->setDataObject(*prop, reffedDO); 
+                    }
                 }
                 catch (const SDORuntimeException&)
                 {
                 }
             }
+            IDRefs.clear();
+            IDEntries.clear();
+            IDBuckets.clear();
+
             try {
                 // Now rebuild the changeSummary
                 if (csbuilder != 0)
@@ -396,15 +468,15 @@ namespace commonj
                                 || prop.isReference())
                             {
                                 // remember this value to resolve later
-                                IDRef ref(currentDataObject, attributes[i].getName(), propValue);
-                                IDRefs.push_back(ref);
+                                addIDRef(currentDataObject,
+                                    attributes[i].getName(), propValue);
                             }
                             else
                             {    
                                 if (pi && pi->getPropertyDefinition().isID)
                                 {
                                     // add this ID to the map
-                                    IDMap[propValue] = currentDataObject;
+                                    IDEntries[internID(propValue)].dataObject = currentDataObject;
                                 }
                                 // Always set the property as a String. SDO will do the conversion
                                 currentDataObject->setCString((const char*)attributes[i].getName(), propValue);
@@ -1247,10 +1319,9 @@ namespace commonj
                             if (currentPropertySetting.isIDREF)
                             {
                                 // remember this value to resolve later
-                                IDRef ref(currentPropertySetting.dataObject,
+                                addIDRef(currentPropertySetting.dataObject,
                                     currentPropertySetting.name,
-                                    currentPropertySetting.value );
-                                IDRefs.push_back(ref);
+                                    currentPropertySetting.value);
                             }
                             else
                             {
@@ -1496,7 +1567,7 @@ namespace commonj
             }
             */
 
-            const std::list<PropertyImpl*> pl = type.getPropertyListReference();
+            const std::list<PropertyImpl*>& pl = type.getPropertyListReference();
 
             for (std::list<PropertyImpl*>::const_iterator i = pl.begin();
                  i != pl.end();
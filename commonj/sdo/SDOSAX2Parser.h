@@ -34,6 +34,7 @@
 
 
 #include <stack>
+#include <vector>
 
 namespace commonj
 {
@@ -153,21 +154,47 @@ namespace commonj
             } ignoreTag;
 
 
-            typedef std::map<SDOXMLString, DataObjectPtr> ID_MAP;
-            ID_MAP IDMap;
+            // The IDs, the values of references and the names of reference
+            // properties are each held once in IDEntries, and found through
+            // a hash. A reference records the entries it uses, so that the
+            // references to one ID or path share a single lookup.
+            class IDEntry
+            {
+            public:
+                IDEntry(const SDOXMLString& k, unsigned int h, int n)
+                : key(k), hash(h), next(n), resolved(false), referenceCount(0)
+                {}
+
+                SDOXMLString key;
+                unsigned int hash;
+                int next;                   // next entry in the bucket, or -1
+                DataObjectPtr dataObject;   // the object with this ID, or found at this path
+                bool resolved;              // the key has been looked up as a path
+                unsigned int referenceCount; // references still to be set to the object
+            };
+
+            typedef std::vector<IDEntry> ID_ENTRIES;
+            ID_ENTRIES IDEntries;
+            std::vector<int> IDBuckets;
+
+            unsigned int internID(const SDOXMLString& key);
+            void addIDRef(DataObjectPtr dataObject,
+                          const SDOXMLString& propertyName,
+                          const SDOXMLString& value);
+            DataObjectPtr findIDTarget(unsigned int value);
 
             class IDRef
             {
             public:
                 IDRef(DataObjectPtr dataobj,
-                const SDOXMLString& prop,
-                const SDOXMLString& val)
+                unsigned int prop,
+                unsigned int val)
                 : dataObject(dataobj), property(prop), value(val)
                 {}
 
                 DataObjectPtr dataObject;
-                SDOXMLString property;
-                SDOXMLString value;
+                unsigned int property;      // entry for the property name
+                unsigned int value;         // entry for the ID or path
             };
 
             typedef std::list<IDRef> ID_REFS;
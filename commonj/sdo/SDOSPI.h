@@ -25,3 +25,4 @@
 #include "commonj/sdo/SDO.h"
 
 #include "commonj/sdo/DASValues.h"
+#include "commonj/sdo/SDOStats.h"
@@ -26,6 +26,7 @@
 #include "commonj/sdo/SDORuntimeException.h"
 #include "commonj/sdo/Logging.h"
 #include "commonj/sdo/SDOUtils.h"
+#include "commonj/sdo/SDOStats.h"
 
 
 #include <stdio.h>
@@ -567,6 +568,7 @@ namespace commonj
 
             try
             {
+                SDOStats::add(SDOStats::SchemaLoads);
                 int rc = parse(absUri);
                 // add new location to map
                 parsedLocations[absUri] = schemaInfo.getTargetNamespaceURI();
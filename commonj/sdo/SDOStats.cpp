@@ -0,0 +1,138 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/* $Rev$ $Date$ */
+
+#include "commonj/sdo/SDOStats.h"
+#include "commonj/sdo/SDOAtomic.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+// The counters are per thread, so that a request served on one thread
+// never sees the work done for a request on another.
+#if defined(WIN32) || defined(_WINDOWS)
+#include <windows.h>
+#define SDO_THREAD_LOCAL __declspec(thread)
+#else
+#include <sys/time.h>
+#define SDO_THREAD_LOCAL __thread
+#endif
+
+namespace commonj
+{
+    namespace sdo
+    {
+
+        static SDO_THREAD_LOCAL bool statsEnabled = false;
+        static SDO_THREAD_LOCAL int64_t counters[SDOStats::CounterCount];
+
+        static const char* const counterNames[SDOStats::CounterCount] =
+        {
+            "objects_created",
+            "objects_destroyed",
+            "path_resolutions",
+            "property_lookups",
+            "property_index_hits",
+            "xml_bytes_parsed",
+            "xml_parse_usec",
+            "xml_bytes_written",
+            "xml_write_usec",
+            "change_summary_entries",
+            "schema_loads",
+            "factory_cache_hits"
+        };
+
+        volatile long SDOStats::enabledThreads = 0;
+
+        void SDOStats::setEnabled(bool enable)
+        {
+            if (enable == statsEnabled)
+            {
+                return;
+            }
+            statsEnabled = enable;
+            if (enable)
+            {
+                SDO_ATOMIC_INCREMENT(&enabledThreads);
+            }
+            else
+            {
+                SDO_ATOMIC_DECREMENT(&enabledThreads);
+            }
+        }
+
+        bool SDOStats::isEnabled()
+        {
+            return statsEnabled;
+        }
+
+        void SDOStats::reset()
+        {
+            for (int i = 0; i < CounterCount; i++)
+            {
+                counters[i] = 0;
+            }
+        }
+
+        int64_t SDOStats::get(Counter counter)
+        {
+            return counters[counter];
+        }
+
+        const char* SDOStats::getName(Counter counter)
+        {
+            return counterNames[counter];
+        }
+
+        void SDOStats::addEnabled(Counter counter, int64_t amount)
+        {
+            if (statsEnabled)
+            {
+                counters[counter] += amount;
+            }
+        }
+
+        void SDOStats::addFileSize(Counter counter, const char* fileName)
+        {
+            struct stat info;
+            if (statsEnabled && fileName != 0 && stat(fileName, &info) == 0)
+            {
+                counters[counter] += info.st_size;
+            }
+        }
+
+        int64_t SDOStats::getMicros()
+        {
+#if defined(WIN32) || defined(_WINDOWS)
+            LARGE_INTEGER count, frequency;
+            QueryPerformanceCounter(&count);
+            QueryPerformanceFrequency(&frequency);
+            return (int64_t) (count.QuadPart / frequency.QuadPart) * 1000000 +
+                (int64_t) (count.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart;
+#else
+            struct timeval now;
+            gettimeofday(&now, 0);
+            return (int64_t) now.tv_sec * 1000000 + now.tv_usec;
+#endif
+        }
+
+    } // End - namespace sdo
+} // End - namespace commonj
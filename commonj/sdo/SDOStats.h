@@ -0,0 +1,143 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+
+/* $Rev$ $Date$ */
+
+#ifndef _SDO_SDOSTATS_H_
+#define _SDO_SDOSTATS_H_
+
+#include "commonj/sdo/export.h"
+
+namespace commonj
+{
+    namespace sdo
+    {
+
+/**
+ * SDOStats keeps counters of the work done by the library, so that the
+ * time spent in a request can be attributed without a profiler.
+ *
+ * The counters are per thread and are only updated once enabled on that
+ * thread. add() is inline and tests a process wide count of the threads
+ * that enabled counting, so while no thread has, a counter costs one load.
+ * A host such as the PHP extension enables and resets them at the start
+ * of each request.
+ */
+    class SDOStats
+    {
+    public:
+
+        enum Counter
+        {
+            ObjectsCreated = 0,    // data objects of a graph constructed
+            ObjectsDestroyed,      // data objects of a graph destroyed
+            PathResolutions,       // path expressions resolved
+            PropertyLookups,       // properties looked up by name
+            PropertyIndexHits,     // lookups answered by a frozen type's index
+            XMLBytesParsed,        // bytes of XML parsed, schemas included
+            XMLParseMicros,        // microseconds spent parsing XML
+            XMLBytesWritten,       // bytes of XML written
+            XMLWriteMicros,        // microseconds spent writing XML
+            ChangeSummaryEntries,  // objects entered in a change summary
+            SchemaLoads,           // schema documents loaded
+            FactoryCacheHits,      // data factories reused from a cache
+            CounterCount
+        };
+
+        /**
+         * Turn counting on or off for this thread.
+         */
+        SDO_SPI static void setEnabled(bool enable);
+
+        SDO_SPI static bool isEnabled();
+
+        /**
+         * Set all of this thread's counters back to zero.
+         */
+        SDO_SPI static void reset();
+
+        SDO_SPI static int64_t get(Counter counter);
+
+        /**
+         * A short lower case name for the counter, such as "objects_created".
+         */
+        SDO_SPI static const char* getName(Counter counter);
+
+        static void add(Counter counter, int64_t amount = 1)
+        {
+            if (enabledThreads != 0)
+            {
+                addEnabled(counter, amount);
+            }
+        }
+
+        /**
+         * Add the size of the named file to the counter.
+         */
+        SDO_SPI static void addFileSize(Counter counter, const char* fileName);
+
+        /**
+         * A clock in microseconds, for use by SDOStatsTimer.
+         */
+        SDO_SPI static int64_t getMicros();
+
+    private:
+        /**
+         * Add to the counter if counting is enabled on this thread.
+         */
+        SDO_SPI static void addEnabled(Counter counter, int64_t amount);
+
+        // The number of threads with counting enabled.
+        SDO_SPI static volatile long enabledThreads;
+    };
+
+/**
+ * SDOStatsTimer adds the microseconds between its construction and its
+ * destruction to a counter, when counting is enabled.
+ */
+    class SDOStatsTimer
+    {
+    public:
+        explicit SDOStatsTimer(SDOStats::Counter c)
+            : counter(c), start(SDOStats::isEnabled() ? SDOStats::getMicros() : -1)
+        {
+        }
+
+        ~SDOStatsTimer()
+        {
+            if (start >= 0)
+            {
+                SDOStats::add(counter, SDOStats::getMicros() - start);
+            }
+        }
+
+    private:
+        // Not copyable
+        SDOStatsTimer(const SDOStatsTimer&);
+        SDOStatsTimer& operator=(const SDOStatsTimer&);
+
+        SDOStats::Counter counter;
+        int64_t start;
+    };
+
+    } // End - namespace sdo
+} // End - namespace commonj
+
+#endif //_SDO_SDOSTATS_H_
@@ -269,7 +269,7 @@ namespace commonj {
                  " isOpen: " << tl[i].isOpenType()
                   << " isSequenced: " << tl[i].isSequencedType() << endl;
 
-              const std::list<PropertyImpl*> pl = tl[i].getPropertyListReference();
+              const std::list<PropertyImpl*>& pl = tl[i].getPropertyListReference();
 
               for (std::list<PropertyImpl*>::const_iterator j = pl.begin();
                    j != pl.end();
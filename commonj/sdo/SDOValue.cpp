@@ -27,21 +27,7 @@ namespace commonj
      SDOValue::SDOValue(const char* inValue, unsigned int len) : 
         typeOfValue(DataTypeInfo::SDOByteArray), transient_buffer(0)
      {
-        char* temp_buffer = new char[len + 1];
-
-        // We would like to use strncpy at this point, but it is
-        // deprecated and its preferred alternative, strncpy_s, does
-        // not copy nulls if they appear in the input stream so we'll
-        // do it by hand.
-        for (unsigned int i = 0; i < len; i++)
-        {
-           temp_buffer[i] = (char) inValue[i];
-        }
-        temp_buffer[len] = 0;
-
-        value.TextString = new SDOString(temp_buffer, len);
-
-        delete[] temp_buffer;
+        value.TextString = new SDOString(inValue, len);
      }
 
      SDOValue::SDOValue(const wchar_t* inValue, unsigned int len) : 
@@ -81,6 +67,9 @@ namespace commonj
            case DataTypeInfo::SDOlong:
               value.Integer = inValue.value.Integer;
               break;
+           case DataTypeInfo::SDOint64_t:
+              value.Int64 = inValue.value.Int64;
+              break;
            case DataTypeInfo::SDOfloat:
               value.Float = inValue.value.Float;
               break;
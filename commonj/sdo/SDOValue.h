@@ -236,6 +236,56 @@ namespace commonj
                                                        max_length);
             }
 
+            // The text held by a CString or Bytes value, or 0 for any other
+            // kind of value. No conversion is done.
+            inline SDO_API const SDOString* getTextString() const
+            {
+               if ((typeOfValue == DataTypeInfo::SDOCString) ||
+                   (typeOfValue == DataTypeInfo::SDOByteArray))
+               {
+                  return value.TextString;
+               }
+               return 0;
+            }
+
+            // The characters and length of a CString or Bytes value, without
+            // copying them or filling the transient buffer. The view stays
+            // valid until the value is changed. Returns false for any other
+            // kind of value, which must be read with a converting getter.
+            inline SDO_API bool getStringView(const char*& data, unsigned int& length) const
+            {
+               const SDOString* text = getTextString();
+               if (text == 0)
+               {
+                  data = 0;
+                  length = 0;
+                  return false;
+               }
+               data = text->data();
+               length = (unsigned int) text->length();
+               return true;
+            }
+
+            // The characters held by a String value, or 0 for any other
+            // kind of value. No conversion is done.
+            inline SDO_API const wchar_t* getWideString(unsigned int& length) const
+            {
+               if (typeOfValue == DataTypeInfo::SDOWideString)
+               {
+                  length = value.WideString.length;
+                  return value.WideString.data;
+               }
+               length = 0;
+               return 0;
+            }
+
+            // The kind of C++ value held, which is not necessarily the SDO
+            // type of the property it belongs to.
+            inline SDO_API DataTypeInfo::RawDataType getRawType() const
+            {
+               return typeOfValue;
+            }
+
             // Beware, the array does not contain values for all the
             // enumeration values and it is the callers job to avoid
             // triggering that.
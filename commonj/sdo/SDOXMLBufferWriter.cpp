@@ -21,6 +21,7 @@
 
 #include "commonj/sdo/SDOXMLBufferWriter.h"
 #include "commonj/sdo/SDORuntimeException.h"
+#include "commonj/sdo/SDOStats.h"
 
 namespace commonj
 {
@@ -47,6 +48,13 @@ namespace commonj
             xmlBufferFree(buf);
         }
         
+        int SDOXMLBufferWriter::write(XMLDocumentPtr doc, int indent)
+        {
+            int rc = SDOXMLWriter::write(doc, indent);
+            SDOStats::add(SDOStats::XMLBytesWritten, xmlBufferLength(buf));
+            return rc;
+        }
+
         SDOXMLString SDOXMLBufferWriter::getBuffer()
         {
             freeWriter();
@@ -41,6 +41,8 @@ namespace commonj
             
             SDOXMLBufferWriter(DataFactoryPtr dataFactory = NULL);                
             virtual ~SDOXMLBufferWriter();
+
+            int write(XMLDocumentPtr doc, int indent=-1);
             
             SDOXMLString getBuffer();
         private:
@@ -20,6 +20,7 @@
 /* $Rev: 452786 $ $Date$ */
 
 #include "commonj/sdo/SDOXMLFileWriter.h"
+#include "commonj/sdo/SDOStats.h"
 
 namespace commonj
 {
@@ -30,7 +31,7 @@ namespace commonj
         
         
         SDOXMLFileWriter::SDOXMLFileWriter(const char* xmlFile, DataFactoryPtr dataFactory)
-            : SDOXMLWriter(dataFactory)
+            : SDOXMLWriter(dataFactory), fileName(xmlFile)
         {
             setWriter(xmlNewTextWriterFilename(xmlFile, 0));
         }
@@ -39,6 +40,13 @@ namespace commonj
         {
         
         }
+
+        int SDOXMLFileWriter::write(XMLDocumentPtr doc, int indent)
+        {
+            int rc = SDOXMLWriter::write(doc, indent);
+            SDOStats::addFileSize(SDOStats::XMLBytesWritten, fileName.c_str());
+            return rc;
+        }
         
         
     } // End - namespace sdo
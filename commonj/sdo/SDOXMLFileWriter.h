@@ -44,8 +44,11 @@ namespace commonj
             SDOXMLFileWriter(const char* xmlFile, DataFactoryPtr dataFactory = NULL);
             
             virtual ~SDOXMLFileWriter();
-    
-            
+
+            int write(XMLDocumentPtr doc, int indent=-1);
+
+        private:
+            SDOString fileName;
         };
     } // End - namespace sdo
 } // End - namespace commonj
@@ -0,0 +1,312 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ * 
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *   
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* $Rev$ $Date$ */
+
+#include "commonj/sdo/SDOXMLTreeWriter.h"
+#include "commonj/sdo/SDORuntimeException.h"
+#include "commonj/sdo/SDOUtils.h"
+
+#include <string.h>
+
+namespace commonj
+{
+    namespace sdo
+    {
+        
+        static const xmlChar* const s_xmlnsPrefix = (const xmlChar*) "xmlns";
+        
+        SDOXMLTreeWriter::SDOXMLTreeWriter(DataFactoryPtr dataFactory)
+            : SDOXMLWriter(dataFactory), doc(NULL), current(NULL),
+              startTagOpen(false), elementPrefixed(false)
+        {
+            doc = xmlNewDoc((const xmlChar*) "1.0");
+            if (doc == NULL)
+            {
+                SDO_THROW_EXCEPTION("SDOXMLTreeWriter", SDOXMLParserException, "xmlNewDoc failed");
+            }
+        }
+        
+        SDOXMLTreeWriter::~SDOXMLTreeWriter()
+        {    
+            if (doc != NULL)
+            {
+                xmlFreeDoc(doc);
+            }
+        }
+        
+        xmlDocPtr SDOXMLTreeWriter::getDocument()
+        {
+            completeStartTag();
+            xmlDocPtr ret = doc;
+            doc = NULL;
+            current = NULL;
+            return ret;
+        }
+
+        bool SDOXMLTreeWriter::isOpen() const
+        {
+            return doc != NULL;
+        }
+
+        void SDOXMLTreeWriter::setIndent(int indent)
+        {
+        }
+
+        int SDOXMLTreeWriter::startDocument(const char* version, const char* encoding)
+        {
+            if (version != NULL)
+            {
+                xmlFree((void*) doc->version);
+                doc->version = xmlStrdup((const xmlChar*) version);
+            }
+            if (encoding != NULL)
+            {
+                doc->encoding = xmlStrdup((const xmlChar*) encoding);
+            }
+            return 0;
+        }
+
+        int SDOXMLTreeWriter::endDocument()
+        {
+            completeStartTag();
+            while (current != NULL)
+            {
+                endElement();
+            }
+            return 0;
+        }
+
+        // Resolves the prefixes of the element and of its attributes, now
+        // that every namespace declaration of the start tag is known.
+        // An undeclared prefix is kept as part of the name.
+        void SDOXMLTreeWriter::completeStartTag()
+        {
+            if (!startTagOpen)
+            {
+                return;
+            }
+            startTagOpen = false;
+
+            xmlNsPtr ns = xmlSearchNs(doc, current, elementPrefixed ? (const xmlChar*) elementPrefix : NULL);
+            if (ns != NULL)
+            {
+                xmlSetNs(current, ns);
+            }
+            else if (elementPrefixed)
+            {
+                SDOXMLString qname = elementPrefix + ":" + SDOXMLString(current->name);
+                xmlNodeSetName(current, qname);
+            }
+
+            for (unsigned int i = 0; i < prefixedAttributes.size(); i++)
+            {
+                const PrefixedAttribute& a = prefixedAttributes[i];
+                ns = xmlSearchNs(doc, current, a.prefix);
+                if (ns != NULL)
+                {
+                    xmlNewNsProp(current, ns, a.name, a.value);
+                }
+                else
+                {
+                    xmlNewProp(current, a.prefix + ":" + a.name, a.value);
+                }
+            }
+            prefixedAttributes.clear();
+        }
+
+        int SDOXMLTreeWriter::addElement(const xmlChar* prefix, const xmlChar* name)
+        {
+            completeStartTag();
+
+            // A name may carry its prefix, as in "sdo:changeSummary"
+            const xmlChar* colon = xmlStrchr(name, ':');
+            if (prefix == NULL && colon != NULL)
+            {
+                elementPrefix = SDOXMLString(name, 0, colon - name);
+                name = colon + 1;
+                elementPrefixed = true;
+            }
+            else
+            {
+                elementPrefixed = (prefix != NULL);
+                if (elementPrefixed)
+                {
+                    elementPrefix = prefix;
+                }
+            }
+
+            xmlNodePtr node = xmlNewDocNode(doc, NULL, name, NULL);
+            if (node == NULL)
+            {
+                return -1;
+            }
+            if (current == NULL)
+            {
+                xmlDocSetRootElement(doc, node);
+            }
+            else
+            {
+                xmlAddChild(current, node);
+            }
+            current = node;
+            startTagOpen = true;
+            return 0;
+        }
+
+        int SDOXMLTreeWriter::startElement(const xmlChar* name)
+        {
+            return addElement(NULL, name);
+        }
+
+        int SDOXMLTreeWriter::startElementNS(const xmlChar* prefix, const xmlChar* name,
+                                             const xmlChar* uri)
+        {
+            int rc = addElement(prefix, name);
+            if (rc == 0 && uri != NULL)
+            {
+                xmlNewNs(current, uri, prefix);
+            }
+            return rc;
+        }
+
+        int SDOXMLTreeWriter::endElement()
+        {
+            if (current == NULL)
+            {
+                return -1;
+            }
+            completeStartTag();
+            current = (current->parent != NULL && current->parent->type == XML_ELEMENT_NODE)
+                ? current->parent : NULL;
+            return 0;
+        }
+
+        int SDOXMLTreeWriter::writeAttribute(const xmlChar* name, const xmlChar* value)
+        {
+            if (!startTagOpen)
+            {
+                return -1;
+            }
+
+            const xmlChar* colon = xmlStrchr(name, ':');
+            if (colon == NULL)
+            {
+                if (xmlStrEqual(name, s_xmlnsPrefix))
+                {
+                    xmlNewNs(current, value, NULL);
+                    return 0;
+                }
+                return xmlNewProp(current, name, value) != NULL ? 0 : -1;
+            }
+
+            SDOXMLString prefix(name, 0, colon - name);
+            return writeAttributeNS(prefix, colon + 1, NULL, value);
+        }
+
+        int SDOXMLTreeWriter::writeAttributeNS(const xmlChar* prefix, const xmlChar* name,
+                                               const xmlChar* uri, const xmlChar* value)
+        {
+            if (!startTagOpen)
+            {
+                return -1;
+            }
+
+            if (prefix == NULL)
+            {
+                return xmlNewProp(current, name, value) != NULL ? 0 : -1;
+            }
+            if (xmlStrEqual(prefix, s_xmlnsPrefix))
+            {
+                xmlNewNs(current, value, name);
+                return 0;
+            }
+            if (uri != NULL)
+            {
+                xmlNewNs(current, uri, prefix);
+            }
+
+            PrefixedAttribute a;
+            a.prefix = prefix;
+            a.name = name;
+            a.value = value;
+            prefixedAttributes.push_back(a);
+            return 0;
+        }
+
+        int SDOXMLTreeWriter::writeElement(const xmlChar* name, const xmlChar* content)
+        {
+            int rc = startElement(name);
+            if (rc == 0)
+            {
+                completeStartTag();
+                if (content != NULL)
+                {
+                    xmlAddChild(current, xmlNewDocText(doc, content));
+                }
+                rc = endElement();
+            }
+            return rc;
+        }
+
+        // Adds the text to the current element, with any CDATA sections in
+        // it as CDATA nodes.
+        int SDOXMLTreeWriter::addText(const xmlChar* text)
+        {
+            if (current == NULL)
+            {
+                return -1;
+            }
+            completeStartTag();
+
+            const char* start = SDOUtils::XMLCDataStartMarker;
+            const char* end = SDOUtils::XMLCDataEndMarker;
+            const char* p = (const char*) text;
+            while (p != NULL && *p != 0)
+            {
+                const char* cdata = strstr(p, start);
+                const char* cdataEnd = cdata != NULL ? strstr(cdata + strlen(start), end) : NULL;
+                if (cdataEnd == NULL)
+                {
+                    xmlAddChild(current, xmlNewDocText(doc, (const xmlChar*) p));
+                    break;
+                }
+                if (cdata > p)
+                {
+                    xmlAddChild(current, xmlNewDocTextLen(doc, (const xmlChar*) p, cdata - p));
+                }
+                cdata += strlen(start);
+                xmlAddChild(current, xmlNewCDataBlock(doc, (const xmlChar*) cdata, cdataEnd - cdata));
+                p = cdataEnd + strlen(end);
+            }
+            return 0;
+        }
+
+        int SDOXMLTreeWriter::writeRaw(const xmlChar* text)
+        {
+            return addText(text);
+        }
+
+        int SDOXMLTreeWriter::writeXMLElement(const SDOXMLString& name, 
+                                              const SDOXMLString& content)
+        {
+            return addText(content);
+        }
+    } // End - namespace sdo
+} // End - namespace commonj
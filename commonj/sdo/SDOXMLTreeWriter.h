@@ -0,0 +1,104 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ * 
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *   
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+/* $Rev$ $Date$ */
+
+#ifndef _SDOXMLTREEWRITER_H_
+#define _SDOXMLTREEWRITER_H_
+
+#include "commonj/sdo/disable_warn.h"
+
+#include "commonj/sdo/SDOXMLWriter.h"
+#include <libxml/tree.h>
+#include <vector>
+
+namespace commonj
+{
+    namespace sdo
+    {
+        
+/** 
+ * SDOXMLTreeWriter extends SDOXMLWriter to give a libxml2 document.
+ * The nodes are built directly, with no XML text written or parsed.
+ *
+ * Element and attribute names written with a prefix are put in the
+ * namespace the prefix is declared for once the start tag is complete,
+ * since the declarations are written as attributes after the name.
+ * Indenting is ignored; the document has no whitespace text nodes.
+ */
+        class SDOXMLTreeWriter : public SDOXMLWriter
+        {
+            
+        public:
+            
+            SDOXMLTreeWriter(DataFactoryPtr dataFactory = NULL);                
+            virtual ~SDOXMLTreeWriter();
+            
+            /**
+             * getDocument hands the written document over to the caller,
+             * who frees it with xmlFreeDoc.
+             */
+            xmlDocPtr getDocument();
+
+        protected:
+            virtual bool isOpen() const;
+            virtual void setIndent(int indent);
+            virtual int startDocument(const char* version, const char* encoding);
+            virtual int endDocument();
+            virtual int startElement(const xmlChar* name);
+            virtual int startElementNS(const xmlChar* prefix, const xmlChar* name,
+                                       const xmlChar* uri);
+            virtual int endElement();
+            virtual int writeAttribute(const xmlChar* name, const xmlChar* value);
+            virtual int writeAttributeNS(const xmlChar* prefix, const xmlChar* name,
+                                         const xmlChar* uri, const xmlChar* value);
+            virtual int writeElement(const xmlChar* name, const xmlChar* content);
+            virtual int writeRaw(const xmlChar* text);
+            virtual int writeXMLElement(const SDOXMLString& name, 
+                                        const SDOXMLString& content);
+
+        private:
+            struct PrefixedAttribute
+            {
+                SDOXMLString prefix;
+                SDOXMLString name;
+                SDOXMLString value;
+            };
+
+            int addElement(const xmlChar* prefix, const xmlChar* name);
+            int addText(const xmlChar* text);
+            void completeStartTag();
+
+            xmlDocPtr doc;
+
+            // The element being written, or 0 before the root element
+            xmlNodePtr current;
+
+            // Whether the start tag of current may still get attributes,
+            // and the prefixes left to resolve when it is complete
+            bool startTagOpen;
+            bool elementPrefixed;
+            SDOXMLString elementPrefix;
+            std::vector<PrefixedAttribute> prefixedAttributes;
+        };
+    } // End - namespace sdo
+} // End - namespace commonj
+
+
+#endif //_SDOXMLTREEWRITER_H_
@@ -35,6 +35,7 @@ using namespace::std;
 #include "commonj/sdo/DataFactoryImpl.h"
 #include "commonj/sdo/PropertySetting.h"
 #include "commonj/sdo/SDOUtils.h"
+#include "commonj/sdo/SDOStats.h"
 
 namespace commonj
 {
@@ -58,7 +59,7 @@ namespace commonj
         
         SDOXMLWriter::SDOXMLWriter(
             DataFactoryPtr dataFact)
-            : dataFactory(dataFact)
+            : writer(NULL), dataFactory(dataFact)
         {
             
         }
@@ -84,12 +85,14 @@ namespace commonj
         
         int SDOXMLWriter::write(XMLDocumentPtr doc, int indent)
         {
+            SDOStatsTimer timer(SDOStats::XMLWriteMicros);
+
             if (!doc)
             {
                 return 0;
             }
             
-            if (writer == NULL)
+            if (!isOpen())
             {
                 // Throw exception
                 return -1;
@@ -100,24 +103,12 @@ namespace commonj
             
             if (indent >= 0)
             {
-                xmlTextWriterSetIndent(writer, 1);
-                if (indent > 0)
-                {
-                    char * chars = new char[indent+1];
-                    for (int i=0;i<indent;i++)chars[i] = ' ';
-                    chars[indent] = 0;
-                    xmlTextWriterSetIndentString(writer, SDOXMLString(chars));
-                    delete[] chars;
-                }
-                else
-                {
-                    xmlTextWriterSetIndentString(writer, SDOXMLString(""));
-                }
+                setIndent(indent);
             }
             
             if (doc->getXMLDeclaration())
             {
-                rc = xmlTextWriterStartDocument(writer, doc->getXMLVersion(), doc->getEncoding(), NULL);
+                rc = startDocument(doc->getXMLVersion(), doc->getEncoding());
                 if (rc < 0) {
                     SDO_THROW_EXCEPTION("write", SDOXMLParserException, "xmlTextWriterStartDocument failed");
                 }
@@ -171,18 +162,94 @@ namespace commonj
 
                 writeDO(root, elementURI, elementName, writeXSIType, true);
             }
-            rc = xmlTextWriterEndDocument(writer);
+            rc = endDocument();
             if (rc < 0) {
                     SDO_THROW_EXCEPTION("write", SDOXMLParserException, "xmlTextWriterEndDocument failed");
                 return rc;
             }
             
-            xmlTextWriterFlush(writer);
-            freeWriter();
-            
             return rc;
         }
 
+        //////////////////////////////////////////////////////////////////////////
+        // The calls the XML is written through, here to the xmlTextWriter
+        //////////////////////////////////////////////////////////////////////////
+
+        bool SDOXMLWriter::isOpen() const
+        {
+            return writer != NULL;
+        }
+
+        void SDOXMLWriter::setIndent(int indent)
+        {
+            xmlTextWriterSetIndent(writer, 1);
+            if (indent > 0)
+            {
+                char * chars = new char[indent+1];
+                for (int i=0;i<indent;i++)chars[i] = ' ';
+                chars[indent] = 0;
+                xmlTextWriterSetIndentString(writer, SDOXMLString(chars));
+                delete[] chars;
+            }
+            else
+            {
+                xmlTextWriterSetIndentString(writer, SDOXMLString(""));
+            }
+        }
+
+        int SDOXMLWriter::startDocument(const char* version, const char* encoding)
+        {
+            return xmlTextWriterStartDocument(writer, version, encoding, NULL);
+        }
+
+        int SDOXMLWriter::endDocument()
+        {
+            int rc = xmlTextWriterEndDocument(writer);
+            if (rc >= 0)
+            {
+                xmlTextWriterFlush(writer);
+                freeWriter();
+            }
+            return rc;
+        }
+
+        int SDOXMLWriter::startElement(const xmlChar* name)
+        {
+            return xmlTextWriterStartElement(writer, name);
+        }
+
+        int SDOXMLWriter::startElementNS(const xmlChar* prefix, const xmlChar* name,
+                                         const xmlChar* uri)
+        {
+            return xmlTextWriterStartElementNS(writer, prefix, name, uri);
+        }
+
+        int SDOXMLWriter::endElement()
+        {
+            return xmlTextWriterEndElement(writer);
+        }
+
+        int SDOXMLWriter::writeAttribute(const xmlChar* name, const xmlChar* value)
+        {
+            return xmlTextWriterWriteAttribute(writer, name, value);
+        }
+
+        int SDOXMLWriter::writeAttributeNS(const xmlChar* prefix, const xmlChar* name,
+                                           const xmlChar* uri, const xmlChar* value)
+        {
+            return xmlTextWriterWriteAttributeNS(writer, prefix, name, uri, value);
+        }
+
+        int SDOXMLWriter::writeElement(const xmlChar* name, const xmlChar* content)
+        {
+            return xmlTextWriterWriteElement(writer, name, content);
+        }
+
+        int SDOXMLWriter::writeRaw(const xmlChar* text)
+        {
+            return xmlTextWriterWriteRaw(writer, text);
+        }
+
         //////////////////////////////////////////////////////////////////////////
         // Write Change Summary attributes
         //////////////////////////////////////////////////////////////////////////
@@ -212,8 +279,7 @@ namespace commonj
                     if (sl.get(j)->getProperty().getType().isDataType())
                     {
                         // data types are OK
-                        rc = xmlTextWriterWriteAttribute(writer, 
-                            SDOXMLString(sl.get(j)->getProperty().getName()),
+                        rc = writeAttribute(SDOXMLString(sl.get(j)->getProperty().getName()),
                             SDOXMLString(sl.get(j)->getCStringValue()));
                     }
                     else 
@@ -223,21 +289,18 @@ namespace commonj
                         {
                             if (cs->isDeleted(dob))
                             {
-                            rc = xmlTextWriterWriteAttribute(writer, 
-                                SDOXMLString(sl.get(j)->getProperty().getName()),
+                            rc = writeAttribute(SDOXMLString(sl.get(j)->getProperty().getName()),
                                 SDOXMLString(cs->getOldXpath(dob)));
                             }
                             else 
                             {
-                            rc = xmlTextWriterWriteAttribute(writer, 
-                                SDOXMLString(sl.get(j)->getProperty().getName()),
+                            rc = writeAttribute(SDOXMLString(sl.get(j)->getProperty().getName()),
                                 SDOXMLString(dob->objectToXPath()));
                             }
                         }
                         else
                         {
-                            rc = xmlTextWriterWriteAttribute(writer, 
-                                SDOXMLString(sl.get(j)->getProperty().getName()),
+                            rc = writeAttribute(SDOXMLString(sl.get(j)->getProperty().getName()),
                                 SDOXMLString(""));
                         }
                     }
@@ -278,9 +341,7 @@ namespace commonj
                     if (sl.get(j)->getProperty().getType().isDataType())
                     {
 
-                        rc = xmlTextWriterWriteElement(
-                            writer,
-                            SDOXMLString(sl.get(j)->getProperty().getName()),
+                        rc = writeElement(SDOXMLString(sl.get(j)->getProperty().getName()),
                             SDOXMLString(sl.get(j)->getCStringValue()));
                             
                     } // if datatype
@@ -297,15 +358,10 @@ namespace commonj
                         }
                         else
                         {
-                            rc = xmlTextWriterStartElement(
-                                writer,
-                                SDOXMLString(sl.get(j)->getProperty().getName()));
-                            rc = xmlTextWriterWriteAttribute(
-                                writer,
-                                SDOXMLString("sdo:ref"),
+                            rc = startElement(SDOXMLString(sl.get(j)->getProperty().getName()));
+                            rc = writeAttribute(SDOXMLString("sdo:ref"),
                                 SDOXMLString(dob2->objectToXPath()));
-                            rc = xmlTextWriterEndElement(
-                                writer);
+                            rc = endElement();
                         }
                     } 
                 }
@@ -331,16 +387,13 @@ namespace commonj
         
             SettingList& sl = cs->getOldValues(dob);
         
-            rc = xmlTextWriterStartElement(
-                writer,
-                SDOXMLString(name));
+            rc = startElement(SDOXMLString(name));
 
             if (sl.size() == 0) 
             {
-                rc = xmlTextWriterWriteAttribute(writer, 
-                    SDOXMLString("sdo:ref"),
+                rc = writeAttribute(SDOXMLString("sdo:ref"),
                     SDOXMLString(cs->getOldXpath(dob)));
-                rc = xmlTextWriterEndElement(writer);
+                rc = endElement();
                 return;
             }
 
@@ -368,8 +421,7 @@ namespace commonj
                         continue;
                     }
 
-                    rc = xmlTextWriterWriteAttribute(writer, 
-                        SDOXMLString(sl.get(j)->getProperty().getName()),
+                    rc = writeAttribute(SDOXMLString(sl.get(j)->getProperty().getName()),
                         SDOXMLString(sl.get(j)->getCStringValue()));
 
                 } // for attributes
@@ -417,8 +469,7 @@ namespace commonj
                         
                         // could only be many valued data type
         
-                        rc = xmlTextWriterWriteElement(writer, 
-                            SDOXMLString(sl.get(k)->getProperty().getName()),
+                        rc = writeElement(SDOXMLString(sl.get(k)->getProperty().getName()),
                             SDOXMLString(sl.get(k)->getCStringValue()));
                     }
                 } // for attributes
@@ -428,7 +479,7 @@ namespace commonj
                  // ignore - and write the end-element
             }
 
-            rc = xmlTextWriterEndElement(writer);
+            rc = endElement();
         } 
 
 
@@ -456,15 +507,11 @@ namespace commonj
 
             if (name == 0) 
             {
-            rc = xmlTextWriterStartElement(
-                writer,
-                elementName);
+            rc = startElement(elementName);
             }
             else
             {
-            rc = xmlTextWriterStartElement(
-                writer,
-                SDOXMLString(name));
+            rc = startElement(SDOXMLString(name));
             }
 
             if (rc != 0)
@@ -482,15 +529,14 @@ namespace commonj
                 name = 0;
             }
 
-            rc = xmlTextWriterWriteAttribute(writer, 
-                SDOXMLString("sdo:ref"),
+            rc = writeAttribute(SDOXMLString("sdo:ref"),
                 SDOXMLString(name));
 
             handleChangeSummaryAttributes(cs, temp);
 
             handleChangeSummaryElements(cs, temp);
 
-            rc = xmlTextWriterEndElement(writer);
+            rc = endElement();
 
         }
 
@@ -506,13 +552,11 @@ namespace commonj
             int rc; 
 
             ChangedDataObjectList& changedDOs =  cs->getChangedDataObjects();
-            rc = xmlTextWriterStartElementNS(writer,
-                    SDOXMLString("sdo"), SDOXMLString("changeSummary"), SDOXMLString(Type::SDOTypeNamespaceURI.c_str()));
+            rc = startElementNS(SDOXMLString("sdo"), SDOXMLString("changeSummary"), SDOXMLString(Type::SDOTypeNamespaceURI.c_str()));
             if (rc != 0) return;
             if (cs->isLogging())
             {
-                rc = xmlTextWriterWriteAttribute(writer, 
-                    SDOXMLString("logging"),
+                rc = writeAttribute(SDOXMLString("logging"),
                     SDOXMLString("true"));
             }
 
@@ -531,8 +575,7 @@ namespace commonj
                         // TODO - can we have more than one create like this?
                         try
                         {
-                            rc = xmlTextWriterWriteElement(writer, 
-                            SDOXMLString("create"),
+                            rc = writeElement(SDOXMLString("create"),
                             SDOXMLString(changedDOs[i]->objectToXPath()));
                         }
                         catch (SDORuntimeException e)
@@ -546,8 +589,7 @@ namespace commonj
                         // TODO - should work out if theres a IDREF here
                         try 
                         {
-                            rc = xmlTextWriterWriteElement(writer, 
-                            SDOXMLString("delete"),
+                            rc = writeElement(SDOXMLString("delete"),
                             SDOXMLString(cs->getOldXpath(changedDOs[i])));
                         }
                         catch (SDORuntimeException e)
@@ -567,7 +609,7 @@ namespace commonj
                 }
                         
             }
-            rc = xmlTextWriterEndElement(writer);
+            rc = endElement();
         }
 
         void SDOXMLWriter::addNamespace(const SDOXMLString& uri, bool tns)
@@ -737,7 +779,7 @@ namespace commonj
                 }
             }
 
-            rc = xmlTextWriterStartElement(writer, theName);
+            rc = startElement(theName);
             if (rc < 0) {
                 SDO_THROW_EXCEPTION("writeDO", SDOXMLParserException, "xmlTextWriterStartElement failed");
             }   
@@ -752,18 +794,17 @@ namespace commonj
             {
                 if (dataObject->isNull(""))
                 {
-                    rc = xmlTextWriterWriteAttributeNS(writer, s_xsi, s_nil, NULL, s_true);
+                    rc = writeAttributeNS(s_xsi, s_nil, NULL, s_true);
                 }
                 else
                 {
                     /* Use our wrapper function just in case the element has CDATA in it */
-                    writeXMLElement(writer,
-                        elementName,
+                    writeXMLElement(elementName,
                         dataObject->getCString(""));
                 }
 
                 // Write the end element and return
-                rc = xmlTextWriterEndElement(writer);
+                rc = endElement();
                 return 0;
             }
             // End - primitive value is written
@@ -794,8 +835,7 @@ namespace commonj
                         }
                     }
 
-                    rc = xmlTextWriterWriteAttributeNS(writer, 
-                        s_xsi, s_type, 
+                    rc = writeAttributeNS(s_xsi, s_type, 
                         NULL,
                         theName);
                 }
@@ -813,7 +853,7 @@ namespace commonj
                      it != namespaceMap.end(); ++it)
                 {
                     if ((*it).first.equals("")) continue;
-                    rc = xmlTextWriterWriteAttributeNS(writer, s_xmlns, (*it).second, NULL, (*it).first);
+                    rc = writeAttributeNS(s_xmlns, (*it).second, NULL, (*it).first);
                 }
             }
             // End - namespace information is written
@@ -824,7 +864,7 @@ namespace commonj
             // write nil if required
             if (dataObject->isNull(""))
             {
-                rc = xmlTextWriterWriteAttributeNS(writer, s_xsi, s_nil, NULL, s_true);
+                rc = writeAttributeNS(s_xsi, s_nil, NULL, s_true);
             }
             // xsi:nil is written
             // ------------------
@@ -878,13 +918,12 @@ namespace commonj
                                 SDOXMLString pref = "tnss";
                                 sprintf(buffer, "%d", j++);
                                 pref += buffer;
-                                rc = xmlTextWriterWriteAttributeNS(writer, s_xmlns, pref, NULL, qname.getURI());
+                                rc = writeAttributeNS(s_xmlns, pref, NULL, qname.getURI());
                                 propertyValue = pref + ":" + qname.getLocalName();
                             }
                             
                         }
-                        rc = xmlTextWriterWriteAttribute(writer, 
-                            propertyName, propertyValue);
+                        rc = writeAttribute(propertyName, propertyValue);
                     }
                     else
                     {
@@ -927,9 +966,7 @@ namespace commonj
                         {
                             // This is a raw write rather than xmlTextWriterWriteString
                             // just in case the text has a CDATA section in it 
-                            rc = xmlTextWriterWriteRaw(
-                                writer,
-                                SDOXMLString(sequence->getCStringValue(i)));
+                            rc = writeRaw(SDOXMLString(sequence->getCStringValue(i)));
                             continue;
                         } // end TextType
 
@@ -1006,13 +1043,12 @@ namespace commonj
                                     theName += seqPropName;
                                 }
                             }
-                            xmlTextWriterStartElement(writer, theName);
+                            startElement(theName);
 
                             /* Use our wrapper function just in case the element has CDATA in it */
-                            writeXMLElement(writer,
-                                    seqPropName,
+                            writeXMLElement(seqPropName,
                                     sequence->getCStringValue(i));
-                            xmlTextWriterEndElement(writer);
+                            endElement();
                             
                         } // end DataType
                     } // end - iterate over sequence
@@ -1052,7 +1088,7 @@ namespace commonj
             // End - non-sequenced DO
             // ----------------------
 
-            rc = xmlTextWriterEndElement(writer);
+            rc = endElement();
             return rc;
 
         } // End - writeDO
@@ -1139,9 +1175,7 @@ namespace commonj
                                 ((DASType*)&tp)->getDASValue("XMLDAS::TypeInfo");
                             if (typeInfo && typeInfo->getTypeDefinition().isExtendedPrimitive)
                             {
-                                xmlTextWriterWriteRaw(
-                                    writer,
-                                    SDOXMLString(dataObject->getCString(pl[i])));
+                                writeRaw(SDOXMLString(dataObject->getCString(pl[i])));
                             }
                             else
                             {
@@ -1163,20 +1197,19 @@ namespace commonj
                                     }
                                 }
 
-                                xmlTextWriterStartElement(writer, theName);
+                                startElement(theName);
 
-                                //xmlTextWriterStartElementNS(writer, NULL, propertyName, NULL);
+                                //startElementNS(NULL, propertyName, NULL);
                                 if (dataObject->isNull(pl[i]))
                                 {
-                                    xmlTextWriterWriteAttributeNS(writer, s_xsi, s_nil, NULL, s_true);
+                                    writeAttributeNS(s_xsi, s_nil, NULL, s_true);
                                 }
                                 else
                                 {
-                                    writeXMLElement(writer,
-                                        propertyName,
+                                    writeXMLElement(propertyName,
                                         dataObject->getCString(pl[i]));
                                 }
-                                xmlTextWriterEndElement(writer);
+                                endElement();
                             }
                         }
                     }
@@ -1233,14 +1266,12 @@ namespace commonj
                 if (isElement)
                 {
                     // Set the IDREF value
-                    xmlTextWriterWriteElement(writer, 
-                        propertyName, refValue);
+                    writeElement(propertyName, refValue);
                 }
                 else
                 {
                     // Set the IDREF value
-                    xmlTextWriterWriteAttribute(writer, 
-                        propertyName, refValue);
+                    writeAttribute(propertyName, refValue);
                 }
             }
         }    
@@ -1251,12 +1282,11 @@ namespace commonj
        * A wrapper for the libxml2 function xmlTextWriterWriteElement
        * it detects CDATA sections before writing out element contents
        */
-      int SDOXMLWriter::writeXMLElement(xmlTextWriterPtr writer, 
-                                        const SDOXMLString& name, 
+      int SDOXMLWriter::writeXMLElement(const SDOXMLString& name, 
                                         const SDOXMLString& content)
       {
         int rc = 0;
-        rc = xmlTextWriterWriteRaw(writer, SDOXMLString(SDOUtils::escapeHtmlEntitiesExcludingCData(content).c_str()));
+        rc = writeRaw(SDOXMLString(SDOUtils::escapeHtmlEntitiesExcludingCData(content).c_str()));
 
         /* A more complex version that doesn't work!
          * I've left it here just in case we need to go back and separate out
@@ -57,6 +57,37 @@ namespace commonj
         protected:
             void setWriter(xmlTextWriterPtr textWriter);
             void freeWriter();
+
+            /**
+             * The calls the XML is written through. These write to the
+             * xmlTextWriter given to setWriter, and take the same arguments
+             * as the xmlTextWriter functions of the same names. A subclass
+             * may override them all to build the XML some other way.
+             */
+            virtual bool isOpen() const;
+            virtual void setIndent(int indent);
+            virtual int startDocument(const char* version, const char* encoding);
+            virtual int endDocument();
+            virtual int startElement(const xmlChar* name);
+            virtual int startElementNS(const xmlChar* prefix, const xmlChar* name,
+                                       const xmlChar* uri);
+            virtual int endElement();
+            virtual int writeAttribute(const xmlChar* name, const xmlChar* value);
+            virtual int writeAttributeNS(const xmlChar* prefix, const xmlChar* name,
+                                         const xmlChar* uri, const xmlChar* value);
+            virtual int writeElement(const xmlChar* name, const xmlChar* content);
+
+            /**
+             * Write text as it stands, unescaped. It may hold CDATA sections.
+             */
+            virtual int writeRaw(const xmlChar* text);
+
+            /**
+             * Write the content of an element, escaping it but for any
+             * CDATA sections.
+             */
+            virtual int writeXMLElement(const SDOXMLString& name, 
+                                        const SDOXMLString& content);
             
         private:
             xmlTextWriterPtr writer;
@@ -99,14 +130,6 @@ namespace commonj
                                  unsigned int start,
                                  unsigned int number);
 
-            /**
-             * A wrapper for the libxml2 function xmlTextWriterWriteElement
-             * it detects CDATA sections before wrting out element contents
-             */
-            int writeXMLElement(xmlTextWriterPtr writer, 
-                                const SDOXMLString& name, 
-                                const SDOXMLString& content);
-
             SchemaInfo* schemaInfo;
             DataFactoryPtr    dataFactory;
 
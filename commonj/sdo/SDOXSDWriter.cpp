@@ -411,7 +411,7 @@ namespace commonj
                     // ---------------------------
                     // Iterate over the properties
                     // ---------------------------
-                    const std::list<PropertyImpl*> pl = type.getPropertyListReference();
+                    const std::list<PropertyImpl*>& pl = type.getPropertyListReference();
                     
                     if (pl.size() != 0)
                     {
@@ -29,6 +29,8 @@
 #include "commonj/sdo/DataObject.h"
 #include "commonj/sdo/DataObjectImpl.h"
 #include "commonj/sdo/SDORuntimeException.h"
+
+#include <map>
 using namespace std;
 
 
@@ -39,11 +41,7 @@ using namespace std;
             SDO_THROW_EXCEPTION("Sequence API", SDOIndexOutOfRangeException,\
             msg.c_str());\
         }\
-        unsigned int j = 0;\
-        for (i = the_list.begin(); (j < index) && (i != the_list.end()); ++i)\
-        {\
-            j++;\
-        }
+        i = the_list.begin() + index;
     
 
 namespace commonj
@@ -59,14 +57,85 @@ namespace commonj
       }
 
       SequenceImpl::SequenceImpl(DataObject* indo)
+         : freeSettings(-1), liveSettings(0)
       {
          the_do = (DataObjectImpl*) indo;
       }
 
       SequenceImpl::SequenceImpl(SequenceImpl* inseq)
+         : the_do(inseq->the_do), freeSettings(-1), liveSettings(0)
       {
          // take a copy of the_list
          the_list = inseq->the_list;
+         buildSettingIndex();
+      }
+
+      void SequenceImpl::cloneEntries(SequenceImpl* from,
+                                      const ClonedObjects& copies)
+      {
+         the_list.reserve(the_list.size() + from->the_list.size());
+
+         // For each many valued reference, the number of items before each
+         // position which were not copied, with one more entry for the end.
+         std::map<const PropertyImpl*, std::vector<unsigned int> > uncopied;
+
+         SEQUENCE_ITEM_LIST::iterator i;
+         for (i = from->the_list.begin(); i != from->the_list.end(); ++i)
+         {
+            const PropertyImpl* prop = (const PropertyImpl*) (*i).getProp();
+            if (prop == 0)
+            {
+               // free text
+               the_list.push_back(*i);
+               continue;
+            }
+
+            unsigned int listIndex = (*i).getIndex();
+            if (prop->isReference())
+            {
+               if (prop->isMany())
+               {
+                  std::vector<unsigned int>& skipped = uncopied[prop];
+                  if (skipped.empty())
+                  {
+                     DataObjectListImpl* values = (DataObjectListImpl*)
+                        &from->the_do->getList(*prop);
+                     const DATAOBJECT_VECTOR& items = values->getDataObjects();
+                     skipped.resize(items.size() + 1, 0);
+                     for (unsigned int j = 0; j < items.size(); j++)
+                     {
+                        skipped[j + 1] = skipped[j] +
+                           (copies.find((DataObjectImpl*) &*items[j]) == 0 ? 1 : 0);
+                     }
+                  }
+                  if (listIndex + 1 >= skipped.size() ||
+                      skipped[listIndex + 1] != skipped[listIndex])
+                  {
+                     continue;
+                  }
+                  // Earlier items which were not copied close up the list.
+                  listIndex -= skipped[listIndex];
+               }
+               else
+               {
+                  DataObjectPtr value = from->the_do->getDataObject(*prop);
+                  DataObject* target = value;
+                  if (target != 0 &&
+                      copies.find((DataObjectImpl*) target) == 0)
+                  {
+                     continue;
+                  }
+               }
+            }
+
+            // Properties of the type are shared, but open properties
+            // belong to the data object.
+            unsigned int propertyIndex = from->the_do->getPropertyIndex(*prop);
+            the_list.push_back(seq_item(the_do->getPropertyImpl(propertyIndex),
+                                        listIndex));
+            indexInserted(the_list.size() - 1);
+         }
+
       }
 
       unsigned int SequenceImpl::size()
@@ -87,12 +156,246 @@ namespace commonj
                                 SDOIndexOutOfRangeException,
                                 msg.c_str());
          }
-         unsigned int j = 0;
-         for (i = the_list.begin(); (j < index) && (i != the_list.end()); ++i)
+         i = the_list.begin() + index;
+         return;
+      }
+
+      // The list index under which every entry of a property is also kept
+      static const unsigned int ANY_INDEX = ~0u;
+
+      // FNV-1a of the name, then of the list index a byte at a time
+      unsigned int SequenceImpl::hashSetting(const char* name, unsigned int listIndex)
+      {
+         unsigned int hash = 2166136261u;
+         for (const unsigned char* c = (const unsigned char*) name; *c != 0; c++)
+         {
+            hash = (hash ^ *c) * 16777619u;
+         }
+         for (int i = 0; i < 4; i++)
          {
-            j++;
+            hash = (hash ^ (listIndex & 0xff)) * 16777619u;
+            listIndex >>= 8;
          }
-         return;
+         return hash;
+      }
+
+      // Gives the setting of the entry at position. Returns false for text.
+      bool SequenceImpl::settingKey(unsigned int position,
+                                    const char*& name,
+                                    unsigned int& listIndex)
+      {
+         seq_item& item = the_list[position];
+         const Property* p = item.getProp();
+         if (p == 0)
+         {
+            return false;
+         }
+         name = p->getName();
+         listIndex = p->isMany() ? item.getIndex() : 0;
+         return true;
+      }
+
+      // Returns the link to the entry for a setting, which is negative if
+      // there is none.
+      int* SequenceImpl::lookupSetting(const char* name, unsigned int listIndex)
+      {
+         static int none = -1;
+         if (settingBuckets.empty())
+         {
+            return &none;
+         }
+         unsigned int hash = hashSetting(name, listIndex);
+         int* link = &settingBuckets[hash & (settingBuckets.size() - 1)];
+         while (*link >= 0)
+         {
+            const SettingEntry& e = settingEntries[*link];
+            if (e.hash == hash && e.listIndex == listIndex
+                && (e.name == name || !strcmp(e.name, name)))
+            {
+               break;
+            }
+            link = &settingEntries[*link].next;
+         }
+         return link;
+      }
+
+      // Doubles the bucket table and chains the live entries again. Free
+      // entries keep their place on the free list.
+      void SequenceImpl::growSettings()
+      {
+         settingBuckets.assign(settingBuckets.empty() ? 16 : settingBuckets.size() * 2, -1);
+         for (unsigned int i = 0; i < settingEntries.size(); i++)
+         {
+            SettingEntry& e = settingEntries[i];
+            if (e.name != 0)
+            {
+               int& bucket = settingBuckets[e.hash & (settingBuckets.size() - 1)];
+               e.next = bucket;
+               bucket = i;
+            }
+         }
+      }
+
+      // Counts an entry at position for a setting. Positions at or after it
+      // have already been moved up.
+      void SequenceImpl::addSetting(const char* name,
+                                    unsigned int listIndex,
+                                    unsigned int position)
+      {
+         int* link = lookupSetting(name, listIndex);
+         if (*link >= 0)
+         {
+            SettingEntry& e = settingEntries[*link];
+            e.count++;
+            if (position < e.position)
+            {
+               e.position = position;
+            }
+            return;
+         }
+
+         if (liveSettings >= settingBuckets.size())
+         {
+            growSettings();
+         }
+
+         unsigned int hash = hashSetting(name, listIndex);
+         int entry;
+         if (freeSettings >= 0)
+         {
+            entry = freeSettings;
+            freeSettings = settingEntries[entry].next;
+            settingEntries[entry] = SettingEntry(name, listIndex, hash, position);
+         }
+         else
+         {
+            entry = settingEntries.size();
+            settingEntries.push_back(SettingEntry(name, listIndex, hash, position));
+         }
+         int& bucket = settingBuckets[hash & (settingBuckets.size() - 1)];
+         settingEntries[entry].next = bucket;
+         bucket = entry;
+         liveSettings++;
+      }
+
+      // Uncounts the entry at position for a setting, before it is taken out
+      // of the list. If it was the first, the next entry takes its place.
+      void SequenceImpl::removeSetting(const char* name,
+                                       unsigned int listIndex,
+                                       unsigned int position)
+      {
+         int* link = lookupSetting(name, listIndex);
+         if (*link < 0)
+         {
+            return;
+         }
+         int entry = *link;
+         SettingEntry& e = settingEntries[entry];
+         if (--e.count == 0)
+         {
+            *link = e.next;
+            e.name = 0;
+            e.next = freeSettings;
+            freeSettings = entry;
+            liveSettings--;
+            return;
+         }
+         if (e.position != position)
+         {
+            return;
+         }
+         for (unsigned int j = position + 1; j < the_list.size(); j++)
+         {
+            const char* n;
+            unsigned int i;
+            if (settingKey(j, n, i)
+                && (listIndex == ANY_INDEX || i == listIndex)
+                && (n == name || !strcmp(n, name)))
+            {
+               e.position = j;
+               return;
+            }
+         }
+      }
+
+      // Moves the positions at or after from by one place
+      void SequenceImpl::shiftSettings(unsigned int from, int by)
+      {
+         for (unsigned int i = 0; i < settingEntries.size(); i++)
+         {
+            SettingEntry& e = settingEntries[i];
+            if (e.name != 0 && e.position >= from)
+            {
+               e.position += by;
+            }
+         }
+      }
+
+      // Records the entry just inserted at position. Appends leave the
+      // other positions alone.
+      void SequenceImpl::indexInserted(unsigned int position)
+      {
+         if (position + 1 < the_list.size())
+         {
+            shiftSettings(position, 1);
+         }
+         const char* name;
+         unsigned int listIndex;
+         if (settingKey(position, name, listIndex))
+         {
+            addSetting(name, listIndex, position);
+            addSetting(name, ANY_INDEX, position);
+         }
+      }
+
+      // Forgets the entry at position, which is about to be taken out.
+      void SequenceImpl::indexRemoved(unsigned int position)
+      {
+         const char* name;
+         unsigned int listIndex;
+         if (settingKey(position, name, listIndex))
+         {
+            removeSetting(name, listIndex, position);
+            removeSetting(name, ANY_INDEX, position);
+         }
+         if (position + 1 < the_list.size())
+         {
+            shiftSettings(position + 1, -1);
+         }
+      }
+
+      void SequenceImpl::buildSettingIndex()
+      {
+         settingEntries.clear();
+         settingBuckets.clear();
+         freeSettings = -1;
+         liveSettings = 0;
+         for (unsigned int j = 0; j < the_list.size(); j++)
+         {
+            const char* name;
+            unsigned int listIndex;
+            if (settingKey(j, name, listIndex))
+            {
+               addSetting(name, listIndex, j);
+               addSetting(name, ANY_INDEX, j);
+            }
+         }
+      }
+
+      // Find the position of the first entry for a setting. Single valued
+      // properties match whatever their list index.
+      bool SequenceImpl::findSetting(const char* propName,
+                                     bool isMany,
+                                     unsigned int pindex,
+                                     unsigned int& position)
+      {
+         int entry = *lookupSetting(propName, isMany ? pindex : ANY_INDEX);
+         if (entry < 0)
+         {
+            return false;
+         }
+         position = settingEntries[entry].position;
+         return true;
       }
       
       // Return the data object associated with this sequence
@@ -184,30 +487,19 @@ namespace commonj
 
       unsigned int SequenceImpl::getIndex(const char* propName, unsigned int pindex)
       {
-         SEQUENCE_ITEM_LIST::iterator i;
-         unsigned int j = 0;
-         for (i = the_list.begin(), j = 0; i != the_list.end(); ++i, ++j)
-         {
-            const Property* p = (*i).getProp();
-            if (p == 0)
-            {
-               continue; // avoid text
-            }
+         unsigned int position;
 
-            if (!strcmp(p->getName(), propName))
-            {
-               if (p->isMany())
-               {
-                  if (pindex == (*i).getIndex())
-                  {
-                     return j;
-                  }
-               }
-               else
-               {
-                  return j;
-               }
-            }
+         // A many valued setting is found by its list index, so try that
+         // first, then any entry for a single valued property.
+         if (findSetting(propName, true, pindex, position)
+             && the_list[position].getProp()->isMany())
+         {
+            return position;
+         }
+         if (findSetting(propName, false, pindex, position)
+             && !the_list[position].getProp()->isMany())
+         {
+            return position;
          }
          SDO_THROW_EXCEPTION("getIndex",
                              SDOIndexOutOfRangeException,
@@ -446,22 +738,14 @@ bool SequenceImpl::addDataObject(const Property& p, RefCountingPointer<DataObjec
       return true;
    }
 
-   SEQUENCE_ITEM_LIST::iterator i;
+   unsigned int position;
 
-   // Scan the sequence to check that this property has not been set already.
-   for (i= the_list.begin(); i != the_list.end(); ++i)
+   // Check that this property has not been set already.
+   if (findSetting(p.getName(), false, 0, position))
    {
-      const Property* pp = (*i).getProp();
-      if (pp == 0)
-      {
-         continue;              // This item is a free text entry.
-      }
-      if (!strcmp(pp->getName(), p.getName()))
-      {
-         SDO_THROW_EXCEPTION("add",
-                             SDOUnsupportedOperationException,
-                             "Sequence::add of property which already exists in sequence");
-      }
+      SDO_THROW_EXCEPTION("add",
+                          SDOUnsupportedOperationException,
+                          "Sequence::add of property which already exists in sequence");
    }
 
    the_do->setDataObject(p, v, true);
@@ -496,8 +780,7 @@ bool SequenceImpl::addDataObject(unsigned int index, unsigned int propertyIndex,
 bool SequenceImpl::addDataObject(unsigned int index, const Property& p, RefCountingPointer<DataObject> v)
 {
    SEQUENCE_ITEM_LIST::iterator i;
-   SEQUENCE_ITEM_LIST::iterator i2 = the_list.end();
-   unsigned int j = 0;
+   unsigned int position;
 
    if (index >= the_list.size())
    {
@@ -514,35 +797,24 @@ bool SequenceImpl::addDataObject(unsigned int index, const Property& p, RefCount
       return true;
    }
 
-   for (i = the_list.begin(); i != the_list.end(); ++i)
+   if (findSetting(p.getName(), false, 0, position))
    {
-      const Property* pp = (*i).getProp();
-      if (pp == 0)
-      {
-         continue;              // This item is a free text entry.
-      }
-      if (!strcmp(pp->getName(), p.getName()))
-      {
-         SDO_THROW_EXCEPTION("Insert",
-                             SDOUnsupportedOperationException,
-                             "Sequence::insert of property which already exists in sequence");
-      }
-      if (j == index)
-      {
-         i2 = i;
-      }
-      j++;
+      SDO_THROW_EXCEPTION("Insert",
+                          SDOUnsupportedOperationException,
+                          "Sequence::insert of property which already exists in sequence");
    }
    // setDataObject can update the sequence but does not do so by an append
    // so tell it to mind its own business and we will update the sequence here.
    the_do->setDataObject(p, v, false);
-   the_list.insert(i2, seq_item(&p, 0));
+   the_list.insert(the_list.begin() + index, seq_item(&p, 0));
+   indexInserted(index);
    return true;
 }
 
     void SequenceImpl::push(const Property& p, unsigned int index)
     {
         the_list.push_back(seq_item(&p,index));
+        indexInserted(the_list.size() - 1);
     }
 
     void SequenceImpl::remove(unsigned int index)
@@ -557,36 +829,41 @@ bool SequenceImpl::addDataObject(unsigned int index, const Property& p, RefCount
 
         checkRange(index, i);
 
+        indexRemoved(index);
         the_list.erase(i);
         return;
     }
 
     void SequenceImpl::removeAll(const Property& p)
     {
-        int j = 0;
-        const Property* prop;
+        unsigned int position;
+
+        // Most settings are not in the sequence yet, as when a document
+        // is loaded, so look before disturbing the entries.
+        if (!findSetting(p.getName(), false, 0, position))
+        {
+            return;
+        }
+
+        // Close up the remaining entries in a single pass.
         SEQUENCE_ITEM_LIST::iterator i = the_list.begin();
+        SEQUENCE_ITEM_LIST::iterator kept = i;
 
-        while (i != the_list.end())
+        for (; i != the_list.end(); ++i)
         {
-           prop = (*i).getProp();
-           if (prop != 0)
+           const Property* prop = (*i).getProp();
+           if (prop != 0 && !strcmp(prop->getName(), p.getName()))
            {
-              if (!strcmp(prop->getName(), p.getName()))
-              {
-                 i = the_list.erase(i);
-              }
-              else
-              {
-                 ++i;
-              }
+              continue;
            }
-           else
+           if (kept != i)
            {
-              ++i;
+              *kept = *i;
            }
-
+           ++kept;
         }
+        the_list.erase(kept, the_list.end());
+        buildSettingIndex();
     
         return;
     }
@@ -602,35 +879,19 @@ bool SequenceImpl::addDataObject(unsigned int index, const Property& p, RefCount
 
         if (toIndex == fromIndex) return;
 
-        SEQUENCE_ITEM_LIST::iterator i1,
-                            i2 = the_list.end(), 
-                            i3 = the_list.end();
-        unsigned int j = 0;
-        for (i3 = the_list.begin(); 
-             j < toIndex && j < fromIndex && 
-                 i3 != the_list.end() ; ++i3);
-        {
-            if (j == toIndex)   i1 = i3;
-            if (j == fromIndex) i2 = i3;
-            j++;
-        }
+        seq_item item(the_list[fromIndex]);
+        indexRemoved(fromIndex);
+        the_list.erase(the_list.begin() + fromIndex);
 
-        if (toIndex < fromIndex) 
+        if (toIndex >= the_list.size()) 
         {
-            the_list.insert( i1, *i2);
-            the_list.erase(i2);
+            the_list.push_back(item);
+            indexInserted(the_list.size() - 1);
         }
-        else 
+        else
         {
-            if (toIndex + 1 == the_list.size()) 
-            {
-                the_list.push_back(*i2);
-            }
-            else
-            {
-                the_list.insert(++i1,*i2);
-            }
-            the_list.erase(i2);
+            the_list.insert(the_list.begin() + toIndex, item);
+            indexInserted(toIndex);
         }
         return;
     }
@@ -669,6 +930,7 @@ bool SequenceImpl::addDataObject(unsigned int index, const Property& p, RefCount
         checkRange(index, i);
 
         the_list.insert(i,seq_item(text));
+        indexInserted(index);
         return true;
     }
 
@@ -1015,21 +1277,13 @@ bool SequenceImpl::addSDOValue(const Property& p, const SDOValue& sval)
       /* the_list.push_back(seq_item(&p,dol.size()-1));*/
       return true;
    }
-//   std::cout << "Incoming property: " << p.getName() << std::endl << std::endl;
-   SEQUENCE_ITEM_LIST::iterator i;
-   for (i = the_list.begin(); i != the_list.end(); ++i)
+   unsigned int position;
+   if (findSetting(p.getName(), false, 0, position))
    {
-      const Property* pp = (*i).getProp();
-      if (pp == 0) continue;
-//      std::cout << pp->getName() << std::endl;
-      if (!strcmp(pp->getName(), p.getName()))
-      {
-         SDO_THROW_EXCEPTION("add",
-                             SDOUnsupportedOperationException,
-                             "Sequence::add of property which already exists in sequence");
-      }
+      SDO_THROW_EXCEPTION("add",
+                          SDOUnsupportedOperationException,
+                          "Sequence::add of property which already exists in sequence");
    }
-//   std::cout << std::endl;
    the_do->setSDOValue(p, sval, sval.convertTypeEnumToString(), true);
    // the_list.push_back(seq_item(&p, 0));
    return true;
@@ -1222,8 +1476,7 @@ bool SequenceImpl::addBytes(const Property& p, const char* v, unsigned int len)
     bool SequenceImpl::addSDOValue(unsigned int index, const Property& p, const SDOValue& sval)
     {
         SEQUENCE_ITEM_LIST::iterator i;
-        SEQUENCE_ITEM_LIST::iterator i2 = the_list.end();
-        unsigned int j = 0;
+        unsigned int position;
         if (index >= the_list.size()) {
             return addSDOValue(p, sval);
         }
@@ -1238,26 +1491,18 @@ bool SequenceImpl::addBytes(const Property& p, const char* v, unsigned int len)
             return true;
         }
 
-        for (i = the_list.begin(); i != the_list.end(); ++i)
+        if (findSetting(p.getName(), false, 0, position))
         {
-            const Property* pp = (*i).getProp();
-            if (pp == 0) continue;
-            if (!strcmp(pp->getName(), p.getName()))
-            {
-               SDO_THROW_EXCEPTION("Insert",
-                                   SDOUnsupportedOperationException,
-                                   "Sequence::insert of property which already exists in sequence");
-            }
-            if (j == index) {
-                i2 = i;
-            }
-            j++;
+           SDO_THROW_EXCEPTION("Insert",
+                               SDOUnsupportedOperationException,
+                               "Sequence::insert of property which already exists in sequence");
         }
 
         // setSDOValue can update the sequence but does not do so by an append so
         // tell it to mind its own business and we will update the sequence here.
         the_do->setSDOValue(p, sval, sval.convertTypeEnumToString(), false);
-        the_list.insert(i2, seq_item(&p, 0));
+        the_list.insert(the_list.begin() + index, seq_item(&p, 0));
+        indexInserted(index);
         return true;
     }
 
@@ -25,10 +25,12 @@
 #include "commonj/sdo/disable_warn.h"
 
 #include <vector>
+#include <string.h>
 
 
 #include "commonj/sdo/Sequence.h"
 #include "commonj/sdo/SDODate.h"
+#include "commonj/sdo/SDOArena.h"
 
 #define SequenceImplPtr RefCountingPointer<SequenceImpl> 
 
@@ -37,6 +39,7 @@ namespace sdo{
 
 class Property; /* forward declaration */
 class DataObjectImpl;
+class ClonedObjects;
 
 /**  SequenceImpl implements the abstract class Sequence.
  *
@@ -48,6 +51,10 @@ class DataObjectImpl;
 class SequenceImpl : public Sequence 
 {
     public:
+
+    // Allocated from the current SDOArena, if any
+    SDO_ARENA_ALLOCATED
+
     ///////////////////////////////////////////////////////////////////////////
     // Returns the number of entries in the sequence.
     // @return the number of entries.
@@ -299,6 +306,13 @@ class SequenceImpl : public Sequence
     ///////////////////////////////////////////////////////////////////////////
     virtual bool isText(unsigned int index);
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Copies the entries of from, the sequence of the object this one's
+    // data object was cloned from. Entries for references which were not
+    // copied are left out.
+    ///////////////////////////////////////////////////////////////////////////
+    void cloneEntries(SequenceImpl* from, const ClonedObjects& copies);
+
     SequenceImpl(DataObject* the_do);
     SequenceImpl(SequenceImpl* s);
   
@@ -316,13 +330,13 @@ class SequenceImpl : public Sequence
           {
           }
           seq_item(const char* t) :
-             the_prop(0)
+             the_prop(0), index(0)
           {
              freeText = new SDOValue(t);
           }
           // Copy constructor
           seq_item(const seq_item& sin) :
-             index(sin.index), freeText(0), the_prop(sin.the_prop)
+             the_prop(sin.the_prop), index(sin.index), freeText(0)
           {
              if (sin.freeText != 0)
              {
@@ -331,22 +345,23 @@ class SequenceImpl : public Sequence
           }
 
           // Copy assignment
-             seq_item& operator=(const seq_item& sin)
+          seq_item& operator=(const seq_item& sin)
+          {
+             if (this != &sin)
              {
-                 if (this != &sin)
-                 {
-                     if (freeText)
-                     {
-                         delete freeText;
-                     }
-                     if (sin.freeText != 0)
-                     {
-                         freeText = new SDOValue(*sin.freeText);
-                     }
-                 }
-                 return *this;
+                SDOValue* text = 0;
+                if (sin.freeText != 0)
+                {
+                   text = new SDOValue(*sin.freeText);
+                }
+                delete freeText;
+                freeText = text;
+                the_prop = sin.the_prop;
+                index = sin.index;
              }
-            
+             return *this;
+          }
+
           // Destructor
           ~seq_item()
           {
@@ -393,11 +408,53 @@ class SequenceImpl : public Sequence
        SDOValue* freeText;
     };
 
-    typedef std::list<seq_item> SEQUENCE_ITEM_LIST;
+    // Entries are held contiguously so that positional access is constant
+    // time.
+    typedef std::vector<seq_item, SDOArenaAllocator<seq_item> > SEQUENCE_ITEM_LIST;
     virtual void checkRange(unsigned int index, SEQUENCE_ITEM_LIST::iterator& i);
 
     SEQUENCE_ITEM_LIST the_list;
 
+    // The position of the first entry for each setting, keyed by property
+    // name and list index, and of the first entry for each property, keyed
+    // by name alone, so that getIndex is a hash lookup. Entries are chained
+    // from a power of two bucket table and removed entries are reused.
+    // Inserting, removing and moving entries update the positions in place.
+    struct SettingEntry
+    {
+        SettingEntry(const char* n, unsigned int i, unsigned int h, unsigned int p)
+            : name(n), listIndex(i), hash(h), position(p), count(1), next(-1)
+        {
+        }
+        const char* name;       // 0 for a free entry
+        unsigned int listIndex; // ~0 for the entry of the property
+        unsigned int hash;
+        unsigned int position;
+        unsigned int count;     // the number of entries in the sequence
+        int next;               // the next entry in the bucket, or free
+    };
+
+    std::vector<SettingEntry> settingEntries;
+    std::vector<int> settingBuckets;
+    int freeSettings;
+    unsigned int liveSettings;
+
+    static unsigned int hashSetting(const char* name, unsigned int listIndex);
+    bool settingKey(unsigned int position, const char*& name, unsigned int& listIndex);
+    int* lookupSetting(const char* name, unsigned int listIndex);
+    void addSetting(const char* name, unsigned int listIndex, unsigned int position);
+    void removeSetting(const char* name, unsigned int listIndex, unsigned int position);
+    void growSettings();
+    void shiftSettings(unsigned int from, int by);
+
+    void indexInserted(unsigned int position);
+    void indexRemoved(unsigned int position);
+    void buildSettingIndex();
+    bool findSetting(const char* propName,
+                     bool isMany,
+                     unsigned int pindex,
+                     unsigned int& position);
+
 };
 };
 };
@@ -25,136 +25,68 @@
 namespace commonj{ 
 namespace sdo {
     
-    Setting::Setting(bool set, bool nul, void* invalue, unsigned int len, const Property& p, unsigned int inindex)
-        : bisSet(set), bisNull(nul) , value(invalue),theProp(&p)
+    Setting::Setting(bool set, bool nul, const SDOValue& invalue, const Property& p, unsigned int inindex)
+        : bisSet(set), bisNull(nul), value(invalue), dataObject(0), theProp(&p)
     {
         index = inindex;
-        length  = len;
-        strbuf = 0;
+        length = 0;
+        if (hasValue())
+        {
+            // The length is wanted before the value is read into a buffer,
+            // so work it out once here.
+            switch (theProp->getTypeEnum())
+            {
+                case Type::BigDecimalType: 
+                case Type::BigIntegerType: 
+                case Type::StringType: 
+                case Type::UriType:
+                    length = value.getString(0, 0);
+                    break;
+                case Type::BytesType:
+                    length = value.getBytes(0, 0);
+                    break;
+                default:
+                    break;
+            }
+        }
     }
 
-    void Setting::copy(const Setting& s)
+    Setting::Setting(bool set, bool nul, DataObject* indob, const Property& p, unsigned int inindex)
+        : bisSet(set), bisNull(nul), dataObject(indob), theProp(&p)
     {
-        bisSet = s.isSet();
-        bisNull = s.isNull();
-        index = s.getIndex();
-        length = s.getLength();
-        theProp = &(s.getProperty());
-        strbuf = 0;
-        switch (theProp->getTypeEnum())
-        {
-            case Type::BooleanType:
-                value = new long;
-                *(long*)value = (long)s.getBooleanValue();
-                break;
-            case Type::ByteType:
-                value = new long;
-                *(long*)value = (long)s.getByteValue();
-                break;
-            case Type::CharacterType:
-                value = new long;
-                *(long*)value = (long)s.getCharacterValue();
-                break;
-            case Type::IntegerType: 
-                value = new long;
-                *(long*)value = (long)s.getIntegerValue();
-                break;
-            case Type::ShortType:
-                value = new long;
-                *(long*)value = (long)s.getShortValue();
-                break;
-            case Type::DoubleType:
-                value = new long double;
-                *(long double*)value = s.getDoubleValue();
-                break;
-            case Type::FloatType:
-                value = new float;
-                *(float*)value = s.getFloatValue();
-                break;
-            case Type::LongType:
-                value = new int64_t;
-                *(int64_t*)value = s.getLongValue();
-                break;
-            case Type::DateType:
-                value = new long;
-                *(long*)value = long(s.getDateValue().getTime());
-                break;
-            case Type::BigDecimalType: 
-            case Type::BigIntegerType: 
-            case Type::StringType: 
-            case Type::UriType:
-                value = new wchar_t[length];
-                s.getStringValue((wchar_t*)value,length);
-                break;
-            case Type::BytesType:
-                value = new char[length];
-                s.getBytesValue((char*)value,length);
-                break;
-            case Type::OtherTypes:
-            case Type::DataObjectType:
-            case Type::ChangeSummaryType:
-                value = s.getDataObjectValue();
-            default:
-                break;
-        }
+        index = inindex;
+        length = 0;
     }
 
     Setting& Setting::operator=(const Setting& s)
     {
         if (this == &s) return *this;
-        copy(s);
+        bisSet = s.bisSet;
+        bisNull = s.bisNull;
+        value = s.value;
+        dataObject = s.dataObject;
+        theProp = s.theProp;
+        length = s.length;
+        index = s.index;
         return *this;
     }
 
     Setting::Setting(const Setting& s)
+        : bisSet(s.bisSet), bisNull(s.bisNull), value(s.value),
+          dataObject(s.dataObject), theProp(s.theProp),
+          length(s.length), index(s.index)
     {
-        copy(s);
     }
 
     Setting::~Setting()
     {
-        // The value has been allocated for everything except data objects
+    }
 
-        switch (theProp->getTypeEnum())
-        {
-            case Type::BooleanType:
-            case Type::ByteType:
-            case Type::CharacterType:
-            case Type::IntegerType: 
-            case Type::ShortType:
-                delete (long*)value;
-                break;
-            case Type::DoubleType:
-                delete (long double*)value;
-                break;
-            case Type::FloatType:
-                delete (float*)value;
-                break;
-            case Type::LongType:
-                delete (int64_t*)value;
-                break;
-            case Type::DateType:
-                delete (long*)value;
-                break;
-            case Type::BigDecimalType: 
-            case Type::BigIntegerType: 
-            case Type::StringType: 
-            case Type::UriType:
-                delete[] (wchar_t*) value;
-                break;
-            case Type::BytesType:
-                delete[] (char*) value;
-                break;
-            case Type::OtherTypes:
-            case Type::DataObjectType:
-            case Type::ChangeSummaryType:
-            default:
-                break;
-        }
-        if (strbuf != 0)
-        {
-           delete[] strbuf;
-        }
+    // Properties which were unset or null read as zero, as they did
+    // before the value was logged.
+    bool Setting::hasValue() const
+    {
+        return value.isSet() && !value.isNull();
     }
 
     const Property& Setting::getProperty() const
@@ -167,119 +99,134 @@ namespace sdo {
       return theProp->getType();
     }
 
+    Type::Types Setting::getTypeEnum() const
+    {
+      return theProp->getTypeEnum();
+    }
+
     bool Setting::getBooleanValue() const
     {
+        if (!hasValue()) return false;
         TypeImpl* t = (TypeImpl*)&(getType());
-        return t->convertToBoolean(value, length);
-        //if (value == 0) return false;
-        //if (*(long*)value != 0) {
-        //    return true;
-        //}
-        //return false;
+        return t->convertToBoolean(value);
     }
 
     char Setting::getByteValue() const
     {
+        if (!hasValue()) return 0;
         TypeImpl* t = (TypeImpl*)&(getType());
-        return t->convertToByte(value, length);
-        //if (value == 0) return 0;
-        //return (char)*(long*)value;
+        return t->convertToByte(value);
     }
 
     wchar_t Setting::getCharacterValue() const
     {
+        if (!hasValue()) return 0;
         TypeImpl* t = (TypeImpl*)&(getType());
-        return t->convertToCharacter(value, length);
-        //if (value == 0) return 0;
-        //return (wchar_t)*(long*)value;
+        return t->convertToCharacter(value);
     }
     
     unsigned int Setting::getBytesValue(char* buffer, unsigned int max) const
     {
         if (buffer == 0 && max == 0) return length;
+        if (!hasValue()) return 0;
 
         TypeImpl* t = (TypeImpl*)&(getType());
-        return t->convertToBytes(value, buffer,length, max);
-        //int i;
-        //char* c = (char*)value;
-        //for (i=0;i < max && i < length;i++)
-        //{
-        //    buffer[i] = (char)*c;
-        //    c++;
-        //}
-        //return i;
+        return t->convertToBytes(value, buffer, max);
     }
     
     unsigned int Setting::getStringValue(wchar_t* buffer, unsigned int max) const
     {
         if (buffer == 0 && max == 0) return length;
+        if (!hasValue()) return 0;
 
         TypeImpl* t = (TypeImpl*)&(getType());
-        return t->convertToString(value, buffer,length, max);
-        //int i;
-        //wchar_t* c = (wchar_t*)value;
-        //for (i=0;i < max && i < length;i++)
-        //{
-        //    buffer[i] = (wchar_t)*c;
-        //    c++;
-        //}
-        //return i;
+        return t->convertToString(value, buffer, max);
     }
 
     short Setting::getShortValue() const
     {
+        if (!hasValue()) return 0;
         TypeImpl* t = (TypeImpl*)&(getType());
-        return t->convertToShort(value,length);
-        //return (short)*(long*)value;
+        return t->convertToShort(value);
     }
 
     long Setting::getIntegerValue() const
     {
+        if (!hasValue()) return 0;
         TypeImpl* t = (TypeImpl*)&(getType());
-        return t->convertToInteger(value, length);
-        //return *(long*)value;
+        return t->convertToInteger(value);
     }
 
 
     int64_t Setting::getLongValue() const
     {
+        if (!hasValue()) return 0;
         TypeImpl* t = (TypeImpl*)&(getType());
-        return t->convertToLong(value, length);
-        //return (int64_t)*(int64_t*)value;
+        return t->convertToLong(value);
     }
 
     float Setting::getFloatValue() const
     {
+        if (!hasValue()) return 0;
         TypeImpl* t = (TypeImpl*)&(getType());
-        return t->convertToFloat(value, length);
-        //return (float)*(float*)value;
+        return t->convertToFloat(value);
     }
 
     const SDODate Setting::getDateValue() const
     {
+        if (!hasValue()) return SDODate(0);
         TypeImpl* t = (TypeImpl*)&(getType());
-        return t->convertToDate(value, length);
+        return t->convertToDate(value);
     }
 
 
     long double Setting::getDoubleValue() const
     {
+        if (!hasValue()) return 0;
         TypeImpl* t = (TypeImpl*)&(getType());
-        return t->convertToDouble(value, length);
-        //return (long double)*(long double*)value;
+        return t->convertToDouble(value);
     }
 
     const char* Setting::getCStringValue()
     {
+        if (!hasValue())
+        {
+            // As for an empty value of the property's own type
+            switch (theProp->getTypeEnum())
+            {
+                case Type::BooleanType:
+                    return "false";
+                case Type::ByteType:
+                case Type::CharacterType:
+                case Type::IntegerType: 
+                case Type::ShortType:
+                case Type::LongType:
+                case Type::DoubleType:
+                case Type::FloatType:
+                case Type::DateType:
+                    return "0";
+                case Type::BigDecimalType: 
+                case Type::BigIntegerType: 
+                case Type::StringType: 
+                case Type::UriType:
+                case Type::BytesType:
+                    return "";
+                default:
+                    break;
+            }
+        }
         TypeImpl* t = (TypeImpl*)&(getType());
-        return t->convertToCString(value, &strbuf, length);
-        //return (const char*)value;
+        return t->convertToCString(value);
     }
 
     RefCountingPointer<DataObject> Setting::getDataObjectValue() const
     {
-        DataObject *dob = (DataObject*)value;
-        return RefCountingPointer<DataObject>(dob);
+        return RefCountingPointer<DataObject>(dataObject);
+    }
+
+    const SDOValue& Setting::getSDOValue() const
+    {
+        return value;
     }
 
 
@@ -305,4 +252,3 @@ namespace sdo {
 
 };
 };
-
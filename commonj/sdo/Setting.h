@@ -27,6 +27,7 @@
 #include "commonj/sdo/Type.h"
 #include "commonj/sdo/DataObject.h"
 #include "commonj/sdo/SDODate.h"
+#include "commonj/sdo/SDOValue.h"
 
 namespace commonj{
 namespace sdo {
@@ -36,18 +37,22 @@ namespace sdo {
      /**  
      * A Setting encapsulates a property and a corresponding single value of 
      * the property's type.
+     * The value is held in the setting itself, as it was stored in the
+     * data object, so that logging a change to a primitive property
+     * allocates nothing.
       */
 
     class Setting
     {
           public:
 
-        Setting(bool set, bool nul, void* invalue, unsigned int len, const Property& p, 
+        Setting(bool set, bool nul, const SDOValue& invalue, const Property& p, 
             unsigned int inindex);
 
-        Setting(const Setting& s);
+        Setting(bool set, bool nul, DataObject* indob, const Property& p, 
+            unsigned int inindex);
 
-        void copy(const Setting& s);
+        Setting(const Setting& s);
 
         Setting& operator=(const Setting& s);
 
@@ -100,6 +105,14 @@ namespace sdo {
         SDO_API const char* getCStringValue() ;
         SDO_API DataObjectPtr getDataObjectValue() const;
 
+        /**  getSDOValue returns the value held, without conversion
+         *
+         * The value is unset for data object properties, and for
+         * properties which were not set.
+          */
+
+        SDO_API const SDOValue& getSDOValue() const;
+
 
 
          /**  getIndex returns the index in a many-valued property
@@ -137,13 +150,15 @@ namespace sdo {
 
         private:
 
+            bool hasValue() const;
+
             bool bisSet;
             bool bisNull;
-            void* value;
+            SDOValue value;
+            DataObject* dataObject;
             const Property* theProp;
             unsigned int length;
             unsigned int index;
-            char* strbuf;
     };
 };
 };
@@ -46,26 +46,19 @@ SettingList::SettingList()
 
 SettingList::~SettingList()
 {
-    while (slist.size() > 0)
-    {
-        Setting* s = slist[0];
-        slist.erase(slist.begin());
-        delete s;
-    }
-
 }
 
 
 Setting& SettingList::operator[] (int pos) const
 {    
     validateIndex(pos);
-    return (*slist[pos]);
+    return const_cast<Setting&>(slist[pos]);
 }
 
 Setting* SettingList::get(int pos) 
 {    
     validateIndex(pos);
-    return (slist[pos]);
+    return &(slist[pos]);
 }
 
 int SettingList::size () const
@@ -78,12 +71,12 @@ int SettingList::size () const
 //    return slist;
 //}
 
-void SettingList::insert (unsigned int index,  Setting* d)
+void SettingList::insert (unsigned int index, const Setting& d)
 {
     slist.insert(slist.begin()+index, d);
 }
 
-void SettingList::append ( Setting* d)
+void SettingList::append (const Setting& d)
 {
     slist.push_back(d);
 }
@@ -91,15 +84,13 @@ void SettingList::append ( Setting* d)
 void SettingList::remove(unsigned int index)
 {
     validateIndex(index);
-    const Setting* s = slist[index];
     slist.erase(slist.begin()+index);
-    delete s;
     return;
 }
 
 void SettingList::validateIndex(int index) const
 {
-    if ((index < 0) || (index > size()))
+    if ((index < 0) || (index >= size()))
     {
         std::string msg("Index out of range:");
         msg += index;
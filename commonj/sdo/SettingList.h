@@ -24,13 +24,16 @@
 
 
 
-#include <vector>
+#include <deque>
 #include "commonj/sdo/Setting.h"
 
 namespace commonj{
 namespace sdo{
 
-typedef std::vector< Setting*> SETTING_VECTOR;
+// Settings are held by value. A deque keeps them in blocks without
+// moving those already appended, so references handed out by operator[]
+// stay good while more changes are logged.
+typedef std::deque<Setting> SETTING_VECTOR;
 
 /**  SettingList is a list of settings returned by a change summary
  */
@@ -59,8 +62,8 @@ public:
 
     SDO_API virtual int size () const;
     
-    virtual void insert (unsigned int index,  Setting* d);
-    virtual void append ( Setting* d);
+    virtual void insert (unsigned int index, const Setting& d);
+    virtual void append (const Setting& d);
     virtual void remove (unsigned int index);
     virtual Setting* get (int pos);
 
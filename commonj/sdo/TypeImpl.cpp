@@ -24,6 +24,7 @@
 #include "commonj/sdo/PropertyImpl.h"
 #include "commonj/sdo/SDODataConverter.h"
 #include "commonj/sdo/TypeImpl.h"
+#include "commonj/sdo/SDOStats.h"
 
 #include <iostream>
 #include <wchar.h>
@@ -105,6 +106,7 @@ namespace sdo{
     {
         isResolving = false;
         isResolved = false;
+        frozen = false;
         brestriction = t.brestriction;
         bFromList = t.bFromList;
     }
@@ -145,6 +147,7 @@ namespace sdo{
      {
         isResolving = false;
         isResolved = false;
+        frozen = false;
         localPropsSize = 0;
         changeSummaryType = false;
         isSequenced = isSeq;
@@ -188,6 +191,9 @@ namespace sdo{
     ///////////////////////////////////////////////////////////////////////////
     TypeImpl::TypeImpl()
     {
+        isResolving = false;
+        isResolved = false;
+        frozen = false;
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -248,6 +254,90 @@ namespace sdo{
             && (this == type || isBaseTypeOf(type->getBaseType())); 
     } 
 
+    bool TypeImpl::isDerivedFrom(const Type& t) const
+    {
+        if (equals(t)) return true;
+
+        if (frozen)
+        {
+            for (unsigned int i = 0; i < baseTypes.size(); i++)
+            {
+                if (baseTypes[i]->equals(t)) return true;
+            }
+            return false;
+        }
+
+        for (const TypeImpl* ti = baseType; ti != 0; ti = ti->baseType)
+        {
+            if (ti->equals(t)) return true;
+        }
+        return false;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Builds the compact lookup tables. The properties of base types are
+    // already merged into props and propArray by initCompoundProperties.
+    ///////////////////////////////////////////////////////////////////////////
+
+    void TypeImpl::freeze()
+    {
+        if (frozen) return;
+
+        // The first property to use a name wins, as in the list scans
+        for (unsigned int i = 0; i < propArray.size(); i++)
+        {
+            const PropertyImpl* p = propArray[i];
+            propNames.insert(PROPERTY_INDEX::value_type(p->getName(), i));
+            for (unsigned int k = 0; k < p->getAliasCount(); k++)
+            {
+                propAliases.insert(PROPERTY_INDEX::value_type(p->getAlias(k), i));
+            }
+            for (unsigned int j = 0; j < p->getSubstitutionCount(); j++)
+            {
+                propSubstitutes.insert(PROPERTY_INDEX::value_type(p->getSubstitutionName(j), i));
+            }
+        }
+
+        for (const TypeImpl* ti = baseType; ti != 0; ti = ti->baseType)
+        {
+            baseTypes.push_back(ti);
+        }
+
+        frozen = true;
+    }
+
+    bool TypeImpl::isFrozen() const
+    {
+        return frozen;
+    }
+
+    PropertyImpl* TypeImpl::findFrozenProperty(const SDOString& propertyName,
+                                               bool substitutes) const
+    {
+        PropertyImpl* pi = 0;
+
+        PROPERTY_INDEX::const_iterator i = propNames.find(propertyName);
+        if (i != propNames.end())
+        {
+            pi = propArray[i->second];
+        }
+        else if (substitutes &&
+                 (i = propSubstitutes.find(propertyName)) != propSubstitutes.end())
+        {
+            pi = propArray[i->second];
+        }
+        else if ((i = propAliases.find(propertyName)) != propAliases.end())
+        {
+            pi = propArray[i->second];
+        }
+
+        if (pi != 0)
+        {
+            SDOStats::add(SDOStats::PropertyIndexHits);
+        }
+        return pi;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // Sets a data type as open.
     ///////////////////////////////////////////////////////////////////////////
@@ -317,6 +407,14 @@ namespace sdo{
         return baseType;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // Indicates whether the type restricts rather than extends its base.
+    ///////////////////////////////////////////////////////////////////////////
+    bool TypeImpl::isRestrictionType() const
+    {
+        return brestriction;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // Returns the name of the type.
     ///////////////////////////////////////////////////////////////////////////
@@ -463,6 +561,16 @@ namespace sdo{
             SDOUnsupportedOperationException, 
             msg.c_str());
         }
+
+        // The properties cannot change once resolved, so each local
+        // property can record its position, and lookups by index need
+        // not walk the list.
+        propArray.assign(props.begin(), props.end());
+        for (unsigned int i = propArray.size() - localPropsSize;
+             i < propArray.size(); i++)
+        {
+            propArray[i]->setIndex(i);
+        }
         isResolved  = true;
         isResolving = false;
         return;
@@ -484,6 +592,10 @@ namespace sdo{
 
     unsigned int TypeImpl::getPropertiesSize() const
     {
+        if (isResolved)
+        {
+            return propArray.size();
+        }
         return props.size();
     }
 
@@ -535,6 +647,30 @@ namespace sdo{
     
     const TypeImpl* TypeImpl::getRealPropertyTypeImpl(const std::string& propertyName) const
     {
+        if (frozen)
+        {
+            PROPERTY_INDEX::const_iterator f = propNames.find(propertyName);
+            if (f == propNames.end())
+            {
+                f = propAliases.find(propertyName);
+                if (f == propAliases.end())
+                {
+                    f = propSubstitutes.find(propertyName);
+                    if (f == propSubstitutes.end()) return 0;
+
+                    const PropertyImpl* p = propArray[f->second];
+                    for (unsigned int j = 0; j < p->getSubstitutionCount(); j++)
+                    {
+                        if (propertyName == p->getSubstitutionName(j))
+                        {
+                            return (TypeImpl*)p->getSubstitutionType(j);
+                        }
+                    }
+                    return 0;
+                }
+            }
+            return propArray[f->second]->getTypeImpl();
+        }
 
         std::list<PropertyImpl*>::const_iterator i;    
         for (i = props.begin(); i != props.end(); ++i)
@@ -572,6 +708,8 @@ namespace sdo{
         // you should not be able to have both "." and "[" before a "/" - this is assumed.
         
         if (propertyName.length() == 0) return 0;
+
+        SDOStats::add(SDOStats::PropertyLookups);
         
         // strchr returns NULL if target not found
         // find_first_of returns string::npos in that case
@@ -597,6 +735,21 @@ namespace sdo{
         {
             copy = propertyName;
         }
+
+        if (frozen)
+        {
+            PropertyImpl* pi = findFrozenProperty(copy, true);
+            if (pi != 0 && (tokenend != string::npos) && (propertyName.length() - tokenend) > 1)
+            {
+                // There is someting to the right of the "/"
+                const TypeImpl* ti = pi->getTypeImpl();
+                if (ti != 0)
+                {
+                    return ti->getPropertyImpl(SDOString(propertyName, tokenend + 1, string::npos));
+                }
+            }
+            return pi;
+        }
         
         std::list<PropertyImpl*>::const_iterator i;    
         for (i = props.begin(); i != props.end(); ++i)
@@ -681,7 +834,12 @@ namespace sdo{
     ///////////////////////////////////////////////////////////////////////////
     PropertyImpl* TypeImpl::getPropertyImplPure(const char* propertyName) const
     {
+        SDOStats::add(SDOStats::PropertyLookups);
 
+        if (frozen)
+        {
+            return findFrozenProperty(propertyName, false);
+        }
         
         std::list<PropertyImpl*>::const_iterator i;    
         for (i = props.begin(); i != props.end(); ++i)
@@ -711,15 +869,26 @@ namespace sdo{
     }
     unsigned int TypeImpl::getPropertyIndex(const SDOString& propertyName) const 
     {
-        std::list<PropertyImpl*>::const_iterator i;    
-        int j = 0;
-        for (i = props.begin(); i != props.end(); ++i)
+        if (frozen)
         {
-            if (!strcmp(propertyName.c_str(), (*i)->getName()))
+            PROPERTY_INDEX::const_iterator f = propNames.find(propertyName);
+            if (f != propNames.end())
             {
-                return j;
+                return f->second;
+            }
+        }
+        else
+        {
+            std::list<PropertyImpl*>::const_iterator i;    
+            int j = 0;
+            for (i = props.begin(); i != props.end(); ++i)
+            {
+                if (!strcmp(propertyName.c_str(), (*i)->getName()))
+                {
+                    return j;
+                }
+                j++;
             }
-            j++;
         }
         string msg("Property not found:");
         msg += propertyName;
@@ -748,6 +917,11 @@ namespace sdo{
     ///////////////////////////////////////////////////////////////////////////
     PropertyImpl* TypeImpl::getPropertyImpl(unsigned int index) const
     {
+        if (isResolved)
+        {
+            return index < propArray.size() ? propArray[index] : 0;
+        }
+
         std::list<PropertyImpl*>::const_iterator i;
         int count = 0;
         for (i = props.begin() ; i != props.end() ; ++i)
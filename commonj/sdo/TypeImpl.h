@@ -229,6 +229,7 @@ public:
     void setBaseType(const Type* tb, bool isRestriction = false);
     const Type* getBaseType() const;
     const TypeImpl* getBaseTypeImpl() const;
+    bool isRestrictionType() const;
 
 
     ///////////////////////////////////////////////////////////////////////////
@@ -265,6 +266,18 @@ public:
 
     virtual bool isFromList() const;
 
+    ///////////////////////////////////////////////////////////////////////////
+    // True if this type is t, or t is one of its base types
+    ///////////////////////////////////////////////////////////////////////////
+    bool isDerivedFrom(const Type& t) const;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Used by DataFactoryImpl::freeze to build the compact lookup tables
+    // of a resolved type. The type may not be changed afterwards.
+    ///////////////////////////////////////////////////////////////////////////
+    void freeze();
+    bool isFrozen() const;
+
 
 private:
     friend class DataFactoryImpl;
@@ -340,6 +353,22 @@ private:
     // says how many of the props are really in this data object type.
     unsigned int localPropsSize;
 
+    // The properties by index, built when the type is resolved.
+    std::vector<PropertyImpl*> propArray;
+
+    // Compact form built by freeze(): maps from property names, aliases
+    // and substitute names to an index, and the chain of base types
+    // nearest first.
+    bool frozen;
+    typedef std::map<std::string, unsigned int> PROPERTY_INDEX;
+    PROPERTY_INDEX propNames;
+    PROPERTY_INDEX propAliases;
+    PROPERTY_INDEX propSubstitutes;
+    std::vector<const TypeImpl*> baseTypes;
+
+    PropertyImpl* findFrozenProperty(const SDOString& propertyName,
+                                     bool substitutes) const;
+
 };
 
 };
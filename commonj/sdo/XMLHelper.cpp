@@ -31,6 +31,10 @@ namespace commonj
         XMLHelper::~XMLHelper()
         {
         }
+
+        void XMLHelper::setArenaAllocation(bool enable)
+        {
+        }
         
     } // End - namespace sdo
 } // End - namespace commonj
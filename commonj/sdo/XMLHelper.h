@@ -27,6 +27,11 @@
 #include "commonj/sdo/XMLDocument.h"
 #include "commonj/sdo/RefCountingObject.h"
 
+// libxml2 tree types, declared here so that users of the helper
+// need not include the libxml2 headers
+struct _xmlNode;
+struct _xmlDoc;
+
 namespace commonj
 {
     namespace sdo
@@ -74,6 +79,19 @@ namespace commonj
             SDO_API virtual XMLDocumentPtr load(
                 const SDOString& inXml,
                 const SDOString& targetNamespaceURI = "") = 0;
+
+            /**  loadNode - loads an already parsed libxml2 tree
+             *
+             * Builds the graph from an element or document node directly,
+             * without writing the tree out as text first.
+             */
+
+            SDO_API virtual XMLDocumentPtr loadNode(
+                struct _xmlNode* node,
+                const char* targetNamespaceURI=0) = 0;
+            SDO_API virtual XMLDocumentPtr loadNode(
+                struct _xmlNode* node,
+                const SDOString& targetNamespaceURI) = 0;
             
             /**  save saves the graph to XML
              *
@@ -137,6 +155,26 @@ namespace commonj
                 const SDOString& rootElementURI,
                 const SDOString& rootElementName,
                 int indent = -1) = 0;
+
+            /**  saveToDOM saves the graph to a libxml2 tree
+             *
+             * saveToDOM - Serializes the datagraph to a new libxml2 document,
+             * which the caller frees with xmlFreeDoc. The nodes are built
+             * directly from the serializer's walk, so no text is written or
+             * parsed. The indent is accepted for symmetry with save and ignored.
+             */
+
+            SDO_API virtual struct _xmlDoc* saveToDOM(XMLDocumentPtr doc, int indent = -1) = 0;
+            SDO_API virtual struct _xmlDoc* saveToDOM(
+                DataObjectPtr dataObject,
+                const char* rootElementURI,
+                const char* rootElementName,
+                int indent = -1) = 0;
+            SDO_API virtual struct _xmlDoc* saveToDOM(
+                DataObjectPtr dataObject,
+                const SDOString& rootElementURI,
+                const SDOString& rootElementName,
+                int indent = -1) = 0;
             
             /**  createDocument creates an XMLDocument
              *
@@ -176,7 +214,16 @@ namespace commonj
 
             virtual const char* getErrorMessage(unsigned int errnum) const = 0;
 
-            
+            /** setArenaAllocation selects region allocation for loads
+             *
+             * When enabled, the data objects of each loaded document are
+             * allocated from a single SDOArena and released together when
+             * the last of them dies, rather than one by one. A helper which
+             * does not support it ignores the setting.
+             */
+
+            SDO_API virtual void setArenaAllocation(bool enable);
+
         };
     } // End - namespace sdo
 } // End - namespace commonj
@@ -22,6 +22,7 @@
 #include "commonj/sdo/SDOXMLFileWriter.h"   // Include first to avoid libxml compile problems!
 #include "commonj/sdo/SDOXMLStreamWriter.h" // Include first to avoid libxml compile problems!
 #include "commonj/sdo/SDOXMLBufferWriter.h" // Include first to avoid libxml compile problems!
+#include "commonj/sdo/SDOXMLTreeWriter.h"   // Include first to avoid libxml compile problems!
 #include "commonj/sdo/XMLHelperImpl.h"
 #include "commonj/sdo/XMLDocumentImpl.h"
 #include <iostream>
@@ -32,6 +33,7 @@
 #include "commonj/sdo/XSDTypeInfo.h"
 #include "commonj/sdo/SDORuntimeException.h"
 #include "commonj/sdo/DataFactoryImpl.h"
+#include "commonj/sdo/SDOArena.h"
 
 
 namespace commonj
@@ -45,6 +47,7 @@ namespace commonj
         //////////////////////////////////////////////////////////////////////
         
         XMLHelperImpl::XMLHelperImpl(DataFactoryPtr df)
+            : arenaAllocation(false)
         {
             dataFactory = (DataFactory*)df;
             if (!dataFactory) 
@@ -58,6 +61,11 @@ namespace commonj
             clearErrors();
         }
 
+        void XMLHelperImpl::setArenaAllocation(bool enable)
+        {
+            arenaAllocation = enable;
+        }
+
         DataFactoryPtr XMLHelperImpl::getDataFactory()
         {
             if (!dataFactory) 
@@ -198,6 +206,7 @@ namespace commonj
         {
             DataObjectPtr rootDataObject;
             clearErrors();
+            SDOArenaScope arenaScope(arenaAllocation);
             SDOSAX2Parser sdoParser(getDataFactory(),
                                     targetNamespaceURI,
                                     rootDataObject,
@@ -215,6 +224,7 @@ namespace commonj
         {
             DataObjectPtr rootDataObject;
             clearErrors();
+            SDOArenaScope arenaScope(arenaAllocation);
             SDOSAX2Parser sdoParser(getDataFactory(),
                                     targetNamespaceURI.c_str(),
                                     rootDataObject,
@@ -232,6 +242,7 @@ namespace commonj
             const char* targetNamespaceURI)
         {
             DataObjectPtr rootDataObject;
+            SDOArenaScope arenaScope(arenaAllocation);
             SDOSAX2Parser sdoParser(getDataFactory(),
                                     targetNamespaceURI,
                                     rootDataObject,
@@ -246,6 +257,7 @@ namespace commonj
             const SDOString& targetNamespaceURI)
         {
             DataObjectPtr rootDataObject;
+            SDOArenaScope arenaScope(arenaAllocation);
             SDOSAX2Parser sdoParser(getDataFactory(),
                                     targetNamespaceURI.c_str(),
                                     rootDataObject,
@@ -270,6 +282,31 @@ namespace commonj
             return load(str, targetNamespaceURI);
         }
 
+        XMLDocumentPtr XMLHelperImpl::loadNode(
+            xmlNodePtr node,
+            const char* targetNamespaceURI)
+        {
+            DataObjectPtr rootDataObject;
+            clearErrors();
+            SDOArenaScope arenaScope(arenaAllocation);
+            SDOSAX2Parser sdoParser(getDataFactory(),
+                                    targetNamespaceURI,
+                                    rootDataObject,
+                                    this);
+            if (sdoParser.walk(node) == 0)
+            {
+                return createDocument(rootDataObject, (const char*)sdoParser.getRootElementURI(), sdoParser.getRootElementName());
+            }
+            return 0;
+        }
+
+        XMLDocumentPtr XMLHelperImpl::loadNode(
+            xmlNodePtr node,
+            const SDOString& targetNamespaceURI)
+        {
+            return loadNode(node, targetNamespaceURI.c_str());
+        }
+
         void XMLHelperImpl::save(XMLDocumentPtr doc, const char* xmlFile, int indent)
         {
             SDOXMLFileWriter writer(xmlFile, dataFactory);
@@ -360,6 +397,33 @@ namespace commonj
                 indent);
         }
 
+        // Serializes the datagraph to a libxml2 document
+        xmlDocPtr XMLHelperImpl::saveToDOM(XMLDocumentPtr doc,
+            int indent)
+        {
+            SDOXMLTreeWriter writer(dataFactory);
+            writer.write(doc, indent);
+            return writer.getDocument();
+        }
+        xmlDocPtr XMLHelperImpl::saveToDOM(
+            DataObjectPtr dataObject,
+            const char* rootElementURI,
+            const char* rootElementName,
+            int indent)
+        {
+            return saveToDOM(createDocument(dataObject,rootElementURI, rootElementName),
+                indent);
+        }
+        xmlDocPtr XMLHelperImpl::saveToDOM(
+            DataObjectPtr dataObject,
+            const SDOString& rootElementURI,
+            const SDOString& rootElementName,
+            int indent)
+        {
+            return saveToDOM(createDocument(dataObject,rootElementURI, rootElementName),
+                indent);
+        }
+
         unsigned int XMLHelperImpl::getErrorCount() const
         {
             return parseErrors.size();
@@ -58,6 +58,8 @@ namespace commonj
             virtual const char*  getErrorMessage(unsigned int errnum) const;
             virtual void setError(const char* error);
 
+            virtual void setArenaAllocation(bool enable);
+
 
             /**  load/loadFile - loads xml data
              *
@@ -94,6 +96,13 @@ namespace commonj
                 const SDOString& inXml,
                 const SDOString& targetNamespaceURI = "");
 
+            virtual XMLDocumentPtr loadNode(
+                struct _xmlNode* node,
+                const char* targetNamespaceURI = 0);
+            virtual XMLDocumentPtr loadNode(
+                struct _xmlNode* node,
+                const SDOString& targetNamespaceURI);
+
             virtual XMLDocumentPtr createDocument(
                 DataObjectPtr dataObject,
                 const char* rootElementURI,
@@ -161,6 +170,22 @@ namespace commonj
                 const SDOString& rootElementURI,
                 const SDOString& rootElementName,
                 int indent = -1);
+
+            /**  saveToDOM saves the graph to a libxml2 tree
+             *
+             * saveToDOM - Serializes the datagraph to a new libxml2 document
+             */
+            struct _xmlDoc* saveToDOM(XMLDocumentPtr doc, int indent = -1);
+            struct _xmlDoc* saveToDOM(
+                DataObjectPtr dataObject,
+                const char* rootElementURI,
+                const char* rootElementName,
+                int indent = -1);
+            struct _xmlDoc* saveToDOM(
+                DataObjectPtr dataObject,
+                const SDOString& rootElementURI,
+                const SDOString& rootElementName,
+                int indent = -1);
                             
         private:
             int     parse(const char* source);
@@ -172,6 +197,9 @@ namespace commonj
             DataFactoryPtr    dataFactory;
             SDOXMLString targetNamespaceURI;
 
+            // Load documents into an SDOArena
+            bool arenaAllocation;
+
             const TypeImpl* findRoot(DataFactory* df,
                 const SDOString& rootElementURI);
 
@@ -38,6 +38,7 @@
 
 #include "commonj/sdo/SDORuntimeException.h"
 #include "commonj/sdo/DASProperty.h"
+#include "commonj/sdo/SDOStats.h"
 #include "commonj/sdo/Logging.h"
 #include "commonj/sdo/Type.h"
 
@@ -106,6 +107,7 @@ namespace commonj
         {
             SDOSchemaSAX2Parser schemaParser(schemaInfo, this, parsedLocations, definedNamespaces);
             clearErrors();
+            SDOStats::add(SDOStats::SchemaLoads);
             schema  >> schemaParser;
             defineTypes(schemaParser.getTypeDefinitions());
             return schemaInfo.getTargetNamespaceURI();
@@ -116,6 +118,7 @@ namespace commonj
             std::istringstream str(schema);
             SDOSchemaSAX2Parser schemaParser(schemaInfo, this, parsedLocations, definedNamespaces);
             clearErrors();
+            SDOStats::add(SDOStats::SchemaLoads);
             str  >> schemaParser;
             defineTypes(schemaParser.getTypeDefinitions());
             return schemaInfo.getTargetNamespaceURI();
@@ -126,6 +129,7 @@ namespace commonj
             std::istringstream str(schema);
             SDOSchemaSAX2Parser schemaParser(schemaInfo, this, parsedLocations, definedNamespaces);
             clearErrors();
+            SDOStats::add(SDOStats::SchemaLoads);
             str  >> schemaParser;
             defineTypes(schemaParser.getTypeDefinitions());
             return schemaInfo.getTargetNamespaceURI();
@@ -397,7 +401,7 @@ namespace commonj
                            {
                               const Type& rootType = dataFactory->getType(prop.typeUri, "RootType");
 
-                              const std::list<PropertyImpl*> pl = rootType.getPropertyListReference();
+                              const std::list<PropertyImpl*>& pl = rootType.getPropertyListReference();
 
                               for (std::list<PropertyImpl*>::const_iterator j = pl.begin();
                                    j != pl.end();
@@ -26,10 +26,19 @@ PHP_SUBST(SDO_SHARED_LIBADD)
 AC_DEFINE(HAVE_SDO, 1, [Whether you have SDO support])
 PHP_REQUIRE_CXX()
 
+dnl Thread safe builds may share metadata and read-only graphs between
+dnl threads, so the core's reference counts must be atomic
+SDO_CXXFLAGS="-I@ext_srcdir@"
+if test "$PHP_THREAD_SAFETY" = "yes"; then
+  SDO_CXXFLAGS="$SDO_CXXFLAGS -DSDO_THREADSAFE_REFCOUNT"
+fi
+
 sdo_srcs="sdo.cpp \
 SDO_CPPException.cpp \
 SDO_DAS_ChangeSummary.cpp \
 SDO_DAS_DataFactory.cpp \
+SDO_DAS_GraphBuilder.cpp \
+SDO_DAS_Json.cpp \
 SDO_DAS_Setting.cpp \
 SDO_DataObject.cpp \
 SDO_Exception.cpp \
@@ -84,19 +93,28 @@ commonj/sdo/SAX2Attributes.cpp \
 commonj/sdo/SAX2Namespaces.cpp \
 commonj/sdo/SAX2Parser.cpp \
 commonj/sdo/SchemaInfo.cpp \
+commonj/sdo/SDOArena.cpp \
 commonj/sdo/SdoCheck.cpp \
 commonj/sdo/SDODate.cpp \
 commonj/sdo/SDODataConverter.cpp \
+commonj/sdo/SDOGraphBuilder.cpp \
+commonj/sdo/SDOGraphSnapshot.cpp \
+commonj/sdo/SDOJsonReader.cpp \
+commonj/sdo/SDOJsonWriter.cpp \
+commonj/sdo/SDOModelSnapshot.cpp \
+commonj/sdo/SDOPredicateIndex.cpp \
 commonj/sdo/SdoRuntime.cpp \
 commonj/sdo/SDORuntimeException.cpp \
 commonj/sdo/SDOSAX2Parser.cpp \
 commonj/sdo/SDOSchemaSAX2Parser.cpp \
+commonj/sdo/SDOStats.cpp \
 commonj/sdo/SDOUtils.cpp \
 commonj/sdo/SDOValue.cpp \
 commonj/sdo/SDOXMLBufferWriter.cpp \
 commonj/sdo/SDOXMLFileWriter.cpp \
 commonj/sdo/SDOXMLStreamWriter.cpp \
 commonj/sdo/SDOXMLString.cpp \
+commonj/sdo/SDOXMLTreeWriter.cpp \
 commonj/sdo/SDOXMLWriter.cpp \
 commonj/sdo/SDOXSDBufferWriter.cpp \
 commonj/sdo/SDOXSDFileWriter.cpp \
@@ -125,7 +143,7 @@ commonj/sdo/XSDPropertyInfo.cpp \
 commonj/sdo/XSDTypeInfo.cpp"
 
 dnl The final parameter tells the build system to use the CXX linker
-PHP_NEW_EXTENSION(sdo, $sdo_srcs $sdo_das_xml_srcs $sdo_lib_srcs, $ext_shared,, -I@ext_srcdir@, 1)
+PHP_NEW_EXTENSION(sdo, $sdo_srcs $sdo_das_xml_srcs $sdo_lib_srcs, $ext_shared,, $SDO_CXXFLAGS, 1)
 PHP_ADD_BUILD_DIR($ext_builddir/commonj/sdo)
 
 PHP_ADD_EXTENSION_DEP(sdo, libxml)
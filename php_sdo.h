@@ -47,9 +47,21 @@ extern zend_module_entry sdo_module_entry;
 #endif
 
 PHP_MINIT_FUNCTION(sdo);
+PHP_MSHUTDOWN_FUNCTION(sdo);
 PHP_RINIT_FUNCTION(sdo);
+PHP_RSHUTDOWN_FUNCTION(sdo);
 PHP_MINFO_FUNCTION(sdo);
 
+/* {{{ proto array sdo_get_stats()
+Return the counters kept by SDO for the current request, when the sdo.stats
+ini setting is on.
+
+Returns an array mapping each counter name, such as objects_created or
+xml_parse_usec, to its value. The values are all zero while sdo.stats is off.
+*/
+PHP_FUNCTION(sdo_get_stats);
+/* }}} */
+
 PHP_METHOD(SDO_PropertyAccess, __get);
 PHP_METHOD(SDO_PropertyAccess, __set);
 
@@ -107,6 +119,42 @@ if this is a root SDO_DataObject.
 PHP_METHOD(SDO_DataObject, getContainer);
 /* }}} */
 
+/* {{{ proto void SDO_DataObject::setValues(array values)
+Set several properties of the data object in one call.
+
+The array maps property names, xpaths or indexes to values, in the same form as $do[$name] = $value.
+The values are written in array order. The call is not atomic: when a value cannot be written
+the exception is thrown and no later value is written, but the values before it may have been.
+
+No return value.
+
+Throws SDO_UnsupportedOperationException, SDO_InvalidConversionException or SDO_IndexOutOfBoundsException as the individual assignments would.
+*/
+PHP_METHOD(SDO_DataObject, setValues);
+/* }}} */
+
+/* {{{ proto array SDO_DataObject::getValues([array names])
+Get several properties of the data object in one call.
+
+The names, xpaths or indexes of the properties to read. Default is NULL, which reads every property which is set or has a default.
+
+An array mapping each name to its value, as $do[$name] would return it.
+
+Throws SDO_PropertyNotSetException if a named property is not set and has no default.
+*/
+PHP_METHOD(SDO_DataObject, getValues);
+/* }}} */
+
+/* {{{ proto string SDO_DataObject::hash()
+Get a hash of the structure and values of the data object and the data objects it contains.
+
+Data objects which compare equal with == have the same hash. The hash does not depend on the order of the properties, so it may be kept to find or compare the same data later.
+
+A string of 16 hexadecimal digits.
+*/
+PHP_METHOD(SDO_DataObject, hash);
+/* }}} */
+
 /* {{{ proto SDO_Model_Property SDO_Sequence::getProperty(integer sequence_index)
 Return the property for the specified sequence index.
 
@@ -323,6 +371,18 @@ The old containing data object of the deleted SDO_DataObject.
 PHP_METHOD(SDO_DAS_ChangeSummary, getOldContainer);
 /* }}} */
 
+/* {{{ proto array SDO_DAS_ChangeSummary::getChangePlan()
+Get all the changes in one array, in the order they should be applied: deletions
+first, contained objects before their containers, then additions, containers
+before the objects they contain, then modifications.
+
+Each entry is an array with the keys 'change_type', 'data_object', 'depth' (the
+number of containers above the object), and 'old_values', an array of the old
+values of the changed properties keyed by property name.
+*/
+PHP_METHOD(SDO_DAS_ChangeSummary, getChangePlan);
+/* }}} */
+
 
 /* {{{ proto integer SDO_DAS_Setting::getPropertyIndex()
 Get the property index for the changed property.
@@ -529,6 +589,52 @@ PHP_METHOD(SDO_Model_ReflectionDataObject, getContainmentProperty);
 /* }}} */
 
 
+/* {{{ proto string SDO_DAS_JsonImpl::encode(SDO_DataObject data_object)
+Encode an SDO_DataObject and the data objects below it as a JSON string.
+*/
+PHP_METHOD(SDO_DAS_JsonImpl, encode);
+/* }}} */
+
+/* {{{ proto SDO_DataObject SDO_DAS_JsonImpl::decode(string json, SDO_DataObject data_object)
+Decode a JSON object into an SDO_DataObject, creating the data objects below it
+from the model of its type. Returns the data object.
+*/
+PHP_METHOD(SDO_DAS_JsonImpl, decode);
+/* }}} */
+
+/* {{{ proto void SDO_DAS_GraphBuilder::__construct(SDO_DataObject root)
+Construct a builder which normalises rows of a result set into data objects below the root.
+*/
+PHP_METHOD(SDO_DAS_GraphBuilder, __construct);
+/* }}} */
+
+/* {{{ proto int SDO_DAS_GraphBuilder::addTable(string table_name [, string parent_table_name])
+Add a table whose objects are held in the property of that name in the parent
+table's type, or in the root. Returns the index of the table.
+*/
+PHP_METHOD(SDO_DAS_GraphBuilder, addTable);
+/* }}} */
+
+/* {{{ proto int SDO_DAS_GraphBuilder::addColumn(string table_name, string property_name [, bool is_key [, string referenced_table_name]])
+Add the next column of the rows, which sets a property of the table's objects, or
+which holds the key of an object of the referenced table. Returns the column index.
+*/
+PHP_METHOD(SDO_DAS_GraphBuilder, addColumn);
+/* }}} */
+
+/* {{{ proto int SDO_DAS_GraphBuilder::addRows(mixed rows)
+Add rows from an array or Traversable (such as a PDOStatement) of numerically indexed
+rows. Returns the number of data objects created so far.
+*/
+PHP_METHOD(SDO_DAS_GraphBuilder, addRows);
+/* }}} */
+
+/* {{{ proto void SDO_DAS_GraphBuilder::resolveReferences()
+Set the non-containment references read from the rows added.
+*/
+PHP_METHOD(SDO_DAS_GraphBuilder, resolveReferences);
+/* }}} */
+
 /* {{{ proto mixed SDO_Exception::getCause()
 Returns the cause of this exception or NULL if the cause is nonexistent or unknown.
 */
@@ -594,6 +700,9 @@ PHP_METHOD(SDO_DataObjectImpl, getChangeSummary);
 PHP_METHOD(SDO_DataObjectImpl, __get);
 PHP_METHOD(SDO_DataObjectImpl, __set);
 PHP_METHOD(SDO_DataObjectImpl, count);
+PHP_METHOD(SDO_DataObjectImpl, setValues);
+PHP_METHOD(SDO_DataObjectImpl, getValues);
+PHP_METHOD(SDO_DataObjectImpl, hash);
 
 PHP_METHOD(SDO_SequenceImpl, getProperty);
 PHP_METHOD(SDO_SequenceImpl, getPropertyIndex);
@@ -625,6 +734,14 @@ PHP_METHOD(SDO_Model_PropertyImpl, getContainingType);
 PHP_METHOD(SDO_Model_PropertyImpl, getDefault);
 /* }}} */
 
+ZEND_BEGIN_MODULE_GLOBALS(sdo)
+	HashTable		*model_wrappers;		/* SDO_Model_Type/Property objects shared in this request */
+	unsigned int	 model_release_count;	/* DataFactoryImpl::getReleaseCount() when they were made */
+	zend_bool		 stats_enabled;			/* the sdo.stats ini setting */
+ZEND_END_MODULE_GLOBALS(sdo)
+
+ZEND_EXTERN_MODULE_GLOBALS(sdo)
+
 /* In every utility function you add that needs to use variables
    in php_sdo_globals, call TSRMLS_FETCH(); after declaring other
    variables used by that function, or better yet, pass in TSRMLS_CC
@@ -46,6 +46,8 @@ PHP_METHOD(SDO_DAS_XML, loadFile);
 PHP_METHOD(SDO_DAS_XML, loadString);
 PHP_METHOD(SDO_DAS_XML, saveFile);
 PHP_METHOD(SDO_DAS_XML, saveString);
+PHP_METHOD(SDO_DAS_XML, loadNode);
+PHP_METHOD(SDO_DAS_XML, saveToDOM);
 PHP_METHOD(SDO_DAS_XML, createDocument);
 PHP_METHOD(SDO_DAS_XML, createDataObject);
 PHP_METHOD(SDO_DAS_XML, __toString);
@@ -63,6 +63,7 @@ typedef struct {
     XMLHelperPtr   xmlHelperPtr;
     XSDHelperPtr   xsdHelperPtr;
 	zval           z_df;
+	int            model_slot; /* 1 + the cache slot of a shared model, or 0 */
 } xmldas_object;
 
 /* SDO_DAS_XML_Document */
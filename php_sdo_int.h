@@ -65,6 +65,8 @@ extern PHP_SDO_API zend_class_entry *sdo_sequenceimpl_class_entry;
 
 extern PHP_SDO_API zend_class_entry *sdo_das_datafactory_class_entry;
 extern PHP_SDO_API zend_class_entry *sdo_das_datafactoryimpl_class_entry;
+extern PHP_SDO_API zend_class_entry *sdo_das_jsonimpl_class_entry;
+extern PHP_SDO_API zend_class_entry *sdo_das_graphbuilder_class_entry;
 extern PHP_SDO_API zend_class_entry *sdo_das_dataobject_class_entry;
 extern PHP_SDO_API zend_class_entry *sdo_das_setting_class_entry;
 extern PHP_SDO_API zend_class_entry *sdo_das_settinglist_class_entry;
@@ -90,11 +92,14 @@ extern PHP_SDO_API void sdo_das_df_new(zval *me, DataFactoryPtr dfp TSRMLS_DC);
 extern PHP_SDO_API DataFactoryPtr sdo_das_df_get(zval *me TSRMLS_DC);
 
 extern PHP_SDO_API void sdo_do_minit(zend_class_entry *tmp TSRMLS_DC);
+extern PHP_SDO_API void sdo_do_mshutdown(TSRMLS_D);
+extern PHP_SDO_API void sdo_do_register_model(DataFactoryPtr dfp TSRMLS_DC);
 extern PHP_SDO_API void sdo_do_new(zval *me, DataObjectPtr dop TSRMLS_DC);
 extern PHP_SDO_API DataObjectPtr sdo_do_get(zval *me TSRMLS_DC);
 
 extern PHP_SDO_API void sdo_list_minit(zend_class_entry *tmp TSRMLS_DC);
 extern PHP_SDO_API void sdo_dataobjectlist_new(zval *me, const Type& typeh, DataObjectPtr dop, DataObjectList *listh TSRMLS_DC);
+extern PHP_SDO_API DataObjectList *sdo_dataobjectlist_get_list(zval *me TSRMLS_DC);
 extern PHP_SDO_API void sdo_changeddataobjectlist_new(zval *me, const ChangedDataObjectList *listh TSRMLS_DC);
 extern PHP_SDO_API void sdo_das_settinglist_new(zval *me, SettingList& listh TSRMLS_DC);
 extern PHP_SDO_API int  sdo_list_count_elements(zval *object, long *count TSRMLS_DC);
@@ -104,11 +109,15 @@ extern PHP_SDO_API void sdo_das_changesummary_new(zval *me, ChangeSummary *chang
 
 extern PHP_SDO_API void sdo_das_setting_minit(zend_class_entry *tmp TSRMLS_DC);
 extern PHP_SDO_API void sdo_das_setting_new(zval *me, Setting *setting TSRMLS_DC);
+extern PHP_SDO_API zval *sdo_das_setting_value(Setting *setting TSRMLS_DC);
 
 extern PHP_SDO_API void sdo_sequence_minit(zend_class_entry *tmp TSRMLS_DC);
 extern PHP_SDO_API void sdo_sequence_new(zval *me, SequencePtr seqp TSRMLS_DC);
 
 extern PHP_SDO_API void sdo_model_type_minit(zend_class_entry *tmp TSRMLS_DC);
+extern PHP_SDO_API zval *sdo_model_wrapper_find(const void *key TSRMLS_DC);
+extern PHP_SDO_API void sdo_model_wrapper_add(const void *key, zval *me TSRMLS_DC);
+extern PHP_SDO_API void sdo_model_rshutdown(TSRMLS_D);
 extern PHP_SDO_API void sdo_model_type_new(zval *me, const Type *typep TSRMLS_DC);
 extern PHP_SDO_API void sdo_model_type_summary_string (ostringstream& print_buf, const Type *typep TSRMLS_DC);
 extern PHP_SDO_API void sdo_model_type_string (ostringstream& print_buf, const Type *typep, const char *indent TSRMLS_DC);
@@ -119,6 +128,10 @@ extern PHP_SDO_API void sdo_model_property_string (ostringstream& print_buf, con
 
 extern PHP_SDO_API void sdo_model_rdo_minit(zend_class_entry *tmp TSRMLS_DC);
 
+extern PHP_SDO_API void sdo_das_json_minit(zend_class_entry *tmp TSRMLS_DC);
+
+extern PHP_SDO_API void sdo_das_gb_minit(zend_class_entry *tmp TSRMLS_DC);
+
 extern PHP_SDO_API zval *sdo_throw_exception(zend_class_entry *ce, const char *message, long code, zval *z_cause TSRMLS_DC);
 extern PHP_SDO_API zval *sdo_throw_exception_ex(zend_class_entry *ce, long code, zval *z_cause TSRMLS_DC, char *format, ...);
 extern PHP_SDO_API void sdo_exception_minit(zend_class_entry *tmp TSRMLS_DC);
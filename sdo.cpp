@@ -54,6 +54,8 @@ PHP_SDO_API zend_class_entry *sdo_das_datafactory_class_entry;
 PHP_SDO_API zend_class_entry *sdo_das_changesummary_class_entry;
 PHP_SDO_API zend_class_entry *sdo_das_setting_class_entry;
 PHP_SDO_API zend_class_entry *sdo_das_datafactoryimpl_class_entry;
+PHP_SDO_API zend_class_entry *sdo_das_jsonimpl_class_entry;
+PHP_SDO_API zend_class_entry *sdo_das_graphbuilder_class_entry;
 PHP_SDO_API zend_class_entry *sdo_dataobjectimpl_class_entry;
 PHP_SDO_API zend_class_entry *sdo_dataobjectlist_class_entry;
 PHP_SDO_API zend_class_entry *sdo_changeddataobjectlist_class_entry;
@@ -82,6 +84,16 @@ ZEND_BEGIN_ARG_INFO(arginfo_sdo_dataobject, 0)
 ZEND_END_ARG_INFO();
 /* }}} */
 
+/* {{{ sdo_functions[] */
+ZEND_BEGIN_ARG_INFO(arginfo_sdo_get_stats, 0)
+ZEND_END_ARG_INFO();
+
+zend_function_entry sdo_functions[] = {
+	PHP_FE(sdo_get_stats, arginfo_sdo_get_stats)
+	{NULL, NULL, NULL}
+};
+/* }}} */
+
 /* {{{ SDO_PropertyAccess methods */
 ZEND_BEGIN_ARG_INFO(arginfo___get, 0)
     ZEND_ARG_INFO(0, name)
@@ -104,6 +116,14 @@ ZEND_BEGIN_ARG_INFO(arginfo_sdo_dataobject_createdataobject, 0)
     ZEND_ARG_INFO(0, identifier)
 ZEND_END_ARG_INFO();
 
+ZEND_BEGIN_ARG_INFO(arginfo_sdo_dataobject_setvalues, 0)
+    ZEND_ARG_ARRAY_INFO(0, values, 0)
+ZEND_END_ARG_INFO();
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_sdo_dataobject_getvalues, 0, ZEND_RETURN_VALUE, 0)
+    ZEND_ARG_ARRAY_INFO(0, names, 1)
+ZEND_END_ARG_INFO();
+
 zend_function_entry sdo_dataobject_methods[] = {
 	ZEND_ABSTRACT_ME(SDO_DataObject, getTypeName, 0)
 	ZEND_ABSTRACT_ME(SDO_DataObject, getTypeNamespaceURI, 0)
@@ -111,6 +131,9 @@ zend_function_entry sdo_dataobject_methods[] = {
 	ZEND_ABSTRACT_ME(SDO_DataObject, createDataObject, arginfo_sdo_dataobject_createdataobject)
 	ZEND_ABSTRACT_ME(SDO_DataObject, clear, 0)
 	ZEND_ABSTRACT_ME(SDO_DataObject, getContainer, 0)
+	ZEND_ABSTRACT_ME(SDO_DataObject, setValues, arginfo_sdo_dataobject_setvalues)
+	ZEND_ABSTRACT_ME(SDO_DataObject, getValues, arginfo_sdo_dataobject_getvalues)
+	ZEND_ABSTRACT_ME(SDO_DataObject, hash, 0)
 	{NULL, NULL, NULL}
 };
 /* }}} */
@@ -206,6 +229,7 @@ zend_function_entry sdo_das_changesummary_methods[] = {
 	ZEND_ME(SDO_DAS_ChangeSummary, getChangeType, arginfo_sdo_dataobject, ZEND_ACC_PUBLIC)
 	ZEND_ME(SDO_DAS_ChangeSummary, getOldValues, arginfo_sdo_dataobject, ZEND_ACC_PUBLIC)
 	ZEND_ME(SDO_DAS_ChangeSummary, getOldContainer, arginfo_sdo_dataobject, ZEND_ACC_PUBLIC)
+	ZEND_ME(SDO_DAS_ChangeSummary, getChangePlan, 0, ZEND_ACC_PUBLIC)
 	{NULL, NULL, NULL}
 };
 /* }}} */
@@ -230,6 +254,46 @@ zend_function_entry sdo_das_df_methods[] = {
 };
 /* }}} */
 
+/* {{{ SDO_DAS_JsonImpl methods */
+ZEND_BEGIN_ARG_INFO(arginfo_sdo_das_jsonimpl_decode, 0)
+    ZEND_ARG_INFO(0, json)
+    ZEND_ARG_OBJ_INFO(0, data_object, SDO_DataObject, 0)
+ZEND_END_ARG_INFO();
+
+zend_function_entry sdo_das_jsonimpl_methods[] = {
+	ZEND_ME(SDO_DAS_JsonImpl, encode, arginfo_sdo_dataobject, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC)
+	ZEND_ME(SDO_DAS_JsonImpl, decode, arginfo_sdo_das_jsonimpl_decode, ZEND_ACC_PUBLIC|ZEND_ACC_STATIC)
+	{NULL, NULL, NULL}
+};
+/* }}} */
+
+/* {{{ SDO_DAS_GraphBuilder methods */
+ZEND_BEGIN_ARG_INFO_EX(arginfo_sdo_das_graphbuilder_addtable, 0, ZEND_RETURN_VALUE, 1)
+    ZEND_ARG_INFO(0, table_name)
+    ZEND_ARG_INFO(0, parent_table_name)
+ZEND_END_ARG_INFO();
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_sdo_das_graphbuilder_addcolumn, 0, ZEND_RETURN_VALUE, 2)
+    ZEND_ARG_INFO(0, table_name)
+    ZEND_ARG_INFO(0, property_name)
+    ZEND_ARG_INFO(0, is_key)
+    ZEND_ARG_INFO(0, referenced_table_name)
+ZEND_END_ARG_INFO();
+
+ZEND_BEGIN_ARG_INFO(arginfo_sdo_das_graphbuilder_addrows, 0)
+    ZEND_ARG_INFO(0, rows)
+ZEND_END_ARG_INFO();
+
+zend_function_entry sdo_das_graphbuilder_methods[] = {
+	ZEND_ME(SDO_DAS_GraphBuilder, __construct, arginfo_sdo_dataobject, ZEND_ACC_PUBLIC)
+	ZEND_ME(SDO_DAS_GraphBuilder, addTable, arginfo_sdo_das_graphbuilder_addtable, ZEND_ACC_PUBLIC)
+	ZEND_ME(SDO_DAS_GraphBuilder, addColumn, arginfo_sdo_das_graphbuilder_addcolumn, ZEND_ACC_PUBLIC)
+	ZEND_ME(SDO_DAS_GraphBuilder, addRows, arginfo_sdo_das_graphbuilder_addrows, ZEND_ACC_PUBLIC)
+	ZEND_ME(SDO_DAS_GraphBuilder, resolveReferences, 0, ZEND_ACC_PUBLIC)
+	{NULL, NULL, NULL}
+};
+/* }}} */
+
 /* {{{ SDO_DataObjectImpl methods */
 zend_function_entry sdo_dataobjectimpl_methods[] = {
 	ZEND_ME(SDO_DataObjectImpl, __construct, 0, ZEND_ACC_PRIVATE) /* can't be newed */
@@ -243,6 +307,9 @@ zend_function_entry sdo_dataobjectimpl_methods[] = {
 	ZEND_ME(SDO_DataObjectImpl, createDataObject, arginfo_sdo_dataobject_createdataobject, ZEND_ACC_PUBLIC)
 	ZEND_ME(SDO_DataObjectImpl, clear, 0, ZEND_ACC_PUBLIC)
 	ZEND_ME(SDO_DataObjectImpl, getContainer, 0, ZEND_ACC_PUBLIC)
+	ZEND_ME(SDO_DataObjectImpl, setValues, arginfo_sdo_dataobject_setvalues, ZEND_ACC_PUBLIC)
+	ZEND_ME(SDO_DataObjectImpl, getValues, arginfo_sdo_dataobject_getvalues, ZEND_ACC_PUBLIC)
+	ZEND_ME(SDO_DataObjectImpl, hash, 0, ZEND_ACC_PUBLIC)
 	/* inherited from SDO_DAS_DataObject ... */
 	ZEND_ME(SDO_DataObjectImpl, getChangeSummary, 0, ZEND_ACC_PUBLIC)
 	{NULL, NULL, NULL}
@@ -400,11 +467,11 @@ zend_module_entry sdo_module_entry = {
     STANDARD_MODULE_HEADER,
 #endif
 	"sdo",
-	NULL, /* function list */
+	sdo_functions,
 	PHP_MINIT(sdo),
-	NULL, /* mshutdown */
+	PHP_MSHUTDOWN(sdo),
 	PHP_RINIT(sdo),
-	NULL, /* rshutdown */
+	PHP_RSHUTDOWN(sdo),
 	PHP_MINFO(sdo),
 	PHP_SDO_VERSION,
 	STANDARD_MODULE_PROPERTIES
@@ -417,12 +484,48 @@ ZEND_GET_MODULE(sdo)
 END_EXTERN_C()
 #endif
 
+ZEND_DECLARE_MODULE_GLOBALS(sdo)
+
+/* {{{ php_sdo_init_globals
+*/
+static void php_sdo_init_globals(zend_sdo_globals *sdo_globals)
+{
+	sdo_globals->model_wrappers = NULL;
+	sdo_globals->model_release_count = 0;
+	sdo_globals->stats_enabled = 0;
+}
+/* }}} */
+
+/* {{{ OnUpdateStats
+ * The SDO counters are switched on the thread running the request, so that
+ * ini_set() takes effect at once.
+ */
+static PHP_INI_MH(OnUpdateStats)
+{
+	if (OnUpdateBool(entry, new_value, new_value_length, mh_arg1, mh_arg2, mh_arg3, stage TSRMLS_CC) == FAILURE) {
+		return FAILURE;
+	}
+	SDOStats::setEnabled(SDO_G(stats_enabled) != 0);
+	return SUCCESS;
+}
+/* }}} */
+
+/* {{{ PHP_INI
+ */
+PHP_INI_BEGIN()
+	STD_PHP_INI_BOOLEAN("sdo.stats", "0", PHP_INI_ALL, OnUpdateStats, stats_enabled, zend_sdo_globals, sdo_globals)
+PHP_INI_END()
+/* }}} */
+
 /* {{{ PHP_MINIT_FUNCTION
 */
 PHP_MINIT_FUNCTION(sdo)
 {
 	zend_class_entry ce;
 
+	ZEND_INIT_MODULE_GLOBALS(sdo, php_sdo_init_globals, NULL);
+	REGISTER_INI_ENTRIES();
+
 	/*
 	 * Check the level of the C++ library
 	 */
@@ -575,11 +678,32 @@ PHP_MINIT_FUNCTION(sdo)
     sdo_das_xml_parserexception_minit(TSRMLS_C);
     sdo_das_xml_fileexception_minit(TSRMLS_C);
 
+	/* class SDO_DAS_JsonImpl, the native encoder and decoder for SDO_DAS_Json */
+    INIT_CLASS_ENTRY(ce, "SDO_DAS_JsonImpl", sdo_das_jsonimpl_methods);
+	sdo_das_json_minit(&ce TSRMLS_CC);
+
+	/* class SDO_DAS_GraphBuilder, the native normaliser for SDO_DAS_Relational */
+    INIT_CLASS_ENTRY(ce, "SDO_DAS_GraphBuilder", sdo_das_graphbuilder_methods);
+	sdo_das_gb_minit(&ce TSRMLS_CC);
+
    return SUCCESS;
 
 }
 /* }}} */
 
+/* {{{ PHP_MSHUTDOWN_FUNCTION
+*/
+PHP_MSHUTDOWN_FUNCTION(sdo)
+{
+	UNREGISTER_INI_ENTRIES();
+
+	/* release the frozen models kept for serialization */
+	sdo_do_mshutdown(TSRMLS_C);
+
+	return SUCCESS;
+}
+/* }}} */
+
 /* {{{ PHP_RINIT_FUNCTION
 */
 PHP_RINIT_FUNCTION(sdo)
@@ -590,6 +714,21 @@ PHP_RINIT_FUNCTION(sdo)
        SDODataConverter::precision = precision;
    }
 
+   /* count from zero for each request */
+   SDOStats::reset();
+   SDOStats::setEnabled(SDO_G(stats_enabled) != 0);
+
+   return SUCCESS;
+}
+/* }}} */
+
+/* {{{ PHP_RSHUTDOWN_FUNCTION
+*/
+PHP_RSHUTDOWN_FUNCTION(sdo)
+{
+   /* release the model wrappers shared during the request */
+   sdo_model_rshutdown(TSRMLS_C);
+
    return SUCCESS;
 }
 /* }}} */
@@ -602,7 +741,38 @@ PHP_MINFO_FUNCTION(sdo)
 	php_info_print_table_header(2, "sdo support", "enabled");
 	php_info_print_table_row(2, "sdo extension version", PHP_SDO_VERSION);
 	php_info_print_table_row(2, "Tuscany sdo cpp version", SdoRuntime::getVersion());
+	php_info_print_table_row(2, "sdo statistics", SDO_G(stats_enabled) ? "enabled" : "disabled");
 	php_info_print_table_end();
+
+	if (SDO_G(stats_enabled)) {
+		char buf[32];
+
+		php_info_print_table_start();
+		php_info_print_table_header(2, "sdo statistic", "this request");
+		for (int i = 0; i < SDOStats::CounterCount; i++) {
+			snprintf(buf, sizeof(buf), "%ld", (long)SDOStats::get((SDOStats::Counter)i));
+			php_info_print_table_row(2, SDOStats::getName((SDOStats::Counter)i), buf);
+		}
+		php_info_print_table_end();
+	}
+
+	DISPLAY_INI_ENTRIES();
+}
+/* }}} */
+
+/* {{{ proto array sdo_get_stats()
+ */
+PHP_FUNCTION(sdo_get_stats)
+{
+	if (ZEND_NUM_ARGS() != 0) {
+		WRONG_PARAM_COUNT;
+	}
+
+	array_init(return_value);
+	for (int i = 0; i < SDOStats::CounterCount; i++) {
+		add_assoc_long(return_value, (char *)SDOStats::getName((SDOStats::Counter)i),
+			(long)SDOStats::get((SDOStats::Counter)i));
+	}
 }
 /* }}} */
 
@@ -0,0 +1,23 @@
+--TEST--
+SDO_DataObject serialize test
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php 
+    $dirname = dirname($_SERVER['SCRIPT_FILENAME']);
+    $xmldas = SDO_DAS_XML::create("${dirname}/company.xsd");
+    $xdoc = $xmldas->loadFile("${dirname}/company.xml");
+    $company = $xdoc->getRootDataObject();
+
+    $copy = unserialize(serialize($company));
+    echo $copy->name . "\n";
+    echo count($copy->departments[0]->employees) . "\n";
+    echo $copy->employeeOfTheMonth->name . "\n";
+    $type = $copy->getTypeName();
+    echo $copy->getTypeNamespaceURI() . "#" . $type . "\n";
+?>
+--EXPECT--
+MegaCorp
+3
+Jane Doe
+companyNS#CompanyType
@@ -0,0 +1,48 @@
+--TEST--
+SDO_DAS_JsonImpl encode and decode test
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php 
+    $dirname = dirname($_SERVER['SCRIPT_FILENAME']);
+    $xmldas = SDO_DAS_XML::create("${dirname}/company.xsd");
+    $xdoc = $xmldas->loadFile("${dirname}/company.xml");
+    $company = $xdoc->getRootDataObject();
+
+    $json = SDO_DAS_JsonImpl::encode($company);
+    $copy = SDO_DAS_JsonImpl::decode($json,
+        $xmldas->createDataObject('companyNS', 'CompanyType'));
+    echo $copy->name . "\n";
+    echo count($copy->departments[0]->employees) . "\n";
+    echo ($json == SDO_DAS_JsonImpl::encode($copy)) ? "same\n" : "different\n";
+
+    $df = SDO_DAS_DataFactory::getDataFactory();
+    $df->addType('GenericNS', 'GenericType', array('open'=>true));
+    $df->addType('ns', 'Blob');
+    $df->addPropertyToType('ns', 'Blob', 'data', SDO_TYPE_NAMESPACE_URI, 'Bytes');
+    $generic = SDO_DAS_JsonImpl::decode('{"a":1,"b":["x\"y",true],"c":{"d":2.5}}',
+        $df->create('GenericNS', 'GenericType'));
+    echo SDO_DAS_JsonImpl::encode($generic) . "\n";
+
+    /* binary data is escaped, and decodes to the same bytes */
+    $blob = $df->create('ns', 'Blob');
+    $blob->data = "a\0\xff";
+    $json = SDO_DAS_JsonImpl::encode($blob);
+    echo $json . "\n";
+    $copy = SDO_DAS_JsonImpl::decode($json, $df->create('ns', 'Blob'));
+    echo bin2hex($copy->data) . "\n";
+
+    try {
+        SDO_DAS_JsonImpl::decode('{"a":', $df->create('GenericNS', 'GenericType'));
+    } catch (SDO_Exception $e) {
+        echo get_class($e) . "\n";
+    }
+?>
+--EXPECT--
+MegaCorp
+3
+same
+{"a":1,"b":{"b0":"x\"y","b1":true},"c":{"d":2.5}}
+{"data":"a\u0000\u00ff"}
+6100ff
+SDO_Exception
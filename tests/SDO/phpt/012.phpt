@@ -0,0 +1,52 @@
+--TEST--
+SDO_DataObject setValues and getValues test
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php 
+    $df = SDO_DAS_DataFactory::getDataFactory();
+    $df->addType('ns', 'Person');
+    $df->addPropertyToType('ns', 'Person', 'name', SDO_TYPE_NAMESPACE_URI, 'String');
+    $df->addPropertyToType('ns', 'Person', 'age', SDO_TYPE_NAMESPACE_URI, 'Integer');
+    $df->addPropertyToType('ns', 'Person', 'married', SDO_TYPE_NAMESPACE_URI, 'Boolean');
+    $df->addPropertyToType('ns', 'Person', 'height', SDO_TYPE_NAMESPACE_URI, 'Double');
+    $df->addPropertyToType('ns', 'Person', 'nickname', SDO_TYPE_NAMESPACE_URI, 'String', array('many'=>true));
+    $df->addPropertyToType('ns', 'Person', 'note', SDO_TYPE_NAMESPACE_URI, 'String');
+
+    $person = $df->create('ns', 'Person');
+    $person->nickname[] = 'Annie';
+    $person->setValues(array('name' => 'Ann', 'age' => '42', 'married' => 1,
+                             'height' => 1.5, 'note' => null));
+    $values = $person->getValues();
+    $nicknames = $values['nickname'];
+    unset($values['nickname']);
+    var_dump($values);
+    echo count($nicknames) . ' ' . $nicknames[0] . "\n";
+    var_dump($person->getValues(array('age', 'married')));
+    try {
+        $person->getValues(array('missing'));
+    } catch (SDO_Exception $e) {
+        echo get_class($e) . "\n";
+    }
+?>
+--EXPECT--
+array(5) {
+  ["name"]=>
+  string(3) "Ann"
+  ["age"]=>
+  int(42)
+  ["married"]=>
+  bool(true)
+  ["height"]=>
+  float(1.5)
+  ["note"]=>
+  NULL
+}
+1 Annie
+array(2) {
+  ["age"]=>
+  int(42)
+  ["married"]=>
+  bool(true)
+}
+SDO_PropertyNotFoundException
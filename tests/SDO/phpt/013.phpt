@@ -0,0 +1,45 @@
+--TEST--
+SDO_DataObjectList wrapper reuse and iteration test
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php 
+    $df = SDO_DAS_DataFactory::getDataFactory();
+    $df->addType('ns', 'Company');
+    $df->addType('ns', 'Employee');
+    $df->addPropertyToType('ns', 'Company', 'employee', 'ns', 'Employee', array('many'=>true, 'containment'=>true));
+    $df->addPropertyToType('ns', 'Employee', 'name', SDO_TYPE_NAMESPACE_URI, 'String');
+
+    $company = $df->create('ns', 'Company');
+    foreach (array('Ann', 'Bob', 'Cy') as $name) {
+        $employee = $company->createDataObject('employee');
+        $employee->name = $name;
+    }
+
+    var_dump($company->employee === $company->employee);
+    for ($i = 0; $i < count($company->employee); $i++) {
+        echo $company->employee[$i]->name . "\n";
+    }
+    foreach ($company->employee as $i => $employee) {
+        echo "$i " . $employee->name . "\n";
+    }
+    var_dump($company->employee[1] === $company['employee[2]']);
+
+    unset($company->employee);
+    echo count($company->employee) . "\n";
+    $company->createDataObject('employee')->name = 'Di';
+    foreach ($company->employee as $employee) {
+        echo $employee->name . "\n";
+    }
+?>
+--EXPECT--
+bool(true)
+Ann
+Bob
+Cy
+0 Ann
+1 Bob
+2 Cy
+bool(true)
+0
+Di
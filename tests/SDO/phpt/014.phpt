@@ -0,0 +1,58 @@
+--TEST--
+SDO_DataObject structural equality and hash test
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php 
+    $df = SDO_DAS_DataFactory::getDataFactory();
+    $df->addType('ns', 'Company');
+    $df->addType('ns', 'Employee');
+    $df->addPropertyToType('ns', 'Company', 'name', SDO_TYPE_NAMESPACE_URI, 'String');
+    $df->addPropertyToType('ns', 'Company', 'employee', 'ns', 'Employee', array('many'=>true, 'containment'=>true));
+    $df->addPropertyToType('ns', 'Company', 'best', 'ns', 'Employee', array('containment'=>false));
+    $df->addPropertyToType('ns', 'Employee', 'name', SDO_TYPE_NAMESPACE_URI, 'String');
+    $df->addPropertyToType('ns', 'Employee', 'age', SDO_TYPE_NAMESPACE_URI, 'Integer');
+
+    function build($df, $names) {
+        $company = $df->create('ns', 'Company');
+        $company->name = 'Acme';
+        foreach ($names as $name) {
+            $employee = $company->createDataObject('employee');
+            $employee->name = $name;
+            $employee->age = 30;
+        }
+        $company->best = $company->employee[1];
+        return $company;
+    }
+
+    $a = build($df, array('Ann', 'Bob'));
+    $b = build($df, array('Ann', 'Bob'));
+    var_dump($a == $b);
+    var_dump($a->hash() == $b->hash());
+    var_dump(strlen($a->hash()));
+
+    $b->employee[0]->age = '30';
+    var_dump($a == $b);
+
+    $b->employee[0]->age = 31;
+    var_dump($a == $b);
+    var_dump($a->hash() == $b->hash());
+
+    $b->employee[0]->age = 30;
+    $b->best = $b->employee[0];
+    var_dump($a == $b);
+
+    $c = build($df, array('Ann', 'Bob', 'Cy'));
+    var_dump($a == $c);
+    var_dump($a->hash() == $c->hash());
+?>
+--EXPECT--
+bool(true)
+bool(true)
+int(16)
+bool(true)
+bool(false)
+bool(false)
+bool(false)
+bool(false)
+bool(false)
@@ -0,0 +1,55 @@
+--TEST--
+SDO_DataObject clone with references test
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php 
+    $df = SDO_DAS_DataFactory::getDataFactory();
+    $df->addType('ns', 'Company');
+    $df->addType('ns', 'Department');
+    $df->addType('ns', 'Employee');
+    $df->addPropertyToType('ns', 'Company', 'name', SDO_TYPE_NAMESPACE_URI, 'String');
+    $df->addPropertyToType('ns', 'Company', 'department', 'ns', 'Department', array('many'=>true, 'containment'=>true));
+    $df->addPropertyToType('ns', 'Company', 'best', 'ns', 'Employee', array('containment'=>false));
+    $df->addPropertyToType('ns', 'Department', 'name', SDO_TYPE_NAMESPACE_URI, 'String');
+    $df->addPropertyToType('ns', 'Department', 'employee', 'ns', 'Employee', array('many'=>true, 'containment'=>true));
+    $df->addPropertyToType('ns', 'Department', 'manager', 'ns', 'Employee', array('containment'=>false));
+    $df->addPropertyToType('ns', 'Employee', 'name', SDO_TYPE_NAMESPACE_URI, 'String');
+
+    $company = $df->create('ns', 'Company');
+    $company->name = 'Acme';
+    $department = $company->createDataObject('department');
+    $department->name = 'Shoes';
+    $ann = $department->createDataObject('employee');
+    $ann->name = 'Ann';
+    $bob = $department->createDataObject('employee');
+    $bob->name = 'Bob';
+    $department->manager = $ann;
+    $company->best = $bob;
+
+    $copy = clone $company;
+    var_dump($copy == $company);
+    var_dump($copy->best->name);
+
+    /* The references lead into the copy, not the original */
+    $copy->best->name = 'Robert';
+    $copy->department[0]->manager->name = 'Anne';
+    var_dump($copy->department[0]->employee[1]->name);
+    var_dump($copy->department[0]->employee[0]->name);
+    var_dump($company->best->name);
+    var_dump($company->department[0]->manager->name);
+
+    /* A clone of part of the graph keeps the references within it */
+    $department_copy = clone $department;
+    var_dump($department_copy->manager->name);
+    var_dump(isset($department_copy->manager));
+?>
+--EXPECT--
+bool(true)
+string(3) "Bob"
+string(6) "Robert"
+string(4) "Anne"
+string(3) "Bob"
+string(3) "Ann"
+string(3) "Ann"
+bool(true)
@@ -0,0 +1,63 @@
+--TEST--
+SDO_DataObject binary serialize test
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php 
+    $df = SDO_DAS_DataFactory::getDataFactory();
+    $df->addType('ns', 'Company');
+    $df->addType('ns', 'Employee');
+    $df->addType('ns', 'Extra', array('open'=>true));
+    $df->addPropertyToType('ns', 'Company', 'name', SDO_TYPE_NAMESPACE_URI, 'String');
+    $df->addPropertyToType('ns', 'Company', 'employee', 'ns', 'Employee', array('many'=>true, 'containment'=>true));
+    $df->addPropertyToType('ns', 'Company', 'best', 'ns', 'Employee', array('containment'=>false));
+    $df->addPropertyToType('ns', 'Company', 'extra', 'ns', 'Extra');
+    $df->addPropertyToType('ns', 'Employee', 'name', SDO_TYPE_NAMESPACE_URI, 'String');
+    $df->addPropertyToType('ns', 'Employee', 'salary', SDO_TYPE_NAMESPACE_URI, 'Double');
+    $df->addPropertyToType('ns', 'Employee', 'scores', SDO_TYPE_NAMESPACE_URI, 'Integer', array('many'=>true));
+
+    $company = $df->create('ns', 'Company');
+    $company->name = 'Acme';
+    $ann = $company->createDataObject('employee');
+    $ann->name = 'Ann';
+    $ann->salary = 1234.5;
+    $ann->scores[] = -3;
+    $ann->scores[] = 70000;
+    $bob = $company->createDataObject('employee');
+    $bob->name = null;
+    $company->best = $ann;
+    $extra = $company->createDataObject('extra');
+    $extra->note = 'open';
+    $extra->count = 42;
+
+    $serialized = serialize($company);
+    $copy = unserialize($serialized);
+    var_dump($copy == $company);
+    var_dump($copy->best->name);
+    var_dump($copy->employee[0]->salary);
+    var_dump($copy->employee[0]->scores[1]);
+    var_dump($copy->employee[1]->name);
+    var_dump($copy->extra->note, $copy->extra->count);
+
+    /* The reference leads into the copy */
+    $copy->best->name = 'Anne';
+    var_dump($copy->employee[0]->name);
+    var_dump($company->employee[0]->name);
+
+    /* Unserializing again gives a graph of its own */
+    $again = unserialize($serialized);
+    var_dump($again->best->name);
+    var_dump($again == $company);
+?>
+--EXPECT--
+bool(true)
+string(3) "Ann"
+float(1234.5)
+int(70000)
+NULL
+string(4) "open"
+int(42)
+string(4) "Anne"
+string(3) "Ann"
+string(3) "Ann"
+bool(true)
@@ -0,0 +1,47 @@
+--TEST--
+SDO_DAS_XML loadNode and saveToDOM test
+--SKIPIF--
+<?php
+    if (!extension_loaded("sdo")) print "skip";
+    else if (!extension_loaded("dom")) print "skip - dom extension not loaded";
+?>
+--FILE--
+<?php 
+    $dirname = dirname($_SERVER['SCRIPT_FILENAME']);
+    $xmldas = SDO_DAS_XML::create("${dirname}/company.xsd");
+
+    $dom = new DOMDocument();
+    $dom->load("${dirname}/company.xml");
+    $xdoc = $xmldas->loadNode($dom);
+    $company = $xdoc->getRootDataObject();
+    echo $company->name . "\n";
+    echo $company->employeeOfTheMonth->name . "\n";
+    echo ($xmldas->saveString($xdoc) ==
+        $xmldas->saveString($xmldas->loadFile("${dirname}/company.xml")))
+        ? "same\n" : "different\n";
+
+    /* An element further down a tree, with its namespace declared above it */
+    $envelope = new DOMDocument();
+    $envelope->loadXML('<env:Envelope xmlns:env="urn:env" xmlns:c="companyNS"><env:Body>' .
+        '<c:company name="Acme"><departments name="Shoes"/></c:company>' .
+        '</env:Body></env:Envelope>');
+    $body = $envelope->documentElement->firstChild;
+    $acme = $xmldas->loadNode($body->firstChild)->getRootDataObject();
+    echo $acme->name . ' ' . $acme->departments[0]->name . "\n";
+
+    $out = $xmldas->saveToDOM($xdoc);
+    echo get_class($out) . "\n";
+    echo $out->documentElement->localName . ' ' .
+        $out->documentElement->getAttribute('name') . "\n";
+    echo $out->getElementsByTagName('employees')->length . "\n";
+    echo $xmldas->loadNode($out->documentElement)->getRootDataObject()->name . "\n";
+?>
+--EXPECT--
+MegaCorp
+Jane Doe
+same
+Acme Shoes
+DOMDocument
+company MegaCorp
+3
+MegaCorp
@@ -0,0 +1,48 @@
+--TEST--
+SDO_Model_Type and SDO_Model_Property objects are shared within a request
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php 
+    $df = SDO_DAS_DataFactory::getDataFactory();
+    $df->addType('ns', 'Person', array('open'=>true));
+    $df->addPropertyToType('ns', 'Person', 'name', SDO_TYPE_NAMESPACE_URI, 'String');
+    $df->addPropertyToType('ns', 'Person', 'friend', 'ns', 'Person', array('containment'=>false));
+
+    $ann = $df->create('ns', 'Person');
+    $bob = $df->create('ns', 'Person');
+    $ann_reflection = new SDO_Model_ReflectionDataObject($ann);
+    $bob_reflection = new SDO_Model_ReflectionDataObject($bob);
+    $type = $ann_reflection->getType();
+    var_dump($type === $bob_reflection->getType());
+
+    $properties = $type->getProperties();
+    var_dump(count($properties));
+    var_dump($properties[0] === $type->getProperty('name'));
+    var_dump($properties[1]->getType() === $type);
+    var_dump($properties[1]->getContainingType() === $type);
+    var_dump($properties === $bob_reflection->getType()->getProperties());
+
+    /* the array returned is a copy */
+    unset($properties[0]);
+    var_dump(count($type->getProperties()));
+
+    /* open properties belong to the data object, and are not shared */
+    $ann->nickname = 'Annie';
+    $instance_properties = $ann_reflection->getInstanceProperties();
+    $again = $ann_reflection->getInstanceProperties();
+    var_dump($instance_properties[2]->name);
+    var_dump($instance_properties[2] === $again[2]);
+    var_dump($instance_properties[0] === $again[0]);
+?>
+--EXPECT--
+bool(true)
+int(2)
+bool(true)
+bool(true)
+bool(true)
+bool(true)
+int(2)
+string(8) "nickname"
+bool(false)
+bool(true)
@@ -0,0 +1,34 @@
+--TEST--
+String and bytes values are read back whole, including embedded NULs
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php 
+    $df = SDO_DAS_DataFactory::getDataFactory();
+    $df->addType('ns', 'Document');
+    $df->addPropertyToType('ns', 'Document', 'text', SDO_TYPE_NAMESPACE_URI, 'String');
+    $df->addPropertyToType('ns', 'Document', 'data', SDO_TYPE_NAMESPACE_URI, 'Bytes');
+    $df->addPropertyToType('ns', 'Document', 'size', SDO_TYPE_NAMESPACE_URI, 'Integer');
+
+    $doc = $df->create('ns', 'Document');
+    $text = str_repeat('0123456789', 100000);
+    $doc->text = $text;
+    $doc->data = "a\0b\0c";
+    $doc->size = 42;
+
+    var_dump($doc->text === $text);
+    var_dump(strlen($doc->data));
+    var_dump($doc->data === "a\0b\0c");
+
+    $values = $doc->getValues(array('text', 'data', 'size'));
+    var_dump($values['text'] === $text);
+    var_dump($values['data'] === "a\0b\0c");
+    var_dump($values['size']);
+?>
+--EXPECT--
+bool(true)
+int(5)
+bool(true)
+bool(true)
+bool(true)
+int(42)
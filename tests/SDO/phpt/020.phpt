@@ -0,0 +1,37 @@
+--TEST--
+sdo_get_stats() counts the work done in the request when sdo.stats is on
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--INI--
+sdo.stats=1
+--FILE--
+<?php 
+    $xmldas = SDO_DAS_XML::create(dirname(__FILE__) . '/company.xsd');
+    $doc = $xmldas->loadFile(dirname(__FILE__) . '/company.xml');
+    $company = $doc->getRootDataObject();
+    $name = $company->name;
+
+    $stats = sdo_get_stats();
+    var_dump(count($stats));
+    var_dump($stats['schema_loads']);
+    var_dump($stats['xml_bytes_parsed'] == filesize(dirname(__FILE__) . '/company.xsd') +
+                                           filesize(dirname(__FILE__) . '/company.xml'));
+    /* the company, its department and three employees */
+    var_dump($stats['objects_created']);
+
+    $xml = $xmldas->saveString($doc);
+    $stats = sdo_get_stats();
+    var_dump($stats['xml_bytes_written'] == strlen($xml));
+
+    /* counting stops when the setting is turned off */
+    ini_set('sdo.stats', 0);
+    $xmldas->saveString($doc);
+    var_dump(sdo_get_stats() == $stats);
+?>
+--EXPECT--
+int(12)
+int(1)
+bool(true)
+int(5)
+bool(true)
+bool(true)
@@ -0,0 +1,47 @@
+--TEST--
+Predicate lookups in a long list follow changes to the list and its keys
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php 
+    $xmldas = SDO_DAS_XML::create(dirname(__FILE__) . '/company.xsd');
+    $company = $xmldas->createDataObject('companyNS', 'CompanyType');
+    for ($i = 0; $i < 100; $i++) {
+        $dept = $company->createDataObject('departments');
+        $dept->number = $i * 10;
+        $dept->name = "Dept $i";
+    }
+
+    var_dump($company["departments[number=500]"]->name);
+    var_dump($company["departments[name='Dept 7']"]->number);
+
+    /* a changed key is found by its new value only */
+    $company["departments[number=500]"]->number = 5;
+    var_dump($company["departments[number=5]"]->name);
+    try {
+        $company["departments[number=500]"];
+        echo "found\n";
+    } catch (SDO_Exception $e) {
+        echo "not found\n";
+    }
+
+    /* the first of several matching items is found */
+    $company->departments[90]->name = 'Dept 3';
+    var_dump($company["departments[name='Dept 3']"]->number);
+    unset($company->departments[3]);
+    var_dump($company["departments[name='Dept 3']"]->number);
+
+    /* items added later are found */
+    $dept = $company->createDataObject('departments');
+    $dept->number = 12345;
+    $dept->name = 'New';
+    var_dump($company["departments[number=12345]"]->name);
+?>
+--EXPECT--
+string(7) "Dept 50"
+int(70)
+string(7) "Dept 50"
+not found
+int(30)
+int(900)
+string(3) "New"
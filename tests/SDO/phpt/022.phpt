@@ -0,0 +1,53 @@
+--TEST--
+Adding types to an XML DAS created with a cache key leaves the shared model alone
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php 
+$schema = <<<END_SCHEMA
+<schema xmlns="http://www.w3.org/2001/XMLSchema"
+        targetNamespace="extraNS" xmlns:extra="extraNS">
+<complexType name="ExtraType">
+<sequence>
+<element name="note" type="string"/>
+</sequence>
+</complexType>
+</schema>
+END_SCHEMA;
+
+$xsd_file = tempnam(sys_get_temp_dir(), 'sdo');
+file_put_contents($xsd_file, $schema);
+
+$xmldas = SDO_DAS_XML::create(dirname(__FILE__) . '/company.xsd', 'phpt-022');
+$company = $xmldas->createDataObject('companyNS', 'CompanyType');
+$xmldas->addTypes($xsd_file);
+unlink($xsd_file);
+
+$extra = $xmldas->createDataObject('extraNS', 'ExtraType');
+$extra->note = 'private';
+var_dump($extra->note);
+
+/* the types the DAS was created with are still there */
+$dept = $xmldas->createDataObject('companyNS', 'DepartmentType');
+$dept->name = 'Shoe';
+var_dump($dept->name);
+
+/* objects created from the shared model are unaffected */
+$company->name = 'Acme';
+var_dump($company->name);
+
+/* another DAS with the same key does not see the added type */
+$other = SDO_DAS_XML::create(dirname(__FILE__) . '/company.xsd', 'phpt-022');
+$other->createDataObject('companyNS', 'CompanyType');
+try {
+    $other->createDataObject('extraNS', 'ExtraType');
+    echo "shared\n";
+} catch (SDO_Exception $e) {
+    echo "not shared\n";
+}
+?>
+--EXPECT--
+string(7) "private"
+string(4) "Shoe"
+string(4) "Acme"
+not shared
@@ -0,0 +1,67 @@
+--TEST--
+Moving entries within a sequence keeps them and their settings in step
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php 
+    $df = SDO_DAS_DataFactory::getDataFactory();
+    $df->addType('ns', 'Mixed', array('sequenced'=>true));
+    $df->addPropertyToType('ns', 'Mixed', 'string', SDO_TYPE_NAMESPACE_URI, 'String');
+    $df->addPropertyToType('ns', 'Mixed', 'int', SDO_TYPE_NAMESPACE_URI, 'Integer');
+
+    function dump($seq) {
+        for ($i = 0; $i < count($seq); $i++) {
+            $p = $seq->getProperty($i);
+            echo ($p ? $p->getName() : 'text') . '=' . $seq[$i] . "\n";
+        }
+        echo "--\n";
+    }
+
+    $mixed = $df->create('ns', 'Mixed');
+    $seq = $mixed->getSequence();
+    $seq->insert('a');
+    $seq->insert('x', NULL, 'string');
+    $seq->insert('b');
+    $seq->insert(42, NULL, 'int');
+
+    /* to the end, then back to the front */
+    $seq->move(3, 0);
+    dump($seq);
+    $seq->move(0, 2);
+    dump($seq);
+
+    /* setting a property finds its moved entry */
+    $mixed->string = 'y';
+    $mixed->int = 7;
+    dump($seq);
+
+    try {
+        $seq->move(0, 4);
+        echo "moved\n";
+    } catch (SDO_IndexOutOfBoundsException $e) {
+        echo "out of range\n";
+    }
+    dump($seq);
+?>
+--EXPECT--
+string=x
+text=b
+int=42
+text=a
+--
+int=42
+string=x
+text=b
+text=a
+--
+int=7
+string=y
+text=b
+text=a
+--
+out of range
+int=7
+string=y
+text=b
+text=a
+--
@@ -0,0 +1,76 @@
+--TEST--
+Change summary old values keep their types, including for deleted objects
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php 
+    $df = SDO_DAS_DataFactory::getDataFactory();
+    $df->addType('ns', 'Root');
+    $df->addType('ns', 'Child');
+    $df->addPropertyToType('ns', 'Root', 'cs', SDO_TYPE_NAMESPACE_URI, 'ChangeSummary');
+    $df->addPropertyToType('ns', 'Root', 'name', SDO_TYPE_NAMESPACE_URI, 'String');
+    $df->addPropertyToType('ns', 'Root', 'count', SDO_TYPE_NAMESPACE_URI, 'Integer');
+    $df->addPropertyToType('ns', 'Root', 'flag', SDO_TYPE_NAMESPACE_URI, 'Boolean');
+    $df->addPropertyToType('ns', 'Root', 'price', SDO_TYPE_NAMESPACE_URI, 'Double');
+    $df->addPropertyToType('ns', 'Root', 'note', SDO_TYPE_NAMESPACE_URI, 'String');
+    $df->addPropertyToType('ns', 'Root', 'data', SDO_TYPE_NAMESPACE_URI, 'Bytes');
+    $df->addPropertyToType('ns', 'Root', 'children', 'ns', 'Child', array('many'=>true, 'containment'=>true));
+    $df->addPropertyToType('ns', 'Child', 'label', SDO_TYPE_NAMESPACE_URI, 'String');
+    $df->addPropertyToType('ns', 'Child', 'tags', SDO_TYPE_NAMESPACE_URI, 'String', array('many'=>true));
+
+    function dump($settings) {
+        foreach ($settings as $setting) {
+            echo $setting->getPropertyName();
+            if ($setting->getListIndex() >= 0) {
+                echo '[' . $setting->getListIndex() . ']';
+            }
+            echo $setting->isSet() ? ' set ' : ' unset ';
+            $value = $setting->getValue();
+            if (is_object($value)) {
+                echo "object {$value->label}\n";
+            } else {
+                var_dump($value);
+            }
+        }
+        echo "--\n";
+    }
+
+    $root = $df->create('ns', 'Root');
+    $root->name = 'old';
+    $root->count = 7;
+    $root->flag = true;
+    $root->price = 1.5;
+    $root->data = 'abc';
+    $child = $root->createDataObject('children');
+    $child->label = 'first';
+    $child->tags[] = 'a';
+    $child->tags[] = 'b';
+
+    $cs = $root->getChangeSummary();
+    $cs->beginLogging();
+    $root->name = 'new';
+    $root->name = 'newer';
+    $root->count = 8;
+    $root->flag = false;
+    $root->price = 2.5;
+    $root->note = 'n';
+    $root->data = 'xy';
+    unset($root->children[0]);
+
+    /* only the value from before the first change is kept */
+    dump($cs->getOldValues($root));
+    dump($cs->getOldValues($child));
+?>
+--EXPECT--
+name set string(3) "old"
+count set int(7)
+flag set bool(true)
+price set float(1.5)
+note unset NULL
+data set string(3) "abc"
+children[0] set object first
+--
+label set string(5) "first"
+tags[1] set string(1) "b"
+tags[0] set string(1) "a"
+--
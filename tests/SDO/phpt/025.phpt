@@ -0,0 +1,31 @@
+--TEST--
+IDREFs are resolved within the document being loaded only
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php 
+    function company($sn, $name) {
+        return "<company xmlns=\"companyNS\" name=\"X\" employeeOfTheMonth=\"E0003\">"
+             . "<departments name=\"D\"><employees name=\"$name\" SN=\"$sn\"/></departments>"
+             . "</company>";
+    }
+
+    $xmldas = SDO_DAS_XML::create(dirname(__FILE__) . '/company.xsd');
+
+    /* the same DAS loads each document, and the ID table of one must
+     * not resolve the references of the next */
+    foreach (array(array('E0003', 'Jane Doe'),
+                   array('E0009', 'Al Smith'),
+                   array('E0003', 'Bob Brown')) as $employee) {
+        $company = $xmldas->loadString(company($employee[0], $employee[1]))->getRootDataObject();
+        if (isset($company->employeeOfTheMonth)) {
+            var_dump($company->employeeOfTheMonth->name);
+        } else {
+            echo "unresolved\n";
+        }
+    }
+?>
+--EXPECT--
+string(8) "Jane Doe"
+unresolved
+string(9) "Bob Brown"
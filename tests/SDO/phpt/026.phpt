@@ -0,0 +1,63 @@
+--TEST--
+Change summary paths follow objects as the lists holding them change
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php 
+$schema = <<<END_SCHEMA
+<xsd:schema xmlns:xsd="http://www.w3.org/2001/XMLSchema" xmlns:sdo="commonj.sdo"
+  xmlns:r="refNS" targetNamespace="refNS">
+  <xsd:element name="list" type="r:ListType"/>
+  <xsd:complexType name="ListType">
+    <xsd:sequence>
+      <xsd:element name="changes" type="sdo:ChangeSummaryType"/>
+      <xsd:element name="groups" type="r:GroupType" maxOccurs="unbounded"/>
+    </xsd:sequence>
+  </xsd:complexType>
+  <xsd:complexType name="GroupType">
+    <xsd:sequence>
+      <xsd:element name="items" type="r:ItemType" maxOccurs="unbounded"/>
+    </xsd:sequence>
+  </xsd:complexType>
+  <xsd:complexType name="ItemType">
+    <xsd:attribute name="name" type="xsd:string"/>
+  </xsd:complexType>
+</xsd:schema>
+END_SCHEMA;
+
+$xsd_file = tempnam(sys_get_temp_dir(), 'sdo');
+file_put_contents($xsd_file, $schema);
+$xmldas = SDO_DAS_XML::create($xsd_file);
+unlink($xsd_file);
+
+$list = $xmldas->createDataObject('refNS', 'ListType');
+for ($g = 0; $g < 2; $g++) {
+    $group = $list->createDataObject('groups');
+    for ($i = 0; $i < 3; $i++) {
+        $item = $group->createDataObject('items');
+        $item->name = "I$g$i";
+    }
+}
+$doc = $xmldas->createDocument('refNS', 'list', $list);
+$target = $list->groups[1]->items[2];
+
+$list->getChangeSummary()->beginLogging();
+$target->name = 'changed';
+/* both of these move the target to a new position */
+$list->groups->insert($xmldas->createDataObject('refNS', 'GroupType'), 0);
+unset($list->groups[2]->items[0]);
+
+preg_match_all('/sdo:ref="[^"]*"|<create>[^<]*|<delete>[^<]*/',
+    $xmldas->saveString($doc), $matches);
+echo implode("\n", $matches[0]) . "\n";
+?>
+--EXPECT--
+<create>#/groups.0
+<delete>#/groups.2/items.0
+sdo:ref="#/groups.2/items.1"
+sdo:ref="#/"
+sdo:ref="#/groups.1"
+sdo:ref="#/groups.2"
+sdo:ref="#/groups.2"
+sdo:ref="#/groups.2/items.0"
+sdo:ref="#/groups.2/items.1"
@@ -0,0 +1,48 @@
+--TEST--
+SDO_DAS_Relational normalises a result set whose metadata lists a child table first
+--SKIPIF--
+<?php if (!extension_loaded("sdo") || !class_exists("PDO")) print "skip"; ?>
+--FILE--
+<?php
+require_once "SDO/DAS/Relational.php";
+
+/* Stands in for a PDOStatement, which the graph builder only iterates */
+class ResultSet extends ArrayIterator {
+    public function setFetchMode($mode) {
+    }
+}
+
+$database_metadata = array(
+    array('name' => 'department', 'columns' => array('id', 'name', 'co_id'),
+          'PK' => 'id', 'FK' => array('from' => 'co_id', 'to' => 'company')),
+    array('name' => 'company', 'columns' => array('id', 'name'), 'PK' => 'id'));
+$containment_metadata = array(array('parent' => 'company', 'child' => 'department'));
+
+$das = new SDO_DAS_Relational($database_metadata, 'company', $containment_metadata);
+
+$rows = new ResultSet(array(
+    array('1', 'Acme', '10', 'Sales'),
+    array('1', 'Acme', '11', 'Shipping'),
+    array('2', 'Ajax', '12', 'Research')));
+$root = $das->normaliseResultSet($rows,
+    array('company.id', 'company.name', 'department.id', 'department.name'));
+
+foreach ($root['company'] as $company) {
+    echo $company['name'], ':';
+    foreach ($company['department'] as $department) {
+        echo ' ', $department['name'];
+    }
+    echo "\n";
+}
+
+try {
+    $das->normaliseResultSet(new ResultSet(array(array('1', '20'))),
+        array('company.id', 'project.id'));
+} catch (SDO_DAS_Relational_Exception $e) {
+    echo get_class($e), "\n";
+}
+?>
+--EXPECT--
+Acme: Sales Shipping
+Ajax: Research
+SDO_DAS_Relational_Exception
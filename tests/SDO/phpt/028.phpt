@@ -0,0 +1,28 @@
+--TEST--
+SDO_DataObject::setValues writes in array order and stops at a failure
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php
+$df = SDO_DAS_DataFactory::getDataFactory();
+$df->addType('ns', 'Item');
+$df->addPropertyToType('ns', 'Item', 'a', SDO_TYPE_NAMESPACE_URI, 'String');
+$df->addPropertyToType('ns', 'Item', 'b', SDO_TYPE_NAMESPACE_URI, 'String');
+
+$item = $df->create('ns', 'Item');
+$item->setValues(array('a' => 'one', 1 => 'two'));
+echo $item->a, ' ', $item->b, "\n";
+
+$item = $df->create('ns', 'Item');
+try {
+    $item->setValues(array('a' => 'one', 'nosuch' => 1, 'b' => 'two'));
+} catch (SDO_PropertyNotFoundException $e) {
+    echo get_class($e), "\n";
+}
+var_dump(isset($item->a), isset($item->b));
+?>
+--EXPECT--
+one two
+SDO_PropertyNotFoundException
+bool(true)
+bool(false)
@@ -0,0 +1,29 @@
+--TEST--
+SDO_DataObject foreach sees properties set and unset in the loop body
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php
+$df = SDO_DAS_DataFactory::getDataFactory();
+$df->addType('ns', 'Item');
+$df->addPropertyToType('ns', 'Item', 'a', SDO_TYPE_NAMESPACE_URI, 'String');
+$df->addPropertyToType('ns', 'Item', 'b', SDO_TYPE_NAMESPACE_URI, 'String');
+$df->addPropertyToType('ns', 'Item', 'c', SDO_TYPE_NAMESPACE_URI, 'String');
+$df->addPropertyToType('ns', 'Item', 'd', SDO_TYPE_NAMESPACE_URI, 'String');
+
+$item = $df->create('ns', 'Item');
+$item->a = 'one';
+$item->c = 'three';
+foreach ($item as $name => $value) {
+    echo "$name=$value\n";
+    if ($name == 'a') {
+        $item->b = 'two';
+        unset($item->c);
+        $item->d = 'four';
+    }
+}
+?>
+--EXPECT--
+a=one
+b=two
+d=four
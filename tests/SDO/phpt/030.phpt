@@ -0,0 +1,32 @@
+--TEST--
+Predicate lookups by an alias of the key follow changes made by its name
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php 
+    $xmldas = SDO_DAS_XML::create(dirname(__FILE__) . '/company_alias.xsd');
+    $company = $xmldas->createDataObject('companyNS', 'CompanyType');
+    for ($i = 0; $i < 40; $i++) {
+        $dept = $company->createDataObject('depts');
+        $dept->number = $i * 10;
+        $dept->name = "Dept $i";
+    }
+
+    var_dump($company["depts[num=70]"]->name);
+
+    /* the key is changed by its name and found by its alias */
+    $company["depts[num=70]"]->number = 100;
+    var_dump($company["depts[num=100]"]->name);
+    var_dump($company["depts[number=100]"]->name);
+    try {
+        $company["depts[num=70]"];
+        echo "found\n";
+    } catch (SDO_Exception $e) {
+        echo "not found\n";
+    }
+?>
+--EXPECT--
+string(6) "Dept 7"
+string(6) "Dept 7"
+string(6) "Dept 7"
+not found
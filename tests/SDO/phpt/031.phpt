@@ -0,0 +1,86 @@
+--TEST--
+SDO_DataObject serialize keeps the change summary, and cached models by fingerprint
+--SKIPIF--
+<?php if (!extension_loaded("sdo")) print "skip"; ?>
+--FILE--
+<?php 
+    $df = SDO_DAS_DataFactory::getDataFactory();
+    $df->addType('ns', 'Root');
+    $df->addType('ns', 'Company');
+    $df->addType('ns', 'Department');
+    $df->addType('ns', 'Employee');
+    $df->addPropertyToType('ns', 'Root', 'cs', SDO_TYPE_NAMESPACE_URI, 'ChangeSummary');
+    $df->addPropertyToType('ns', 'Root', 'company', 'ns', 'Company', array('many'=>true, 'containment'=>true));
+    $df->addPropertyToType('ns', 'Company', 'name', SDO_TYPE_NAMESPACE_URI, 'String');
+    $df->addPropertyToType('ns', 'Company', 'department', 'ns', 'Department', array('many'=>true, 'containment'=>true));
+    $df->addPropertyToType('ns', 'Department', 'name', SDO_TYPE_NAMESPACE_URI, 'String');
+    $df->addPropertyToType('ns', 'Department', 'employee', 'ns', 'Employee', array('many'=>true, 'containment'=>true));
+    $df->addPropertyToType('ns', 'Employee', 'name', SDO_TYPE_NAMESPACE_URI, 'String');
+
+    $root = $df->create('ns', 'Root');
+    $company = $root->createDataObject('company');
+    $company->name = 'ACME';
+    $old_department = $company->createDataObject('department');
+    $old_department->name = 'Old';
+    $old_employee = $old_department->createDataObject('employee');
+    $old_employee->name = 'Ann';
+
+    $root->getChangeSummary()->beginLogging();
+    $company->name = 'MegaCorp';
+    unset($company->department[0]);
+    $department = $company->createDataObject('department');
+    $employee = $department->createDataObject('employee');
+    $employee->name = 'Bob';
+    $department->name = 'New';
+
+    function plan($root) {
+        $names = array(SDO_DAS_ChangeSummary::ADDITION => 'ADDITION',
+                       SDO_DAS_ChangeSummary::MODIFICATION => 'MODIFICATION',
+                       SDO_DAS_ChangeSummary::DELETION => 'DELETION');
+        foreach ($root->getChangeSummary()->getChangePlan() as $change) {
+            $type = $change['data_object']->getTypeName();
+            if ($type == 'Root') continue;
+            echo $names[$change['change_type']] . ' ' . $type . ' ' . $change['depth'];
+            foreach ($change['old_values'] as $name => $value) {
+                if ($name == 'name') echo " $name=$value";
+            }
+            echo "\n";
+        }
+        echo "--\n";
+    }
+
+    /* the copy has the same changes, and goes on logging */
+    $copy = unserialize(serialize($root));
+    plan($copy);
+    var_dump($copy->getChangeSummary()->isLogging());
+    $copy->company[0]->department[0]->employee[0]->name = 'Bobby';
+    $copy->company[0]->department[0]->name = 'Newer';
+    plan($copy);
+
+    /* A cached model is known by its fingerprint, so it is not written */
+    $dirname = dirname($_SERVER['SCRIPT_FILENAME']);
+    $xmldas = SDO_DAS_XML::create("${dirname}/company.xsd");
+    $cached_xmldas = SDO_DAS_XML::create("${dirname}/company.xsd", '031');
+    $company = $xmldas->loadFile("${dirname}/company.xml")->getRootDataObject();
+    $cached_company = $cached_xmldas->loadFile("${dirname}/company.xml")->getRootDataObject();
+    $serialized = serialize($cached_company);
+    var_dump(strlen($serialized) < strlen(serialize($company)));
+    $copy = unserialize($serialized);
+    echo $copy->employeeOfTheMonth->name . "\n";
+?>
+--EXPECT--
+DELETION Employee 3 name=Ann
+DELETION Department 2 name=Old
+ADDITION Department 2
+ADDITION Employee 3
+MODIFICATION Company 1 name=ACME
+--
+bool(true)
+DELETION Employee 3 name=Ann
+DELETION Department 2 name=Old
+ADDITION Department 2
+ADDITION Employee 3
+MODIFICATION Company 1 name=ACME
+--
+bool(true)
+Jane Doe